@@ -0,0 +1,104 @@
+#include <cstdint>
+#include <stdexcept>
+
+#include "Arena.h"
+
+using namespace OpenModelica;
+
+namespace
+{
+  thread_local Arena *currentArena = nullptr;
+}
+
+Arena::Scope::Scope(Arena *arena) noexcept
+  : _previous{currentArena}
+{
+  currentArena = arena;
+}
+
+Arena::Scope::~Scope()
+{
+  currentArena = _previous;
+}
+
+Arena::Arena(size_t blockSize)
+  : _blockSize{blockSize}
+{
+
+}
+
+Arena::~Arena()
+{
+  // Destroy the objects in the reverse order of creation, since objects may
+  // refer to objects created before them.
+  for (auto it = _destructors.rbegin(); it != _destructors.rend(); ++it) {
+    it->destroy(it->object);
+  }
+}
+
+Arena& Arena::current()
+{
+  if (!currentArena) {
+    throw std::logic_error("Arena::current: no arena is active on this thread");
+  }
+
+  return *currentArena;
+}
+
+Arena* Arena::currentOrNull() noexcept
+{
+  return currentArena;
+}
+
+void* Arena::allocate(size_t size, size_t alignment)
+{
+  auto align = [alignment] (std::byte *p) {
+    auto addr = reinterpret_cast<uintptr_t>(p);
+    return reinterpret_cast<std::byte*>((addr + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1));
+  };
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  _used += size;
+
+  if (_pos) {
+    auto p = align(_pos);
+
+    if (p + size <= _end) {
+      _pos = p + size;
+      return p;
+    }
+  }
+
+  if (size + alignment > _blockSize / 4) {
+    // Large objects get a block of their own, so the rest of the current
+    // block isn't wasted.
+    _blocks.emplace_back(new std::byte[size + alignment]);
+    _reserved += size + alignment;
+    return align(_blocks.back().get());
+  }
+
+  _blocks.emplace_back(new std::byte[_blockSize]);
+  _reserved += _blockSize;
+  auto p = align(_blocks.back().get());
+  _pos = p + size;
+  _end = _blocks.back().get() + _blockSize;
+  return p;
+}
+
+size_t Arena::reservedBytes() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _reserved;
+}
+
+size_t Arena::usedBytes() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _used;
+}
+
+void Arena::addDestructor(void *object, void (*destroy)(void*))
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _destructors.push_back({object, destroy});
+}
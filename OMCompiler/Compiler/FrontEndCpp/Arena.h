@@ -0,0 +1,87 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace OpenModelica
+{
+  // A bump allocator for the objects created during one instantiation. The
+  // objects are allocated in large blocks and all of them are destroyed at
+  // once when the arena is destroyed, instead of being individually allocated
+  // and freed. Allocation is thread-safe so the arena can be shared by the
+  // tasks of an instantiation.
+  class Arena
+  {
+    public:
+      // Makes an arena the current one for the calling thread while in scope.
+      class Scope
+      {
+        public:
+          explicit Scope(Arena *arena) noexcept;
+          ~Scope();
+
+          Scope(const Scope&) = delete;
+          Scope& operator= (const Scope&) = delete;
+
+        private:
+          Arena *_previous;
+      };
+
+    public:
+      explicit Arena(size_t blockSize = 64 * 1024);
+      ~Arena();
+
+      Arena(const Arena&) = delete;
+      Arena& operator= (const Arena&) = delete;
+
+      // The arena of the calling thread, throws if there isn't any.
+      static Arena& current();
+      static Arena* currentOrNull() noexcept;
+
+      template<typename T, typename... Args>
+      T* create(Args&&... args)
+      {
+        auto mem = allocate(sizeof(T), alignof(T));
+        auto obj = new (mem) T(std::forward<Args>(args)...);
+
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+          addDestructor(obj, [] (void *p) { static_cast<T*>(p)->~T(); });
+        }
+
+        return obj;
+      }
+
+      void* allocate(size_t size, size_t alignment);
+
+      // The number of bytes allocated from the system and handed out to objects.
+      size_t reservedBytes() const;
+      size_t usedBytes() const;
+
+    private:
+      struct Destructor
+      {
+        void *object;
+        void (*destroy)(void*);
+      };
+
+      void addDestructor(void *object, void (*destroy)(void*));
+
+    private:
+      mutable std::mutex _mutex;
+      size_t _blockSize;
+      std::vector<std::unique_ptr<std::byte[]>> _blocks;
+      std::byte *_pos = nullptr;
+      std::byte *_end = nullptr;
+      size_t _reserved = 0;
+      size_t _used = 0;
+      std::vector<Destructor> _destructors;
+  };
+}
+
+#endif /* ARENA_H */
@@ -27,6 +27,7 @@ namespace OpenModelica
       virtual ~Class();
 
       virtual const ClassTree* classTree() const noexcept { return nullptr; }
+      virtual ClassTree* classTree() noexcept { return nullptr; }
 
       virtual MetaModelica::Value toMetaModelica() const = 0;
   };
@@ -37,6 +38,7 @@ namespace OpenModelica
       PartialClass(const Absyn::ClassParts &definition, bool isClassExtends, InstNode *scope);
 
       const ClassTree* classTree() const noexcept override { return &_elements; }
+      ClassTree* classTree() noexcept override { return &_elements; }
 
       MetaModelica::Value toMetaModelica() const override;
 
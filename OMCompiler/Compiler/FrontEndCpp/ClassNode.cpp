@@ -25,7 +25,7 @@ ClassNode::ClassNode(Absyn::Class *cls, InstNode *parent)
 }
 
 ClassNode::ClassNode(Absyn::Class *cls, InstNode *parent, std::unique_ptr<InstNodeType> nodeType)
-  : _name{cls ? cls->name() : ""},
+  : _name{cls ? Identifier{cls->name()} : Identifier{}},
     _definition{cls},
     _visibility{cls ? cls->prefixes().visibility() : Visibility::Public},
     _parentScope{parent},
@@ -49,19 +49,31 @@ void ClassNode::setNodeType(std::unique_ptr<InstNodeType> nodeType) noexcept
 
 void ClassNode::partialInst()
 {
-  if (_cls) return;
-  _cls = Class::fromAbsyn(*_definition, this);
-  _mmCache.reset();
+  std::call_once(_partialInstFlag, [this] {
+    _cls = Class::fromAbsyn(*_definition, this);
+    _mmCache.reset();
+  });
 }
 
 void ClassNode::expand()
 {
-
+  partialInst();
+  if (auto tree = _cls ? _cls->classTree() : nullptr) tree->expand();
 }
 
 void ClassNode::instantiate()
 {
+  expand();
+  if (auto tree = _cls ? _cls->classTree() : nullptr) tree->instantiate();
+}
 
+InstNode* ClassNode::lookupElement(const std::string &name)
+{
+  // Expanding the class is a no-op if it's already been done, so lookup can
+  // expand classes lazily while other classes are being instantiated.
+  expand();
+  auto tree = _cls ? _cls->classTree() : nullptr;
+  return tree ? tree->lookupElement(name) : nullptr;
 }
 
 MetaModelica::Value ClassNode::toMetaModelica() const
@@ -75,7 +87,7 @@ MetaModelica::Value ClassNode::toMetaModelica() const
 
     // Create a MetaModelica record for the node.
     auto rec = MetaModelica::Record(InstNode::CLASS_NODE, NFInstNode_InstNode_CLASS__NODE__desc, {
-      MetaModelica::Value(_name),
+      MetaModelica::Value(_name.str()),
       _definition->toSCode(),
       _visibility.toSCode(),
       cls_ptr,
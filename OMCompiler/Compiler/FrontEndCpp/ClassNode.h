@@ -3,6 +3,7 @@
 
 #include "InstNode.h"
 
+#include <mutex>
 #include <optional>
 
 namespace OpenModelica
@@ -16,7 +17,8 @@ namespace OpenModelica
 
       //const Class* getClass() const noexcept override;
 
-      const std::string& name() const noexcept override { return _name; }
+      Identifier id() const noexcept override { return _name; }
+      const std::string& name() const noexcept override { return _name.str(); }
       Absyn::Element* definition() const noexcept override { return _definition; }
 
       const InstNodeType* nodeType() const noexcept override;
@@ -26,10 +28,12 @@ namespace OpenModelica
       void expand() override;
       void instantiate() override;
 
+      InstNode* lookupElement(const std::string &name) override;
+
       MetaModelica::Value toMetaModelica() const override;
 
     private:
-      std::string _name;
+      Identifier _name;
       Absyn::Class *_definition;
       Visibility _visibility;
       std::unique_ptr<Class> _cls;
@@ -38,6 +42,9 @@ namespace OpenModelica
       std::unique_ptr<InstNodeType> _nodeType;
 
       mutable std::optional<MetaModelica::Value> _mmCache;
+      // Lookup can reach the same class from several threads, only the first
+      // one creates the class.
+      std::once_flag _partialInstFlag;
   };
 }
 
@@ -1,9 +1,13 @@
+#include <stdexcept>
+
+#include "Arena.h"
 #include "MMAvlTree.h"
 #include "Absyn/ElementVisitor.h"
 #include "ClassNode.h"
 #include "Class.h"
 #include "Import.h"
 #include "ClassTree.h"
+#include "TaskPool.h"
 
 using namespace OpenModelica;
 
@@ -131,9 +135,9 @@ ClassTree::~ClassTree() = default;
 
 void ClassTree::add(Absyn::Class &cls)
 {
-  auto cls_node = std::make_unique<ClassNode>(&cls, _parent);
-  addLocalName(cls.name(), Entry{EntryType::Class, _classes.size()}, *cls_node);
-  _classes.push_back(std::move(cls_node));
+  auto cls_node = Arena::current().create<ClassNode>(&cls, _parent);
+  addLocalName(cls_node->id(), Entry{EntryType::Class, _classes.size()}, *cls_node);
+  _classes.push_back(cls_node);
 
   // If the class is an element redeclare, add an entry in the duplicate tree so
   // we can check later that it actually redeclares something.
@@ -172,6 +176,9 @@ void ClassTree::add(Absyn::Import &/*imp*/)
 // are added to their respective arrays by the instantiation function below.
 void ClassTree::expand()
 {
+  std::unique_lock<std::shared_mutex> lock(_mutex);
+  if (_state != State::Partial) return;
+
   size_t cls_idx = _classes.size();
   size_t comp_idx = 0;
   std::vector<size_t> ext_cls_idxs, ext_comp_idxs;
@@ -186,7 +193,7 @@ void ClassTree::expand()
     if (ref_index < 0) {
       // A component. Add its name to the lookup tree.
       auto entry = Entry{EntryType::Component, comp_idx};
-      addLocalName(c->name(), entry, *c);
+      addLocalName(c->id(), entry, *c);
 
       // If the component is an element redeclare, add an entry in the duplicate
       // tree so we can check later that it actually redeclares something.
@@ -228,16 +235,80 @@ void ClassTree::expand()
 // possible to send in the correct instance in that case, so setting the
 // instance to a nullptr is interpreted by this function to mean that the
 // instance should be set to the cloned clsNode.
+//
+// The local classes, components and extends don't depend on each other at
+// this point, so they're instantiated as tasks on the pool. Each of them
+// instantiates its own elements the same way, and the tasks waiting for their
+// children run other pending tasks meanwhile.
 void ClassTree::instantiate()
 {
+  expand();
+
+  std::call_once(_instantiateFlag, [this] {
+    auto &pool = TaskPool::instance();
+    TaskPool::Group group;
+
+    // The tasks create the nodes of their elements in the same arena.
+    auto arena = Arena::currentOrNull();
+    auto inst = [arena] (InstNode *node) {
+      Arena::Scope scope{arena};
+      node->instantiate();
+    };
+
+    for (auto ext: _extends) {
+      if (ext) pool.run(group, [inst, ext] { inst(ext); });
+    }
+
+    for (auto cls: _classes) {
+      pool.run(group, [inst, cls] { inst(cls); });
+    }
+
+    for (auto comp: _components) {
+      // Skip the placeholders for the extends.
+      if (comp->refIndex() < 0) pool.run(group, [inst, comp] { inst(comp); });
+    }
+
+    pool.wait(group);
+
+    std::unique_lock<std::shared_mutex> lock(_mutex);
+    _state = State::Instantiated;
+  });
+}
+
+InstNode* ClassTree::lookupElement(const std::string &name) const
+{
+  // A name that has never been interned can't be in any lookup table.
+  auto id = Identifier::find(name);
+  if (!id) return nullptr;
+
+  std::shared_lock<std::shared_mutex> lock(_mutex);
+
+  auto it = _table.find(*id);
+  if (it == _table.end()) return nullptr;
+
+  // Inherited elements are only added to the arrays when the tree is
+  // instantiated, until then only the local elements can be returned.
+  auto &entry = it->second;
+  switch (entry.type) {
+    case EntryType::Class:
+      return entry.index < _classes.size() ? _classes[entry.index] : nullptr;
+    case EntryType::Component:
+      return _state >= State::Instantiated && entry.index < _components.size() ?
+        _components[entry.index] : nullptr;
+    case EntryType::Import:
+      // The tree doesn't add imports yet (see ClassTree::add(Absyn::Import&)),
+      // so an import entry means the tree was built by something else.
+      throw std::runtime_error("ClassTree::lookupElement: lookup of imported element " + name + " is not supported");
+  }
 
+  return nullptr;
 }
 
 MetaModelica::Record ClassTree::toNF() const
 {
   LookupTree ltree;
   for (auto &e: _table) {
-    ltree.add(MetaModelica::Value{e.first}, e.second);
+    ltree.add(MetaModelica::Value{e.first.str()}, e.second);
   }
 
   switch (_state) {
@@ -286,7 +357,7 @@ MetaModelica::Record ClassTree::toNF() const
   }
 }
 
-void ClassTree::addLocalName(const std::string &name, Entry entry, const InstNode &/*node*/)
+void ClassTree::addLocalName(Identifier name, Entry entry, const InstNode &/*node*/)
 {
   auto [it, inserted] = _table.try_emplace(name, entry);
 
@@ -301,7 +372,7 @@ void ClassTree::addLocalName(const std::string &name, Entry entry, const InstNod
   }
 }
 
-void ClassTree::addInheritedName(const std::string &name, Entry entry)
+void ClassTree::addInheritedName(Identifier name, Entry entry)
 {
   auto [it, inserted] = _table.try_emplace(name, entry);
 
@@ -1,10 +1,14 @@
 #ifndef CLASSTREE_H
 #define CLASSTREE_H
 
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 #include <unordered_map>
 
+#include "Identifier.h"
+
 #include "Absyn/AbsynFwd.h"
 #include "MetaModelica.h"
 
@@ -38,9 +42,13 @@ namespace OpenModelica
       void add(Absyn::Extends &ext);
       void add(Absyn::Import &imp);
 
+      // Both are idempotent and may be called from several threads, lookup of
+      // an element blocks while the tree is being expanded.
       void expand();
       void instantiate();
 
+      InstNode* lookupElement(const std::string &name) const;
+
       MetaModelica::Record toNF() const;
 
     public:
@@ -53,8 +61,8 @@ namespace OpenModelica
 
       struct Entry
       {
-        EntryType type;
-        size_t index;
+        EntryType type = EntryType::Class;
+        size_t index = 0;
 
         operator MetaModelica::Value() const noexcept;
         Entry offset(size_t classOffset, size_t componentOffset) const;
@@ -79,12 +87,12 @@ namespace OpenModelica
       };
 
     private:
-      using LookupTable = std::unordered_map<std::string, Entry>;
-      using DuplicateTable = std::unordered_map<std::string, Duplicate>;
+      using LookupTable = IdentifierMap<Entry>;
+      using DuplicateTable = std::unordered_map<Identifier, Duplicate, Identifier::Hash>;
 
     private:
-      void addLocalName(const std::string &name, Entry entry, const InstNode &node);
-      void addInheritedName(const std::string &name, Entry entry);
+      void addLocalName(Identifier name, Entry entry, const InstNode &node);
+      void addInheritedName(Identifier name, Entry entry);
       void countInheritedElements(size_t &classCount, size_t &componentCount) const;
       void expandExtends(const InstNode &extends, size_t classOffset, size_t componentOffset);
 
@@ -92,15 +100,16 @@ namespace OpenModelica
       InstNode *_parent;
       State _state;
       LookupTable _table;
-      // TODO: These are shared_ptr:s to mimic the MetaModelica implementation,
-      //       but for C++ it might be better to store references to the pointers
-      //       in the lookup table instead and only store the local elements here.
-      std::vector<std::shared_ptr<InstNode>> _classes;
-      std::vector<std::shared_ptr<InstNode>> _components;
+      // The nodes are owned by the arena of the instantiation that created the
+      // tree, which releases all of them at once.
+      std::vector<InstNode*> _classes;
+      std::vector<InstNode*> _components;
       std::vector<int> _localComponents;
-      std::vector<std::unique_ptr<InstNode>> _extends;
+      std::vector<InstNode*> _extends;
       std::vector<Import> _imports;
       DuplicateTable _duplicates;
+      mutable std::shared_mutex _mutex;
+      std::once_flag _instantiateFlag;
   };
 }
 
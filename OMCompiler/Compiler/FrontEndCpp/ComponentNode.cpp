@@ -20,7 +20,7 @@ ComponentNode::ComponentNode(Absyn::Component *definition, InstNode *parent)
 }
 
 ComponentNode::ComponentNode(Absyn::Component *definition, InstNode *parent, std::unique_ptr<InstNodeType> nodeType)
-  : _name{definition ? definition->name() : ""},
+  : _name{definition ? Identifier{definition->name()} : Identifier{}},
     _definition{definition},
     _visibility{definition ? definition->prefixes().visibility() : Visibility::Public},
     _component{std::make_unique<ComponentDef>(definition)},
@@ -51,7 +51,7 @@ MetaModelica::Value ComponentNode::toMetaModelica() const
 
     // Create a MetaModelica record for the node.
     auto rec = MetaModelica::Record{InstNode::COMPONENT_NODE, NFInstNode_InstNode_COMPONENT__NODE__desc, {
-      MetaModelica::Value{_name},
+      MetaModelica::Value{_name.str()},
       _definition->toSCode(),
       _visibility.toSCode(),
       comp_ptr,
@@ -12,7 +12,8 @@ namespace OpenModelica
       ComponentNode(Absyn::Component *definition, InstNode *parent, std::unique_ptr<InstNodeType> nodeType);
       ~ComponentNode();
 
-      const std::string& name() const noexcept override { return _name; }
+      Identifier id() const noexcept override { return _name; }
+      const std::string& name() const noexcept override { return _name.str(); }
       Absyn::Element* definition() const noexcept override { return _definition; }
 
       const InstNodeType* nodeType() const noexcept override;
@@ -21,7 +22,7 @@ namespace OpenModelica
       MetaModelica::Value toMetaModelica() const override;
 
     private:
-      std::string _name;
+      Identifier _name;
       Absyn::Component *_definition;
       Visibility _visibility;
       std::unique_ptr<Component> _component;
@@ -0,0 +1,97 @@
+#include <array>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+
+#include "Identifier.h"
+
+using namespace OpenModelica;
+
+namespace
+{
+  const std::string* emptyName() noexcept
+  {
+    static const std::string name;
+    return &name;
+  }
+
+  // The interned strings are split into shards by their hash, each with its
+  // own lock, so that threads instantiating different classes rarely wait for
+  // each other.
+  class Interner
+  {
+    public:
+      static Interner& instance()
+      {
+        // Never destroyed, identifiers may be used during static destruction.
+        static Interner *interner = new Interner();
+        return *interner;
+      }
+
+      const std::string* intern(std::string_view name)
+      {
+        if (name.empty()) return emptyName();
+
+        auto &shard = _shards[std::hash<std::string_view>{}(name) % SHARD_COUNT];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.index.find(name);
+        if (it != shard.index.end()) return it->second;
+
+        // The deque never moves its elements, so the views used as keys and the
+        // pointers handed out stay valid.
+        auto &str = shard.strings.emplace_back(name);
+        shard.index.emplace(str, &str);
+        return &str;
+      }
+
+      const std::string* find(std::string_view name)
+      {
+        if (name.empty()) return emptyName();
+
+        auto &shard = _shards[std::hash<std::string_view>{}(name) % SHARD_COUNT];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.index.find(name);
+        return it != shard.index.end() ? it->second : nullptr;
+      }
+
+    private:
+      static constexpr size_t SHARD_COUNT = 64;
+
+      struct Shard
+      {
+        std::mutex mutex;
+        std::deque<std::string> strings;
+        std::unordered_map<std::string_view, const std::string*> index;
+      };
+
+      std::array<Shard, SHARD_COUNT> _shards;
+  };
+}
+
+Identifier::Identifier() noexcept
+  : _name{emptyName()}
+{
+
+}
+
+Identifier::Identifier(std::string_view name)
+  : _name{Interner::instance().intern(name)}
+{
+
+}
+
+std::optional<Identifier> Identifier::find(std::string_view name)
+{
+  auto str = Interner::instance().find(name);
+  return str ? std::optional<Identifier>{Identifier{str}} : std::nullopt;
+}
+
+std::ostream& OpenModelica::operator<< (std::ostream &os, Identifier id)
+{
+  os << id.str();
+  return os;
+}
@@ -0,0 +1,176 @@
+#ifndef IDENTIFIER_H
+#define IDENTIFIER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace OpenModelica
+{
+  // An interned name. All identifiers with the same string share the same
+  // storage, so comparing and hashing them only needs the pointer. The
+  // interned strings are never released.
+  class Identifier
+  {
+    public:
+      struct Hash
+      {
+        size_t operator() (Identifier id) const noexcept { return id.hash(); }
+      };
+
+    public:
+      Identifier() noexcept;
+      explicit Identifier(std::string_view name);
+
+      // Returns the identifier for the name if it has already been interned.
+      // Used for lookup, a name that's never been interned can't be found.
+      static std::optional<Identifier> find(std::string_view name);
+
+      const std::string& str() const noexcept { return *_name; }
+      bool empty() const noexcept { return _name->empty(); }
+
+      size_t hash() const noexcept
+      {
+        // Fibonacci hashing of the address, folding the high bits into the low
+        // ones since the low bits of an address are mostly zero.
+        auto h = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(_name)) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(h ^ (h >> 32));
+      }
+
+      bool operator== (Identifier other) const noexcept { return _name == other._name; }
+      bool operator!= (Identifier other) const noexcept { return _name != other._name; }
+
+    private:
+      explicit Identifier(const std::string *name) noexcept : _name{name} {}
+
+    private:
+      const std::string *_name;
+  };
+
+  std::ostream& operator<< (std::ostream &os, Identifier id);
+
+  // A hash table keyed by identifiers using open addressing with linear
+  // probing. Elements can't be erased, which is all the lookup tables of the
+  // instantiation need. Iteration order is unspecified.
+  template<typename T>
+  class IdentifierMap
+  {
+    public:
+      using value_type = std::pair<Identifier, T>;
+
+      template<typename Slot, typename Value>
+      class Iterator
+      {
+        public:
+          using iterator_category = std::forward_iterator_tag;
+          using value_type = Value;
+          using difference_type = std::ptrdiff_t;
+          using pointer = Value*;
+          using reference = Value&;
+
+          Iterator(Slot *slot, Slot *end) noexcept : _slot{slot}, _end{end} { skipEmpty(); }
+
+          reference operator*() const noexcept { return _slot->value; }
+          pointer operator->() const noexcept { return &_slot->value; }
+
+          Iterator& operator++() noexcept { ++_slot; skipEmpty(); return *this; }
+          Iterator operator++(int) noexcept { auto it = *this; ++*this; return it; }
+
+          bool operator== (const Iterator &other) const noexcept { return _slot == other._slot; }
+          bool operator!= (const Iterator &other) const noexcept { return _slot != other._slot; }
+
+        private:
+          void skipEmpty() noexcept { while (_slot != _end && !_slot->used) ++_slot; }
+
+          Slot *_slot;
+          Slot *_end;
+      };
+
+    private:
+      struct Slot
+      {
+        bool used = false;
+        value_type value;
+      };
+
+    public:
+      using iterator = Iterator<Slot, value_type>;
+      using const_iterator = Iterator<const Slot, const value_type>;
+
+      iterator begin() noexcept { return {_slots.data(), _slots.data() + _slots.size()}; }
+      iterator end() noexcept { return {_slots.data() + _slots.size(), _slots.data() + _slots.size()}; }
+      const_iterator begin() const noexcept { return {_slots.data(), _slots.data() + _slots.size()}; }
+      const_iterator end() const noexcept { return {_slots.data() + _slots.size(), _slots.data() + _slots.size()}; }
+
+      size_t size() const noexcept { return _size; }
+      bool empty() const noexcept { return _size == 0; }
+
+      iterator find(Identifier key) noexcept
+      {
+        auto slot = findSlot(key);
+        return slot && slot->used ? iterator{slot, _slots.data() + _slots.size()} : end();
+      }
+
+      const_iterator find(Identifier key) const noexcept
+      {
+        auto slot = const_cast<IdentifierMap*>(this)->findSlot(key);
+        return slot && slot->used ? const_iterator{slot, _slots.data() + _slots.size()} : end();
+      }
+
+      std::pair<iterator, bool> try_emplace(Identifier key, T value)
+      {
+        // Keep the load factor at most 1/2 to keep the probe sequences short.
+        if ((_size + 1) * 2 > _slots.size()) {
+          rehash(_slots.empty() ? 16 : _slots.size() * 2);
+        }
+
+        auto slot = findSlot(key);
+        auto end = _slots.data() + _slots.size();
+
+        if (slot->used) {
+          return {iterator{slot, end}, false};
+        }
+
+        slot->used = true;
+        slot->value = value_type{key, std::move(value)};
+        ++_size;
+        return {iterator{slot, end}, true};
+      }
+
+    private:
+      // Returns the slot containing the key, or the empty slot where it
+      // should be inserted.
+      Slot* findSlot(Identifier key) noexcept
+      {
+        if (_slots.empty()) return nullptr;
+
+        auto mask = _slots.size() - 1;
+        for (auto i = key.hash() & mask; ; i = (i + 1) & mask) {
+          auto &slot = _slots[i];
+          if (!slot.used || slot.value.first == key) return &slot;
+        }
+      }
+
+      void rehash(size_t capacity)
+      {
+        std::vector<Slot> old(capacity);
+        old.swap(_slots);
+
+        for (auto &slot: old) {
+          if (slot.used) *findSlot(slot.value.first) = std::move(slot);
+        }
+      }
+
+    private:
+      std::vector<Slot> _slots;
+      size_t _size = 0;
+  };
+}
+
+#endif /* IDENTIFIER_H */
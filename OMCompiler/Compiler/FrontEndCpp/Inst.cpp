@@ -1,50 +1,57 @@
 #include <string>
 #include <vector>
 #include <iostream>
-#include <chrono>
 #include <utility>
 
+#include "Arena.h"
 #include "MetaModelica.h"
 #include "Absyn/Element.h"
 #include "Absyn/Class.h"
 #include "ClassNode.h"
 #include "Class.h"
 #include "Inst.h"
+#include "PhaseStats.h"
+#include "TaskPool.h"
 
 using namespace OpenModelica;
 
 void* Inst_test(void *scode);
 
-class Timer
+namespace
 {
-  using clock = std::chrono::steady_clock;
+  // Converts SCode elements to Absyn. The top-level elements are usually whole
+  // libraries which don't depend on each other, so they're converted as
+  // separate tasks.
+  std::vector<std::unique_ptr<Absyn::Element>> elementsFromSCode(MetaModelica::List elements)
+  {
+    PhaseStats::Scope scope{"SCode to Absyn"};
 
-  public:
-    Timer(std::string name)
-      : _start{clock::now()},
-        _name{std::move(name)}
-    {
-    }
+    std::vector<MetaModelica::Value> scode;
+    for (auto e: elements) scode.push_back(e);
 
-    ~Timer()
-    {
-      auto end = clock::now();
-      auto diff = std::chrono::duration<double>(end - _start);
-      auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(diff).count();
-      std::cout << _name << ": " << ms << "ms" << std::endl;
+    std::vector<std::unique_ptr<Absyn::Element>> res(scode.size());
+    auto &pool = TaskPool::instance();
+    TaskPool::Group group;
+
+    for (size_t i = 0; i < scode.size(); ++i) {
+      pool.run(group, [&res, &scode, i] { res[i] = Absyn::Element::fromSCode(scode[i]); });
     }
 
-  private:
-    clock::time_point _start;
-    std::string _name;
-};
+    pool.wait(group);
+    return res;
+  }
+}
 
 void* Inst_makeTopNode(void *program, void *annotationProgram)
 {
+  // The nodes created by the instantiation are allocated in an arena and
+  // released together once they've been converted to MetaModelica. The arena
+  // must outlive all the nodes, so it's declared first.
+  Arena arena;
+  Arena::Scope arena_scope{&arena};
+
   // Create an Absyn class for the top scope to put the elements in.
-  auto top_elements = MetaModelica::List(program).mapVector(
-    [] (auto e) { return Absyn::Element::fromSCode(e); }
-  );
+  auto top_elements = elementsFromSCode(MetaModelica::List(program));
 
   // if Flags.getConfigBool(Flags.BASE_MODELICA) then
   //   top_elements := NFBuiltinFuncs.BASE_MODELICA_POSITIVE_MAX_SIMPLE :: top_elements;
@@ -61,9 +68,7 @@ void* Inst_makeTopNode(void *program, void *annotationProgram)
   // Create a node for the builtin annotation classes. These should only be
   // accessible in annotations, so they're stored in a separate scope stored in
   // the node type for the top scope.
-  auto ann_elements = MetaModelica::List(annotationProgram).mapVector(
-    [] (auto e) { return Absyn::Element::fromSCode(e); }
-  );
+  auto ann_elements = elementsFromSCode(MetaModelica::List(annotationProgram));
   auto ann_package = Absyn::Class("<annotations>", Absyn::ElementPrefixes{}, Encapsulated{true},
                                   Partial{false}, Restriction::Package(),
                                   std::make_unique<Absyn::ClassParts>(std::move(ann_elements)));
@@ -84,7 +89,10 @@ void* Inst_makeTopNode(void *program, void *annotationProgram)
   top_node->setNodeType(std::make_unique<TopScopeType>(std::move(ann_node)));
 
   // Create a new class from the elements.
-  top_node->partialInst();
+  {
+    PhaseStats::Scope scope{"partialInst"};
+    top_node->partialInst();
+  }
 
   // TODO: The class needs to be expanded to allow lookup in it. The top scope will
   // only contain classes, so we can do this instead of the whole expandClass.
@@ -101,7 +109,47 @@ void* Inst_makeTopNode(void *program, void *annotationProgram)
   // the actual Clock node (which can't be defined in regular Modelica).
   // ClassTree.replaceClass(NFBuiltin.CLOCK_NODE, elems);
 
-  return top_node->toMetaModelica().data();
+  void *res;
+
+  {
+    PhaseStats::Scope scope{"toMetaModelica"};
+    res = top_node->toMetaModelica().data();
+  }
+
+  PhaseStats::instance().addMemory("arena", arena.reservedBytes(), arena.usedBytes());
+  return res;
+}
+
+void Inst_setNumThreads(int numThreads)
+{
+  TaskPool::instance().setThreadCount(numThreads > 1 ? static_cast<size_t>(numThreads) : 0);
+}
+
+void* Inst_phaseStatistics()
+{
+  MetaModelica::List lst;
+  auto phases = PhaseStats::instance().phases();
+
+  for (auto it = phases.rbegin(); it != phases.rend(); ++it) {
+    lst.cons(MetaModelica::Tuple{MetaModelica::Value(it->name), MetaModelica::Value(it->time)});
+  }
+
+  return lst.data();
+}
+
+void* Inst_memoryStatistics()
+{
+  MetaModelica::List lst;
+  auto memory = PhaseStats::instance().memory();
+
+  for (auto it = memory.rbegin(); it != memory.rend(); ++it) {
+    lst.cons(MetaModelica::Tuple{MetaModelica::Value(it->name),
+                                 MetaModelica::Value(static_cast<int64_t>(it->reservedBytes)),
+                                 MetaModelica::Value(static_cast<int64_t>(it->usedBytes))});
+  }
+
+  PhaseStats::instance().reset();
+  return lst.data();
 }
 
 void* Inst_test(void *scode)
@@ -110,7 +158,7 @@ void* Inst_test(void *scode)
   std::vector<std::unique_ptr<Absyn::Element>> elements;
 
   {
-    Timer t{"Creating elements"};
+    PhaseStats::Scope scope{"Creating elements"};
     for (auto e: value.toList()) {
       elements.emplace_back(Absyn::Element::fromSCode(e));
       std::cout << *elements.back() << ';' << std::endl;
@@ -120,11 +168,12 @@ void* Inst_test(void *scode)
   MetaModelica::List lst;
 
   {
-    Timer t{"Generating SCode"};
+    PhaseStats::Scope scope{"Generating SCode"};
     for (auto it = elements.rbegin(); it != elements.rend(); ++it) {
       lst.cons((*it)->toSCode());
     }
   }
 
+  std::cout << PhaseStats::instance();
   return lst.data();
 }
@@ -6,6 +6,9 @@
 #endif
 
 extern void* Inst_makeTopNode(void *program, void *annotationProgram);
+extern void Inst_setNumThreads(int numThreads);
+extern void* Inst_phaseStatistics();
+extern void* Inst_memoryStatistics();
 
 #ifdef __cplusplus
   }
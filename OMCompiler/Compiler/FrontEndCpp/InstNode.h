@@ -4,6 +4,7 @@
 #include "Absyn/AbsynFwd.h"
 #include "MetaModelica.h"
 #include "InstNodeType.h"
+#include "Identifier.h"
 
 #include <memory>
 
@@ -34,6 +35,7 @@ namespace OpenModelica
       bool isRef() const noexcept { return false; }
       bool isRedeclare() const noexcept { return false; }
 
+      virtual Identifier id() const noexcept = 0;
       virtual const std::string& name() const noexcept = 0;
       virtual Absyn::Element* definition() const noexcept = 0;
       int refIndex() const noexcept { return 0; }
@@ -47,6 +49,9 @@ namespace OpenModelica
       virtual void expand() {};
       virtual void instantiate() {};
 
+      // Looks up a local or inherited element of the node's class.
+      virtual InstNode* lookupElement(const std::string &/*name*/) { return nullptr; }
+
       virtual MetaModelica::Value toMetaModelica() const = 0;
   };
 
@@ -0,0 +1,95 @@
+#include <cstdio>
+#include <ostream>
+
+#include "PhaseStats.h"
+
+using namespace OpenModelica;
+
+PhaseStats::Scope::Scope(std::string_view name)
+  : _name{name}, _start{clock::now()}
+{
+
+}
+
+PhaseStats::Scope::~Scope()
+{
+  auto diff = std::chrono::duration<double>(clock::now() - _start);
+  PhaseStats::instance().add(_name, diff.count());
+}
+
+PhaseStats& PhaseStats::instance()
+{
+  static PhaseStats stats;
+  return stats;
+}
+
+void PhaseStats::add(std::string_view name, double seconds)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  // There are only a handful of phases, a linear search is fine.
+  for (auto &phase: _phases) {
+    if (phase.name == name) {
+      ++phase.calls;
+      phase.time += seconds;
+      return;
+    }
+  }
+
+  _phases.push_back(Phase{std::string{name}, 1, seconds});
+}
+
+void PhaseStats::addMemory(std::string_view name, size_t reservedBytes, size_t usedBytes)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  for (auto &memory: _memory) {
+    if (memory.name == name) {
+      memory.reservedBytes += reservedBytes;
+      memory.usedBytes += usedBytes;
+      return;
+    }
+  }
+
+  _memory.push_back(Memory{std::string{name}, reservedBytes, usedBytes});
+}
+
+std::vector<PhaseStats::Phase> PhaseStats::phases() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _phases;
+}
+
+std::vector<PhaseStats::Memory> PhaseStats::memory() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _memory;
+}
+
+void PhaseStats::reset()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  _phases.clear();
+  _memory.clear();
+}
+
+namespace OpenModelica
+{
+  std::ostream& operator<< (std::ostream &os, const PhaseStats &stats)
+  {
+    char time[32];
+
+    for (auto &phase: stats.phases()) {
+      std::snprintf(time, sizeof(time), "%.4g", phase.time);
+      os << "Performance of FrontEndCpp: task " << phase.name << " (" << phase.calls
+         << " calls), time " << time << '\n';
+    }
+
+    for (auto &memory: stats.memory()) {
+      os << "Performance of FrontEndCpp: memory " << memory.name << ", reserved " << memory.reservedBytes
+         << " bytes, used " << memory.usedBytes << " bytes\n";
+    }
+
+    return os;
+  }
+}
@@ -0,0 +1,74 @@
+#ifndef PHASESTATS_H
+#define PHASESTATS_H
+
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace OpenModelica
+{
+  // Accumulated wall-clock time and number of calls of the phases of the
+  // instantiation, collected from all threads. The times of phases that run
+  // concurrently add up, so they can exceed the time of the enclosing phase.
+  // The memory allocated by the arenas of the instantiation is collected too.
+  // NFInst reports them with ExecStat.execStatTasks when -d=execstat is set.
+  class PhaseStats
+  {
+    public:
+      struct Phase
+      {
+        std::string name;
+        size_t calls;
+        double time;
+      };
+
+      struct Memory
+      {
+        std::string name;
+        size_t reservedBytes;
+        size_t usedBytes;
+      };
+
+      // Adds the time from construction to destruction to the given phase.
+      class Scope
+      {
+        using clock = std::chrono::steady_clock;
+
+        public:
+          explicit Scope(std::string_view name);
+          ~Scope();
+
+          Scope(const Scope&) = delete;
+          Scope& operator= (const Scope&) = delete;
+
+        private:
+          std::string_view _name;
+          clock::time_point _start;
+      };
+
+    public:
+      static PhaseStats& instance();
+
+      void add(std::string_view name, double seconds);
+      // Adds the bytes reserved and used by an arena, see Arena::reservedBytes.
+      void addMemory(std::string_view name, size_t reservedBytes, size_t usedBytes);
+      // The phases in the order they were first used.
+      std::vector<Phase> phases() const;
+      std::vector<Memory> memory() const;
+      void reset();
+
+    private:
+      mutable std::mutex _mutex;
+      std::vector<Phase> _phases;
+      std::vector<Memory> _memory;
+  };
+
+  // Prints the phases on the same format as ExecStat.execStatTasks.
+  std::ostream& operator<< (std::ostream &os, const PhaseStats &stats);
+}
+
+#endif /* PHASESTATS_H */
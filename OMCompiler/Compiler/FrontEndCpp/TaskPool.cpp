@@ -0,0 +1,224 @@
+#include <limits>
+
+#if defined(OM_HAVE_PTHREADS)
+#include <pthread.h>
+extern "C" {
+#include "meta/meta_modelica.h"
+}
+#endif
+
+#include "TaskPool.h"
+
+using namespace OpenModelica;
+
+namespace
+{
+  constexpr size_t NO_WORKER = std::numeric_limits<size_t>::max();
+
+  // The index of the worker running on this thread, if any.
+  thread_local size_t currentWorker = NO_WORKER;
+
+  struct WorkerStart
+  {
+    TaskPool *pool;
+    size_t index;
+  };
+}
+
+TaskPool& TaskPool::instance()
+{
+  // Never destroyed, the workers must not be joined during the static
+  // destruction at exit.
+  static TaskPool *pool = new TaskPool();
+  return *pool;
+}
+
+TaskPool::~TaskPool()
+{
+  stop();
+}
+
+void TaskPool::setThreadCount(size_t count)
+{
+  if (count == threadCount() || (count <= 1 && _workers.empty())) {
+    return;
+  }
+
+  stop();
+  start(count > 1 ? count : 0);
+}
+
+void TaskPool::start(size_t count)
+{
+#if defined(OM_HAVE_PTHREADS)
+  _stop = false;
+
+  for (size_t i = 0; i < count; ++i) {
+    _workers.emplace_back(std::make_unique<Worker>());
+  }
+
+  for (size_t i = 0; i < _workers.size(); ++i) {
+    auto thread = new pthread_t;
+    auto start = new WorkerStart{this, i};
+
+#if defined(GC_THREADS) || defined(GC_WIN32_PTHREADS)
+    int err = GC_pthread_create(thread, nullptr, &TaskPool::workerMain, start);
+#else
+    int err = pthread_create(thread, nullptr, &TaskPool::workerMain, start);
+#endif
+
+    if (err) {
+      // Run with the workers that could be started, the tasks of the others
+      // are stolen by the running ones.
+      delete thread;
+      delete start;
+    } else {
+      _workers[i]->thread = thread;
+    }
+  }
+#else
+  (void)count;
+#endif
+}
+
+void TaskPool::stop()
+{
+#if defined(OM_HAVE_PTHREADS)
+  {
+    std::lock_guard<std::mutex> lock(_sleepMutex);
+    _stop = true;
+  }
+  _sleepCondition.notify_all();
+
+  for (auto &w: _workers) {
+    if (w->thread) {
+      auto thread = static_cast<pthread_t*>(w->thread);
+#if defined(GC_THREADS) || defined(GC_WIN32_PTHREADS)
+      GC_pthread_join(*thread, nullptr);
+#else
+      pthread_join(*thread, nullptr);
+#endif
+      delete thread;
+    }
+  }
+#endif
+
+  _workers.clear();
+}
+
+void* TaskPool::workerMain(void *arg)
+{
+  auto start = static_cast<WorkerStart*>(arg);
+  auto pool = start->pool;
+  auto index = start->index;
+  delete start;
+
+  currentWorker = index;
+
+  while (!pool->_stop) {
+    if (!pool->runPending(index)) {
+      std::unique_lock<std::mutex> lock(pool->_sleepMutex);
+      pool->_sleepCondition.wait(lock, [pool] { return pool->_stop || pool->_queued > 0; });
+    }
+  }
+
+  return nullptr;
+}
+
+void TaskPool::run(Group &group, Task task)
+{
+  ++group._pending;
+
+  if (_workers.empty()) {
+    Job job{&group, std::move(task)};
+    execute(job);
+    return;
+  }
+
+  auto &worker = currentWorker == NO_WORKER ? _external : *_workers[currentWorker];
+
+  {
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.jobs.push_back(Job{&group, std::move(task)});
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_sleepMutex);
+    ++_queued;
+  }
+  _sleepCondition.notify_one();
+}
+
+void TaskPool::wait(Group &group)
+{
+  while (group._pending > 0) {
+    if (!runPending(currentWorker)) {
+      // The remaining tasks of the group are running on other threads.
+      std::unique_lock<std::mutex> lock(_sleepMutex);
+      _sleepCondition.wait(lock, [this, &group] { return group._pending == 0 || _queued > 0; });
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(group._errorMutex);
+  if (group._error) {
+    auto error = group._error;
+    group._error = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+bool TaskPool::runPending(size_t self)
+{
+  Job job;
+  bool found = (self != NO_WORKER && pop(self, job, false)) || pop(NO_WORKER, job, true);
+
+  for (size_t i = 1; !found && i <= _workers.size(); ++i) {
+    auto victim = self == NO_WORKER ? i - 1 : (self + i) % _workers.size();
+    found = victim != self && pop(victim, job, true);
+  }
+
+  if (found) {
+    --_queued;
+    execute(job);
+  }
+
+  return found;
+}
+
+bool TaskPool::pop(size_t index, Job &job, bool steal)
+{
+  auto &worker = index == NO_WORKER ? _external : *_workers[index];
+  std::lock_guard<std::mutex> lock(worker.mutex);
+
+  if (worker.jobs.empty()) {
+    return false;
+  }
+
+  if (steal) {
+    job = std::move(worker.jobs.front());
+    worker.jobs.pop_front();
+  } else {
+    job = std::move(worker.jobs.back());
+    worker.jobs.pop_back();
+  }
+
+  return true;
+}
+
+void TaskPool::execute(Job &job)
+{
+  auto group = job.group;
+
+  try {
+    job.task();
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(group->_errorMutex);
+    if (!group->_error) group->_error = std::current_exception();
+  }
+
+  if (--group->_pending == 0) {
+    // Wake up the threads waiting for the group.
+    std::lock_guard<std::mutex> lock(_sleepMutex);
+    _sleepCondition.notify_all();
+  }
+}
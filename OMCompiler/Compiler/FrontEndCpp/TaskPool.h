@@ -0,0 +1,97 @@
+#ifndef TASKPOOL_H
+#define TASKPOOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+
+namespace OpenModelica
+{
+  // A work-stealing thread pool for the instantiation. Each worker has its own
+  // deque of tasks, it runs the newest of its own tasks first and steals the
+  // oldest tasks of the other workers when it runs out of work. Tasks may
+  // spawn new tasks and wait for them, a waiting thread runs other tasks in
+  // the meantime so nested parallelism doesn't deadlock the pool.
+  //
+  // The workers are created with GC_pthread_create so that tasks may allocate
+  // MetaModelica values. Without pthreads all tasks run on the calling thread.
+  class TaskPool
+  {
+    public:
+      using Task = std::function<void()>;
+
+      // A set of tasks that can be waited for. The first exception thrown by
+      // one of the tasks is rethrown by TaskPool::wait.
+      class Group
+      {
+        public:
+          Group() = default;
+          Group(const Group&) = delete;
+          Group& operator= (const Group&) = delete;
+
+        private:
+          friend class TaskPool;
+
+          std::atomic<size_t> _pending = 0;
+          std::mutex _errorMutex;
+          std::exception_ptr _error;
+      };
+
+    public:
+      static TaskPool& instance();
+
+      ~TaskPool();
+
+      // Sets the number of worker threads, 0 or 1 runs all tasks serially.
+      // Must not be called while tasks are running.
+      void setThreadCount(size_t count);
+      size_t threadCount() const noexcept { return _workers.size(); }
+
+      // Adds a task to the group.
+      void run(Group &group, Task task);
+      // Waits until all tasks of the group are done, running pending tasks
+      // while waiting.
+      void wait(Group &group);
+
+    private:
+      struct Job
+      {
+        Group *group;
+        Task task;
+      };
+
+      struct Worker
+      {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+        void *thread = nullptr;
+      };
+
+      TaskPool() = default;
+
+      void start(size_t count);
+      void stop();
+      static void* workerMain(void *arg);
+
+      bool runPending(size_t self);
+      bool pop(size_t index, Job &job, bool steal);
+      void execute(Job &job);
+
+    private:
+      std::vector<std::unique_ptr<Worker>> _workers;
+      // Tasks added by threads that are not workers of the pool.
+      Worker _external;
+      std::mutex _sleepMutex;
+      std::condition_variable _sleepCondition;
+      std::atomic<long> _queued = 0;
+      std::atomic<bool> _stop = false;
+  };
+}
+
+#endif /* TASKPOOL_H */
@@ -134,6 +134,7 @@ end translateModel;
     #include "simulation/solver/mixedSystem.h"
     #include "simulation/solver/spatialDistribution.h"
     #include "simulation/solver/synchronous.h"
+    #include "simulation/solver/taskGraph.h"
 
     #include <string.h>
 
@@ -3549,13 +3550,19 @@ template functionInitialEquations(list<SimEqSystem> initalEquations, Integer num
                   fileNamePrefix, fullPathPrefix, modelNamePrefix, "functionInitialEquations", "06inz", &eqfuncs, /* not static */ false,
                   /* do optimize */ false, /* initial */ init)
 
+  // the equation functions are still generated above, only the calls are replaced
+  let &taskGraphCalls = buffer ""
+  let taskGraph = if Flags.getConfigBool(Flags.PARALLEL_INIT) then
+                    functionXXX_taskGraph(initalEquations, "InitialEquations", &taskGraphCalls, modelNamePrefix)
+
   <<
   <%eqfuncs%>
+  <%taskGraph%>
 
   int <%symbolName(modelNamePrefix,"functionInitialEquations")%>(DATA *data, threadData_t *threadData)
   {
     data->simulationInfo->discreteCall = 1;
-    <%fncalls %>
+    <%if Flags.getConfigBool(Flags.PARALLEL_INIT) then taskGraphCalls else fncalls%>
     data->simulationInfo->discreteCall = 0;
 
     return 0;
@@ -4372,6 +4379,48 @@ template functionXXX_systems(list<list<SimEqSystem>> eqs, String name, Text &loo
     >>
 end functionXXX_systems;
 
+template functionXXX_taskGraph(list<SimEqSystem> eqs, String name, Text &loop, String modelNamePrefixStr)
+  "Generates the task graph of the equation blocks for --parallelODE and
+   --parallelInit.
+   The blocks are sorted by level, the blocks of one level are independent.
+   Linear and non-linear systems are placed after the other blocks of their
+   level and evaluated one at a time."
+::=
+  let eqFunction = symbolName(modelNamePrefixStr,"eqFunction")
+  let levels = taskGraphLevels(eqs)
+  let tasks = List.flatten(levels)
+  match tasks
+  case {} then
+    let &loop +=
+      <<
+      /* no <%name%> systems */
+      >>
+    ""
+  else
+    let nTasks = listLength(tasks)
+    let nLevels = listLength(levels)
+    let &loop +=
+      <<
+      evaluateTaskGraph(data, threadData, &function<%name%>_taskGraph);
+      >>
+    <<
+    /* forwarded equations */
+    <%tasks |> eq => equationForward_(eq, contextSimulationNonDiscrete, modelNamePrefixStr); separator="\n"%>
+
+    static void (*const function<%name%>_taskGraphTasks[<%nTasks%>])(DATA*, threadData_t*) = {
+      <%tasks |> eq => '<%eqFunction%>_<%equationIndexGeneral(eq)%>'; separator=",\n"%>
+    };
+    static const int function<%name%>_taskGraphLevelSize[<%nLevels%>] = {<%levels |> level => listLength(level); separator=", "%>};
+    static const int function<%name%>_taskGraphCost[<%nTasks%>] = {<%tasks |> eq => taskGraphCost(eq); separator=", "%>};
+    static const TASK_GRAPH function<%name%>_taskGraph = {
+      <%nTasks%>, <%nLevels%>,
+      function<%name%>_taskGraphTasks,
+      function<%name%>_taskGraphLevelSize,
+      function<%name%>_taskGraphCost
+    };
+    >>
+end functionXXX_taskGraph;
+
 
 template functionDAEModeEquationsMultiFiles(list<SimEqSystem> inEqs, Integer numEqs, Integer equationsPerFile, Context context, String fileNamePrefix, String fullPathPrefix, String modelNamePrefix, String funcName, String partName, Text &eqFuncs, Boolean static, Boolean noOpt, Boolean init)
 ::=
@@ -4502,6 +4551,8 @@ template functionODE(list<list<SimEqSystem>> derivativEquations, Text method, Op
                     (functionXXX_systems_HPCOM(derivativEquations, "ODE", &fncalls, &varDecls, hpcOmSchedules, modelNamePrefix))
                 else if Flags.getConfigBool(Flags.PARMODAUTO) then
                     (functionXXX_systems_arrayFormat(derivativEquations, "ODE", &fncalls, &nrfuncs, &varDecls, modelNamePrefix))
+                else if Flags.getConfigBool(Flags.PARALLEL_ODE) then
+                    (functionXXX_taskGraph(List.flatten(derivativEquations), "ODE", &fncalls, modelNamePrefix))
                 else
                     (functionXXX_systems(derivativEquations, "ODE", &fncalls, &varDecls, modelNamePrefix))
   /* let systems = functionXXX_systems(derivativEquations, "ODE", &fncalls, &varDecls) */
@@ -4538,7 +4589,10 @@ template functionAlgebraic(list<list<SimEqSystem>> algebraicEquations, String mo
 ::=
   let &varDecls = buffer ""
   let &fncalls = buffer ""
-  let systems = functionXXX_systems(algebraicEquations, "Alg", &fncalls, &varDecls, modelNamePrefix)
+  let systems = if Flags.getConfigBool(Flags.PARALLEL_ODE) then
+                    functionXXX_taskGraph(List.flatten(algebraicEquations), "Alg", &fncalls, modelNamePrefix)
+                else
+                    functionXXX_systems(algebraicEquations, "Alg", &fncalls, &varDecls, modelNamePrefix)
   <<
   <%systems%>
   /* for continuous time variables */
@@ -10137,6 +10137,7 @@ template generateTimeEvent(list<BackendDAE.TimeEvent> timeEvents, SimCode simCod
         {
           _timeEventData[_dimTimeEvent-_dimClock+i] = std::make_pair(_clockShift[i] * _clockInterval[i], _clockInterval[i]);
         }
+        resetTimeEventQueue();
       }
       >>
 end generateTimeEvent;
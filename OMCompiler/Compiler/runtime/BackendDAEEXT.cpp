@@ -46,306 +46,516 @@
 #include <set>
 #include <string>
 #include <vector>
+#include <algorithm>
 #include <cassert>
+#include <pthread.h>
 
+using namespace std;
+
+extern "C" {
+#include "matchmaker.h"
+}
 
-static std::set<int> e_mark;
-static std::set<int> differentiated_mark;
-static std::set<int> v_mark;
+/* Marks are kept as bitvectors together with the list of marked indices,
+ * so marking is O(1) and the marked indices are returned without scanning
+ * the whole bitvector.
+ */
+typedef struct {
+  vector<bool> *marked;
+  vector<int> *indices;
+} BackendDAEEXT_marks;
+
+/* All state of the module, one instance per thread unless the caller
+ * installs its own handle with BackendDAEEXTImpl__setHandle, so that
+ * matchings and index reductions may run concurrently.
+ */
+typedef struct {
+  BackendDAEEXT_marks e_mark;
+  BackendDAEEXT_marks v_mark;
+  BackendDAEEXT_marks differentiated_mark;
+
+  vector<int> *number;
+  vector<int> *lowlink;
+  vector<int> *v;
+  vector<int> *f;
+
+  unsigned int n; /* size of match */
+  unsigned int m; /* size of row_match */
+  int* match;
+  int* row_match;
+  int* col_ptrs;
+  int* col_ids;
+  int numThreads; /* threads of the parallel matching algorithms */
+} BackendDAEEXT_members;
+
+static pthread_once_t backendDAEExt_once_create_key = PTHREAD_ONCE_INIT;
+static pthread_key_t backendDAEExtDefaultKey;
+static pthread_key_t backendDAEExtHandleKey;
+
+extern "C" void BackendDAEEXTImpl__freeHandle(void *handle);
+
+static void make_key()
+{
+  pthread_key_create(&backendDAEExtDefaultKey,BackendDAEEXTImpl__freeHandle);
+  pthread_key_create(&backendDAEExtHandleKey,NULL);
+}
 
-static std::vector<int> number;
-static std::vector<int> lowlink;
-static std::vector<int> v;
-static std::vector<int> f;
+static void initMarkSet(BackendDAEEXT_marks *marks)
+{
+  marks->marked = new vector<bool>;
+  marks->indices = new vector<int>;
+}
 
-using namespace std;
+static void freeMarkSet(BackendDAEEXT_marks *marks)
+{
+  delete marks->marked;
+  delete marks->indices;
+}
+
+static void clearMarkSet(BackendDAEEXT_marks *marks, int size)
+{
+  /* only reset the marked entries, the bitvector keeps its capacity */
+  for (vector<int>::iterator it=marks->indices->begin(); it != marks->indices->end(); it++) {
+    (*marks->marked)[*it] = false;
+  }
+  marks->indices->clear();
+  if (size > 0 && marks->marked->size() < (size_t)size+1) {
+    marks->marked->resize(size+1, false);
+  }
+}
+
+static void setMark(BackendDAEEXT_marks *marks, int i)
+{
+  if (i < 0) return;
+  if ((size_t)i >= marks->marked->size()) {
+    marks->marked->resize(max((size_t)i+1, 2*marks->marked->size()), false);
+  }
+  if (!(*marks->marked)[i]) {
+    (*marks->marked)[i] = true;
+    marks->indices->push_back(i);
+  }
+}
+
+static int getMark(BackendDAEEXT_marks *marks, int i)
+{
+  return i >= 0 && (size_t)i < marks->marked->size() && (*marks->marked)[i];
+}
+
+static void* getMarkedList(BackendDAEEXT_marks *marks)
+{
+  /* same order as before: descending indices */
+  void *res = mmc_mk_nil();
+  sort(marks->indices->begin(), marks->indices->end());
+  for (vector<int>::iterator it=marks->indices->begin(); it != marks->indices->end(); it++) {
+    res = mmc_mk_cons(mmc_mk_icon(*it),res);
+  }
+  return res;
+}
 
 extern "C" {
-#include "matchmaker.h"
 
-static unsigned int n=0; /* size of match */
-static unsigned int m=0; /* size of row_match */
-static int* match=NULL;
-static int* row_match=NULL;
-static int* col_ptrs=NULL;
-static int* col_ids=NULL;
+/* Creates a new, independent state for the matching and sorting functions. */
+void* BackendDAEEXTImpl__newHandle()
+{
+  /* We use malloc instead of new because when we do dynamic loading of functions, C++ objects in TLS might be free'd upon return to the main process. */
+  BackendDAEEXT_members *res = (BackendDAEEXT_members*) malloc(sizeof(BackendDAEEXT_members));
+  initMarkSet(&res->e_mark);
+  initMarkSet(&res->v_mark);
+  initMarkSet(&res->differentiated_mark);
+  res->number = new vector<int>;
+  res->lowlink = new vector<int>;
+  res->v = new vector<int>;
+  res->f = new vector<int>;
+  res->n = 0;
+  res->m = 0;
+  res->match = NULL;
+  res->row_match = NULL;
+  res->col_ptrs = NULL;
+  res->col_ids = NULL;
+  res->numThreads = 1;
+  return res;
+}
+
+void BackendDAEEXTImpl__freeHandle(void *handle)
+{
+  BackendDAEEXT_members *members = (BackendDAEEXT_members*) handle;
+  if (members == NULL) return;
+  freeMarkSet(&members->e_mark);
+  freeMarkSet(&members->v_mark);
+  freeMarkSet(&members->differentiated_mark);
+  delete members->number;
+  delete members->lowlink;
+  delete members->v;
+  delete members->f;
+  free(members->match);
+  free(members->row_match);
+  free(members->col_ptrs);
+  free(members->col_ids);
+  free(members);
+}
+
+/* Installs the given handle for the calling thread, NULL restores the
+ * default state of the thread. Returns the previously installed handle.
+ */
+void* BackendDAEEXTImpl__setHandle(void *handle)
+{
+  void *old;
+  pthread_once(&backendDAEExt_once_create_key,make_key);
+  old = pthread_getspecific(backendDAEExtHandleKey);
+  pthread_setspecific(backendDAEExtHandleKey,handle);
+  return old;
+}
+
+}
+
+static BackendDAEEXT_members* getMembers()
+{
+  BackendDAEEXT_members *res;
+  pthread_once(&backendDAEExt_once_create_key,make_key);
+  res = (BackendDAEEXT_members*) pthread_getspecific(backendDAEExtHandleKey);
+  if (res != NULL) return res;
+  res = (BackendDAEEXT_members*) pthread_getspecific(backendDAEExtDefaultKey);
+  if (res != NULL) return res;
+  res = (BackendDAEEXT_members*) BackendDAEEXTImpl__newHandle();
+  pthread_setspecific(backendDAEExtDefaultKey,res);
+  return res;
+}
+
+static void resizeAndClear(vector<int> *vec, int size)
+{
+  if (size < 0) size = 0;
+  vec->assign(size, 0);
+}
+
+extern "C" {
 
 void BackendDAEEXTImpl__initMarks(int nvars, int neqns)
 {
-// Why are the inputs not even used?
-  v_mark.clear();
-  e_mark.clear();
+  BackendDAEEXT_members *members = getMembers();
+  clearMarkSet(&members->v_mark, nvars);
+  clearMarkSet(&members->e_mark, neqns);
 }
 
 void BackendDAEEXTImpl__eMark(int i)
 {
-  e_mark.insert(e_mark.begin(),i);
+  setMark(&getMembers()->e_mark, i);
 }
 
 void BackendDAEEXTImpl__vMark(int i)
 {
-  v_mark.insert(v_mark.begin(),i);
+  setMark(&getMembers()->v_mark, i);
 }
 
 int BackendDAEEXTImpl__getVMark(int i)
 {
-  return v_mark.find(i) != v_mark.end();
+  return getMark(&getMembers()->v_mark, i);
 }
 
 int BackendDAEEXTImpl__getEMark(int i)
 {
-  //cout << "get_e_mark[" << i << "] == " << e_mark[i-1] << endl;
-  return e_mark.find(i) != e_mark.end();
+  return getMark(&getMembers()->e_mark, i);
 }
 
 void* BackendDAEEXTImpl__getMarkedEqns()
 {
-  std::set<int>::iterator it;
-  void *res = mmc_mk_nil();
-  for (it=e_mark.begin(); it != e_mark.end(); it++) {
-    res = mmc_mk_cons(mmc_mk_icon(*it),res);
-  }
-  return res;
+  return getMarkedList(&getMembers()->e_mark);
 }
 
 void BackendDAEEXTImpl__markDifferentiated(int i)
 {
-  differentiated_mark.insert(differentiated_mark.begin(),i);
+  setMark(&getMembers()->differentiated_mark, i);
 }
 
 void BackendDAEEXTImpl__clearDifferentiated()
 {
-  differentiated_mark.clear();
+  clearMarkSet(&getMembers()->differentiated_mark, 0);
 }
 
 void* BackendDAEEXTImpl__getDifferentiatedEqns()
 {
-  std::set<int>::iterator it;
-  void *res = mmc_mk_nil();
-  for (it=differentiated_mark.begin(); it != differentiated_mark.end(); it++) {
-    res = mmc_mk_cons(mmc_mk_icon(*it),res);
-  }
-  return res;
+  return getMarkedList(&getMembers()->differentiated_mark);
 }
 
 void* BackendDAEEXTImpl__getMarkedVariables()
 {
-  std::set<int>::iterator it;
-  void *res = mmc_mk_nil();
-  for (it=v_mark.begin(); it != v_mark.end(); it++) {
-    res = mmc_mk_cons(mmc_mk_icon(*it),res);
-  }
-  return res;
+  return getMarkedList(&getMembers()->v_mark);
 }
 
 void BackendDAEEXTImpl__initLowLink(int nvars)
 {
-  //cout << "init lowlink n= " << nvars << endl;
-  lowlink.reserve(nvars);
-
-  while (lowlink.size() < (unsigned int)nvars)
-    lowlink.push_back(0);
-  for (int i =0; i < nvars; i++)
-    lowlink[i]=0;
+  resizeAndClear(getMembers()->lowlink, nvars);
 }
 
 void BackendDAEEXTImpl__initNumber(int nvars)
 {
-  //cout << "init number n= " << nvars << endl;
-  number.reserve(nvars);
-
-  while (number.size() < (unsigned int)nvars)
-    number.push_back(0);
-  for (int i =0; i < nvars; i++)
-    number[i]=0;
+  resizeAndClear(getMembers()->number, nvars);
 }
 
 void BackendDAEEXTImpl__setLowLink(int i, int val)
 {
-  lowlink[i-1]=val;
+  (*getMembers()->lowlink)[i-1]=val;
 }
 
 void BackendDAEEXTImpl__setNumber(int i, int val)
 {
-  number[i-1]=val;
+  (*getMembers()->number)[i-1]=val;
 }
 
 int BackendDAEEXTImpl__getNumber(int i)
 {
-  return number[i-1];
+  return (*getMembers()->number)[i-1];
 }
 
 int BackendDAEEXTImpl__getLowLink(int i)
 {
-  return lowlink[i-1];
+  return (*getMembers()->lowlink)[i-1];
 }
 
 void BackendDAEEXTImpl__dumpMarkedEquations(int nvars)
 {
+  vector<int> eqns(*getMembers()->e_mark.indices);
+  sort(eqns.begin(), eqns.end());
   cout << "marked equations" << endl << "================" << endl;
-  for (std::set<int>::iterator i =e_mark.begin() ; i != e_mark.end(); i++)
+  for (vector<int>::iterator i = eqns.begin(); i != eqns.end(); i++)
     cout << "eqn " << *i << endl;
 }
 
 void BackendDAEEXTImpl__dumpMarkedVariables(int nvars)
 {
+  vector<int> vars(*getMembers()->v_mark.indices);
+  sort(vars.begin(), vars.end());
   cout << "marked variables" << endl << "================" << endl;
-  for (std::set<int>::iterator i =v_mark.begin() ; i != v_mark.end(); i++)
+  for (vector<int>::iterator i = vars.begin(); i != vars.end(); i++)
     cout << "var " << *i << endl;
 }
 
 void BackendDAEEXTImpl__initV(int size)
 {
-  v.reserve(size);
+  getMembers()->v->reserve(size);
 }
 
 void BackendDAEEXTImpl__initF(int size)
 {
-  f.reserve(size);
+  getMembers()->f->reserve(size);
 }
 
 void BackendDAEEXTImpl__setF(int i, int val)
 {
-  if (i > f.size()) { f.resize(i); }
-  f[i-1]=val;
+  vector<int> *f = getMembers()->f;
+  if (i > f->size()) { f->resize(i); }
+  (*f)[i-1]=val;
 }
 
 int BackendDAEEXTImpl__getF(int i)
 {
-  assert(i <= f.size());
-  return f[i-1];
+  vector<int> *f = getMembers()->f;
+  assert(i <= f->size());
+  return (*f)[i-1];
 }
 
 void BackendDAEEXTImpl__setV(int i, int val)
 {
-  if ( i > v.size() ) { v.resize(i); }
-  v[i-1]=val;
+  vector<int> *v = getMembers()->v;
+  if ( i > v->size() ) { v->resize(i); }
+  (*v)[i-1]=val;
 }
 
 int BackendDAEEXTImpl__getV(int i)
 {
-  assert(i <= v.size());
-  return v[i-1];
+  vector<int> *v = getMembers()->v;
+  assert(i <= v->size());
+  return (*v)[i-1];
 }
 
-void BackendDAEExtImpl__cheapmatching(int nvars, int neqns, int cheapID, int clear_match)
+}
+
+/* Resizes match and row_match to the size of the system. Keeps the previous
+ * matching if clear_match == 0, otherwise all nodes are unmatched.
+ */
+static void prepareMatching(BackendDAEEXT_members *members, int nvars, int neqns, int clear_match)
 {
   int i=0;
   if (clear_match==0){
-    if (neqns>n) {
-      if(match)
-      {
-        int* tmp = (int*) malloc(neqns * sizeof(int));
-        memcpy(tmp,match,n*sizeof(int));
-        free(match);
-        match = tmp;
-        for (i = n; i < neqns; i++) {
-          match[i] = -1;
-        }
-      } else {
-         match = (int*) malloc(neqns * sizeof(int));
-         memset(match,-1,neqns * sizeof(int));
+    if (neqns>members->n) {
+      members->match = (int*) realloc(members->match, neqns * sizeof(int));
+      for (i = members->n; i < neqns; i++) {
+        members->match[i] = -1;
       }
-      n = neqns;
+      members->n = neqns;
     }
-    if (nvars>m) {
-      if(row_match)
-      {
-        int* tmp = (int*) malloc(nvars * sizeof(int));
-        memcpy(tmp,row_match,m*sizeof(int));
-        free(row_match);
-        row_match = tmp;
-        for (i = m; i < nvars; i++) {
-          row_match[i] = -1;
-        }
-      } else {
-        row_match = (int*) malloc(nvars * sizeof(int));
-         memset(row_match,-1,nvars * sizeof(int));
+    if (nvars>members->m) {
+      members->row_match = (int*) realloc(members->row_match, nvars * sizeof(int));
+      for (i = members->m; i < nvars; i++) {
+        members->row_match[i] = -1;
       }
-      m = nvars;
+      members->m = nvars;
     }
   }
   else {
-  if (neqns>n) {
-      if (match) free(match);
-      match = (int*) malloc(neqns * sizeof(int));
-      memset(match,-1,neqns * sizeof(int));
-  } else {
-      memset(match,-1,n * sizeof(int));
-  }
-    n = neqns;
-    if (nvars>m) {
-      if (row_match) free(row_match);
-      row_match = (int*) malloc(nvars * sizeof(int));
-      memset(row_match,-1,nvars * sizeof(int));
-    } else {
-      memset(row_match,-1,m * sizeof(int));
+    if (neqns>members->n) {
+      if (members->match) free(members->match);
+      members->match = (int*) malloc(neqns * sizeof(int));
+      memset(members->match,-1,neqns * sizeof(int));
+    } else if (members->match) {
+      memset(members->match,-1,members->n * sizeof(int));
     }
-    m = nvars;
-  }
-  if ((match != NULL) && (row_match != NULL)) {
-    cheapmatching(col_ptrs,col_ids,match,row_match,neqns,nvars,cheapID,0 /*clear_match already done*/);
+    members->n = neqns;
+    if (nvars>members->m) {
+      if (members->row_match) free(members->row_match);
+      members->row_match = (int*) malloc(nvars * sizeof(int));
+      memset(members->row_match,-1,nvars * sizeof(int));
+    } else if (members->row_match) {
+      memset(members->row_match,-1,members->m * sizeof(int));
+    }
+    members->m = nvars;
   }
 }
 
-void BackendDAEExtImpl__matching(int nvars, int neqns, int matchingID, int cheapID, double relabel_period, int clear_match)
+/* Strongly connected components of the graph given by the adjacency matrix
+ * of setAdjacencyMatrix (rows 0..n-1, columns 0..m-1) and row_match.
+ * Iterative version of Tarjan's algorithm using the flat number/lowlink
+ * arrays of the handle. The components are the same as of
+ *   - Sorting.Tarjan(m, ass1) if transposed == 0, the nodes are the rows,
+ *   - Sorting.TarjanTransposed(mT, ass2) if transposed != 0, the nodes are
+ *     the columns, i.e. the transposed adjacency matrix was set.
+ */
+static void* tarjan(BackendDAEEXT_members *members, int transposed)
 {
-  int i=0;
-  if (clear_match==0){
-    if (neqns>n) {
-      if(match)
-      {
-        int* tmp = (int*) malloc(neqns * sizeof(int));
-        memcpy(tmp,match,n*sizeof(int));
-        free(match);
-        match = tmp;
-        for (i = n; i < neqns; i++) {
-          match[i] = -1;
+  const int nNodes = transposed ? members->m : members->n;
+  const int *col_ptrs = members->col_ptrs, *col_ids = members->col_ids;
+  const int *row_match = members->row_match;
+  vector<int> &number = *members->number;
+  vector<int> &lowlink = *members->lowlink;
+  vector<int> stack, callStack, edge;
+  vector<bool> onStack(nNodes, false);
+  vector<void*> comps;
+  void *res = mmc_mk_nil(), *comp;
+  int index = 0, node, next, row, k;
+
+  if (col_ptrs == NULL || row_match == NULL) {
+    return res;
+  }
+  number.assign(nNodes, -1);
+  lowlink.assign(nNodes, -1);
+
+  for (int c = 0; c < (int)members->m; c++) {
+    next = transposed ? c : row_match[c];
+    if (next < 0 || (transposed && row_match[next] < 0) || number[next] != -1) {
+      continue;
+    }
+
+    do {
+      if (next >= 0) {
+        /* visit next, set the depth index to the smallest unused index */
+        number[next] = lowlink[next] = index++;
+        stack.push_back(next);
+        onStack[next] = true;
+        callStack.push_back(next);
+        row = transposed ? row_match[next] : next;
+        edge.push_back(row >= 0 ? col_ptrs[row] : 0);
+      }
+      next = -1;
+
+      /* consider the next successor of node */
+      node = callStack.back();
+      row = transposed ? row_match[node] : node;
+      k = edge.back();
+      if (row >= 0 && k < col_ptrs[row+1]) {
+        edge.back() = k+1;
+        next = transposed ? col_ids[k] : row_match[col_ids[k]];
+        if (next < 0 || next == node || next >= nNodes) {
+          next = -1;
+        } else if (number[next] != -1) {
+          if (onStack[next]) {
+            lowlink[node] = min(lowlink[node], number[next]);
+          }
+          next = -1;
         }
-      } else {
-         match = (int*) malloc(neqns * sizeof(int));
-         memset(match,-1,neqns * sizeof(int));
+        continue;
       }
-      n = neqns;
-    }
-    if (nvars>m) {
-      if(row_match)
-      {
-        int* tmp = (int*) malloc(nvars * sizeof(int));
-        memcpy(tmp,row_match,m*sizeof(int));
-        free(row_match);
-        row_match = tmp;
-        for (i = m; i < nvars; i++) {
-          row_match[i] = -1;
+
+      /* all successors are visited, if node is a root node pop the stack and generate an SCC */
+      if (lowlink[node] == number[node]) {
+        comp = mmc_mk_nil();
+        for (k = stack.size()-1; stack[k] != node; k--);
+        for (int j = k; j < (int)stack.size(); j++) {
+          onStack[stack[j]] = false;
+          comp = mmc_mk_cons(mmc_mk_icon(stack[j]+1), comp);
         }
-      } else {
-        row_match = (int*) malloc(nvars * sizeof(int));
-         memset(row_match,-1,nvars * sizeof(int));
+        stack.resize(k);
+        comps.push_back(comp);
       }
-      m = nvars;
-    }
+      callStack.pop_back();
+      edge.pop_back();
+      if (!callStack.empty()) {
+        lowlink[callStack.back()] = min(lowlink[callStack.back()], lowlink[node]);
+      }
+    } while (!callStack.empty());
   }
-  else {
-    if (neqns>n) {
-      if (match) free(match);
-      match = (int*) malloc(neqns * sizeof(int));
-      memset(match,-1,neqns * sizeof(int));
-    } else {
-      memset(match,-1,n * sizeof(int));
+
+  /* Sorting.Tarjan returns the components in the order they are found,
+   * Sorting.TarjanTransposed in reverse order */
+  if (transposed) {
+    for (vector<void*>::iterator it = comps.begin(); it != comps.end(); it++) {
+      res = mmc_mk_cons(*it, res);
     }
-    n = neqns;
-    if (nvars>m) {
-      if (row_match) free(row_match);
-      row_match = (int*) malloc(nvars * sizeof(int));
-      memset(row_match,-1,nvars * sizeof(int));
-    } else {
-      memset(row_match,-1,m * sizeof(int));
+  } else {
+    for (vector<void*>::reverse_iterator it = comps.rbegin(); it != comps.rend(); it++) {
+      res = mmc_mk_cons(*it, res);
     }
-    m = nvars;
   }
-  if ((match != NULL) && (row_match != NULL)) {
-    matching(col_ptrs,col_ids,match,row_match,neqns,nvars,matchingID,cheapID,relabel_period,0 /*clear_match already done*/);
+  return res;
+}
+
+extern "C" {
+
+void BackendDAEExtImpl__cheapmatching(int nvars, int neqns, int cheapID, int clear_match)
+{
+  BackendDAEEXT_members *members = getMembers();
+  prepareMatching(members, nvars, neqns, clear_match);
+  if ((members->match != NULL) && (members->row_match != NULL)) {
+    cheapmatching(members->col_ptrs,members->col_ids,members->match,members->row_match,neqns,nvars,cheapID,0 /*clear_match already done*/,members->numThreads);
+  }
+}
+
+void BackendDAEExtImpl__matching(int nvars, int neqns, int matchingID, int cheapID, double relabel_period, int clear_match)
+{
+  BackendDAEEXT_members *members = getMembers();
+  prepareMatching(members, nvars, neqns, clear_match);
+  if ((members->match != NULL) && (members->row_match != NULL)) {
+    matching(members->col_ptrs,members->col_ids,members->match,members->row_match,neqns,nvars,matchingID,cheapID,relabel_period,0 /*clear_match already done*/,members->numThreads);
+  }
+}
+
+int BackendDAEExtImpl__writeAdjacencyMatrix(const char *fileName, int nvars, int neqns)
+{
+  BackendDAEEXT_members *members = getMembers();
+  if (members->col_ptrs == NULL) {
+    return 0;
+  }
+  ofstream file(fileName);
+  if (!file) {
+    return 0;
   }
+  file << "%%MatrixMarket matrix coordinate pattern general\n";
+  file << "% rows are equations, columns are variables\n";
+  file << neqns << " " << nvars << " " << members->col_ptrs[neqns] << "\n";
+  for (int i = 0; i < neqns; i++) {
+    for (int k = members->col_ptrs[i]; k < members->col_ptrs[i+1]; k++) {
+      file << i+1 << " " << members->col_ids[k]+1 << "\n";
+    }
+  }
+  return file.good();
+}
+
+void BackendDAEExtImpl__setNumThreads(int numThreads)
+{
+  getMembers()->numThreads = numThreads > 0 ? numThreads : 1;
+}
+
+void* BackendDAEExtImpl__tarjan(int transposed)
+{
+  return tarjan(getMembers(), transposed);
 }
 
 }
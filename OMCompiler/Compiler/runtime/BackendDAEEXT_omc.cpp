@@ -114,12 +114,12 @@ extern void BackendDAEEXT_setAdjacencyMatrix(modelica_integer nvars, modelica_in
   mmc_sint_t i1;
   int j=0;
   modelica_integer nelts = MMC_HDRSLOTS(MMC_GETHDR(adjacencymatrix));
+  BackendDAEEXT_members *members = getMembers();
+  int *col_ptrs, *col_ids;
 
-  if (col_ptrs) free(col_ptrs);
-  col_ptrs = (int*) malloc((neqns+1) * sizeof(int));
+  col_ptrs = members->col_ptrs = (int*) realloc(members->col_ptrs, (neqns+1) * sizeof(int));
   col_ptrs[neqns]=nz;
-  if (col_ids) free(col_ids);
-  col_ids = (int*) malloc(nz * sizeof(int));
+  col_ids = members->col_ids = (int*) realloc(members->col_ids, (nz > 0 ? nz : 1) * sizeof(int));
 
   for(i=0; i<neqns; ++i) {
     modelica_metatype ie = MMC_STRUCTDATA(adjacencymatrix)[i];
@@ -140,6 +140,21 @@ extern void BackendDAEEXT_matching(modelica_integer nv, modelica_integer ne, mod
   BackendDAEExtImpl__matching(nv, ne, matchingID, cheapID, relabel_period, clear_match);
 }
 
+extern void BackendDAEEXT_setNumThreads(modelica_integer numThreads)
+{
+  BackendDAEExtImpl__setNumThreads(numThreads);
+}
+
+extern int BackendDAEEXT_writeAdjacencyMatrix(const char *fileName, modelica_integer nvars, modelica_integer neqns)
+{
+  return BackendDAEExtImpl__writeAdjacencyMatrix(fileName, nvars, neqns);
+}
+
+extern modelica_metatype BackendDAEEXT_tarjan(modelica_integer transposed)
+{
+  return BackendDAEExtImpl__tarjan(transposed);
+}
+
 static void failBecauseLength(const char *function, const char *var1str, long len1, const char *var2str, long len2)
 {
   char len1str[64],len2str[64];
@@ -154,6 +169,9 @@ extern void BackendDAEEXT_getAssignment(modelica_metatype ass1, modelica_metatyp
   int i=0;
   mmc_uint_t len1 = MMC_HDRSLOTS(MMC_GETHDR(ass1));
   mmc_uint_t len2 = MMC_HDRSLOTS(MMC_GETHDR(ass2));
+  BackendDAEEXT_members *members = getMembers();
+  unsigned int n = members->n, m = members->m;
+  int *match = members->match, *row_match = members->row_match;
   if (n > len1) {
     failBecauseLength("BackendDAEEXT.getAssignment", "n", n, "arrayLength(ass1)", len1);
     MMC_THROW();
@@ -184,37 +202,38 @@ extern int BackendDAEEXT_setAssignment(int lenass1, int lenass2, modelica_metaty
 {
   int nelts=0;
   int i=0;
+  BackendDAEEXT_members *members = getMembers();
 
   nelts = MMC_HDRSLOTS(MMC_GETHDR(ass1));
   if (nelts > 0) {
-    n = lenass1;
-    if (n > nelts) {
-      failBecauseLength("BackendDAEEXT.setAssignment", "n", n, "arrayLength(ass1)", nelts);
+    members->n = lenass1;
+    if (members->n > nelts) {
+      failBecauseLength("BackendDAEEXT.setAssignment", "n", members->n, "arrayLength(ass1)", nelts);
       return 0;
     }
-    if(match) {
-      free(match);
+    if(members->match) {
+      free(members->match);
     }
-    match = (int*) malloc(n * sizeof(int));
-    for(i=0; i<n; ++i) {
-      match[i] = MMC_UNTAGFIXNUM(MMC_STRUCTDATA(ass1)[i])-1;
-      if (match[i]<0) match[i] = -1;
+    members->match = (int*) malloc(members->n * sizeof(int));
+    for(i=0; i<members->n; ++i) {
+      members->match[i] = MMC_UNTAGFIXNUM(MMC_STRUCTDATA(ass1)[i])-1;
+      if (members->match[i]<0) members->match[i] = -1;
     }
   }
   nelts = MMC_HDRSLOTS(MMC_GETHDR(ass2));
   if (nelts > 0) {
-    m = lenass2;
-    if (m > nelts) {
-      failBecauseLength("BackendDAEEXT.setAssignment", "m", m, "arrayLength(ass2)", nelts);
+    members->m = lenass2;
+    if (members->m > nelts) {
+      failBecauseLength("BackendDAEEXT.setAssignment", "m", members->m, "arrayLength(ass2)", nelts);
       return 0;
     }
-    if(row_match) {
-      free(row_match);
+    if(members->row_match) {
+      free(members->row_match);
     }
-    row_match = (int*) malloc(m * sizeof(int));
-    for(i=0; i<m; ++i) {
-      row_match[i] = MMC_UNTAGFIXNUM(MMC_STRUCTDATA(ass2)[i])-1;
-      if (row_match[i]<0) row_match[i] = -1;
+    members->row_match = (int*) malloc(members->m * sizeof(int));
+    for(i=0; i<members->m; ++i) {
+      members->row_match[i] = MMC_UNTAGFIXNUM(MMC_STRUCTDATA(ass2)[i])-1;
+      if (members->row_match[i]<0) members->row_match[i] = -1;
     }
   }
   return 1;
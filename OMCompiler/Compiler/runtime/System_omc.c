@@ -43,6 +43,7 @@ extern "C"
 
 #include <ctype.h> /* for toupper */
 #include <limits.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include "util/omc_msvc.h"
 #include "util/omc_file.h"
@@ -545,6 +546,15 @@ extern int System_getuid()
 #endif
 }
 
+extern int System_getpid()
+{
+#if defined(__MINGW32__) || defined(_MSC_VER)
+  return _getpid();
+#else
+  return getpid();
+#endif
+}
+
 extern const char* System_readEnv(const char *envname)
 {
   char *envvalue = getenv(envname);
@@ -572,6 +582,77 @@ extern const char* System_getUUIDStr()
   return strcpy(ModelicaAllocateString(strlen(res)),res);
 }
 
+#define SHA256_ROTR(x,n) (((x) >> (n)) | ((x) << (32-(n))))
+
+static void sha256_block(uint32_t h[8], const unsigned char *block)
+{
+  static const uint32_t k[64] = {
+    0x428a2f98,0x71374491,0xb5c0fbcf,0xe9b5dba5,0x3956c25b,0x59f111f1,0x923f82a4,0xab1c5ed5,
+    0xd807aa98,0x12835b01,0x243185be,0x550c7dc3,0x72be5d74,0x80deb1fe,0x9bdc06a7,0xc19bf174,
+    0xe49b69c1,0xefbe4786,0x0fc19dc6,0x240ca1cc,0x2de92c6f,0x4a7484aa,0x5cb0a9dc,0x76f988da,
+    0x983e5152,0xa831c66d,0xb00327c8,0xbf597fc7,0xc6e00bf3,0xd5a79147,0x06ca6351,0x14292967,
+    0x27b70a85,0x2e1b2138,0x4d2c6dfc,0x53380d13,0x650a7354,0x766a0abb,0x81c2c92e,0x92722c85,
+    0xa2bfe8a1,0xa81a664b,0xc24b8b70,0xc76c51a3,0xd192e819,0xd6990624,0xf40e3585,0x106aa070,
+    0x19a4c116,0x1e376c08,0x2748774c,0x34b0bcb5,0x391c0cb3,0x4ed8aa4a,0x5b9cca4f,0x682e6ff3,
+    0x748f82ee,0x78a5636f,0x84c87814,0x8cc70208,0x90befffa,0xa4506ceb,0xbef9a3f7,0xc67178f2
+  };
+  uint32_t w[64], a, b, c, d, e, f, g, hh, t1, t2;
+  int i;
+
+  for (i = 0; i < 16; ++i) {
+    w[i] = ((uint32_t) block[4*i] << 24) | ((uint32_t) block[4*i+1] << 16) |
+           ((uint32_t) block[4*i+2] << 8) | (uint32_t) block[4*i+3];
+  }
+  for (i = 16; i < 64; ++i) {
+    uint32_t s0 = SHA256_ROTR(w[i-15], 7) ^ SHA256_ROTR(w[i-15], 18) ^ (w[i-15] >> 3);
+    uint32_t s1 = SHA256_ROTR(w[i-2], 17) ^ SHA256_ROTR(w[i-2], 19) ^ (w[i-2] >> 10);
+    w[i] = w[i-16] + s0 + w[i-7] + s1;
+  }
+
+  a = h[0]; b = h[1]; c = h[2]; d = h[3]; e = h[4]; f = h[5]; g = h[6]; hh = h[7];
+  for (i = 0; i < 64; ++i) {
+    t1 = hh + (SHA256_ROTR(e, 6) ^ SHA256_ROTR(e, 11) ^ SHA256_ROTR(e, 25)) + ((e & f) ^ (~e & g)) + k[i] + w[i];
+    t2 = (SHA256_ROTR(a, 2) ^ SHA256_ROTR(a, 13) ^ SHA256_ROTR(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+    hh = g; g = f; f = e; e = d + t1; d = c; c = b; b = a; a = t1 + t2;
+  }
+  h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+}
+
+/* Returns the SHA-256 digest of the string as 64 lowercase hex digits. */
+extern const char* System_sha256(const char* str)
+{
+  uint32_t h[8] = {0x6a09e667,0xbb67ae85,0x3c6ef372,0xa54ff53a,0x510e527f,0x9b05688c,0x1f83d9ab,0x5be0cd19};
+  const unsigned char *data = (const unsigned char*) str;
+  size_t len = strlen(str), rest, i;
+  uint64_t bits = (uint64_t) len * 8;
+  unsigned char block[128];
+  char *res;
+
+  for (i = 0; i + 64 <= len; i += 64) {
+    sha256_block(h, data + i);
+  }
+
+  /* Pad the remaining bytes with 0x80, zeros and the length in bits. */
+  rest = len - i;
+  memset(block, 0, sizeof(block));
+  memcpy(block, data + i, rest);
+  block[rest] = 0x80;
+  rest = rest < 56 ? 64 : 128;
+  for (i = 0; i < 8; ++i) {
+    block[rest - 1 - i] = (unsigned char) (bits >> (8 * i));
+  }
+  sha256_block(h, block);
+  if (rest == 128) {
+    sha256_block(h, block + 64);
+  }
+
+  res = ModelicaAllocateString(64);
+  for (i = 0; i < 8; ++i) {
+    sprintf(res + 8*i, "%08x", (unsigned int) h[i]);
+  }
+  return res;
+}
+
 extern int System_loadLibrary(const char *name, int relativePath, int printDebug)
 {
   int res = SystemImpl__loadLibrary(name, relativePath, printDebug);
@@ -909,6 +990,7 @@ typedef struct thread_data {
   int len;
   void **commands;
   void **status;
+  double *times;
   threadData_t *parent;
 } thread_data;
 
@@ -917,18 +999,21 @@ static void* System_launchParallelTasksThread(void *in)
   int exitstatus = 1;
   int n;
   thread_data *data = (thread_data*) in;
+  rtclock_t tick_tp;
   while (1) {
     int fail = 1;
     pthread_mutex_lock(&data->mutex);
     n = data->current++;
     pthread_mutex_unlock(&data->mutex);
     if (data->fail || n >= data->len) break;
+    rt_ext_tp_tick(&tick_tp);
     MMC_TRY_TOP()
     threadData->parent = data->parent;
     threadData->mmc_thread_work_exit = threadData->mmc_jumper;
     data->status[n] = data->fn(threadData,data->commands[n]);
     fail = 0;
     MMC_CATCH_TOP()
+    data->times[n] = rt_ext_tp_tock(&tick_tp);
     if (fail) {
       data->fail = 1;
     }
@@ -936,17 +1021,27 @@ static void* System_launchParallelTasksThread(void *in)
   return NULL;
 }
 
-static void* System_launchParallelTasksSerial(threadData_t *threadData, void *dataLst, modelica_metatype (*fn)(threadData_t *,modelica_metatype))
+static void* System_launchParallelTasksSerial(threadData_t *threadData, void *dataLst, modelica_metatype (*fn)(threadData_t *,modelica_metatype), double *times)
 {
   void *result = mmc_mk_nil();
+  rtclock_t tick_tp;
+  int i = 0;
   while (!listEmpty(dataLst)) {
+    rt_ext_tp_tick(&tick_tp);
     result = mmc_mk_cons(fn(threadData, MMC_CAR(dataLst)),result);
+    times[i++] = rt_ext_tp_tock(&tick_tp);
     dataLst = MMC_CDR(dataLst);
   }
-  return listReverse(dataLst);
+  return listReverse(result);
 }
 
-extern void* System_launchParallelTasks(threadData_t *threadData, int numThreads, void *dataLst, modelica_metatype (*fn)(threadData_t *,modelica_metatype))
+/* Runs fn on every element of dataLst using a pool of numThreads workers.
+ * The workers take the next pending task from a shared counter, so tasks are
+ * started in list order but finish whenever they are done; put the most
+ * expensive tasks first to get a good load balance.
+ * The wall-clock time each task took is stored in times (length of dataLst).
+ */
+static void* System_launchParallelTasksImpl(threadData_t *threadData, int numThreads, void *dataLst, modelica_metatype (*fn)(threadData_t *,modelica_metatype), double *times)
 {
   int i;
   size_t len = listLength(dataLst);
@@ -997,7 +1092,7 @@ extern void* System_launchParallelTasks(threadData_t *threadData, int numThreads
   if (len == 0) {
     return mmc_mk_nil();
   } else if (numThreads == 1 || len == 1) {
-    return System_launchParallelTasksSerial(threadData,dataLst,fn);
+    return System_launchParallelTasksSerial(threadData,dataLst,fn,times);
   }
 
   /* Make sure we get nothing unexpected here */
@@ -1011,11 +1106,13 @@ extern void* System_launchParallelTasks(threadData_t *threadData, int numThreads
   data.len = len;
   data.commands = commands;
   data.status = status;
+  data.times = times;
   data.fail = 0;
   data.parent = threadData;
   for (i=0; i<len; i++, dataLst = MMC_CDR(dataLst)) {
     commands[i] = MMC_CAR(dataLst);
     status[i] = 0; /* just in case */
+    times[i] = 0.0;
   }
   numThreads = numThreads > len ? len : numThreads;
   unsigned int live_threads = 0;
@@ -1079,6 +1176,26 @@ extern void* System_launchParallelTasks(threadData_t *threadData, int numThreads
   return result;
 }
 
+extern void* System_launchParallelTasks(threadData_t *threadData, int numThreads, void *dataLst, modelica_metatype (*fn)(threadData_t *,modelica_metatype))
+{
+  double *times = (double*) omc_alloc_interface.malloc_atomic(sizeof(double)*(listLength(dataLst)+1));
+  return System_launchParallelTasksImpl(threadData, numThreads, dataLst, fn, times);
+}
+
+extern void* System_launchParallelTasksTimed(threadData_t *threadData, int numThreads, void *dataLst, modelica_metatype (*fn)(threadData_t *,modelica_metatype), void **outTimes)
+{
+  int i;
+  size_t len = listLength(dataLst);
+  double *times = (double*) omc_alloc_interface.malloc_atomic(sizeof(double)*(len+1));
+  void *result = System_launchParallelTasksImpl(threadData, numThreads, dataLst, fn, times);
+  void *timeLst = mmc_mk_nil();
+  for (i=len-1; i>=0; i--) {
+    timeLst = mmc_mk_cons(mmc_mk_rcon(times[i]), timeLst);
+  }
+  *outTimes = timeLst;
+  return result;
+}
+
 void System_initGarbageCollector(void)
 {
   SystemImpl__initGarbageCollector();
@@ -23,6 +23,7 @@
 #include <stdlib.h>
 #include <ctype.h>
 #include <math.h>
+#include <pthread.h>
 
 #include "matchmaker.h"
 
@@ -1245,7 +1246,224 @@ void match_pr_fifo_fair(int* col_ptrs, int* col_ids, int* row_ptrs, int* row_ids
   free(r_label);
 }
 
-void matching(int* col_ptrs, int* col_ids, int* match, int* row_match, int n, int m, int matching_id, int cheap_id, double relabel_period, int clear_match) {
+/* Runs worker on num_threads threads, thread i gets the i-th element of the
+ * array args with elements of size args_size. The calling thread runs the
+ * first one. If a thread cannot be created its work is done afterwards by
+ * the calling thread.
+ */
+void par_run(void* (*worker)(void*), void* args, size_t args_size, int num_threads) {
+  pthread_t* threads;
+  int* started;
+  int i;
+
+  if(num_threads <= 1) {
+    worker(args);
+    return;
+  }
+
+  threads = (pthread_t*)malloc(sizeof(pthread_t) * num_threads);
+  started = (int*)malloc(sizeof(int) * num_threads);
+  for(i = 1; i < num_threads; i++) {
+    started[i] = 0 == pthread_create(&threads[i], NULL, worker, (char*)args + i * args_size);
+  }
+  worker(args);
+  for(i = 1; i < num_threads; i++) {
+    if(started[i]) {
+      pthread_join(threads[i], NULL);
+    } else {
+      worker((char*)args + i * args_size);
+    }
+  }
+  free(started);
+  free(threads);
+}
+
+#define PAR_PF_CHUNK 64
+
+typedef struct {
+  int* col_ptrs;
+  int* col_ids;
+  int* match;
+  int* row_match;
+  int* visited;       /* phase in which a row was claimed by a search */
+  int* colptrs;       /* a column is only used by the thread whose search holds it */
+  int* lookahead;
+  int* unmatched;
+  int nunmatched;
+  int next;           /* next unmatched column to hand out */
+  int pcount;
+} par_pf_shared;
+
+typedef struct {
+  par_pf_shared* shared;
+  int* stack;
+  int* left;          /* columns that stay unmatched in this phase */
+  int nleft;
+  int naugmented;
+} par_pf_thread;
+
+/* Claims a row for the current phase, fails if any search has visited it */
+static int par_pf_claim(int* visited, int row, int pcount) {
+  int temp = __atomic_load_n(&visited[row], __ATOMIC_RELAXED);
+  return temp != pcount && __sync_bool_compare_and_swap(&visited[row], temp, pcount);
+}
+
+static void* par_pf_phase(void* arg) {
+  par_pf_thread* thread = (par_pf_thread*)arg;
+  par_pf_shared* shared = thread->shared;
+  int* col_ptrs = shared->col_ptrs;
+  int* col_ids = shared->col_ids;
+  int* match = shared->match;
+  int* row_match = shared->row_match;
+  int* visited = shared->visited;
+  int* colptrs = shared->colptrs;
+  int* lookahead = shared->lookahead;
+  int* stack = thread->stack;
+  int pcount = shared->pcount;
+  int i, start, end, row, col, stack_col, temp, ptr, eptr, stack_last, current_col;
+
+  thread->nleft = 0;
+  thread->naugmented = 0;
+
+  while((start = __sync_fetch_and_add(&shared->next, PAR_PF_CHUNK)) < shared->nunmatched) {
+    end = start + PAR_PF_CHUNK < shared->nunmatched ? start + PAR_PF_CHUNK : shared->nunmatched;
+    for(i = start; i < end; i++) {
+      current_col = shared->unmatched[i];
+      stack[0] = current_col; stack_last = 0; colptrs[current_col] = col_ptrs[current_col];
+
+      while(stack_last > -1) {
+        stack_col = stack[stack_last];
+
+        /* a free row that another search claimed first gets matched by that search */
+        eptr = col_ptrs[stack_col + 1];
+        for(ptr = lookahead[stack_col]; ptr < eptr; ptr++) {
+          row = col_ids[ptr];
+          if(__atomic_load_n(&row_match[row], __ATOMIC_RELAXED) == -1 && par_pf_claim(visited, row, pcount)) {
+            break;
+          }
+        }
+        lookahead[stack_col] = ptr + 1;
+
+        if(ptr >= eptr) {
+          for(ptr = colptrs[stack_col]; ptr < eptr; ptr++) {
+            if(par_pf_claim(visited, col_ids[ptr], pcount)) {
+              break;
+            }
+          }
+          colptrs[stack_col] = ptr + 1;
+
+          if(ptr == eptr) {
+            --stack_last;
+            continue;
+          }
+
+          row = col_ids[ptr];
+          col = row_match[row];
+          if(col != -1) {
+            stack[++stack_last] = col; colptrs[col] = col_ptrs[col];
+            continue;
+          }
+        } else {
+          row = col_ids[ptr];
+        }
+
+        /* the rows of the path are claimed by this search, so are the matched columns */
+        while(row != -1) {
+          col = stack[stack_last--];
+          temp = match[col];
+          match[col] = row; __atomic_store_n(&row_match[row], col, __ATOMIC_RELAXED);
+          row = temp;
+        }
+        break;
+      }
+
+      if(match[current_col] == -1) {
+        thread->left[thread->nleft++] = current_col;
+      } else {
+        thread->naugmented++;
+      }
+    }
+  }
+  return NULL;
+}
+
+/* Parallel variant of match_pf. In each phase the unmatched columns are
+ * handed out to the threads in chunks and every thread searches augmenting
+ * paths with the lookahead DFS of match_pf. A row is claimed with an atomic
+ * compare and swap before a search uses it, which keeps the augmenting
+ * paths of one phase vertex disjoint. Searches may block each other this
+ * way, so once a phase finds fewer augmenting paths than there are threads,
+ * match_pf_fair completes the matching to a maximum one.
+ */
+void match_par_pf(int* col_ptrs, int* col_ids, int* match, int* row_match, int n, int m, int num_threads) {
+  par_pf_shared shared;
+  par_pf_thread* threads;
+  int i, j, naugmented;
+
+  if(num_threads <= 1 || n < PAR_MATCHING_MIN_COLUMNS) {
+    match_pf_fair(col_ptrs, col_ids, match, row_match, n, m);
+    return;
+  }
+
+  shared.col_ptrs = col_ptrs;
+  shared.col_ids = col_ids;
+  shared.match = match;
+  shared.row_match = row_match;
+  shared.visited = (int*)calloc(m, sizeof(int));
+  shared.colptrs = (int*)malloc(sizeof(int) * n);
+  shared.lookahead = (int*)malloc(sizeof(int) * n);
+  shared.unmatched = (int*)malloc(sizeof(int) * n);
+  shared.nunmatched = 0;
+  shared.pcount = 1;
+  memcpy(shared.lookahead, col_ptrs, sizeof(int) * n);
+
+  for(i = 0; i < n; i++) {
+    if(match[i] == -1 && col_ptrs[i] != col_ptrs[i+1]) {
+      shared.unmatched[shared.nunmatched++] = i;
+    }
+  }
+
+  threads = (par_pf_thread*)malloc(sizeof(par_pf_thread) * num_threads);
+  for(j = 0; j < num_threads; j++) {
+    threads[j].shared = &shared;
+    threads[j].stack = (int*)malloc(sizeof(int) * n);
+    threads[j].left = (int*)malloc(sizeof(int) * (shared.nunmatched + 1));
+  }
+
+  while(shared.nunmatched > 0) {
+    shared.next = 0;
+    par_run(par_pf_phase, threads, sizeof(par_pf_thread), num_threads);
+
+    naugmented = 0;
+    shared.nunmatched = 0;
+    for(j = 0; j < num_threads; j++) {
+      naugmented += threads[j].naugmented;
+      memcpy(shared.unmatched + shared.nunmatched, threads[j].left, sizeof(int) * threads[j].nleft);
+      shared.nunmatched += threads[j].nleft;
+    }
+    shared.pcount++;
+
+    if(naugmented < num_threads) {
+      break;
+    }
+  }
+
+  for(j = 0; j < num_threads; j++) {
+    free(threads[j].stack);
+    free(threads[j].left);
+  }
+  free(threads);
+  free(shared.unmatched);
+  free(shared.lookahead);
+  free(shared.colptrs);
+  free(shared.visited);
+
+  if(shared.nunmatched > 0) {
+    match_pf_fair(col_ptrs, col_ids, match, row_match, n, m);
+  }
+}
+
+void matching(int* col_ptrs, int* col_ids, int* match, int* row_match, int n, int m, int matching_id, int cheap_id, double relabel_period, int clear_match, int num_threads) {
   int* row_ptrs = NULL;
   int* row_ids = NULL;
   int i;
@@ -1260,7 +1478,7 @@ void matching(int* col_ptrs, int* col_ids, int* match, int* row_match, int n, in
     }
   }
 
-  if(matching_id >= do_hk || cheap_id > do_old_cheap) {
+  if(MATCHING_NEEDS_ROWS(matching_id, cheap_id)) {
 
     row_ptrs = (int*) malloc((m+1) * sizeof(int));
     memset(row_ptrs, 0, (m+1) * sizeof(int));
@@ -1287,7 +1505,7 @@ void matching(int* col_ptrs, int* col_ids, int* match, int* row_match, int n, in
     free(t_row_ptrs);
   }
 
-  cheap_matching(col_ptrs, col_ids, row_ptrs, row_ids, match, row_match, n, m, cheap_id);
+  cheap_matching(col_ptrs, col_ids, row_ptrs, row_ids, match, row_match, n, m, cheap_id, num_threads);
 
   if(matching_id == do_dfs) {
     match_dfs(col_ptrs, col_ids, match, row_match, n, m);
@@ -1309,8 +1527,10 @@ void matching(int* col_ptrs, int* col_ids, int* match, int* row_match, int n, in
     match_abmp_bfs(col_ptrs, col_ids, row_ptrs, row_ids, match, row_match, n, m);
   } else if(matching_id == do_pr_fifo_fair) {
     match_pr_fifo_fair(col_ptrs, col_ids, row_ptrs, row_ids, match, row_match, n, m, relabel_period);
+  } else if(matching_id == do_par_pf) {
+    match_par_pf(col_ptrs, col_ids, match, row_match, n, m, num_threads);
   }
-  if(matching_id >= do_hk || cheap_id > do_old_cheap) {
+  if(MATCHING_NEEDS_ROWS(matching_id, cheap_id)) {
     free(row_ids);
     free(row_ptrs);
   }
@@ -554,7 +554,65 @@ void mind_cheap(int *col_ptrs, int *col_ids, int *row_ptrs, int *row_ids, int *m
   free(rnodes);
 }
 
-void cheap_matching(int *col_ptrs, int *col_ids, int *row_ptrs, int *row_ids, int *match, int *row_match, int n, int m, int cheap_id)
+typedef struct {
+  int* col_ptrs;
+  int* col_ids;
+  int* match;
+  int* row_match;
+  int start;
+  int end;
+} par_cheap_args;
+
+static void* par_cheap_thread(void* arg) {
+  par_cheap_args* args = (par_cheap_args*)arg;
+  int* col_ptrs = args->col_ptrs;
+  int* col_ids = args->col_ids;
+  int* row_match = args->row_match;
+  int i, ptr;
+
+  for(i = args->start; i < args->end; i++) {
+    if(args->match[i] != -1) {
+      continue;
+    }
+    for(ptr = col_ptrs[i]; ptr < col_ptrs[i + 1]; ptr++) {
+      int r_id = col_ids[ptr];
+      /* the row goes to the thread that sets it first */
+      if(__atomic_load_n(&row_match[r_id], __ATOMIC_RELAXED) == -1 && __sync_bool_compare_and_swap(&row_match[r_id], -1, i)) {
+        args->match[i] = r_id;
+        break;
+      }
+    }
+  }
+  return NULL;
+}
+
+/* Simple greedy matching as old_cheap, with the columns split into one
+ * contiguous range per thread. Only the first free row of a column is
+ * taken, so the result depends on the thread timing but has the same
+ * quality as the serial greedy matching.
+ */
+void par_cheap(int* col_ptrs, int* col_ids, int* match, int* row_match, int n, int m, int num_threads) {
+  par_cheap_args* args;
+  int i;
+
+  if(n < PAR_MATCHING_MIN_COLUMNS || num_threads < 1) {
+    num_threads = 1;
+  }
+
+  args = (par_cheap_args*)malloc(sizeof(par_cheap_args) * num_threads);
+  for(i = 0; i < num_threads; i++) {
+    args[i].col_ptrs = col_ptrs;
+    args[i].col_ids = col_ids;
+    args[i].match = match;
+    args[i].row_match = row_match;
+    args[i].start = (int)(((long long)n * i) / num_threads);
+    args[i].end = (int)(((long long)n * (i + 1)) / num_threads);
+  }
+  par_run(par_cheap_thread, args, sizeof(par_cheap_args), num_threads);
+  free(args);
+}
+
+void cheap_matching(int *col_ptrs, int *col_ids, int *row_ptrs, int *row_ids, int *match, int *row_match, int n, int m, int cheap_id, int num_threads)
 {
   if(do_old_cheap == cheap_id)
   {
@@ -572,11 +630,15 @@ void cheap_matching(int *col_ptrs, int *col_ids, int *row_ptrs, int *row_ids, in
   {
     mind_cheap(col_ptrs, col_ids, row_ptrs, row_ids, match, row_match, n, m);
   }
+  else if(do_par_cheap == cheap_id)
+  {
+    par_cheap(col_ptrs, col_ids, match, row_match, n, m, num_threads);
+  }
 }
 
-void cheapmatching(int* col_ptrs, int* col_ids, int* match, int* row_match, int n, int m, int cheap_id, int clear_match) {
-  int* row_ptrs;
-  int* row_ids;
+void cheapmatching(int* col_ptrs, int* col_ids, int* match, int* row_match, int n, int m, int cheap_id, int clear_match, int num_threads) {
+  int* row_ptrs = NULL;
+  int* row_ids = NULL;
   int i;
 
   if (clear_match==1)
@@ -589,7 +651,7 @@ void cheapmatching(int* col_ptrs, int* col_ids, int* match, int* row_match, int
     }
   }
 
-  if(cheap_id > do_old_cheap) {
+  if(CHEAP_NEEDS_ROWS(cheap_id)) {
     row_ptrs = (int*) malloc((m+1) * sizeof(int));
     memset(row_ptrs, 0, (m+1) * sizeof(int));
 
@@ -615,9 +677,9 @@ void cheapmatching(int* col_ptrs, int* col_ids, int* match, int* row_match, int
     free(t_row_ptrs);
   }
 
-  cheap_matching(col_ptrs, col_ids, row_ptrs, row_ids, match, row_match, n, m, cheap_id);
+  cheap_matching(col_ptrs, col_ids, row_ptrs, row_ids, match, row_match, n, m, cheap_id, num_threads);
 
-  if(cheap_id > do_old_cheap) {
+  if(CHEAP_NEEDS_ROWS(cheap_id)) {
     free(row_ids);
     free(row_ptrs);
   }
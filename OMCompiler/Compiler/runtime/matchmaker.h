@@ -20,10 +20,13 @@
 #ifndef MATCHMAKER_H_
 #define MATCHMAKER_H_
 
+#include <stddef.h>
+
 #define do_old_cheap 1
 #define do_sk_cheap 2
 #define do_sk_cheap_rand 3
 #define do_mind_cheap 4
+#define do_par_cheap 5
 
 #define do_dfs 1
 #define do_bfs 2
@@ -35,11 +38,20 @@
 #define do_abmp 8
 #define do_abmp_bfs 9
 #define do_pr_fifo_fair 10
+#define do_par_pf 11
+
+/* The algorithms that also need the row-wise structure row_ptrs/row_ids */
+#define CHEAP_NEEDS_ROWS(cheap_id) ((cheap_id) > do_old_cheap && (cheap_id) <= do_mind_cheap)
+#define MATCHING_NEEDS_ROWS(match_id, cheap_id) (((match_id) >= do_hk && (match_id) <= do_pr_fifo_fair) || CHEAP_NEEDS_ROWS(cheap_id))
+
+/* Number of columns below which the parallel algorithms run on one thread */
+#define PAR_MATCHING_MIN_COLUMNS 10000
 
 void old_cheap(int* col_ptrs, int* col_ids, int* match, int* row_match, int n, int m);
 void sk_cheap(int* col_ptrs, int* col_ids, int* row_ptrs, int* row_ids, int* match, int* row_match, int n, int m);
 void sk_cheap_rand(int* col_ptrs, int* col_ids, int* row_ptrs, int* row_ids, int* match, int* row_match, int n, int m);
 void mind_cheap(int* col_ptrs, int* col_ids, int* row_ptrs, int* row_ids, int* match, int* row_match, int n, int m);
+void par_cheap(int* col_ptrs, int* col_ids, int* match, int* row_match, int n, int m, int num_threads);
 
 void match_dfs(int* col_ptrs, int* col_ids, int* match, int* row_match, int n, int m);
 void match_bfs(int* col_ptrs, int* col_ids, int* match, int* row_match, int n, int m);
@@ -51,12 +63,15 @@ void match_hk_dw(int* col_ptrs, int* col_ids, int* row_ptrs, int* row_ids, int*
 void match_abmp(int* col_ptrs, int* col_ids, int* row_ptrs, int* row_ids, int* match, int* row_match, int n, int m);
 void match_abmp_bfs(int* col_ptrs, int* col_ids, int* row_ptrs, int* row_ids, int* match, int* row_match, int n, int m);
 void match_pr_fifo_fair(int* col_ptrs, int* col_ids, int* row_ptrs, int* row_ids, int* match, int* row_match, int n, int m, double relabel_period);
+void match_par_pf(int* col_ptrs, int* col_ids, int* match, int* row_match, int n, int m, int num_threads);
 
 void pr_global_relabel(int* l_label, int* r_label, int* row_ptrs, int* row_ids, int* match, int* row_match, int n, int m);
 
-void cheap_matching(int* col_ptrs, int* col_ids, int* row_ptrs, int* row_ids, int* match, int* row_match, int n, int m, int cheap_id);
+void par_run(void* (*worker)(void*), void* args, size_t args_size, int num_threads);
+
+void cheap_matching(int* col_ptrs, int* col_ids, int* row_ptrs, int* row_ids, int* match, int* row_match, int n, int m, int cheap_id, int num_threads);
 
-void cheapmatching(int* col_ptrs, int* col_ids, int* match, int* row_match, int n, int m, int cheap_id, int clear_match);
-void matching(int* col_ptrs, int* col_ids, int* match, int* row_match, int n, int m, int match_id, int cheap_id, double relabel_period, int clear_match);
+void cheapmatching(int* col_ptrs, int* col_ids, int* match, int* row_match, int n, int m, int cheap_id, int clear_match, int num_threads);
+void matching(int* col_ptrs, int* col_ids, int* match, int* row_match, int n, int m, int match_id, int cheap_id, double relabel_period, int clear_match, int num_threads);
 
 #endif /* MATCHMAKER_H_ */
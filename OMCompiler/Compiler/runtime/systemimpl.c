@@ -1030,6 +1030,25 @@ extern int SystemImpl__copyFile(const char *str_1, const char *str_2)
   return rv;
 }
 
+/* Gives str_2 the permissions of str_1, so that a copied executable can still be run. */
+extern int SystemImpl__copyFilePermissions(const char *str_1, const char *str_2)
+{
+#if !(defined(__MINGW32__) || defined(_MSC_VER))
+  omc_stat_t buf;
+  if (omc_stat(str_1, &buf) != 0 || chmod(str_2, buf.st_mode & 07777) != 0) {
+    const char *msg[3] = {strerror(errno), str_2, str_1};
+    c_add_message(NULL,85,
+      ErrorType_scripting,
+      ErrorLevel_error,
+      gettext("Error copying the permissions of %s to %s: %s"),
+      msg,
+      3);
+    return 0;
+  }
+#endif
+  return 1;
+}
+
 static char * SystemImpl__NextDir(const char * path)
 {
   char * res = NULL;
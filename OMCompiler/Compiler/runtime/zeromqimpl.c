@@ -132,6 +132,102 @@ void ZeroMQ_sendReply(void *mmcZmqSocket, const char* reply)
   zmq_msg_close(&replyMsg);
 }
 
+/* Binary requests
+ *
+ * A request that starts with a MessagePack array header is a binary request. The
+ * array contains the commands to evaluate as MessagePack strings, and the reply is
+ * an array with the result of each command in the same order. This lets a client
+ * send several commands in one round-trip instead of one request per command.
+ * The first byte of a binary request is never the first byte of a text request,
+ * since those are Modelica expressions. The encoding is in zeromqmsgpack.c.
+ */
+#include "zeromqmsgpack.c"
+
+static void zeroMQAddRequest(void *userData, const char *str, size_t len)
+{
+  void **requests = (void**)userData;
+  char *request = (char*)malloc(len + 1);
+  memcpy(request, str, len);
+  request[len] = 0;
+  *requests = mmc_mk_cons(mmc_mk_scon(request), *requests);
+  free(request);
+}
+
+/* Decodes a MessagePack array of strings to a list of strings. Returns 0 if the
+ * request is malformed. */
+static int zeroMQDecodeRequests(const unsigned char *data, size_t size, void **requests)
+{
+  void *res = mmc_mk_nil();
+  if (!zeroMQDecodeStrings(data, size, zeroMQAddRequest, &res)) {
+    return 0;
+  }
+  *requests = listReverse(res);
+  return 1;
+}
+
+/* Receives the next request. Text requests are returned as a list with one
+ * command, binary requests as a list with all the commands in the request. A
+ * malformed binary request gives an empty list. */
+void* ZeroMQ_handleRequests(void *mmcZmqSocket, int *binary)
+{
+  // Convert the void* to ZeroMQ Socket
+  intptr_t zmqSocket = (intptr_t)MMC_FETCH(MMC_OFFSET(MMC_UNTAGPTR(mmcZmqSocket),1));
+  void *requests = mmc_mk_nil();
+  zmq_msg_t request;
+  int rc = zmq_msg_init(&request);
+  assert(rc == 0);
+  // Block until a message is available to be received from socket
+  int size = zmq_msg_recv(&request, (void*)zmqSocket, 0);
+  assert(size != -1);
+  const unsigned char *data = (const unsigned char*)zmq_msg_data(&request);
+
+  *binary = zeroMQIsBinaryRequest(data, size);
+  if (*binary) {
+    if (!zeroMQDecodeRequests(data, size, &requests)) {
+      requests = mmc_mk_nil();
+    }
+  } else {
+    char *requestStr = (char*)malloc(size + 1);
+    memcpy(requestStr, data, size);
+    requestStr[size] = 0;
+    requests = mmc_mk_cons(mmc_mk_scon(requestStr), mmc_mk_nil());
+    free(requestStr);
+  }
+  // release the zmq_msg_t
+  zmq_msg_close(&request);
+  return requests;
+}
+
+/* Sends the replies to a request received with ZeroMQ_handleRequests, as a
+ * MessagePack array if the request was binary. Replies that are not valid
+ * UTF-8 are sent as bins instead of strings. */
+void ZeroMQ_sendReplies(void *mmcZmqSocket, void *replies, int binary)
+{
+  // Convert the void* to ZeroMQ Socket
+  intptr_t zmqSocket = (intptr_t)MMC_FETCH(MMC_OFFSET(MMC_UNTAGPTR(mmcZmqSocket),1));
+  size_t count = 0, size = ZEROMQ_MAX_HEADER_SIZE;
+  void *lst;
+  unsigned char *buf, *pos;
+
+  if (!binary) {
+    ZeroMQ_sendReply(mmcZmqSocket, listEmpty(replies) ? "" : MMC_STRINGDATA(MMC_CAR(replies)));
+    return;
+  }
+
+  for (lst = replies; !listEmpty(lst); lst = MMC_CDR(lst)) {
+    count++;
+    size += ZEROMQ_MAX_HEADER_SIZE + MMC_STRLEN(MMC_CAR(lst));
+  }
+
+  buf = (unsigned char*)malloc(size);
+  pos = zeroMQWriteArrayHeader(buf, count);
+  for (lst = replies; !listEmpty(lst); lst = MMC_CDR(lst)) {
+    pos = zeroMQWriteString(pos, MMC_STRINGDATA(MMC_CAR(lst)), MMC_STRLEN(MMC_CAR(lst)));
+  }
+  zmq_send((void*)zmqSocket, buf, pos - buf, 0);
+  free(buf);
+}
+
 void ZeroMQ_close(void *mmcZmqSocket)
 {
   if (zeroMQFilePath) {
@@ -0,0 +1,159 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-2010, Linköpings University,
+ * Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF THIS OSMC PUBLIC
+ * LICENSE (OSMC-PL). ANY USE, REPRODUCTION OR DISTRIBUTION OF
+ * THIS PROGRAM CONSTITUTES RECIPIENT'S ACCEPTANCE OF THE OSMC
+ * PUBLIC LICENSE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from Linköpings University, either from the above address,
+ * from the URL: http://www.ida.liu.se/projects/OpenModelica
+ * and in the OpenModelica distribution.
+ *
+ * This program is distributed  WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS
+ * OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+/* The MessagePack encoding of the binary requests of the ZeroMQ server, see
+ * zeromqimpl.c. It does not depend on ZeroMQ or the MetaModelica runtime so
+ * testsuite/openmodelica/bootstrapping/ZeroMQMessagePack.c can test it.
+ *
+ * A binary request is an array of commands and the reply is an array with the
+ * result of each command. The commands and results are strings, or bins if
+ * they are not valid UTF-8.
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "is_utf8.h"
+
+static int zeroMQIsBinaryRequest(const unsigned char *data, size_t size)
+{
+  return size > 0 && ((data[0] >= 0x90 && data[0] <= 0x9f) || data[0] == 0xdc || data[0] == 0xdd);
+}
+
+static int zeroMQReadUInt(const unsigned char **pos, const unsigned char *end, int bytes, size_t *value)
+{
+  int i;
+  if (end - *pos < bytes) {
+    return 0;
+  }
+  *value = 0;
+  for (i = 0; i < bytes; i++) {
+    *value = (*value << 8) | (*pos)[i];
+  }
+  *pos += bytes;
+  return 1;
+}
+
+/* Decodes a MessagePack array of strings or bins and calls add for each element
+ * in order. Returns 0 if the data is malformed. */
+static int zeroMQDecodeStrings(const unsigned char *data, size_t size, void (*add)(void*, const char*, size_t), void *userData)
+{
+  const unsigned char *pos = data, *end = data + size;
+  size_t count, len, i;
+  unsigned char type;
+
+  if (!zeroMQIsBinaryRequest(data, size)) {
+    return 0;
+  }
+  type = *pos++;
+  if (type >= 0x90 && type <= 0x9f) {
+    count = type & 0x0f;
+  } else if (!zeroMQReadUInt(&pos, end, type == 0xdc ? 2 : 4, &count)) {
+    return 0;
+  }
+
+  for (i = 0; i < count; i++) {
+    if (pos >= end) {
+      return 0;
+    }
+    type = *pos++;
+    if (type >= 0xa0 && type <= 0xbf) {
+      len = type & 0x1f;
+    } else if (type == 0xd9 || type == 0xc4) {
+      /* str 8 or bin 8 */
+      if (!zeroMQReadUInt(&pos, end, 1, &len)) return 0;
+    } else if (type == 0xda || type == 0xc5) {
+      if (!zeroMQReadUInt(&pos, end, 2, &len)) return 0;
+    } else if (type == 0xdb || type == 0xc6) {
+      if (!zeroMQReadUInt(&pos, end, 4, &len)) return 0;
+    } else {
+      return 0;
+    }
+    if ((size_t)(end - pos) < len) {
+      return 0;
+    }
+    add(userData, (const char*)pos, len);
+    pos += len;
+  }
+
+  return pos == end;
+}
+
+/* Writes a header with the length in the fix type if there is one (fixType != 0)
+ * and the length fits, otherwise in the smallest of the 8, 16 and 32-bit types. */
+static unsigned char* zeroMQWriteHeader(unsigned char *pos, unsigned char fixType, unsigned char fixMax, const unsigned char types[3], size_t len)
+{
+  int i, bytes;
+  if (fixType && len <= fixMax) {
+    *pos++ = fixType | (unsigned char)len;
+    return pos;
+  } else if (types[0] && len <= 0xff) {
+    *pos++ = types[0];
+    bytes = 1;
+  } else if (len <= 0xffff) {
+    *pos++ = types[1];
+    bytes = 2;
+  } else {
+    *pos++ = types[2];
+    bytes = 4;
+  }
+  for (i = bytes - 1; i >= 0; i--) {
+    *pos++ = (unsigned char)(len >> (8 * i));
+  }
+  return pos;
+}
+
+/* The number of bytes zeroMQWriteArrayHeader and zeroMQWriteString write at most. */
+#define ZEROMQ_MAX_HEADER_SIZE 5
+
+static unsigned char* zeroMQWriteArrayHeader(unsigned char *pos, size_t count)
+{
+  static const unsigned char arrayTypes[3] = {0, 0xdc, 0xdd};
+  return zeroMQWriteHeader(pos, 0x90, 0x0f, arrayTypes, count);
+}
+
+/* Writes the data as a str if it is valid UTF-8 and as a bin otherwise, so the
+ * client gets it unchanged in both cases. */
+static unsigned char* zeroMQWriteString(unsigned char *pos, const char *str, size_t len)
+{
+  static const unsigned char strTypes[3] = {0xd9, 0xda, 0xdb};
+  static const unsigned char binTypes[3] = {0xc4, 0xc5, 0xc6};
+  char *message;
+  int faultyBytes;
+
+  is_utf8((unsigned char*)str, len, &message, &faultyBytes);
+  if (message) {
+    pos = zeroMQWriteHeader(pos, 0, 0, binTypes, len);
+  } else {
+    pos = zeroMQWriteHeader(pos, 0xa0, 0x1f, strTypes, len);
+  }
+  memcpy(pos, str, len);
+  return pos + len;
+}
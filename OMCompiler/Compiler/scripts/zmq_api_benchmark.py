@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+"""
+Measures the throughput of the omc interactive API over ZeroMQ, sending one
+text request per command versus binary (MessagePack) requests with several
+commands each.
+
+Start omc with the ZeroMQ server first, e.g.
+
+  omc --interactive=zmq -z=bench
+
+and then run
+
+  zmq_api_benchmark.py -z bench [--batch 32] [--calls 2000] [--class Modelica.Blocks.Continuous.PID]
+
+Requires pyzmq.
+"""
+
+import argparse
+import getpass
+import os
+import struct
+import sys
+import tempfile
+import time
+
+import zmq
+
+
+def pack_strings(strings):
+  """Encodes a list of strings as a MessagePack array."""
+  out = bytearray()
+  n = len(strings)
+  if n < 16:
+    out.append(0x90 | n)
+  elif n < 0x10000:
+    out += struct.pack(">BH", 0xdc, n)
+  else:
+    out += struct.pack(">BI", 0xdd, n)
+
+  for s in strings:
+    b = s.encode("utf-8")
+    n = len(b)
+    if n < 32:
+      out.append(0xa0 | n)
+    elif n < 0x100:
+      out += struct.pack(">BB", 0xd9, n)
+    elif n < 0x10000:
+      out += struct.pack(">BH", 0xda, n)
+    else:
+      out += struct.pack(">BI", 0xdb, n)
+    out += b
+
+  return bytes(out)
+
+
+def unpack_strings(data):
+  """Decodes a MessagePack array of strings. Bins, which omc sends for replies
+  that are not valid UTF-8, are returned as bytes."""
+  def read_uint(pos, size):
+    return int.from_bytes(data[pos:pos + size], "big"), pos + size
+
+  t = data[0]
+  if 0x90 <= t <= 0x9f:
+    n, pos = t & 0x0f, 1
+  elif t == 0xdc:
+    n, pos = read_uint(1, 2)
+  elif t == 0xdd:
+    n, pos = read_uint(1, 4)
+  else:
+    raise ValueError("expected a MessagePack array, got type 0x%02x" % t)
+
+  res = []
+  for _ in range(n):
+    t = data[pos]
+    pos += 1
+    if 0xa0 <= t <= 0xbf:
+      size = t & 0x1f
+    elif t in (0xd9, 0xc4):
+      size, pos = read_uint(pos, 1)
+    elif t in (0xda, 0xc5):
+      size, pos = read_uint(pos, 2)
+    elif t in (0xdb, 0xc6):
+      size, pos = read_uint(pos, 4)
+    else:
+      raise ValueError("expected a MessagePack string, got type 0x%02x" % t)
+    res.append(data[pos:pos + size] if t in (0xc4, 0xc5, 0xc6) else data[pos:pos + size].decode("utf-8"))
+    pos += size
+
+  return res
+
+
+def endpoint_from_port_file(suffix):
+  """Reads the endpoint omc wrote to its port file."""
+  suffix = "." + suffix if suffix else ""
+  tmp = tempfile.gettempdir()
+  if sys.platform == "win32":
+    path = os.path.join(tmp, "openmodelica.port" + suffix)
+  else:
+    path = os.path.join(tmp, "openmodelica.%s.port%s" % (getpass.getuser(), suffix))
+  with open(path) as f:
+    return f.read().strip()
+
+
+def commands(cls, count):
+  """A mix of the calls OMEdit makes when a model is opened."""
+  calls = [
+    "getVersion()",
+    "isPackage(%s)" % cls,
+    "getClassInformation(%s)" % cls,
+    "getClassNames(%s)" % cls.rsplit(".", 1)[0],
+    "getInheritedClasses(%s)" % cls,
+    "getComponents(%s)" % cls,
+    "getModelInstance(%s, prettyPrint=false)" % cls,
+  ]
+  return [calls[i % len(calls)] for i in range(count)]
+
+
+def run_text(socket, cmds):
+  start = time.perf_counter()
+  for cmd in cmds:
+    socket.send_string(cmd)
+    socket.recv()
+  return time.perf_counter() - start
+
+
+def run_binary(socket, cmds, batch):
+  start = time.perf_counter()
+  for i in range(0, len(cmds), batch):
+    chunk = cmds[i:i + batch]
+    socket.send(pack_strings(chunk))
+    replies = unpack_strings(socket.recv())
+    if len(replies) != len(chunk):
+      raise RuntimeError("got %d replies for %d commands" % (len(replies), len(chunk)))
+  return time.perf_counter() - start
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+  parser.add_argument("-z", "--suffix", default="", help="the -z suffix omc was started with")
+  parser.add_argument("--endpoint", help="connect to this endpoint instead of reading the port file")
+  parser.add_argument("--class", dest="cls", default="Modelica.Blocks.Continuous.PID", help="the class to query")
+  parser.add_argument("--calls", type=int, default=2000, help="number of calls per run")
+  parser.add_argument("--batch", type=int, default=32, help="number of calls per binary request")
+  args = parser.parse_args()
+
+  endpoint = args.endpoint or endpoint_from_port_file(args.suffix)
+  context = zmq.Context()
+  socket = context.socket(zmq.REQ)
+  socket.connect(endpoint)
+
+  socket.send_string("loadModel(Modelica)")
+  print("loadModel(Modelica): " + socket.recv().decode("utf-8").strip())
+
+  cmds = commands(args.cls, args.calls)
+  # Warm up omc's caches so both runs see the same state.
+  run_text(socket, cmds[:min(len(cmds), 50)])
+
+  text = run_text(socket, cmds)
+  binary = run_binary(socket, cmds, max(1, args.batch))
+
+  print("%-24s %8.3f s %10.1f calls/s" % ("text, 1 per request", text, len(cmds) / text))
+  print("%-24s %8.3f s %10.1f calls/s" % ("binary, %d per request" % args.batch, binary, len(cmds) / binary))
+  print("speedup: %.2fx" % (text / binary))
+
+  socket.close()
+  context.term()
+
+
+if __name__ == "__main__":
+  main()
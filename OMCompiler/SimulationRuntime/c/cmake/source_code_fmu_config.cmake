@@ -39,6 +39,7 @@ set(SOURCE_FMU_COMMON_FILES_LIST ./gc/memory_pool.c
                                  ./util/ringbuffer.c
                                  ./util/simulation_options.c
                                  ./util/string_array.c
+                                 ./util/timer_queue.c
                                  ./util/utility.c
                                  ./util/varinfo.c
                                  ./math-support/pivot.c
@@ -55,6 +56,7 @@ set(SOURCE_FMU_COMMON_FILES_LIST ./gc/memory_pool.c
                                  ./simulation/solver/spatialDistribution.c
                                  ./simulation/solver/stateset.c
                                  ./simulation/solver/synchronous.c
+                                 ./simulation/solver/taskGraph.c
                                  ./simulation/solver/initialization/initialization.c
                                  ./meta/meta_modelica_catch.c)
 
@@ -98,6 +100,7 @@ set(SOURCE_FMU_COMMON_HEADERS \"./omc_inline.h\",
                               \"./simulation/simulation_runtime.h\",
                               \"./simulation/omc_simulation_util.h\",
                               \"./simulation/results/simulation_result.h\",
+                              \"./simulation/solver/checkpoint.h\",
                               \"./simulation/solver/cvode_solver.h\",
                               \"./simulation/solver/dae_mode.h\",
                               \"./simulation/solver/dassl.h\",
@@ -114,6 +117,7 @@ set(SOURCE_FMU_COMMON_HEADERS \"./omc_inline.h\",
                               \"./simulation/solver/mixedSearchSolver.h\",
                               \"./simulation/solver/mixedSystem.h\",
                               \"./simulation/solver/model_help.h\",
+                              \"./simulation/solver/nlsSparseLU.h\",
                               \"./simulation/solver/nonlinearSolverHomotopy.h\",
                               \"./simulation/solver/nonlinearSolverHybrd.h\",
                               \"./simulation/solver/nonlinearSystem.h\",
@@ -128,6 +132,7 @@ set(SOURCE_FMU_COMMON_HEADERS \"./omc_inline.h\",
                               \"./simulation/solver/sundials_error.h\",
                               \"./simulation/solver/sundials_util.h\",
                               \"./simulation/solver/synchronous.h\",
+                              \"./simulation/solver/taskGraph.h\",
                               \"./simulation/solver/initialization/initialization.h\",
                               \"./meta/meta_modelica_builtin_boxptr.h\",
                               \"./meta/meta_modelica_builtin_boxvar.h\",
@@ -164,6 +169,7 @@ set(SOURCE_FMU_COMMON_HEADERS \"./omc_inline.h\",
                               \"./util/rtclock.h\",
                               \"./util/simulation_options.h\",
                               \"./util/string_array.h\",
+                              \"./util/timer_queue.h\",
                               \"./util/uthash.h\",
                               \"./util/utility.h\",
                               \"./util/varinfo.h\",
@@ -201,7 +207,7 @@ string(REPLACE ";" "," SOURCE_FMU_DGESV_FILES "${SOURCE_FMU_DGESV_FILES_LIST_QUO
 ######################################################################################################################
 ## Non-linear system files
 
-set(SOURCE_FMU_NLS_FILES_LIST simulation/solver/nonlinearSolverHomotopy.c simulation/solver/nonlinearSolverHybrd.c simulation/solver/nonlinearValuesList.c simulation/solver/nonlinearSystem.c)
+set(SOURCE_FMU_NLS_FILES_LIST simulation/solver/nlsSparseLU.c simulation/solver/nonlinearSolverHomotopy.c simulation/solver/nonlinearSolverHybrd.c simulation/solver/nonlinearValuesList.c simulation/solver/nonlinearSystem.c)
 
 foreach(source_file ${SOURCE_FMU_NLS_FILES_LIST})
   list(APPEND SOURCE_FMU_NLS_FILES_LIST_QUOTED \"${source_file}\")
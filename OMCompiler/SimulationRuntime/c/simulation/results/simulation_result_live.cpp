@@ -0,0 +1,317 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF THE BSD NEW LICENSE OR THE
+ * GPL VERSION 3 LICENSE OR THE OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the OSMC (Open Source Modelica Consortium)
+ * Public License (OSMC-PL) are obtained from OSMC, either from the above
+ * address, from the URLs: http://www.openmodelica.org or
+ * http://www.ida.liu.se/projects/OpenModelica, and in the OpenModelica
+ * distribution. GNU version 3 is obtained from:
+ * http://www.gnu.org/copyleft/gpl.html. The New BSD License is obtained from:
+ * http://www.opensource.org/licenses/BSD-3-Clause.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE, EXCEPT AS
+ * EXPRESSLY SET FORTH IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE
+ * CONDITIONS OF OSMC-PL.
+ *
+ */
+
+/*
+ * The live result is written in addition to the normal result file. It wraps
+ * the functions of the selected result format and publishes each emitted point
+ * into a memory mapped ring buffer that other processes can read while the
+ * simulation is running. See util/live_result.h for the layout.
+ */
+
+#include "util/omc_error.h"
+#include "util/omc_file.h"
+#include "util/live_result.h"
+#include "simulation_result_live.h"
+
+#include <atomic>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#if defined(__MINGW32__) || defined(_MSC_VER)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* The ring buffer holds at most this many frames, and fewer for large models. */
+#define LIVE_RESULT_MAX_FRAMES 256
+#define LIVE_RESULT_MIN_FRAMES 16
+#define LIVE_RESULT_FRAMES_BUDGET (16 * 1024 * 1024)
+
+extern "C" {
+
+typedef struct live_storage {
+  /* The functions of the wrapped result format. */
+  void (*emit)(simulation_result*, DATA*, threadData_t*);
+  void (*writeParameterData)(simulation_result*, DATA*, threadData_t*);
+  void (*free)(simulation_result*, DATA*, threadData_t*);
+
+  char *map;
+  size_t size;
+  char *fileName;
+#if defined(__MINGW32__) || defined(_MSC_VER)
+  HANDLE file;
+  HANDLE mapping;
+#endif
+  omc_live_result_header *header;
+  double *parameters;
+  char *frames;
+  uint64_t frameSize;
+} live_storage;
+
+/* There is only one sim_result, so there is only one live result as well. */
+static live_storage live;
+
+static uint64_t live_align8(uint64_t n)
+{
+  return (n + 7) & ~(uint64_t)7;
+}
+
+/* Creates and maps the file, returns NULL with a warning if that fails. */
+static char* live_map(const char *fileName, size_t size)
+{
+#if defined(__MINGW32__) || defined(_MSC_VER)
+  wchar_t *unicodeFileName = omc_multibyte_to_wchar_str(fileName);
+  live.file = CreateFileW(unicodeFileName, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                          NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+  free(unicodeFileName);
+  if (live.file == INVALID_HANDLE_VALUE) {
+    warningStreamPrint(OMC_LOG_STDOUT, 0, "Failed to create the live result file %s: error %lu", fileName, (unsigned long) GetLastError());
+    return NULL;
+  }
+  /* Creating the mapping extends the file to the given size. */
+  live.mapping = CreateFileMappingW(live.file, NULL, PAGE_READWRITE, (DWORD) ((uint64_t) size >> 32), (DWORD) size, NULL);
+  void *map = live.mapping ? MapViewOfFile(live.mapping, FILE_MAP_ALL_ACCESS, 0, 0, size) : NULL;
+  if (!map) {
+    warningStreamPrint(OMC_LOG_STDOUT, 0, "Failed to map the live result file %s: error %lu", fileName, (unsigned long) GetLastError());
+    if (live.mapping) CloseHandle(live.mapping);
+    CloseHandle(live.file);
+    return NULL;
+  }
+  return (char*) map;
+#else
+  int fd = open(fileName, O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+  if (fd < 0) {
+    warningStreamPrint(OMC_LOG_STDOUT, 0, "Failed to create the live result file %s: %s", fileName, strerror(errno));
+    return NULL;
+  }
+  if (ftruncate(fd, size) < 0) {
+    warningStreamPrint(OMC_LOG_STDOUT, 0, "Failed to resize the live result file %s: %s", fileName, strerror(errno));
+    close(fd);
+    return NULL;
+  }
+  void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) {
+    warningStreamPrint(OMC_LOG_STDOUT, 0, "Failed to map the live result file %s: %s", fileName, strerror(errno));
+    return NULL;
+  }
+  return (char*) map;
+#endif
+}
+
+static void live_unmap()
+{
+#if defined(__MINGW32__) || defined(_MSC_VER)
+  UnmapViewOfFile(live.map);
+  CloseHandle(live.mapping);
+  CloseHandle(live.file);
+#else
+  munmap(live.map, live.size);
+#endif
+  live.map = NULL;
+}
+
+static void live_writeParameters(DATA *data)
+{
+  memcpy(live.parameters, data->simulationInfo->realParameter, live.header->numParameters * sizeof(double));
+  std::atomic_thread_fence(std::memory_order_release);
+  live.header->state = OMC_LIVE_RESULT_RUNNING;
+}
+
+static void live_emit(simulation_result *self, DATA *data, threadData_t *threadData)
+{
+  omc_live_result_header *header = live.header;
+
+  /* Some solvers emit without writing the parameters first. */
+  if (header->state == OMC_LIVE_RESULT_INITIALIZING) {
+    live_writeParameters(data);
+  }
+
+  uint64_t n = header->writeCount;
+  char *slot = live.frames + (n % header->numFrames) * live.frameSize;
+  volatile uint64_t *sequence = (volatile uint64_t*) slot;
+  double *values = (double*) (slot + sizeof(uint64_t));
+
+  /* Invalidate the slot before overwriting it, so that readers still copying
+   * the old frame notice that it has changed. */
+  *sequence = 0;
+  std::atomic_thread_fence(std::memory_order_release);
+  values[0] = data->localData[0]->timeValue;
+  memcpy(values + 1, data->localData[0]->realVars, (header->numSignals - 1) * sizeof(double));
+  std::atomic_thread_fence(std::memory_order_release);
+  *sequence = n + 1;
+  header->writeCount = n + 1;
+
+  live.emit(self, data, threadData);
+}
+
+static void live_writeParameterData(simulation_result *self, DATA *data, threadData_t *threadData)
+{
+  live_writeParameters(data);
+  live.writeParameterData(self, data, threadData);
+}
+
+static void live_free(simulation_result *self, DATA *data, threadData_t *threadData)
+{
+  if (live.map) {
+    std::atomic_thread_fence(std::memory_order_release);
+    live.header->state = OMC_LIVE_RESULT_FINISHED;
+    live_unmap();
+    /* The complete results are in the result file now. Readers that still map
+     * the live result keep their mapping. On Windows the removal fails while a
+     * reader has the file open, which is harmless. */
+    omc_unlink(live.fileName);
+    free(live.fileName);
+    live.fileName = NULL;
+  }
+
+  self->emit = live.emit;
+  self->writeParameterData = live.writeParameterData;
+  self->free = live.free;
+  live.free(self, data, threadData);
+}
+
+/**
+ * @brief Publish the results of the simulation into a live result file.
+ *
+ * Creates the memory mapped file and wraps the emit, writeParameterData and
+ * free functions of the already initialized result, which are still called.
+ * All real variables are published, regardless of the variable filter of the
+ * result file, since the readers decide which of them they need.
+ *
+ * @param self        Initialized simulation result.
+ * @param data        Simulation data.
+ * @param threadData  Thread data.
+ * @param fileName    Name of the live result file, overwritten if it exists
+ *                    and removed when the simulation has finished.
+ */
+void live_result_attach(simulation_result *self, DATA *data, threadData_t *threadData, const char *fileName)
+{
+  MODEL_DATA *modelData = data->modelData;
+  uint32_t numSignals = 1 + modelData->nVariablesReal;
+  uint32_t numParameters = modelData->nParametersReal;
+  uint32_t numNames = numSignals + modelData->nAliasReal + numParameters;
+  uint64_t stringsSize = strlen("time") + 1;
+  long i;
+
+  for (i = 0; i < modelData->nVariablesReal; i++) stringsSize += strlen(modelData->realVarsData[i].info.name) + 1;
+  for (i = 0; i < modelData->nAliasReal; i++) stringsSize += strlen(modelData->realAlias[i].info.name) + 1;
+  for (i = 0; i < modelData->nParametersReal; i++) stringsSize += strlen(modelData->realParameterData[i].info.name) + 1;
+
+  uint64_t frameSize = OMC_LIVE_RESULT_FRAME_SIZE(numSignals);
+  uint64_t numFrames = LIVE_RESULT_FRAMES_BUDGET / frameSize;
+  if (numFrames > LIVE_RESULT_MAX_FRAMES) numFrames = LIVE_RESULT_MAX_FRAMES;
+  if (numFrames < LIVE_RESULT_MIN_FRAMES) numFrames = LIVE_RESULT_MIN_FRAMES;
+
+  uint64_t namesOffset = live_align8(sizeof(omc_live_result_header));
+  uint64_t stringsOffset = namesOffset + numNames * sizeof(omc_live_result_name);
+  uint64_t parametersOffset = live_align8(stringsOffset + stringsSize);
+  uint64_t framesOffset = live_align8(parametersOffset + numParameters * sizeof(double));
+  uint64_t size = framesOffset + numFrames * frameSize;
+
+  live.size = (size_t) size;
+  live.map = live_map(fileName, live.size);
+  if (!live.map) {
+    /* The live result is only an addition to the result file, so the simulation goes on without it. */
+    return;
+  }
+  live.fileName = strdup(fileName);
+  live.header = (omc_live_result_header*) live.map;
+  live.parameters = (double*) (live.map + parametersOffset);
+  live.frames = live.map + framesOffset;
+  live.frameSize = frameSize;
+
+  omc_live_result_header *header = live.header;
+  memset(header, 0, sizeof(omc_live_result_header));
+  header->version = OMC_LIVE_RESULT_VERSION;
+  header->headerSize = sizeof(omc_live_result_header);
+  header->numSignals = numSignals;
+  header->numFrames = (uint32_t) numFrames;
+  header->numParameters = numParameters;
+  header->numNames = numNames;
+  header->namesOffset = namesOffset;
+  header->stringsOffset = stringsOffset;
+  header->parametersOffset = parametersOffset;
+  header->framesOffset = framesOffset;
+  header->fileSize = size;
+  header->startTime = data->simulationInfo->startTime;
+  header->stopTime = data->simulationInfo->stopTime;
+  header->state = OMC_LIVE_RESULT_INITIALIZING;
+
+  omc_live_result_name *names = (omc_live_result_name*) (live.map + namesOffset);
+  char *strings = live.map + stringsOffset;
+  uint32_t stringPos = 0, n = 0;
+
+  auto addName = [&](const char *name, int32_t index, int32_t negate) {
+    size_t len = strlen(name) + 1;
+    memcpy(strings + stringPos, name, len);
+    names[n].nameOffset = stringPos;
+    names[n].index = index;
+    names[n].negate = negate;
+    names[n].reserved = 0;
+    stringPos += (uint32_t) len;
+    n++;
+  };
+
+  addName("time", 0, 0);
+  for (i = 0; i < modelData->nVariablesReal; i++) {
+    addName(modelData->realVarsData[i].info.name, (int32_t) (i + 1), 0);
+  }
+  for (i = 0; i < modelData->nAliasReal; i++) {
+    DATA_REAL_ALIAS *alias = &modelData->realAlias[i];
+    int32_t index = 0;
+    if (alias->aliasType == ALIAS_TYPE_VARIABLE) index = alias->nameID + 1;
+    else if (alias->aliasType == ALIAS_TYPE_PARAMETER) index = -alias->nameID - 1;
+    addName(alias->info.name, index, alias->negate);
+  }
+  for (i = 0; i < modelData->nParametersReal; i++) {
+    addName(modelData->realParameterData[i].info.name, (int32_t) (-i - 1), 0);
+  }
+
+  /* Readers check the magic, so it is written last. */
+  std::atomic_thread_fence(std::memory_order_release);
+  memcpy(header->magic, OMC_LIVE_RESULT_MAGIC, sizeof(header->magic));
+
+  live.emit = self->emit;
+  live.writeParameterData = self->writeParameterData;
+  live.free = self->free;
+  self->emit = live_emit;
+  self->writeParameterData = live_writeParameterData;
+  self->free = live_free;
+
+  infoStreamPrint(OMC_LOG_SOLVER, 0, "Publishing %u signals in %u frames to the live result file %s", numSignals, (unsigned) numFrames, fileName);
+}
+
+} // extern "C"
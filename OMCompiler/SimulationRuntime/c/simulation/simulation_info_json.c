@@ -36,6 +36,42 @@
 #include "../util/omc_numbers.h"
 #include "solver/model_help.h"
 #include "../util/omc_file.h"
+#if defined(OM_HAVE_PTHREADS)
+#include <pthread.h>
+#endif
+
+/**
+ * @brief Parsed info.json shared by all instances of the same model.
+ *
+ * The equation and function info is immutable after parsing, so all
+ * instances of a model in one process (e.g. many instances of the same FMU)
+ * reference the same arrays. The profile block indices depend on
+ * measure_time_flag, which is therefore part of the key. Entries are reference
+ * counted and freed when the last instance calls modelInfoDeinit.
+ */
+typedef struct MODEL_INFO_SHARED
+{
+  char *key;                           /* Resolved file name of the info.json */
+  int measureTimeFlag;                 /* measure_time_flag used for profileBlockIndex */
+  long nFunctions;
+  long nEquations;
+  long nProfileBlocks;
+  FUNCTION_INFO *functionNames;
+  EQUATION_INFO *equationInfo;
+  long refCount;
+  struct MODEL_INFO_SHARED *next;
+} MODEL_INFO_SHARED;
+
+static MODEL_INFO_SHARED *sharedModelInfos = NULL;
+
+#if defined(OM_HAVE_PTHREADS)
+static pthread_mutex_t sharedModelInfosMutex = PTHREAD_MUTEX_INITIALIZER;
+#define SHARED_MODEL_INFOS_LOCK() pthread_mutex_lock(&sharedModelInfosMutex)
+#define SHARED_MODEL_INFOS_UNLOCK() pthread_mutex_unlock(&sharedModelInfosMutex)
+#else
+#define SHARED_MODEL_INFOS_LOCK()
+#define SHARED_MODEL_INFOS_UNLOCK()
+#endif
 
 /**
  * @brief Skip whitespace.
@@ -490,22 +526,26 @@ static void readInfoJson(const char *str, MODEL_DATA_XML *xml)
 /**
  * @brief Initialize model data xml structure by parsing info.json.
  *
+ * If another instance of the same model already parsed the info.json its
+ * function and equation info is reused instead.
+ *
  * @param xml     Model info struct to initialize.
  */
 void modelInfoInit(MODEL_DATA_XML* xml)
 {
   // check for file exists, as --fmiFilter=blackBox or protected will not export the _info.json file
   int fileExists;
+  const char *jsonFile;
+  MODEL_INFO_SHARED *shared;
   if (omc_flag[FLAG_INPUT_PATH])
   {
-    const char *jsonFile;
     GC_asprintf(&jsonFile, "%s/%s", omc_flagValue[FLAG_INPUT_PATH], xml->fileName);
-    fileExists = omc_file_exists(jsonFile);
   }
   else
   {
-    fileExists = omc_file_exists(xml->fileName);
+    jsonFile = xml->fileName;
   }
+  fileExists = omc_file_exists(jsonFile);
 
   if (!fileExists)
   {
@@ -513,6 +553,21 @@ void modelInfoInit(MODEL_DATA_XML* xml)
     return;
   }
 
+  /* reuse the info of another instance of the same model */
+  SHARED_MODEL_INFOS_LOCK();
+  for (shared = sharedModelInfos; shared != NULL; shared = shared->next) {
+    if (shared->nFunctions == xml->nFunctions && shared->nEquations == xml->nEquations &&
+        shared->measureTimeFlag == measure_time_flag && !strcmp(shared->key, jsonFile)) {
+      shared->refCount++;
+      xml->functionNames = shared->functionNames;
+      xml->equationInfo = shared->equationInfo;
+      xml->nProfileBlocks = shared->nProfileBlocks;
+      SHARED_MODEL_INFOS_UNLOCK();
+      return;
+    }
+  }
+  SHARED_MODEL_INFOS_UNLOCK();
+
 #if !defined(OMC_NO_FILESYSTEM)
   omc_mmap_read mmap_reader = {0};
 #endif
@@ -551,16 +606,53 @@ void modelInfoInit(MODEL_DATA_XML* xml)
 #if !defined(OMC_NO_FILESYSTEM)
   omc_mmap_close_read(mmap_reader);
 #endif
+
+  shared = (MODEL_INFO_SHARED*) malloc(sizeof(MODEL_INFO_SHARED));
+  shared->key = strdup(jsonFile);
+  shared->measureTimeFlag = measure_time_flag;
+  shared->nFunctions = xml->nFunctions;
+  shared->nEquations = xml->nEquations;
+  shared->nProfileBlocks = xml->nProfileBlocks;
+  shared->functionNames = xml->functionNames;
+  shared->equationInfo = xml->equationInfo;
+  shared->refCount = 1;
+  SHARED_MODEL_INFOS_LOCK();
+  shared->next = sharedModelInfos;
+  sharedModelInfos = shared;
+  SHARED_MODEL_INFOS_UNLOCK();
 }
 
 /**
  * @brief Deinitialize memory allocated by modelInfoInit
  *
+ * The parsed info is shared between all instances of a model and only
+ * freed for the last one.
+ *
  * @param xml   Pointer to model info xml data.
  */
 void modelInfoDeinit(MODEL_DATA_XML* xml)
 {
   int i,j;
+  MODEL_INFO_SHARED **prev, *shared;
+
+  /* only the last instance frees the shared info */
+  SHARED_MODEL_INFOS_LOCK();
+  for (prev = &sharedModelInfos; *prev != NULL; prev = &(*prev)->next) {
+    shared = *prev;
+    if (xml->equationInfo != NULL && shared->equationInfo == xml->equationInfo) {
+      if (--shared->refCount > 0) {
+        xml->functionNames = NULL;
+        xml->equationInfo = NULL;
+      } else {
+        *prev = shared->next;
+        free(shared->key);
+        free(shared);
+      }
+      break;
+    }
+  }
+  SHARED_MODEL_INFOS_UNLOCK();
+
   if (xml->functionNames != NULL) {
     for (i = 0; i < xml->nFunctions; ++i) {
       free((void*) xml->functionNames[i].name);
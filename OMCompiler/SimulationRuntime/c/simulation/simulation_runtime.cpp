@@ -46,10 +46,18 @@
 #include <fstream>
 #include <stdarg.h>
 
+#include <map>
+#include <vector>
+
 #ifndef _MSC_VER
   #include <regex.h>
 #endif
 
+#if !defined(__MINGW32__) && !defined(_MSC_VER)
+  #include <sys/wait.h>
+  #include <unistd.h>
+#endif
+
 /* For CommandLineToArgvW. */
 #if defined(__MINGW32__) || defined(_MSC_VER)
 #include <windows.h>
@@ -80,6 +88,7 @@
 #include "simulation/results/simulation_result_mat4.h"
 #include "simulation/results/simulation_result_wall.h"
 #include "simulation/results/simulation_result_ia.h"
+#include "simulation/results/simulation_result_live.h"
 #include "simulation/solver/solver_main.h"
 #include "simulation/solver/gbode_util.h"
 #include "simulation_info_json.h"
@@ -95,6 +104,7 @@
 #include "simulation/solver/dae_mode.h"
 #include "dataReconciliation/dataReconciliation.h"
 #include "util/parallel_helper.h"
+#include "util/read_csv.h"
 
 #ifdef _OMC_QSS_LIB
   #include "solver_qss/solver_qss.h"
@@ -736,6 +746,11 @@ int initializeResultData(DATA* simData, threadData_t *threadData, int cpuTime)
   initializeOutputFilter(simData->modelData, simData->simulationInfo->variableFilter, resultFormatHasCheapAliasesAndParameters);
   sim_result.init(&sim_result, simData, threadData);
   infoStreamPrint(OMC_LOG_SOLVER, 0, "Allocated simulation result data storage for method '%s' and file='%s'", (char*) simData->simulationInfo->outputFormat, sim_result.filename);
+#if !defined(OMC_MINIMAL_RUNTIME)
+  if (omc_flag[FLAG_LIVE_RESULT]) {
+    live_result_attach(&sim_result, simData, threadData, omc_flagValue[FLAG_LIVE_RESULT]);
+  }
+#endif
   return 0;
 }
 
@@ -999,6 +1014,12 @@ int initRuntimeAndSimulation(int argc, char**argv, DATA *data, threadData_t *thr
             }
             break;
 
+          case FLAG_IDA_PRECOND:
+            for(j=1; j<IDA_PRECOND_MAX; ++j) {
+              infoStreamPrint(OMC_LOG_STDOUT, 0, "%-18s [%s]", IDA_PRECOND_METHOD_NAME[j], IDA_PRECOND_METHOD_DESC[j]);
+            }
+            break;
+
           case FLAG_IIM:
             for(j=1; j<IIM_MAX; ++j) {
               infoStreamPrint(OMC_LOG_STDOUT, 0, "%-18s [%s]", INIT_METHOD_NAME[j], INIT_METHOD_DESC[j]);
@@ -1329,6 +1350,185 @@ int _main_initRuntimeAndSimulation(int argc, char**argv, DATA *data, threadData_
   return 0;
 }
 
+/*! \fn setEnsembleStartValue
+ *
+ *  Sets the start value of a scalar parameter or variable for one variant of
+ *  an ensemble simulation.
+ *
+ *  \return 0 on success, 1 if there is no scalar parameter or variable with that name
+ */
+static int setEnsembleStartValue(MODEL_DATA *modelData, const char *name, double value)
+{
+  long i;
+
+  for(i=0; i<modelData->nParametersRealArray; ++i) {
+    if(0 == strcmp(name, modelData->realParameterData[i].info.name) && 1 == modelData->realParameterData[i].attribute.start.dim_size[0]) {
+      put_real_element(value, 0, &modelData->realParameterData[i].attribute.start);
+      return 0;
+    }
+  }
+  for(i=0; i<modelData->nVariablesRealArray; ++i) {
+    if(0 == strcmp(name, modelData->realVarsData[i].info.name) && 1 == modelData->realVarsData[i].attribute.start.dim_size[0]) {
+      put_real_element(value, 0, &modelData->realVarsData[i].attribute.start);
+      return 0;
+    }
+  }
+  for(i=0; i<modelData->nParametersInteger; ++i) {
+    if(0 == strcmp(name, modelData->integerParameterData[i].info.name)) {
+      modelData->integerParameterData[i].attribute.start = (modelica_integer) value;
+      return 0;
+    }
+  }
+  for(i=0; i<modelData->nVariablesInteger; ++i) {
+    if(0 == strcmp(name, modelData->integerVarsData[i].info.name)) {
+      modelData->integerVarsData[i].attribute.start = (modelica_integer) value;
+      return 0;
+    }
+  }
+  for(i=0; i<modelData->nParametersBoolean; ++i) {
+    if(0 == strcmp(name, modelData->booleanParameterData[i].info.name)) {
+      modelData->booleanParameterData[i].attribute.start = (0.0 != value);
+      return 0;
+    }
+  }
+  for(i=0; i<modelData->nVariablesBoolean; ++i) {
+    if(0 == strcmp(name, modelData->booleanVarsData[i].info.name)) {
+      modelData->booleanVarsData[i].attribute.start = (0.0 != value);
+      return 0;
+    }
+  }
+  return 1;
+}
+
+/*! \fn runEnsemble
+ *
+ *  Simulates all variants of the csv file given by -ensemble. The init file
+ *  has already been read and the data structure is set up; every variant is
+ *  simulated in a forked worker process which only changes the start values
+ *  and the result file. At most -ensembleThreads workers run at the same time.
+ *
+ *  \param [out] [isWorker] set to 1 in the worker processes, which return the
+ *                          result of their simulation and exit afterwards
+ *  \return 0 if all variants were simulated successfully
+ */
+static int runEnsemble(int argc, char**argv, DATA *data, threadData_t *threadData, int *isWorker)
+{
+  *isWorker = 0;
+#if defined(__MINGW32__) || defined(_MSC_VER)
+  errorStreamPrint(OMC_LOG_STDOUT, 0, "Flag -ensemble is not supported on this platform.");
+  return 1;
+#else
+  struct csv_data *variants = read_csv(omc_flagValue[FLAG_ENSEMBLE]);
+  int numWorkers = omc_flag[FLAG_ENSEMBLE_THREADS] ? atoi(omc_flagValue[FLAG_ENSEMBLE_THREADS]) : (int) sysconf(_SC_NPROCESSORS_ONLN);
+  int i, j, next = 0, failed = 0;
+
+  if(!variants || variants->numsteps < 1) {
+    errorStreamPrint(OMC_LOG_STDOUT, 0, "Could not read any variant from ensemble file %s.", omc_flagValue[FLAG_ENSEMBLE]);
+    return 1;
+  }
+  for(j=0; j<variants->numvars; ++j) {
+    if(setEnsembleStartValue(data->modelData, variants->variables[j], variants->data[j*variants->numsteps])) {
+      errorStreamPrint(OMC_LOG_STDOUT, 0, "Ensemble file %s: %s is not a scalar parameter or variable of the model.", omc_flagValue[FLAG_ENSEMBLE], variants->variables[j]);
+      omc_free_csv_reader(variants);
+      return 1;
+    }
+  }
+  if(numWorkers < 1) {
+    numWorkers = 1;
+  }
+
+  /* every variant writes <result>_<variant>.<format> */
+  string outputPath = omc_flag[FLAG_OUTPUT_PATH] ? string(omc_flagValue[FLAG_OUTPUT_PATH]) + "/" : "";
+  string resultFile = omc_flagValue[FLAG_R] ? string(omc_flagValue[FLAG_R]) :
+    outputPath + data->modelData->modelFilePrefix + "_res." + data->simulationInfo->outputFormat;
+  size_t extPos = resultFile.rfind('.');
+  string resultBase = resultFile.substr(0, extPos);
+  string resultExt = extPos == string::npos ? "" : resultFile.substr(extPos);
+  std::vector<string> resultFiles(variants->numsteps);
+  std::vector<int> status(variants->numsteps, -1);
+  std::map<pid_t, int> running;
+
+  infoStreamPrint(OMC_LOG_STDOUT, 0, "Simulating %d variants of ensemble %s with %d workers.", variants->numsteps, omc_flagValue[FLAG_ENSEMBLE], numWorkers);
+  fflush(NULL);
+
+  while(next < variants->numsteps || !running.empty())
+  {
+    if(next < variants->numsteps && (int) running.size() < numWorkers) {
+      std::stringstream ss;
+      ss << resultBase << "_" << (next+1) << resultExt;
+      resultFiles[next] = ss.str();
+
+      pid_t pid = fork();
+      if(0 == pid) {
+        /* worker: simulate one variant */
+        *isWorker = 1;
+        for(j=0; j<variants->numvars; ++j) {
+          setEnsembleStartValue(data->modelData, variants->variables[j], variants->data[j*variants->numsteps+next]);
+        }
+        omc_flag[FLAG_R] = 1;
+        omc_flagValue[FLAG_R] = GC_strdup(resultFiles[next].c_str());
+        omc_free_csv_reader(variants);
+        return startNonInteractiveSimulation(argc, argv, data, threadData);
+      } else if(pid < 0) {
+        errorStreamPrint(OMC_LOG_STDOUT, 0, "Could not start a worker for ensemble variant %d: %s", next+1, strerror(errno));
+        status[next++] = 1;
+        failed++;
+        if(running.empty()) {
+          continue;
+        }
+      } else {
+        running[pid] = next++;
+        continue;
+      }
+    }
+
+    int wstatus;
+    pid_t pid = waitpid(-1, &wstatus, 0);
+    if(pid < 0) {
+      if(EINTR == errno) {
+        continue;
+      }
+      errorStreamPrint(OMC_LOG_STDOUT, 0, "Waiting for ensemble workers failed: %s", strerror(errno));
+      break;
+    }
+    std::map<pid_t, int>::iterator it = running.find(pid);
+    if(it == running.end()) {
+      continue;
+    }
+    i = it->second;
+    running.erase(it);
+    status[i] = WIFEXITED(wstatus) ? WEXITSTATUS(wstatus) : 1;
+    if(status[i]) {
+      failed++;
+      warningStreamPrint(OMC_LOG_STDOUT, 0, "Ensemble variant %d failed.", i+1);
+    } else {
+      infoStreamPrint(OMC_LOG_SIMULATION, 0, "Ensemble variant %d finished, result file %s.", i+1, resultFiles[i].c_str());
+    }
+  }
+
+  /* index of all variants: variant, status, result file and the varied start values */
+  string indexFile = outputPath + data->modelData->modelFilePrefix + "_ensemble.csv";
+  std::ofstream index(indexFile.c_str());
+  index << "\"variant\",\"status\",\"resultFile\"";
+  for(j=0; j<variants->numvars; ++j) {
+    index << ",\"" << variants->variables[j] << "\"";
+  }
+  index << "\n" << std::setprecision(17);
+  for(i=0; i<variants->numsteps; ++i) {
+    index << (i+1) << "," << status[i] << ",\"" << resultFiles[i] << "\"";
+    for(j=0; j<variants->numvars; ++j) {
+      index << "," << variants->data[j*variants->numsteps+i];
+    }
+    index << "\n";
+  }
+  index.close();
+
+  infoStreamPrint(OMC_LOG_STDOUT, 0, "Ensemble finished: %d of %d variants succeeded, index written to %s.", variants->numsteps - failed, variants->numsteps, indexFile.c_str());
+  omc_free_csv_reader(variants);
+  return failed ? 1 : 0;
+#endif
+}
+
 /* \brief main function for simulator
  *
  * The arguments for the main function are:
@@ -1341,6 +1541,7 @@ int _main_initRuntimeAndSimulation(int argc, char**argv, DATA *data, threadData_
 int _main_SimulationRuntime(int argc, char**argv, DATA *data, threadData_t *threadData)
 {
   int retVal = -1;
+  int isEnsembleWorker = 0;
   MMC_TRY_INTERNAL(globalJumpBuffer)
 
   /* sighandler_t oldhandler = different type on all platforms... */
@@ -1349,13 +1550,20 @@ int _main_SimulationRuntime(int argc, char**argv, DATA *data, threadData_t *thre
   signal(SIGUSR1, SimulationRuntime_printStatus);
 #endif
 
-  retVal = startNonInteractiveSimulation(argc, argv, data, threadData);
+  if(omc_flag[FLAG_ENSEMBLE]) {
+    retVal = runEnsemble(argc, argv, data, threadData, &isEnsembleWorker);
+  } else {
+    retVal = startNonInteractiveSimulation(argc, argv, data, threadData);
+  }
 
   freeMixedSystems(data, threadData);        /* free mixed system data */
   freeLinearSystems(data, threadData);       /* free linear system data */
   freeNonlinearSystems(data, threadData);    /* free nonlinear system data */
 
-  data->callback->callExternalObjectDestructors(data, threadData);
+  /* the external objects of an ensemble are only constructed in the workers */
+  if(!omc_flag[FLAG_ENSEMBLE] || isEnsembleWorker) {
+    data->callback->callExternalObjectDestructors(data, threadData);
+  }
   deInitializeDataStruc(data);
   fflush(NULL);
   MMC_CATCH_INTERNAL(globalJumpBuffer)
@@ -0,0 +1,545 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF THE BSD NEW LICENSE OR THE
+ * GPL VERSION 3 LICENSE OR THE OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the OSMC (Open Source Modelica Consortium)
+ * Public License (OSMC-PL) are obtained from OSMC, either from the above
+ * address, from the URLs: http://www.openmodelica.org or
+ * http://www.ida.liu.se/projects/OpenModelica, and in the OpenModelica
+ * distribution. GNU version 3 is obtained from:
+ * http://www.gnu.org/copyleft/gpl.html. The New BSD License is obtained from:
+ * http://www.opensource.org/licenses/BSD-3-Clause.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE, EXCEPT AS
+ * EXPRESSLY SET FORTH IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE
+ * CONDITIONS OF OSMC-PL.
+ *
+ */
+
+/*! \file checkpoint.c
+ *
+ * A checkpoint contains everything needed to continue a simulation without
+ * running the initialization again: the current values of all variables,
+ * their pre-values, the parameters, the event handling data (zero-crossings,
+ * relations, samples), the clock partitions and the buffers of delay and
+ * spatialDistribution operators.
+ *
+ * The integrator itself is not part of a checkpoint. A restarted simulation
+ * continues like after an event, i.e. the integrator is re-initialized at the
+ * time of the checkpoint.
+ *
+ * The data is stored in the binary representation of the machine writing the
+ * checkpoint. The header contains the model GUID, the sizes of the model and a
+ * layout signature (byte order and size of the stored types), a checkpoint is
+ * only restored by the same executable on the same kind of machine.
+ */
+
+#include "checkpoint.h"
+#include "delay.h"
+#include "model_help.h"
+#include "spatialDistribution.h"
+#include "stateset.h"
+#include "synchronous.h"
+#include "initialization/initialization.h"
+#include "linearSystem.h"
+#include "nonlinearSystem.h"
+#include "../options.h"
+#include "../../openmodelica_func.h"
+#include "../../meta/meta_modelica.h"
+#include "../../util/omc_error.h"
+#include "../../util/omc_file.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#define CHECKPOINT_MAGIC "OMCCHKPT"
+#define CHECKPOINT_VERSION 2
+#define CHECKPOINT_NSIZES 15
+#define CHECKPOINT_NLAYOUT 11
+
+static void getCheckpointSizes(DATA *data, long *sizes)
+{
+  MODEL_DATA *mData = data->modelData;
+
+  sizes[0] = mData->nVariablesReal;
+  sizes[1] = mData->nVariablesInteger;
+  sizes[2] = mData->nVariablesBoolean;
+  sizes[3] = mData->nVariablesString;
+  sizes[4] = mData->nParametersReal;
+  sizes[5] = mData->nParametersInteger;
+  sizes[6] = mData->nParametersBoolean;
+  sizes[7] = mData->nParametersString;
+  sizes[8] = mData->nZeroCrossings;
+  sizes[9] = mData->nRelations;
+  sizes[10] = mData->nMathEvents;
+  sizes[11] = mData->nSamples;
+  sizes[12] = mData->nDelayExpressions;
+  sizes[13] = mData->nSpatialDistributions;
+  sizes[14] = mData->nBaseClocks;
+}
+
+/* byte order and size of everything written in binary form */
+static void getCheckpointLayout(int *layout)
+{
+  layout[0] = 0x01020304;
+  layout[1] = (int) sizeof(int);
+  layout[2] = (int) sizeof(long);
+  layout[3] = (int) sizeof(size_t);
+  layout[4] = (int) sizeof(double);
+  layout[5] = (int) sizeof(modelica_real);
+  layout[6] = (int) sizeof(modelica_integer);
+  layout[7] = (int) sizeof(modelica_boolean);
+  layout[8] = (int) sizeof(TIME_AND_VALUE);
+  layout[9] = (int) sizeof(SYNC_TIMER);
+  layout[10] = (int) sizeof(CLOCK_STATS);
+}
+
+/*! \fn checkpointCheckLength
+ *
+ *  Checks a length read from a checkpoint before it is used to allocate or
+ *  read len items of itemSize bytes: the rest of the file has to hold them.
+ *
+ *  \return 0 if the length is valid, 1 otherwise
+ */
+int checkpointCheckLength(FILE *file, size_t len, size_t itemSize)
+{
+  long pos = ftell(file);
+  long end;
+
+  if (pos < 0 || fseek(file, 0, SEEK_END)) {
+    return 1;
+  }
+  end = ftell(file);
+  if (fseek(file, pos, SEEK_SET) || end < pos) {
+    return 1;
+  }
+  return len > (size_t) (end - pos) / itemSize;
+}
+
+static int writeString(FILE *file, const char *str)
+{
+  size_t len = strlen(str);
+
+  return checkpointWrite(file, &len, sizeof(size_t), 1) ||
+         checkpointWrite(file, str, sizeof(char), len);
+}
+
+/*! \fn readString
+ *
+ *  Reads a string written by writeString. The returned string is allocated
+ *  with malloc and has to be freed by the caller.
+ */
+static char* readString(FILE *file)
+{
+  size_t len;
+  char *str;
+
+  if (checkpointRead(file, &len, sizeof(size_t), 1) ||
+      checkpointCheckLength(file, len, sizeof(char))) {
+    return NULL;
+  }
+  str = (char*) malloc(len + 1);
+  if (!str || checkpointRead(file, str, sizeof(char), len)) {
+    free(str);
+    return NULL;
+  }
+  str[len] = '\0';
+  return str;
+}
+
+static int writeStrings(FILE *file, modelica_string *strings, long n)
+{
+  long i;
+
+  for (i = 0; i < n; i++) {
+    if (writeString(file, MMC_STRINGDATA(strings[i]))) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static int readStrings(FILE *file, modelica_string *strings, long n)
+{
+  long i;
+  char *str;
+
+  for (i = 0; i < n; i++) {
+    str = readString(file);
+    if (!str) {
+      return 1;
+    }
+    strings[i] = mmc_mk_scon_persist(str);
+    free(str);
+  }
+  return 0;
+}
+
+static int writeCheckpointData(DATA *data, FILE *file)
+{
+  MODEL_DATA *mData = data->modelData;
+  SIMULATION_INFO *simInfo = data->simulationInfo;
+  SIMULATION_DATA *sData = data->localData[0];
+  long sizes[CHECKPOINT_NSIZES];
+  int layout[CHECKPOINT_NLAYOUT];
+  int version = CHECKPOINT_VERSION;
+
+  getCheckpointSizes(data, sizes);
+  getCheckpointLayout(layout);
+
+  /* header */
+  if (checkpointWrite(file, CHECKPOINT_MAGIC, sizeof(char), strlen(CHECKPOINT_MAGIC)) ||
+      checkpointWrite(file, &version, sizeof(int), 1) ||
+      checkpointWrite(file, layout, sizeof(int), CHECKPOINT_NLAYOUT) ||
+      writeString(file, mData->modelGUID) ||
+      checkpointWrite(file, sizes, sizeof(long), CHECKPOINT_NSIZES) ||
+      checkpointWrite(file, &sData->timeValue, sizeof(modelica_real), 1)) {
+    return 1;
+  }
+
+  /* variables, pre-values and parameters */
+  if (checkpointWrite(file, sData->realVars, sizeof(modelica_real), mData->nVariablesReal) ||
+      checkpointWrite(file, sData->integerVars, sizeof(modelica_integer), mData->nVariablesInteger) ||
+      checkpointWrite(file, sData->booleanVars, sizeof(modelica_boolean), mData->nVariablesBoolean) ||
+      writeStrings(file, sData->stringVars, mData->nVariablesString) ||
+      checkpointWrite(file, simInfo->realVarsPre, sizeof(modelica_real), mData->nVariablesReal) ||
+      checkpointWrite(file, simInfo->integerVarsPre, sizeof(modelica_integer), mData->nVariablesInteger) ||
+      checkpointWrite(file, simInfo->booleanVarsPre, sizeof(modelica_boolean), mData->nVariablesBoolean) ||
+      writeStrings(file, simInfo->stringVarsPre, mData->nVariablesString) ||
+      checkpointWrite(file, simInfo->realParameter, sizeof(modelica_real), mData->nParametersReal) ||
+      checkpointWrite(file, simInfo->integerParameter, sizeof(modelica_integer), mData->nParametersInteger) ||
+      checkpointWrite(file, simInfo->booleanParameter, sizeof(modelica_boolean), mData->nParametersBoolean) ||
+      writeStrings(file, simInfo->stringParameter, mData->nParametersString)) {
+    return 1;
+  }
+
+  /* event handling */
+  if (checkpointWrite(file, simInfo->zeroCrossings, sizeof(modelica_real), mData->nZeroCrossings) ||
+      checkpointWrite(file, simInfo->zeroCrossingsPre, sizeof(modelica_real), mData->nZeroCrossings) ||
+      checkpointWrite(file, simInfo->relations, sizeof(modelica_boolean), mData->nRelations) ||
+      checkpointWrite(file, simInfo->relationsPre, sizeof(modelica_boolean), mData->nRelations) ||
+      checkpointWrite(file, simInfo->storedRelations, sizeof(modelica_boolean), mData->nRelations) ||
+      checkpointWrite(file, simInfo->mathEventsValuePre, sizeof(modelica_real), mData->nMathEvents) ||
+      checkpointWrite(file, &simInfo->nextSampleEvent, sizeof(double), 1) ||
+      checkpointWrite(file, simInfo->nextSampleTimes, sizeof(double), mData->nSamples) ||
+      checkpointWrite(file, simInfo->samples, sizeof(modelica_boolean), mData->nSamples) ||
+      checkpointWrite(file, &simInfo->solverSteps, sizeof(double), 1)) {
+    return 1;
+  }
+
+  /* operators with memory */
+  return writeSynchronousCheckpoint(data, file) ||
+         writeDelayCheckpoint(data, file) ||
+         writeSpatialDistributionCheckpoint(data, file);
+}
+
+/*! \fn writeCheckpoint
+ *
+ *  Writes the current state of the simulation to fileName. The checkpoint is
+ *  written to a temporary file first and renamed afterwards, so a process
+ *  that is killed while writing never leaves a corrupted checkpoint behind.
+ *
+ *  \param [in]  [data]
+ *  \param [in]  [fileName]
+ *  \return 0 on success, 1 otherwise
+ */
+int writeCheckpoint(DATA *data, threadData_t *threadData, const char *fileName)
+{
+  size_t len = strlen(fileName);
+  char *tmpFileName = (char*) malloc(len + 5);
+  FILE *file;
+  int failed;
+
+  memcpy(tmpFileName, fileName, len);
+  memcpy(tmpFileName + len, ".tmp", 5);
+
+  file = omc_fopen(tmpFileName, "wb");
+  if (!file) {
+    warningStreamPrint(OMC_LOG_STDOUT, 0, "Could not open checkpoint file %s: %s", tmpFileName, strerror(errno));
+    free(tmpFileName);
+    return 1;
+  }
+
+  failed = writeCheckpointData(data, file);
+  failed = fclose(file) || failed;
+
+  /* replaces an existing checkpoint atomically (MoveFileEx on Windows) */
+  if (!failed) {
+    failed = omc_rename(tmpFileName, fileName);
+  }
+
+  if (failed) {
+    warningStreamPrint(OMC_LOG_STDOUT, 0, "Could not write checkpoint file %s: %s", fileName, strerror(errno));
+    omc_unlink(tmpFileName);
+  }
+
+  free(tmpFileName);
+  return failed;
+}
+
+static int readCheckpointHeader(DATA *data, FILE *file, const char *fileName, modelica_real *time)
+{
+  char magic[sizeof(CHECKPOINT_MAGIC)] = {0};
+  long sizes[CHECKPOINT_NSIZES], expectedSizes[CHECKPOINT_NSIZES];
+  int layout[CHECKPOINT_NLAYOUT], expectedLayout[CHECKPOINT_NLAYOUT];
+  int version, i;
+  char *guid;
+
+  if (checkpointRead(file, magic, sizeof(char), strlen(CHECKPOINT_MAGIC)) ||
+      strcmp(magic, CHECKPOINT_MAGIC)) {
+    errorStreamPrint(OMC_LOG_STDOUT, 0, "%s is not a checkpoint file.", fileName);
+    return 1;
+  }
+
+  if (checkpointRead(file, &version, sizeof(int), 1) || version != CHECKPOINT_VERSION) {
+    errorStreamPrint(OMC_LOG_STDOUT, 0, "Checkpoint file %s has an unsupported version.", fileName);
+    return 1;
+  }
+
+  /* byte order and type sizes of the writing machine */
+  getCheckpointLayout(expectedLayout);
+  if (checkpointRead(file, layout, sizeof(int), CHECKPOINT_NLAYOUT) ||
+      memcmp(layout, expectedLayout, sizeof(layout))) {
+    errorStreamPrint(OMC_LOG_STDOUT, 0, "Checkpoint file %s was written on a machine with a different data layout.", fileName);
+    return 1;
+  }
+
+  guid = readString(file);
+  if (!guid || strcmp(guid, data->modelData->modelGUID)) {
+    errorStreamPrint(OMC_LOG_STDOUT, 0, "Checkpoint file %s was written by a different model (GUID %s, expected %s).", fileName, guid ? guid : "", data->modelData->modelGUID);
+    free(guid);
+    return 1;
+  }
+  free(guid);
+
+  getCheckpointSizes(data, expectedSizes);
+  if (checkpointRead(file, sizes, sizeof(long), CHECKPOINT_NSIZES)) {
+    errorStreamPrint(OMC_LOG_STDOUT, 0, "Checkpoint file %s is truncated.", fileName);
+    return 1;
+  }
+  for (i = 0; i < CHECKPOINT_NSIZES; i++) {
+    if (sizes[i] != expectedSizes[i]) {
+      errorStreamPrint(OMC_LOG_STDOUT, 0, "Checkpoint file %s does not match the model structure.", fileName);
+      return 1;
+    }
+  }
+
+  return checkpointRead(file, time, sizeof(modelica_real), 1);
+}
+
+static int readCheckpointData(DATA *data, FILE *file)
+{
+  MODEL_DATA *mData = data->modelData;
+  SIMULATION_INFO *simInfo = data->simulationInfo;
+  SIMULATION_DATA *sData = data->localData[0];
+
+  if (checkpointRead(file, sData->realVars, sizeof(modelica_real), mData->nVariablesReal) ||
+      checkpointRead(file, sData->integerVars, sizeof(modelica_integer), mData->nVariablesInteger) ||
+      checkpointRead(file, sData->booleanVars, sizeof(modelica_boolean), mData->nVariablesBoolean) ||
+      readStrings(file, sData->stringVars, mData->nVariablesString) ||
+      checkpointRead(file, simInfo->realVarsPre, sizeof(modelica_real), mData->nVariablesReal) ||
+      checkpointRead(file, simInfo->integerVarsPre, sizeof(modelica_integer), mData->nVariablesInteger) ||
+      checkpointRead(file, simInfo->booleanVarsPre, sizeof(modelica_boolean), mData->nVariablesBoolean) ||
+      readStrings(file, simInfo->stringVarsPre, mData->nVariablesString) ||
+      checkpointRead(file, simInfo->realParameter, sizeof(modelica_real), mData->nParametersReal) ||
+      checkpointRead(file, simInfo->integerParameter, sizeof(modelica_integer), mData->nParametersInteger) ||
+      checkpointRead(file, simInfo->booleanParameter, sizeof(modelica_boolean), mData->nParametersBoolean) ||
+      readStrings(file, simInfo->stringParameter, mData->nParametersString)) {
+    return 1;
+  }
+
+  if (checkpointRead(file, simInfo->zeroCrossings, sizeof(modelica_real), mData->nZeroCrossings) ||
+      checkpointRead(file, simInfo->zeroCrossingsPre, sizeof(modelica_real), mData->nZeroCrossings) ||
+      checkpointRead(file, simInfo->relations, sizeof(modelica_boolean), mData->nRelations) ||
+      checkpointRead(file, simInfo->relationsPre, sizeof(modelica_boolean), mData->nRelations) ||
+      checkpointRead(file, simInfo->storedRelations, sizeof(modelica_boolean), mData->nRelations) ||
+      checkpointRead(file, simInfo->mathEventsValuePre, sizeof(modelica_real), mData->nMathEvents) ||
+      checkpointRead(file, &simInfo->nextSampleEvent, sizeof(double), 1) ||
+      checkpointRead(file, simInfo->nextSampleTimes, sizeof(double), mData->nSamples) ||
+      checkpointRead(file, simInfo->samples, sizeof(modelica_boolean), mData->nSamples) ||
+      checkpointRead(file, &simInfo->solverSteps, sizeof(double), 1)) {
+    return 1;
+  }
+  /* checkpoints are written between steps, so no sample-call is active */
+  initSampleTimers(data);
+
+  return readSynchronousCheckpoint(data, file) ||
+         readDelayCheckpoint(data, file) ||
+         readSpatialDistributionCheckpoint(data, file);
+}
+
+/*! \fn restoreCheckpoint
+ *
+ *  Replaces the initialization of the model by the state stored in a
+ *  checkpoint. Everything that initialization() sets up apart from solving the
+ *  initial system (bound parameters, samples, clocks, ...) is done here as
+ *  well, afterwards the stored values are read. External objects that are not
+ *  constructed from parameters are constructed by evaluating the initial
+ *  system once before the checkpoint is read.
+ *
+ *  Finally the state derived from the variables is rebuilt like at the end of
+ *  initialization(): discrete system, zero-crossings, dynamic state
+ *  selection, delay buffers and relations.
+ *
+ *  \param [ref] [data]
+ *  \param [in]  [fileName]
+ *  \return 0 on success, 1 otherwise
+ */
+int restoreCheckpoint(DATA *data, threadData_t *threadData, const char *fileName)
+{
+  SIMULATION_INFO *simInfo = data->simulationInfo;
+  modelica_real time;
+  FILE *file;
+  int failed, i;
+
+  infoStreamPrint(OMC_LOG_INIT, 0, "### RESTORE CHECKPOINT %s ###", fileName);
+
+  file = omc_fopen(fileName, "rb");
+  if (!file) {
+    errorStreamPrint(OMC_LOG_STDOUT, 0, "Could not open checkpoint file %s: %s", fileName, strerror(errno));
+    return 1;
+  }
+  if (readCheckpointHeader(data, file, fileName, &time)) {
+    fclose(file);
+    return 1;
+  }
+
+  setAllParamsToStart(data);
+  setAllVarsToStart(data);
+  data->callback->updateBoundParameters(data, threadData);
+  data->callback->updateBoundVariableAttributes(data, threadData);
+  data->callback->function_initSpatialDistribution(data, threadData);
+  updateStaticDataOfLinearSystems(data, threadData);
+  updateStaticDataOfNonlinearSystems(data, threadData);
+
+  /* external objects depending on variables are constructed in the initial
+   * system, the variables it computes are replaced by the checkpoint */
+  for (i = 0; i < data->modelData->nExtObjs; i++) {
+    if (simInfo->extObjs[i] == NULL) {
+      break;
+    }
+  }
+  if (i < data->modelData->nExtObjs) {
+    infoStreamPrint(OMC_LOG_INIT, 0, "evaluating the initial system to construct external objects");
+    simInfo->initial = 1;
+    data->callback->functionInitialEquations(data, threadData);
+    simInfo->initial = 0;
+    for (i = 0; i < data->modelData->nExtObjs; i++) {
+      if (simInfo->extObjs[i] == NULL) {
+        warningStreamPrint(OMC_LOG_STDOUT, 0, "External object %i is NULL, did a external constructor fail?", i);
+      }
+    }
+  }
+
+  initSample(data, threadData, simInfo->startTime, simInfo->stopTime);
+  initSynchronous(data, threadData, simInfo->startTime);
+
+  failed = readCheckpointData(data, file);
+  fclose(file);
+  if (failed) {
+    errorStreamPrint(OMC_LOG_STDOUT, 0, "Checkpoint file %s is truncated or corrupted.", fileName);
+    return 1;
+  }
+
+  data->localData[0]->timeValue = time;
+  simInfo->initial = 0;
+  overwriteOldSimulationData(data);
+
+  /* checkpoints are written between steps, the event iteration only
+   * re-evaluates the discrete system and does not change any variable */
+  updateDiscreteSystem(data, threadData);
+  saveZeroCrossings(data, threadData);
+
+#if !defined(OMC_NO_STATESELECTION)
+  if (stateSelection(data, threadData, 0, 1) == 1) {
+    if (stateSelection(data, threadData, 1, 1) == 1) {
+      warningStreamPrint(OMC_LOG_STDOUT, 0, "Cannot restore the dynamic state selection in an unique way. Use -lv LOG_DSS to see the switching state set.");
+    }
+  }
+#endif
+
+  /* the buffers already end with the values at the checkpoint time, storing
+   * them again only drops values that are no longer needed */
+  data->callback->function_storeDelayed(data, threadData);
+  data->callback->function_storeSpatialDistribution(data, threadData);
+  data->callback->function_updateRelations(data, threadData, 1);
+
+  overwriteOldSimulationData(data);
+  storeOldValues(data);
+
+  infoStreamPrint(OMC_LOG_SUCCESS, 0, "The simulation was restored from checkpoint %s at time %g.", fileName, time);
+  return 0;
+}
+
+/*! \fn restartStepNo
+ *
+ *  Returns the number of the first output point of the regular grid after the
+ *  time of a restored checkpoint, 0 if the simulation was not restarted.
+ */
+unsigned int restartStepNo(DATA *data)
+{
+  SIMULATION_INFO *simInfo = data->simulationInfo;
+  unsigned int stepNo = 0;
+
+  if (!omc_flag[FLAG_RESTART]) {
+    return 0;
+  }
+  while (stepNo < simInfo->numSteps &&
+         (double)(stepNo*(simInfo->stopTime-simInfo->startTime))/(simInfo->numSteps) + simInfo->startTime < data->localData[0]->timeValue) {
+    stepNo++;
+  }
+  return stepNo;
+}
+
+/*! \fn initCheckpoint
+ *
+ *  Reads the checkpoint flags. Checkpoints are only written if -checkpoint
+ *  is given.
+ */
+void initCheckpoint(CHECKPOINT_DATA *checkpoint)
+{
+  checkpoint->fileName = omc_flag[FLAG_CHECKPOINT] ? omc_flagValue[FLAG_CHECKPOINT] : NULL;
+  checkpoint->interval = 600;
+  checkpoint->nWritten = 0;
+
+  if (omc_flag[FLAG_CHECKPOINT_INTERVAL]) {
+    checkpoint->interval = atof(omc_flagValue[FLAG_CHECKPOINT_INTERVAL]);
+    if (checkpoint->interval < 0) {
+      warningStreamPrint(OMC_LOG_STDOUT, 0, "Invalid value %s for -checkpointInterval, using 600 seconds.", omc_flagValue[FLAG_CHECKPOINT_INTERVAL]);
+      checkpoint->interval = 600;
+    }
+  }
+
+  rt_ext_tp_tick(&checkpoint->lastWrite);
+}
+
+/*! \fn updateCheckpoint
+ *
+ *  Writes a new checkpoint if the checkpoint interval (wall-clock time) has
+ *  passed since the last one. Must only be called after a successful step.
+ */
+void updateCheckpoint(DATA *data, threadData_t *threadData, CHECKPOINT_DATA *checkpoint)
+{
+  if (!checkpoint->fileName || rt_ext_tp_tock(&checkpoint->lastWrite) < checkpoint->interval) {
+    return;
+  }
+
+  if (!writeCheckpoint(data, threadData, checkpoint->fileName)) {
+    checkpoint->nWritten++;
+    infoStreamPrint(OMC_LOG_SOLVER, 0, "wrote checkpoint %u to %s at time %g", checkpoint->nWritten, checkpoint->fileName, data->localData[0]->timeValue);
+  }
+  rt_ext_tp_tick(&checkpoint->lastWrite);
+}
@@ -0,0 +1,81 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF THE BSD NEW LICENSE OR THE
+ * GPL VERSION 3 LICENSE OR THE OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the OSMC (Open Source Modelica Consortium)
+ * Public License (OSMC-PL) are obtained from OSMC, either from the above
+ * address, from the URLs: http://www.openmodelica.org or
+ * http://www.ida.liu.se/projects/OpenModelica, and in the OpenModelica
+ * distribution. GNU version 3 is obtained from:
+ * http://www.gnu.org/copyleft/gpl.html. The New BSD License is obtained from:
+ * http://www.opensource.org/licenses/BSD-3-Clause.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE, EXCEPT AS
+ * EXPRESSLY SET FORTH IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE
+ * CONDITIONS OF OSMC-PL.
+ *
+ */
+
+/*! \file checkpoint.h
+ *
+ * Writing and reading checkpoints of a running simulation, used to resume a
+ * simulation with -restart=<file> without re-initialization.
+ */
+
+#ifndef OMC_CHECKPOINT_H
+#define OMC_CHECKPOINT_H
+
+#include <stdio.h>
+
+#include "../../simulation_data.h"
+#include "../../util/rtclock.h"
+
+#ifdef __cplusplus
+  extern "C" {
+#endif
+
+typedef struct CHECKPOINT_DATA {
+  const char *fileName;     /* checkpoint file, NULL if checkpoints are disabled */
+  double interval;          /* wall-clock time in seconds between two checkpoints */
+  rtclock_t lastWrite;      /* time of the last written checkpoint */
+  unsigned int nWritten;    /* number of checkpoints written so far */
+} CHECKPOINT_DATA;
+
+void initCheckpoint(CHECKPOINT_DATA *checkpoint);
+void updateCheckpoint(DATA *data, threadData_t *threadData, CHECKPOINT_DATA *checkpoint);
+
+int writeCheckpoint(DATA *data, threadData_t *threadData, const char *fileName);
+int restoreCheckpoint(DATA *data, threadData_t *threadData, const char *fileName);
+unsigned int restartStepNo(DATA *data);
+
+/* Helpers for the modules that store their own state in a checkpoint.
+ * Both return 0 on success and 1 on failure. */
+static inline int checkpointWrite(FILE *file, const void *ptr, size_t size, size_t n)
+{
+  return n != 0 && fwrite(ptr, size, n, file) != n;
+}
+
+static inline int checkpointRead(FILE *file, void *ptr, size_t size, size_t n)
+{
+  return n != 0 && fread(ptr, size, n, file) != n;
+}
+
+int checkpointCheckLength(FILE *file, size_t len, size_t itemSize);
+
+#ifdef __cplusplus
+  }
+#endif
+
+#endif
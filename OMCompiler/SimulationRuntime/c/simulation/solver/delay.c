@@ -34,6 +34,7 @@
  */
 
 #include "delay.h"
+#include "checkpoint.h"
 #include "epsilon.h"
 #include "../../util/omc_error.h"
 #include "../../util/ringbuffer.h"
@@ -327,6 +328,63 @@ double delayZeroCrossing(DATA* data, threadData_t *threadData, unsigned int expr
 }
 
 
+/**
+ * @brief Write all delay buffers to a checkpoint file.
+ *
+ * @param data        Data containing the delay buffers.
+ * @param file        Checkpoint file opened for binary writing.
+ * @return int        0 on success, 1 on failure.
+ */
+int writeDelayCheckpoint(DATA* data, FILE* file)
+{
+  int i, j, len;
+  RINGBUFFER* delayStruct;
+
+  for (i = 0; i < data->modelData->nDelayExpressions; i++) {
+    delayStruct = data->simulationInfo->delayStructure[i];
+    len = ringBufferLength(delayStruct);
+    if (checkpointWrite(file, &len, sizeof(int), 1)) {
+      return 1;
+    }
+    for (j = 0; j < len; j++) {
+      if (checkpointWrite(file, getRingData(delayStruct, j), sizeof(TIME_AND_VALUE), 1)) {
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Replace all delay buffers with the content of a checkpoint file.
+ *
+ * @param data        Data containing the delay buffers.
+ * @param file        Checkpoint file opened for binary reading.
+ * @return int        0 on success, 1 on failure.
+ */
+int readDelayCheckpoint(DATA* data, FILE* file)
+{
+  int i, j, len;
+  RINGBUFFER* delayStruct;
+  TIME_AND_VALUE tpl;
+
+  for (i = 0; i < data->modelData->nDelayExpressions; i++) {
+    delayStruct = data->simulationInfo->delayStructure[i];
+    removeLastRingData(delayStruct, ringBufferLength(delayStruct));
+    if (checkpointRead(file, &len, sizeof(int), 1) || len < 0 ||
+        checkpointCheckLength(file, (size_t) len, sizeof(TIME_AND_VALUE))) {
+      return 1;
+    }
+    for (j = 0; j < len; j++) {
+      if (checkpointRead(file, &tpl, sizeof(TIME_AND_VALUE), 1)) {
+        return 1;
+      }
+      appendRingData(delayStruct, &tpl);
+    }
+  }
+  return 0;
+}
+
 /**
  * @brief Print transported quantity data to stream.
  *
@@ -34,6 +34,8 @@
 #ifndef _DELAY_H_
 #define _DELAY_H_
 
+#include <stdio.h>
+
 #include "../../simulation_data.h"
 
 typedef struct TIME_AND_VALUE
@@ -50,6 +52,9 @@ double delayImpl(DATA* data, threadData_t *threadData, int exprNumber, double ex
 void storeDelayedExpression(DATA* data, threadData_t *threadData, int exprNumber, double exprValue, double delayTime, double delayMax);
 double delayZeroCrossing(DATA* data, threadData_t *threadData, unsigned int exprNumber, unsigned int relationIndex, double delayTime);
 
+int writeDelayCheckpoint(DATA* data, FILE* file);
+int readDelayCheckpoint(DATA* data, FILE* file);
+
 #ifdef __cplusplus
 }
 #endif
@@ -154,7 +154,6 @@ int checkEvents(DATA* data, threadData_t *threadData, LIST* eventLst, modelica_b
 void handleEvents(DATA* data, threadData_t *threadData, LIST* eventLst, double *eventTime, SOLVER_INFO* solverInfo)
 {
   double time = data->localData[0]->timeValue;
-  long i;
   LIST_NODE* it;
 
   /* time event */
@@ -163,12 +162,7 @@ void handleEvents(DATA* data, threadData_t *threadData, LIST* eventLst, double *
     storePreValues(data);
 
     /* activate time event */
-    for(i=0; i<data->modelData->nSamples; ++i)
-      if(data->simulationInfo->nextSampleTimes[i] <= time + SAMPLE_EPS)
-      {
-        data->simulationInfo->samples[i] = 1;
-        infoStreamPrint(OMC_LOG_EVENTS, 0, "[%ld] sample(%g, %g)", data->modelData->samplesInfo[i].index, data->modelData->samplesInfo[i].start, data->modelData->samplesInfo[i].interval);
-      }
+    activateSampleEvents(data, time + SAMPLE_EPS);
   }
   data->simulationInfo->chatteringInfo.lastStepsNumStateEvents-=data->simulationInfo->chatteringInfo.lastSteps[data->simulationInfo->chatteringInfo.currentIndex];
   /* state event */
@@ -228,20 +222,7 @@ void handleEvents(DATA* data, threadData_t *threadData, LIST* eventLst, double *
   if(data->simulationInfo->sampleActivated)
   {
     /* deactivate time events */
-    for(i=0; i<data->modelData->nSamples; ++i)
-    {
-      if(data->simulationInfo->samples[i])
-      {
-        data->simulationInfo->samples[i] = 0;
-        data->simulationInfo->nextSampleTimes[i] += data->modelData->samplesInfo[i].interval;
-      }
-    }
-
-    for(i=0; i<data->modelData->nSamples; ++i) {
-      if((i == 0) || (data->simulationInfo->nextSampleTimes[i] < data->simulationInfo->nextSampleEvent)) {
-        data->simulationInfo->nextSampleEvent = data->simulationInfo->nextSampleTimes[i];
-      }
-    }
+    deactivateSampleEvents(data);
 
     data->simulationInfo->sampleActivated = 0;
 
@@ -84,6 +84,12 @@ static int callSparseJacobian(realtype currentTime, realtype cj,
                               N_Vector yy, N_Vector yp, N_Vector rr, SUNMatrix Jac, void *user_data,
                               N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
 
+static int idaPrecondSetup(realtype tt, N_Vector yy, N_Vector yp, N_Vector rr,
+                           realtype cj, void *user_data);
+static int idaPrecondSolve(realtype tt, N_Vector yy, N_Vector yp, N_Vector rr,
+                           N_Vector rvec, N_Vector zvec, realtype cj,
+                           realtype delta, void *user_data);
+
 static int residualFunctionIDA(double time, N_Vector yy, N_Vector yp, N_Vector res, void* user_data);
 static int rootsFunctionIDA(double time, N_Vector yy, N_Vector yp, double *gout, void* userData);
 
@@ -381,6 +387,46 @@ int ida_solver_initial(DATA* data, threadData_t *threadData,
     idaData->jacobianMethod = COLOREDNUMJAC;
   }
 
+  /* if FLAG_IDA_PRECOND is set, choose preconditioner of the iterative linear solvers */
+  idaData->precondMethod = IDA_PRECOND_NONE;
+  idaData->precondJac = NULL;
+  idaData->precondNNZ = 0;
+  idaData->precondRowPtr = NULL;
+  idaData->precondColInd = NULL;
+  idaData->precondVal = NULL;
+  idaData->precondDiag = NULL;
+  idaData->precondWork = NULL;
+  idaData->precondDiagInv = NULL;
+  if (idaData->linearSolverMethod == IDA_LS_SPGMR || idaData->linearSolverMethod == IDA_LS_SPBCG || idaData->linearSolverMethod == IDA_LS_SPTFQMR) {
+    if (omc_flag[FLAG_IDA_PRECOND]) {
+      idaData->precondMethod = IDA_PRECOND_UNKNOWN;
+      for (i=1; i< IDA_PRECOND_MAX; i++) {
+        if (!strcmp((const char*)omc_flagValue[FLAG_IDA_PRECOND], IDA_PRECOND_METHOD_NAME[i])) {
+          idaData->precondMethod = (enum IDA_PRECOND)i;
+          break;
+        }
+      }
+      if (idaData->precondMethod == IDA_PRECOND_UNKNOWN) {
+        if (OMC_ACTIVE_WARNING_STREAM(OMC_LOG_SOLVER)) {
+          warningStreamPrint(OMC_LOG_SOLVER, 1, "unrecognized ida preconditioner %s, current options are:", (const char*)omc_flagValue[FLAG_IDA_PRECOND]);
+          for(i=1; i < IDA_PRECOND_MAX; ++i) {
+            warningStreamPrint(OMC_LOG_SOLVER, 0, "%-15s [%s]", IDA_PRECOND_METHOD_NAME[i], IDA_PRECOND_METHOD_DESC[i]);
+          }
+          messageCloseWarning(OMC_LOG_SOLVER);
+        }
+        throwStreamPrint(threadData,"unrecognized ida preconditioner %s", (const char*)omc_flagValue[FLAG_IDA_PRECOND]);
+      }
+    }
+    /* The preconditioner is built from the colored sparse Jacobian */
+    if (idaData->precondMethod != IDA_PRECOND_NONE && idaData->jacobianMethod == INTERNALNUMJAC) {
+      warningStreamPrint(OMC_LOG_STDOUT, 0, "The ida preconditioner %s needs a colored Jacobian."
+                                        " No preconditioner will be used.", IDA_PRECOND_METHOD_NAME[idaData->precondMethod]);
+      idaData->precondMethod = IDA_PRECOND_NONE;
+    }
+  } else if (omc_flag[FLAG_IDA_PRECOND]) {
+    warningStreamPrint(OMC_LOG_STDOUT, 0, "Flag -%s is only used with the iterative ida linear solvers and will be ignored.", FLAG_NAME[FLAG_IDA_PRECOND]);
+  }
+
   /* Set NNZ */
   if (idaData->daeMode) {
     idaData->NNZ = data->simulationInfo->daeModeData->sparsePattern->numberOfNonZeros;
@@ -391,27 +437,33 @@ int ida_solver_initial(DATA* data, threadData_t *threadData,
   switch (idaData->linearSolverMethod){
   case IDA_LS_SPGMR:
     idaData->J = NULL;
-    idaData->linSol = SUNLinSol_SPGMR(idaData->y_linSol, PREC_NONE, idaData->N);
+    idaData->linSol = SUNLinSol_SPGMR(idaData->y_linSol, idaData->precondMethod == IDA_PRECOND_NONE ? PREC_NONE : PREC_LEFT, idaData->N);
     if (idaData->linSol == NULL) {
       throwStreamPrint(threadData, "##IDA## In function SUNLinSol_SPGMR: Input incompatible.");
     }
-    idaData->jacobianMethod = INTERNALNUMJAC;
+    if (idaData->precondMethod == IDA_PRECOND_NONE) {
+      idaData->jacobianMethod = INTERNALNUMJAC;
+    }
     break;
   case IDA_LS_SPBCG:
     idaData->J = NULL;
-    idaData->linSol = SUNLinSol_SPBCGS(idaData->y_linSol, PREC_NONE, idaData->N);
+    idaData->linSol = SUNLinSol_SPBCGS(idaData->y_linSol, idaData->precondMethod == IDA_PRECOND_NONE ? PREC_NONE : PREC_LEFT, idaData->N);
     if (idaData->linSol == NULL) {
       throwStreamPrint(threadData, "##IDA## In function SUNLinSol_SPBCGS: Input incompatible.");
     }
-    idaData->jacobianMethod = INTERNALNUMJAC;
+    if (idaData->precondMethod == IDA_PRECOND_NONE) {
+      idaData->jacobianMethod = INTERNALNUMJAC;
+    }
     break;
   case IDA_LS_SPTFQMR:
     idaData->J = NULL;
-    idaData->linSol = SUNLinSol_SPTFQMR(idaData->y_linSol, PREC_NONE, idaData->N);
+    idaData->linSol = SUNLinSol_SPTFQMR(idaData->y_linSol, idaData->precondMethod == IDA_PRECOND_NONE ? PREC_NONE : PREC_LEFT, idaData->N);
     if (idaData->linSol == NULL) {
       throwStreamPrint(threadData, "##IDA## In function SUNLinSol_SPTFQMR: Input incompatible.");
     }
-    idaData->jacobianMethod = INTERNALNUMJAC;
+    if (idaData->precondMethod == IDA_PRECOND_NONE) {
+      idaData->jacobianMethod = INTERNALNUMJAC;
+    }
     break;
   case IDA_LS_DENSE:
     idaData->J = SUNDenseMatrix(idaData->N, idaData->N);
@@ -442,7 +494,33 @@ int ida_solver_initial(DATA* data, threadData_t *threadData,
 
   /* Set Jacobian function */
   /* Use sparse jacobian evaluation */
-  if (idaData->linearSolverMethod == IDA_LS_KLU) {
+  if (idaData->J == NULL && idaData->precondMethod != IDA_PRECOND_NONE) {
+    idaData->allocatedParMem = 0;   /* FALSE */
+
+    /* Jacobian-vector products are approximated by IDA, the colored sparse
+     * Jacobian is only evaluated when IDA sets up the preconditioner */
+    if (idaData->NNZ < 0) {
+      throwStreamPrint(threadData, "##IDA## idaData->NNZ not set.");
+    }
+    idaData->precondJac = SUNSparseMatrix(idaData->N, idaData->N, idaData->NNZ + idaData->N, CSC_MAT);
+    if (idaData->precondMethod == IDA_PRECOND_JACOBI) {
+      idaData->precondDiagInv = (double*) malloc(idaData->N*sizeof(double));
+    } else {
+      idaData->precondNNZ = idaData->NNZ + idaData->N;
+      idaData->precondRowPtr = (sunindextype*) malloc((idaData->N+1)*sizeof(sunindextype));
+      idaData->precondColInd = (sunindextype*) malloc(idaData->precondNNZ*sizeof(sunindextype));
+      idaData->precondVal = (double*) malloc(idaData->precondNNZ*sizeof(double));
+      idaData->precondDiag = (sunindextype*) malloc(idaData->N*sizeof(sunindextype));
+      idaData->precondWork = (sunindextype*) malloc(idaData->N*sizeof(sunindextype));
+    }
+    flag = IDASetPreconditioner(idaData->ida_mem, idaPrecondSetup, idaPrecondSolve);
+    checkReturnFlag_SUNDIALS(flag, SUNDIALS_IDALS_FLAG, "IDASetPreconditioner");
+#ifdef USE_PARJAC
+    allocateThreadLocalJacobians(data, &(idaData->jacColumns));
+    idaData->allocatedParMem = 1;   /* TRUE */
+#endif
+    infoStreamPrint(OMC_LOG_SOLVER, 0, "IDA preconditioner selected %s", IDA_PRECOND_METHOD_DESC[idaData->precondMethod]);
+  } else if (idaData->linearSolverMethod == IDA_LS_KLU) {
     idaData->allocatedParMem = 0;   /* FALSE */
 
     /* Set Jacobian function for matrix based linear solvers */
@@ -623,6 +701,15 @@ void ida_solver_deinitial(IDA_SOLVER *idaData)
   SUNMatDestroy(idaData->J);
   SUNLinSolFree(idaData->linSol);
 
+  /* Free preconditioner data */
+  SUNMatDestroy(idaData->precondJac);
+  free(idaData->precondRowPtr);
+  free(idaData->precondColInd);
+  free(idaData->precondVal);
+  free(idaData->precondDiag);
+  free(idaData->precondWork);
+  free(idaData->precondDiagInv);
+
   /* Free dae-mode data */
   if (idaData->daeMode) {
     free(idaData->states);
@@ -1651,6 +1738,7 @@ static int jacoColoredNumericalSparse(double currentTime, N_Vector yy,
   long int i,j,ii;
   int nth = 0;
   int disBackup = idaData->useScaling;
+  int retVal = 0;
 
   double currentStep;
 
@@ -1708,7 +1796,9 @@ static int jacoColoredNumericalSparse(double currentTime, N_Vector yy,
       }
     }
     idaData->useScaling = FALSE;
-    idaData->residualFunction(currentTime, yy, yp, idaData->newdelta, userData);  /* Points to residualFunctionIDA */
+    if (idaData->residualFunction(currentTime, yy, yp, idaData->newdelta, userData) != 0) {  /* Points to residualFunctionIDA */
+      retVal = 1;  /* Recoverable error, ida retries with a smaller step */
+    }
     idaData->useScaling = disBackup;
 
     increaseJacContext(data);
@@ -1749,7 +1839,7 @@ static int jacoColoredNumericalSparse(double currentTime, N_Vector yy,
   unsetContext(data);
   messageClose(OMC_LOG_SOLVER_V);
 
-  return 0;
+  return retVal;
 }
 
 /*
@@ -1781,12 +1871,22 @@ int jacColoredSymbolicalSparse(double currentTime, N_Vector yy, N_Vector yp,
   unsigned int rows = jac->sizeRows;
   SPARSE_PATTERN* sparsePattern = jac->sparsePattern;
   int maxColors = sparsePattern->maxColors;
+  int saveJumpState;
+  int success = 0;
 
   /* Reset Jacobian matrix */
   SUNMatZero(Jac);
 
   setContext(data, currentTime, CONTEXT_SYM_JACOBIAN);      /* Reuse jacobian matrix in KLU solver */
 
+  saveJumpState = threadData->currentErrorStage;
+  threadData->currentErrorStage = ERROR_INTEGRATOR;
+
+  /* try */
+#if !defined(OMC_EMCC)
+  MMC_TRY_INTERNAL(simulationJumpBuffer)
+#endif
+
   /* Evaluate constant equations if available */
   if (jac->constantEqns != NULL) {
       jac->constantEqns(data, threadData, jac, NULL);
@@ -1794,11 +1894,17 @@ int jacColoredSymbolicalSparse(double currentTime, N_Vector yy, N_Vector yp,
 
   genericColoredSymbolicJacobianEvaluation(rows, columns, sparsePattern, Jac, t_jac,
                                            data, threadData, &setJacElementSundialsSparse);
+  success = 1;
+#if !defined(OMC_EMCC)
+  MMC_CATCH_INTERNAL(simulationJumpBuffer)
+#endif
+
+  threadData->currentErrorStage = saveJumpState;
 
   finishSparseColPtr(Jac, sparsePattern->numberOfNonZeros);
   unsetContext(data);
 
-  return 0;
+  return success ? 0 : 1;  /* Recoverable error, ida retries with a smaller step */
 }
 
 /*
@@ -1814,6 +1920,7 @@ static int callSparseJacobian(double currentTime, double cj,
   threadData_t* threadData = (threadData_t*)(((IDA_USERDATA*)((IDA_SOLVER*)user_data)->userData)->threadData);
   int i;
   int flag;
+  int retVal = 0;
 
   /* profiling */
   if (measure_time_flag) rt_accumulate(SIM_TIMER_SOLVER);
@@ -1821,11 +1928,11 @@ static int callSparseJacobian(double currentTime, double cj,
 
   if (idaData->jacobianMethod == COLOREDSYMJAC || idaData->jacobianMethod == SYMJAC)
   {
-    jacColoredSymbolicalSparse(currentTime, yy, yp, rr, Jac, cj, user_data);
+    retVal = jacColoredSymbolicalSparse(currentTime, yy, yp, rr, Jac, cj, user_data);
   }
   else if (idaData->jacobianMethod == COLOREDNUMJAC || idaData->jacobianMethod == NUMJAC)
   {
-    jacoColoredNumericalSparse(currentTime, yy, yp, rr, Jac, cj, user_data);
+    retVal = jacoColoredNumericalSparse(currentTime, yy, yp, rr, Jac, cj, user_data);
   }
 
   /* debug */
@@ -1847,9 +1954,193 @@ static int callSparseJacobian(double currentTime, double cj,
   rt_accumulate(SIM_TIMER_JACOBIAN);
   if (measure_time_flag) rt_tick(SIM_TIMER_SOLVER);
 
+  return retVal;
+}
+
+
+/**
+ * @brief Set up the preconditioner of the iterative linear solvers.
+ *
+ * Called by IDA whenever it would update the iteration matrix of a matrix
+ * based linear solver, so the colored sparse Jacobian is evaluated as rarely
+ * as for the direct solvers. Depending on the selected method the inverted
+ * diagonal or the incomplete LU factorization without fill-in, ILU(0), of the
+ * iteration matrix is computed.
+ *
+ * @param tt          Current value of the independent variable.
+ * @param yy          Current value of the dependent variable vector.
+ * @param yp          Current value of y'.
+ * @param rr          Current value of the residual vector F(t,y,y').
+ * @param cj          Scalar in the iteration matrix dF/dy + cj*dF/dy'.
+ * @param user_data   Pointer to IDA solver data struct.
+ * @return int        Return 0 on success and a positive value if the Jacobian
+ *                    could not be evaluated, so ida retries with a smaller step.
+ */
+static int idaPrecondSetup(realtype tt, N_Vector yy, N_Vector yp, N_Vector rr,
+                           realtype cj, void *user_data)
+{
+  IDA_SOLVER* idaData = (IDA_SOLVER*)user_data;
+  SUNMatrix A = idaData->precondJac;
+  const sunindextype n = idaData->N;
+  sunindextype i, j, k, p, q, nnz;
+  sunindextype *Ap, *Ai, *rowPtr, *colInd, *diag, *work;
+  double *Ax, *val, pivot;
+
+  if (callSparseJacobian(tt, cj, yy, yp, rr, A, user_data, NULL, NULL, NULL) != 0) {
+    infoStreamPrint(OMC_LOG_SOLVER, 0, "##IDA## Evaluating the Jacobian for the preconditioner failed at time %g.", tt);
+    return 1;
+  }
+
+  /* _omc_SUNMatScaleIAdd_Sparse may have reallocated the matrix content */
+  Ap = SM_INDEXPTRS_S(A);
+  Ai = SM_INDEXVALS_S(A);
+  Ax = SM_DATA_S(A);
+  nnz = Ap[n];
+
+  if (idaData->precondMethod == IDA_PRECOND_JACOBI) {
+    for (i = 0; i < n; i++) {
+      idaData->precondDiagInv[i] = 1.0;
+    }
+    for (j = 0; j < n; j++) {
+      for (p = Ap[j]; p < Ap[j+1]; p++) {
+        if (Ai[p] == j && Ax[p] != 0.0) {
+          idaData->precondDiagInv[j] = 1.0 / Ax[p];
+        }
+      }
+    }
+    return 0;
+  }
+
+  /* Transpose the CSC matrix into CSR format with sorted column indices and
+   * an explicit diagonal element in every row */
+  if (nnz + n > idaData->precondNNZ) {
+    idaData->precondNNZ = nnz + n;
+    idaData->precondColInd = (sunindextype*) realloc(idaData->precondColInd, idaData->precondNNZ*sizeof(sunindextype));
+    idaData->precondVal = (double*) realloc(idaData->precondVal, idaData->precondNNZ*sizeof(double));
+  }
+  rowPtr = idaData->precondRowPtr;
+  colInd = idaData->precondColInd;
+  val = idaData->precondVal;
+  diag = idaData->precondDiag;
+  work = idaData->precondWork;
+
+  for (i = 0; i < n; i++) {
+    work[i] = 1;          /* diagonal element */
+  }
+  for (j = 0; j < n; j++) {
+    for (p = Ap[j]; p < Ap[j+1]; p++) {
+      if (Ai[p] != j) {
+        work[Ai[p]]++;
+      }
+    }
+  }
+  rowPtr[0] = 0;
+  for (i = 0; i < n; i++) {
+    rowPtr[i+1] = rowPtr[i] + work[i];
+    work[i] = rowPtr[i];
+  }
+  for (j = 0; j < n; j++) {
+    diag[j] = work[j];
+    colInd[work[j]] = j;
+    val[work[j]++] = 0.0;
+    for (p = Ap[j]; p < Ap[j+1]; p++) {
+      i = Ai[p];
+      if (i == j) {
+        val[diag[j]] += Ax[p];
+      } else {
+        colInd[work[i]] = j;
+        val[work[i]++] = Ax[p];
+      }
+    }
+  }
+
+  /* ILU(0) factorization in place, IKJ variant */
+  for (i = 0; i < n; i++) {
+    work[i] = -1;
+  }
+  for (i = 0; i < n; i++) {
+    for (p = rowPtr[i]; p < rowPtr[i+1]; p++) {
+      work[colInd[p]] = p;
+    }
+    for (p = rowPtr[i]; p < diag[i]; p++) {
+      k = colInd[p];
+      val[p] /= val[diag[k]];
+      for (q = diag[k] + 1; q < rowPtr[k+1]; q++) {
+        if (work[colInd[q]] >= 0) {
+          val[work[colInd[q]]] -= val[p] * val[q];
+        }
+      }
+    }
+    /* Zero pivots are replaced by one, any regular preconditioner keeps the
+     * Krylov iteration correct and only affects its convergence */
+    pivot = val[diag[i]];
+    if (fabs(pivot) < DBL_MIN) {
+      infoStreamPrint(OMC_LOG_SOLVER_V, 0, "##IDA## Zero pivot in row %ld of ILU(0) preconditioner replaced by 1.", (long int)i);
+      val[diag[i]] = 1.0;
+    }
+    for (p = rowPtr[i]; p < rowPtr[i+1]; p++) {
+      work[colInd[p]] = -1;
+    }
+  }
+
   return 0;
 }
 
+/**
+ * @brief Solve P*z = r with the preconditioner computed by idaPrecondSetup.
+ *
+ * @param tt          Current value of the independent variable.
+ * @param yy          Current value of the dependent variable vector.
+ * @param yp          Current value of y'.
+ * @param rr          Current value of the residual vector F(t,y,y').
+ * @param rvec        Right-hand side vector r.
+ * @param zvec        Computed output vector z.
+ * @param cj          Scalar in the iteration matrix dF/dy + cj*dF/dy'.
+ * @param delta       Input tolerance for iterative methods, unused.
+ * @param user_data   Pointer to IDA solver data struct.
+ * @return int        Return 0 on success.
+ */
+static int idaPrecondSolve(realtype tt, N_Vector yy, N_Vector yp, N_Vector rr,
+                           N_Vector rvec, N_Vector zvec, realtype cj,
+                           realtype delta, void *user_data)
+{
+  IDA_SOLVER* idaData = (IDA_SOLVER*)user_data;
+  const sunindextype n = idaData->N;
+  const sunindextype *rowPtr = idaData->precondRowPtr;
+  const sunindextype *colInd = idaData->precondColInd;
+  const sunindextype *diag = idaData->precondDiag;
+  const double *val = idaData->precondVal;
+  double *r = N_VGetArrayPointer_Serial(rvec);
+  double *z = N_VGetArrayPointer_Serial(zvec);
+  double sum;
+  sunindextype i, p;
+
+  if (idaData->precondMethod == IDA_PRECOND_JACOBI) {
+    for (i = 0; i < n; i++) {
+      z[i] = r[i] * idaData->precondDiagInv[i];
+    }
+    return 0;
+  }
+
+  /* forward substitution with L */
+  for (i = 0; i < n; i++) {
+    sum = r[i];
+    for (p = rowPtr[i]; p < diag[i]; p++) {
+      sum -= val[p] * z[colInd[p]];
+    }
+    z[i] = sum;
+  }
+  /* backward substitution with U */
+  for (i = n - 1; i >= 0; i--) {
+    sum = z[i];
+    for (p = diag[i] + 1; p < rowPtr[i+1]; p++) {
+      sum -= val[p] * z[colInd[p]];
+    }
+    z[i] = sum / val[diag[i]];
+  }
+
+  return 0;
+}
 
 /* TODO: Unify with nlsKinsolFScaling from kinsolSolver.c? */
 static int getScalingFactors(DATA* data, IDA_SOLVER* idaData, SUNMatrix inScaleMatrix)
@@ -101,6 +101,17 @@ typedef struct IDA_SOLVER
   SUNMatrix J;              /* Sparse matrix template for cloning matrices needed within
                                linear solver */
 
+  /* ### preconditioner of iterative linear solvers ### */
+  enum IDA_PRECOND precondMethod; /* specifies the preconditioner of spgmr, spbcg and sptfqmr */
+  SUNMatrix precondJac;           /* Sparse iteration matrix the preconditioner is built from */
+  sunindextype precondNNZ;        /* Allocated length of precondColInd and precondVal */
+  sunindextype *precondRowPtr;    /* CSR row pointers of the ILU(0) factors */
+  sunindextype *precondColInd;    /* CSR column indices of the ILU(0) factors */
+  double *precondVal;             /* ILU(0) factors, L with implicit unit diagonal and U */
+  sunindextype *precondDiag;      /* Position of the diagonal element in each CSR row */
+  sunindextype *precondWork;      /* Work array of length N */
+  double *precondDiagInv;         /* Inverted diagonal for the Jacobi preconditioner */
+
   /* ### daeMode ### */
   booleantype daeMode;      /* If TRUE then solve dae more with a reals residual function */
   long int N;               /* Number of unknowns */
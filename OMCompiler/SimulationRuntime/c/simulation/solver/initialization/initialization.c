@@ -249,6 +249,47 @@ void log_homotopy_lambda_vars(DATA *data, threadData_t *threadData, const char*
   return;
 }
 
+/**
+ * @brief Log the time spent in each linear and non-linear system.
+ *
+ * With --parallelInit independent systems are solved concurrently, so the
+ * sum of the system times can exceed the wall-clock time of the
+ * initialization.
+ *
+ * @param data        Pointer to data.
+ * @param wallTime    Wall-clock time of the initialization.
+ */
+static void printInitialSystemTimes(DATA *data, double wallTime)
+{
+  long i;
+  double systemTime = 0.0;
+
+  if (!OMC_ACTIVE_STREAM(OMC_LOG_INIT)) return;
+  infoStreamPrint(OMC_LOG_INIT, 1, "time spent in algebraic systems");
+
+#if !defined(OMC_NUM_NONLINEAR_SYSTEMS) || OMC_NUM_NONLINEAR_SYSTEMS>0
+  for (i = 0; i < data->modelData->nNonLinearSystems; ++i) {
+    NONLINEAR_SYSTEM_DATA* nonlinsys = &data->simulationInfo->nonlinearSystemData[i];
+    if (nonlinsys->numberOfCall > 0) {
+      infoStreamPrint(OMC_LOG_INIT, 0, "non-linear system %d of size %d: %lu calls, %g s", (int)nonlinsys->equationIndex, (int)nonlinsys->size, nonlinsys->numberOfCall, nonlinsys->totalTime);
+      systemTime += nonlinsys->totalTime;
+    }
+  }
+#endif
+#if !defined(OMC_NUM_LINEAR_SYSTEMS) || OMC_NUM_LINEAR_SYSTEMS>0
+  for (i = 0; i < data->modelData->nLinearSystems; ++i) {
+    LINEAR_SYSTEM_DATA* linsys = &data->simulationInfo->linearSystemData[i];
+    if (linsys->numberOfCall > 0) {
+      infoStreamPrint(OMC_LOG_INIT, 0, "linear system %d of size %d: %lu calls, %g s", (int)linsys->equationIndex, (int)linsys->size, linsys->numberOfCall, linsys->totalTime);
+      systemTime += linsys->totalTime;
+    }
+  }
+#endif
+
+  infoStreamPrint(OMC_LOG_INIT, 0, "%g s in algebraic systems, %g s wall-clock time", systemTime, wallTime);
+  messageClose(OMC_LOG_INIT);
+}
+
 /*! \fn static int symbolic_initialization(DATA *data, threadData_t *threadData)
  *
  *  \param [ref] [data]
@@ -706,18 +747,14 @@ void initSample(DATA* data, threadData_t *threadData, double startTime, double s
   long i;
 
   data->callback->function_initSample(data, threadData);              /* set-up sample */
-  data->simulationInfo->nextSampleEvent = DBL_MAX;                    /* should never be reached */
   for(i=0; i<data->modelData->nSamples; ++i) {
     if(startTime < data->modelData->samplesInfo[i].start) {
       data->simulationInfo->nextSampleTimes[i] = data->modelData->samplesInfo[i].start;
     } else {
       data->simulationInfo->nextSampleTimes[i] = data->modelData->samplesInfo[i].start + ceil((startTime-data->modelData->samplesInfo[i].start) / data->modelData->samplesInfo[i].interval) * data->modelData->samplesInfo[i].interval;
     }
-
-    if((i == 0) || (data->simulationInfo->nextSampleTimes[i] < data->simulationInfo->nextSampleEvent)) {
-      data->simulationInfo->nextSampleEvent = data->simulationInfo->nextSampleTimes[i];
-    }
   }
+  initSampleTimers(data);                                              /* DBL_MAX if there are no samples */
 }
 
 /*! \fn int initialization(DATA *data, const char* pInitMethod, const char* pOptiMethod, const char* pInitFile, double initTime)
@@ -734,6 +771,7 @@ int initialization(DATA *data, threadData_t *threadData, const char* pInitMethod
   int initMethod = IIM_SYMBOLIC; /* default method */
   int retVal = -1;
   int i;
+  rtclock_t initClock;
   modelica_boolean read_init_from_file = (pInitFile && strcmp(pInitFile, ""));
   modelica_boolean fmi_init_method = !strcmp(pInitMethod, "fmi");
 
@@ -820,7 +858,11 @@ int initialization(DATA *data, threadData_t *threadData, const char* pInitMethod
   if(IIM_NONE == initMethod) {
     retVal = 0;
   } else if(IIM_SYMBOLIC == initMethod) {
+    rt_ext_tp_tick(&initClock);
     retVal = symbolic_initialization(data, threadData);
+#if !defined(OMC_MINIMAL_LOGGING)
+    printInitialSystemTimes(data, rt_ext_tp_tock(&initClock));
+#endif
   } else {
     throwStreamPrint(threadData, "unsupported option -iim");
   }
@@ -1678,6 +1678,10 @@ NLS_SOLVER_STATUS B_nlsKinsolSolve(DATA* data, threadData_t* threadData, NONLINE
   double *xStart = NV_DATA_S(kinsolData->initialGuess);
   double fNormValue;
 
+  /* data may be a per-thread copy, see taskGraph.c */
+  kinsolData->userData->data = data;
+  kinsolData->userData->threadData = threadData;
+
   infoStreamPrintWithEquationIndexes(OMC_LOG_NLS_V, omc_dummyFileInfo, 1, indexes,
     "Start solving Non-Linear System %d (size %d) at time %g with Kinsol Solver",
     eqSystemNumber, (int) nlsData->size, data->localData[0]->timeValue);
@@ -58,11 +58,6 @@
   #include <omp.h>
 #endif
 
-/* Private function prototypes */
-void* syncTimerListAlloc(const void* data);
-void syncTimerListFree(void* data);
-void syncTimerListCopy(void* dest, const void* src);
-
 int maxEventIterations = 20;
 double linearSparseSolverMaxDensity = DEFAULT_FLAG_LSS_MAX_DENSITY;
 int linearSparseSolverMinSize = DEFAULT_FLAG_LSS_MIN_SIZE;
@@ -802,6 +797,75 @@ int getNextSampleTimeFMU(DATA *data, double *nextSampleEvent)
   return 0 /* FALSE */;
 }
 
+/**
+ * @brief Rebuild queue of sample timers from data->simulationInfo->nextSampleTimes.
+ *
+ * Deactivates all sample-calls and updates data->simulationInfo->nextSampleEvent.
+ *
+ * @param data    Data
+ */
+void initSampleTimers(DATA *data)
+{
+  long i;
+
+  clearTimerQueue(data->simulationInfo->sampleTimers);
+  for(i=0; i<data->modelData->nSamples; ++i) {
+    data->simulationInfo->samples[i] = 0;
+    pushTimer(data->simulationInfo->sampleTimers, data->simulationInfo->nextSampleTimes[i], &i);
+  }
+  data->simulationInfo->nActiveSamples = 0;
+  data->simulationInfo->nextSampleEvent = nextTimerTime(data->simulationInfo->sampleTimers);
+}
+
+/**
+ * @brief Activate all sample-calls with next sample time up to given time.
+ *
+ * Only the sample timers that are due are touched, so this is O(k log n)
+ * for k simultaneous sample events out of n sample-calls.
+ *
+ * @param data    Data
+ * @param time    Activate sample-calls with next sample time <= time.
+ */
+void activateSampleEvents(DATA *data, double time)
+{
+  SIMULATION_INFO *simulationInfo = data->simulationInfo;
+  long i;
+
+  while(timerQueueLength(simulationInfo->sampleTimers) > 0 && nextTimerTime(simulationInfo->sampleTimers) <= time)
+  {
+    popTimer(simulationInfo->sampleTimers, &i);
+    simulationInfo->samples[i] = 1;
+    simulationInfo->activeSamples[simulationInfo->nActiveSamples++] = i;
+    infoStreamPrint(OMC_LOG_EVENTS, 0, "[%ld] sample(%g, %g)", data->modelData->samplesInfo[i].index, data->modelData->samplesInfo[i].start, data->modelData->samplesInfo[i].interval);
+  }
+}
+
+/**
+ * @brief Deactivate all active sample-calls and schedule their next sample time.
+ *
+ * Updates data->simulationInfo->nextSampleEvent.
+ *
+ * @param data    Data
+ */
+void deactivateSampleEvents(DATA *data)
+{
+  SIMULATION_INFO *simulationInfo = data->simulationInfo;
+  long i, k;
+
+  for(k=0; k<simulationInfo->nActiveSamples; ++k)
+  {
+    i = simulationInfo->activeSamples[k];
+    simulationInfo->samples[i] = 0;
+    simulationInfo->nextSampleTimes[i] += data->modelData->samplesInfo[i].interval;
+    pushTimer(simulationInfo->sampleTimers, simulationInfo->nextSampleTimes[i], &i);
+  }
+  simulationInfo->nActiveSamples = 0;
+
+  if(0 < data->modelData->nSamples) {
+    simulationInfo->nextSampleEvent = nextTimerTime(simulationInfo->sampleTimers);
+  }
+}
+
 /**
  * @brief Allocates static model data.
  *
@@ -1074,10 +1138,13 @@ void initializeDataStruc(DATA *data, threadData_t *threadData)
   data->simulationInfo->nextSampleEvent = data->simulationInfo->startTime;
   data->simulationInfo->nextSampleTimes = (double*) calloc(data->modelData->nSamples, sizeof(double));
   data->simulationInfo->samples = (modelica_boolean*) calloc(data->modelData->nSamples, sizeof(modelica_boolean));
+  data->simulationInfo->sampleTimers = allocTimerQueue(data->modelData->nSamples, sizeof(long));
+  data->simulationInfo->activeSamples = (long*) calloc(data->modelData->nSamples, sizeof(long));
+  data->simulationInfo->nActiveSamples = 0;
 
   if (data->modelData->nBaseClocks > 0) {
     data->simulationInfo->baseClocks = (BASECLOCK_DATA*) calloc(data->modelData->nBaseClocks, sizeof(BASECLOCK_DATA));
-    data->simulationInfo->intvlTimers = allocList(syncTimerListAlloc, syncTimerListFree, syncTimerListCopy);
+    data->simulationInfo->intvlTimers = allocTimerQueue(data->modelData->nBaseClocks, sizeof(SYNC_TIMER));
   } else {
     data->simulationInfo->baseClocks = NULL;
     data->simulationInfo->intvlTimers = NULL;
@@ -1288,9 +1355,11 @@ void deInitializeDataStruc(DATA *data)
   omc_alloc_interface.free_uncollectable(data->modelData->samplesInfo);
   free(data->simulationInfo->nextSampleTimes);
   free(data->simulationInfo->samples);
+  freeTimerQueue(data->simulationInfo->sampleTimers);
+  free(data->simulationInfo->activeSamples);
 
   free(data->simulationInfo->baseClocks);
-  freeList(data->simulationInfo->intvlTimers);
+  freeTimerQueue(data->simulationInfo->intvlTimers);
   data->simulationInfo->intvlTimers = NULL;
 
   freeSpatialDistribution(data->simulationInfo->spatialDistributionData, data->modelData->nSpatialDistributions);
@@ -1621,36 +1690,4 @@ modelica_real _event_div_real(modelica_real x1, modelica_real x2, modelica_integ
 }
 
 
-/**
- * @brief Allocate memory for syncTimerList elements.
- *
- * @param data      Unused.
- * @return void*    Allocated memory for LIST_NODE data.
- */
-void* syncTimerListAlloc(const void* data) {
-  void* newElem = malloc(sizeof(SYNC_TIMER));
-  assertStreamPrint(NULL, newElem != NULL, "syncTimerListAlloc: Out of memory");
-  return newElem;
-}
-
-/**
- * @brief Free memory allocated with syncTimerListAlloc.
- *
- * @param data      Void pointer, representing SYNC_TIMER.
- */
-void syncTimerListFree(void* data) {
-  free(data);
-}
-
-/**
- * @brief Copy data of syncTimerList elements.
- *
- * @param dest    Void pointer of destination data, representing SYNC_TIMER.
- * @param src     Void pointer of source data, representing SYNC_TIMER.
- */
-void syncTimerListCopy(void* dest, const void* src) {
-  memcpy(dest, src, sizeof(SYNC_TIMER));
-}
-
-
 int measure_time_flag=0;
@@ -114,6 +114,9 @@ void storeRelations(DATA* data);
 void setZCtol(double relativeTol);
 
 int getNextSampleTimeFMU(DATA *data, double *nextSampleEvent);
+void initSampleTimers(DATA *data);
+void activateSampleEvents(DATA *data, double time);
+void deactivateSampleEvents(DATA *data);
 
 void storeOldValues(DATA *data);
 
@@ -99,7 +99,30 @@ DATA_NEWTON* allocateNewtonData(int size, NLS_USERDATA* userData)
   newtonData->ftol = 1e-6;
   newtonData->maxfev = size*100;
   newtonData->epsfcn = DBL_EPSILON;
-  newtonData->fjac = (double*) malloc((size*(size+1))*sizeof(double));
+
+  /* use sparse LU for large systems if the sparsity pattern is available,
+   * not for the NLS of an ODE integrator step: gbode changes its size and
+   * sparsity pattern when it switches to multi-rate integration */
+  newtonData->sparseLU = NULL;
+  newtonData->fdWork = NULL;
+  if (userData->solverData == NULL) {
+    if (userData->nlsData->jacobianIndex != -1 && userData->analyticJacobian != NULL) {
+      JACOBIAN* jacobian = userData->analyticJacobian;
+      if (jacobian->sizeRows == size && nlsSparseLUApplicable(userData->nlsData, jacobian->sparsePattern, size)) {
+        newtonData->sparseLU = nlsSparseLUAllocate(size, jacobian->sizeCols, jacobian->sparsePattern);
+      }
+    } else if (userData->nlsData->size == size && userData->nlsData->isPatternAvailable &&
+               nlsSparseLUApplicable(userData->nlsData, userData->nlsData->sparsePattern, size)) {
+      newtonData->sparseLU = nlsSparseLUAllocate(size, size, userData->nlsData->sparsePattern);
+      newtonData->fdWork = (double*) malloc(2*size*sizeof(double));
+    }
+  }
+  if (newtonData->sparseLU) {
+    newtonData->fjac = NULL;
+    infoStreamPrint(OMC_LOG_NLS, 0, "Newton solver uses sparse LU factorization for system of size %d with %d non-zeros.", size, nlsSparseLUNumberOfNonZeros(newtonData->sparseLU));
+  } else {
+    newtonData->fjac = (double*) malloc((size*(size+1))*sizeof(double));
+  }
 
   newtonData->rwork = (double*) malloc((size)*sizeof(double));
   newtonData->iwork = (int*) malloc(size*sizeof(int));
@@ -134,6 +157,8 @@ void freeNewtonData(DATA_NEWTON* newtonData)
   free(newtonData->x);
   free(newtonData->fvec);
   free(newtonData->fjac);
+  nlsSparseLUFree(newtonData->sparseLU);
+  free(newtonData->fdWork);
   free(newtonData->rwork);
   free(newtonData->iwork);
 
@@ -230,7 +255,7 @@ int _omc_newton(genericResidualFunc f, DATA_NEWTON* solverData, void* userData)
 
 
     /* debug output */
-    if(OMC_ACTIVE_STREAM(OMC_LOG_NLS_JAC))
+    if(OMC_ACTIVE_STREAM(OMC_LOG_NLS_JAC) && !solverData->sparseLU)
     {
       char *buffer = (char*)malloc(sizeof(char)*solverData->n*15);
 
@@ -374,6 +399,22 @@ int solveLinearSystem(int n, int* iwork, double* fvec, double *fjac, DATA_NEWTON
   int i, nrsh=1, lapackinfo;
   char trans = 'N';
 
+  if (solverData->sparseLU)
+  {
+    /* if no factorization is given, calculate it */
+    if (solverData->factorization == 0)
+    {
+      if (nlsSparseLUFactorize(solverData->sparseLU, n, NULL) != 0)
+      {
+        warningStreamPrint(OMC_LOG_NLS, 0, "Newton iteration linear solver: Jacobian matrix singular.");
+        return -1;
+      }
+      solverData->factorization = 1;
+    }
+    /* save solution of J*(x_{n+1} - x_n)=f */
+    return nlsSparseLUSolve(solverData->sparseLU, fvec, solverData->x_increment);
+  }
+
   /* if no factorization is given, calculate it */
   if (solverData->factorization == 0)
   {
@@ -473,10 +514,15 @@ void compute_scaling_vector(DATA_NEWTON* solverData, double* scalingVector) {
   int i;
   int jac_row_start;
 
+  if (solverData->sparseLU) {
+    nlsSparseLUColMaxNorm(solverData->sparseLU, scalingVector);
+  }
   for(i=0; i<solverData->n; i++)
   {
-    jac_row_start = i*solverData->n;
-    scalingVector[i] = _omc_gen_maximumVectorNorm(&(solverData->fjac[jac_row_start]), solverData->n);
+    if (!solverData->sparseLU) {
+      jac_row_start = i*solverData->n;
+      scalingVector[i] = _omc_gen_maximumVectorNorm(&(solverData->fjac[jac_row_start]), solverData->n);
+    }
     if(scalingVector[i] <= 0.0) {
       warningStreamPrint(OMC_LOG_NLS_V, 1, "Jacobian matrix is singular.");
       scalingVector[i] = 1e-16;
@@ -36,6 +36,7 @@
 
 #include "nonlinearSolverNewton.h"
 #include "nonlinearSystem.h"
+#include "nlsSparseLU.h"
 #include "simulation_data.h"
 
 #ifdef __cplusplus
@@ -62,7 +63,9 @@ typedef struct DATA_NEWTON
   int maxfev;
   int info;
   double epsfcn;
-  double* fjac;           /** Jacobian matrix in row-major format */
+  double* fjac;           /** Jacobian matrix in row-major format, NULL if sparseLU is used */
+  NLS_SPARSE_LU* sparseLU;  /** Sparse Jacobian and LU factorization for large systems with sparsity pattern, else NULL */
+  double* fdWork;         /** Work array for colored finite differences of sparse Jacobian */
   double* rwork;
   int* iwork;
   int calculate_jacobian;
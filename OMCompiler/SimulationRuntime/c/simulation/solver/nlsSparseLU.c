@@ -0,0 +1,551 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF THE BSD NEW LICENSE OR THE
+ * GPL VERSION 3 LICENSE OR THE OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the OSMC (Open Source Modelica Consortium)
+ * Public License (OSMC-PL) are obtained from OSMC, either from the above
+ * address, from the URLs: http://www.openmodelica.org or
+ * http://www.ida.liu.se/projects/OpenModelica, and in the OpenModelica
+ * distribution. GNU version 3 is obtained from:
+ * http://www.gnu.org/copyleft/gpl.html. The New BSD License is obtained from:
+ * http://www.opensource.org/licenses/BSD-3-Clause.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE, EXCEPT AS
+ * EXPRESSLY SET FORTH IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE
+ * CONDITIONS OF OSMC-PL.
+ *
+ */
+
+/*! \file nlsSparseLU.c
+ */
+
+#include "omc_config.h"
+#include "nlsSparseLU.h"
+#include "../../util/omc_error.h"
+
+#ifdef WITH_SUITESPARSE
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <klu.h>
+
+#include "model_help.h"
+
+struct NLS_SPARSE_LU
+{
+  int n;                        /* number of residuals */
+  int nCols;                    /* number of columns of the Jacobian, n or n+1 */
+  const SPARSE_PATTERN* sp;     /* sparsity pattern of the Jacobian */
+  double* jac;                  /* values of the Jacobian in the order of sp */
+
+  /* J(:,1:n) in compressed column format, always with diagonal elements */
+  int* Bp;
+  int* Bi;
+  double* Bx;
+  int* spToB;                   /* position in Bx of each element of jac, -1 for lambda column */
+  int* diag;                    /* position in Bx of diagonal element of each column */
+  double* lambdaCol;            /* lambda column c of [a*J + s*I | c] */
+  double jacFactor;             /* a */
+  double diagShift;             /* s */
+
+  /* square system handed to KLU */
+  int size;
+  int fixedCol;                 /* column of [a*J + s*I | c] not in system, -1 if extra row */
+  int* colIdx;                  /* column of [a*J + s*I | c] of each column of the system */
+  int* Ap;
+  int* Ai;
+  double* Ax;
+  double* work;
+
+  klu_symbolic* symbolic;
+  klu_numeric* numeric;
+  klu_common common;
+};
+
+/**
+ * @brief Check if non-linear system should be solved with sparse LU.
+ *
+ * Sparse LU is used if KLU is chosen as linear solver of the non-linear
+ * system or the system is bigger than the minimum size for sparse solvers,
+ * see runtime flag -nlssMinSize.
+ *
+ * @param nlsData         Non-linear system data.
+ * @param sparsePattern   Sparsity pattern of Jacobian or NULL.
+ * @param n               Number of residuals.
+ * @return                True if sparse LU should be used.
+ */
+modelica_boolean nlsSparseLUApplicable(NONLINEAR_SYSTEM_DATA* nlsData, const SPARSE_PATTERN* sparsePattern, int n)
+{
+  if (sparsePattern == NULL) {
+    return FALSE;
+  }
+  return nlsData->nlsLinearSolver == NLS_LS_KLU || n > nonlinearSparseSolverMinSize;
+}
+
+/**
+ * @brief Allocate sparse Jacobian and LU data.
+ *
+ * @param n               Number of residuals.
+ * @param nCols           Number of columns of the Jacobian, n or n+1 if
+ *                        the Jacobian contains the lambda column.
+ * @param sparsePattern   Sparsity pattern of the Jacobian in CSC format.
+ * @return                Sparse LU data, NULL if pattern does not fit.
+ */
+NLS_SPARSE_LU* nlsSparseLUAllocate(int n, int nCols, const SPARSE_PATTERN* sparsePattern)
+{
+  NLS_SPARSE_LU* lu;
+  int i, j, p, nz, hasDiag, nnz, maxNnz;
+
+  if (sparsePattern == NULL || n <= 0 || (nCols != n && nCols != n+1)) {
+    return NULL;
+  }
+  nnz = sparsePattern->leadindex[nCols];
+  for (p = 0; p < nnz; p++) {
+    if (sparsePattern->index[p] >= (unsigned int) n) {
+      return NULL;
+    }
+  }
+
+  lu = (NLS_SPARSE_LU*) malloc(sizeof(NLS_SPARSE_LU));
+  assertStreamPrint(NULL, NULL != lu, "nlsSparseLUAllocate() failed. Out of memory.");
+
+  lu->n = n;
+  lu->nCols = nCols;
+  lu->sp = sparsePattern;
+  lu->jac = (double*) calloc(nnz, sizeof(double));
+
+  /* pattern of J(:,1:n) with diagonal */
+  lu->Bp = (int*) malloc((n+1)*sizeof(int));
+  lu->Bi = (int*) malloc((nnz+n)*sizeof(int));
+  lu->Bx = (double*) calloc(nnz+n, sizeof(double));
+  lu->spToB = (int*) malloc(nnz*sizeof(int));
+  lu->diag = (int*) malloc(n*sizeof(int));
+  lu->lambdaCol = (double*) calloc(n, sizeof(double));
+  nz = 0;
+  for (j = 0; j < n; j++) {
+    lu->Bp[j] = nz;
+    hasDiag = 0;
+    for (p = sparsePattern->leadindex[j]; p < sparsePattern->leadindex[j+1]; p++) {
+      i = sparsePattern->index[p];
+      if (i == j) {
+        hasDiag = 1;
+        lu->diag[j] = nz;
+      }
+      lu->spToB[p] = nz;
+      lu->Bi[nz++] = i;
+    }
+    if (!hasDiag) {
+      lu->diag[j] = nz;
+      lu->Bi[nz++] = j;
+    }
+  }
+  lu->Bp[n] = nz;
+  for (p = sparsePattern->leadindex[n]; p < nnz; p++) {
+    lu->spToB[p] = -1;
+  }
+  lu->jacFactor = 1.0;
+  lu->diagShift = 0.0;
+
+  /* square system: pattern of J, dense lambda column and dense extra row */
+  maxNnz = nz + 2*n + 1;
+  lu->size = 0;
+  lu->fixedCol = -2;
+  lu->colIdx = (int*) malloc((n+1)*sizeof(int));
+  lu->Ap = (int*) malloc((n+2)*sizeof(int));
+  lu->Ai = (int*) malloc(maxNnz*sizeof(int));
+  lu->Ax = (double*) malloc(maxNnz*sizeof(double));
+  lu->work = (double*) malloc((n+1)*sizeof(double));
+
+  lu->symbolic = NULL;
+  lu->numeric = NULL;
+  klu_defaults(&lu->common);
+
+  return lu;
+}
+
+/**
+ * @brief Free sparse Jacobian and LU data.
+ *
+ * @param lu    Sparse LU data.
+ */
+void nlsSparseLUFree(NLS_SPARSE_LU* lu)
+{
+  if (lu == NULL) {
+    return;
+  }
+  if (lu->numeric) {
+    klu_free_numeric(&lu->numeric, &lu->common);
+  }
+  if (lu->symbolic) {
+    klu_free_symbolic(&lu->symbolic, &lu->common);
+  }
+  free(lu->jac);
+  free(lu->Bp);
+  free(lu->Bi);
+  free(lu->Bx);
+  free(lu->spToB);
+  free(lu->diag);
+  free(lu->lambdaCol);
+  free(lu->colIdx);
+  free(lu->Ap);
+  free(lu->Ai);
+  free(lu->Ax);
+  free(lu->work);
+  free(lu);
+}
+
+/**
+ * @brief Values of the Jacobian in the order of its sparsity pattern.
+ *
+ * To be filled by evalJacobian or finite differences, followed by a call of
+ * nlsSparseLUUpdate.
+ */
+double* nlsSparseLUValues(NLS_SPARSE_LU* lu)
+{
+  return lu->jac;
+}
+
+/**
+ * @brief Number of non-zero elements of the Jacobian.
+ */
+int nlsSparseLUNumberOfNonZeros(NLS_SPARSE_LU* lu)
+{
+  return lu->sp->leadindex[lu->nCols];
+}
+
+/**
+ * @brief Take over new values of the Jacobian.
+ *
+ * Resets the homotopy to a = 1, s = 0. If the Jacobian has n+1 columns
+ * the last one becomes the lambda column c, otherwise c = 0.
+ *
+ * @param lu            Sparse LU data.
+ * @param colScaling    Scaling factor for each column or NULL.
+ */
+void nlsSparseLUUpdate(NLS_SPARSE_LU* lu, const double* colScaling)
+{
+  const SPARSE_PATTERN* sp = lu->sp;
+  int j, p;
+  double scal;
+
+  memset(lu->Bx, 0, lu->Bp[lu->n]*sizeof(double));
+  memset(lu->lambdaCol, 0, lu->n*sizeof(double));
+  for (j = 0; j < lu->nCols; j++) {
+    scal = colScaling ? colScaling[j] : 1.0;
+    for (p = sp->leadindex[j]; p < sp->leadindex[j+1]; p++) {
+      if (j < lu->n) {
+        lu->Bx[lu->spToB[p]] = lu->jac[p] * scal;
+      } else {
+        lu->lambdaCol[sp->index[p]] = lu->jac[p] * scal;
+      }
+    }
+  }
+  lu->jacFactor = 1.0;
+  lu->diagShift = 0.0;
+}
+
+/**
+ * @brief Set homotopy matrix [a*J + s*I | c].
+ *
+ * @param lu          Sparse LU data.
+ * @param jacFactor   Factor a of the Jacobian.
+ * @param diagShift   Shift s of the diagonal.
+ * @param lambdaCol   Lambda column c of length n, or NULL to keep it.
+ */
+void nlsSparseLUSetHomotopy(NLS_SPARSE_LU* lu, double jacFactor, double diagShift, const double* lambdaCol)
+{
+  lu->jacFactor = jacFactor;
+  lu->diagShift = diagShift;
+  if (lambdaCol) {
+    memcpy(lu->lambdaCol, lambdaCol, lu->n*sizeof(double));
+  }
+}
+
+/**
+ * @brief Get dense column of [a*J + s*I | c].
+ *
+ * @param lu        Sparse LU data.
+ * @param col       Column index, 0 <= col <= n.
+ * @param values    Output, dense column of length n.
+ */
+void nlsSparseLUGetColumn(NLS_SPARSE_LU* lu, int col, double* values)
+{
+  int p;
+
+  if (col == lu->n) {
+    memcpy(values, lu->lambdaCol, lu->n*sizeof(double));
+    return;
+  }
+  memset(values, 0, lu->n*sizeof(double));
+  for (p = lu->Bp[col]; p < lu->Bp[col+1]; p++) {
+    values[lu->Bi[p]] = lu->jacFactor * lu->Bx[p];
+  }
+  values[col] += lu->diagShift;
+}
+
+/**
+ * @brief Sum of absolute values of each row of [a*J + s*I | c].
+ *
+ * @param lu            Sparse LU data.
+ * @param withLambda    Include lambda column c.
+ * @param rowSum        Output, vector of length n.
+ */
+void nlsSparseLUAbsRowSum(NLS_SPARSE_LU* lu, modelica_boolean withLambda, double* rowSum)
+{
+  int i, j, p;
+
+  for (i = 0; i < lu->n; i++) {
+    rowSum[i] = withLambda ? fabs(lu->lambdaCol[i]) : 0.0;
+  }
+  for (j = 0; j < lu->n; j++) {
+    for (p = lu->Bp[j]; p < lu->Bp[j+1]; p++) {
+      rowSum[lu->Bi[p]] += fabs(lu->jacFactor * lu->Bx[p] + (p == lu->diag[j] ? lu->diagShift : 0.0));
+    }
+  }
+}
+
+/**
+ * @brief Maximum norm of each column of J.
+ *
+ * @param lu        Sparse LU data.
+ * @param colNorm   Output, vector of length n.
+ */
+void nlsSparseLUColMaxNorm(NLS_SPARSE_LU* lu, double* colNorm)
+{
+  int j, p;
+
+  for (j = 0; j < lu->n; j++) {
+    colNorm[j] = 0.0;
+    for (p = lu->Bp[j]; p < lu->Bp[j+1]; p++) {
+      colNorm[j] = fmax(colNorm[j], fabs(lu->Bx[p]));
+    }
+  }
+}
+
+/**
+ * @brief Build pattern of square system.
+ */
+static void buildSystemPattern(NLS_SPARSE_LU* lu, int fixedCol)
+{
+  int i, j, k = 0, p, nz = 0;
+  int n = lu->n;
+
+  for (j = 0; j <= n; j++) {
+    if (j == fixedCol) {
+      continue;
+    }
+    lu->colIdx[k] = j;
+    lu->Ap[k] = nz;
+    if (j < n) {
+      for (p = lu->Bp[j]; p < lu->Bp[j+1]; p++) {
+        lu->Ai[nz++] = lu->Bi[p];
+      }
+    } else {
+      for (i = 0; i < n; i++) {
+        lu->Ai[nz++] = i;
+      }
+    }
+    if (fixedCol < 0) {
+      lu->Ai[nz++] = n;
+    }
+    k++;
+  }
+  lu->size = k;
+  lu->Ap[k] = nz;
+  lu->fixedCol = fixedCol;
+}
+
+/**
+ * @brief Fill values of square system.
+ */
+static void fillSystemValues(NLS_SPARSE_LU* lu, const double* extraRow)
+{
+  int i, j, k, p, nz = 0;
+  int n = lu->n;
+
+  for (k = 0; k < lu->size; k++) {
+    j = lu->colIdx[k];
+    if (j < n) {
+      for (p = lu->Bp[j]; p < lu->Bp[j+1]; p++) {
+        lu->Ax[nz++] = lu->jacFactor * lu->Bx[p] + (p == lu->diag[j] ? lu->diagShift : 0.0);
+      }
+    } else {
+      for (i = 0; i < n; i++) {
+        lu->Ax[nz++] = lu->lambdaCol[i];
+      }
+    }
+    if (extraRow) {
+      lu->Ax[nz++] = extraRow[j];
+    }
+  }
+}
+
+/**
+ * @brief Factorize square system.
+ *
+ * The symbolic analysis is kept as long as the structure of the system does
+ * not change, the numeric factorization is reused by a refactorization with
+ * the previous pivots if it is still accurate.
+ *
+ * @param lu          Sparse LU data.
+ * @param fixedCol    Column of [a*J + s*I | c] to drop, 0 <= fixedCol <= n,
+ *                    or -1 to factorize the (n+1) x (n+1) system with extra row.
+ * @param extraRow    Dense row of length n+1 if fixedCol = -1, otherwise NULL.
+ * @return            0 on success, -1 if the system is singular.
+ */
+int nlsSparseLUFactorize(NLS_SPARSE_LU* lu, int fixedCol, const double* extraRow)
+{
+  assertStreamPrint(NULL, (fixedCol < 0) == (extraRow != NULL), "nlsSparseLUFactorize: Either drop a column or add a row.");
+
+  if (lu->symbolic == NULL || fixedCol != lu->fixedCol) {
+    if (lu->numeric) {
+      klu_free_numeric(&lu->numeric, &lu->common);
+    }
+    if (lu->symbolic) {
+      klu_free_symbolic(&lu->symbolic, &lu->common);
+    }
+    buildSystemPattern(lu, fixedCol);
+    lu->symbolic = klu_analyze(lu->size, lu->Ap, lu->Ai, &lu->common);
+    if (lu->symbolic == NULL) {
+      lu->fixedCol = -2;
+      warningStreamPrint(OMC_LOG_NLS_V, 0, "Sparse LU: Symbolic analysis failed with status %d.", lu->common.status);
+      return -1;
+    }
+  }
+  fillSystemValues(lu, extraRow);
+
+  if (lu->numeric) {
+    /* Refactor using the same pivots, but check that the refactor is still accurate */
+    klu_refactor(lu->Ap, lu->Ai, lu->Ax, lu->symbolic, lu->numeric, &lu->common);
+    klu_rgrowth(lu->Ap, lu->Ai, lu->Ax, lu->symbolic, lu->numeric, &lu->common);
+    if (lu->common.status != KLU_OK || lu->common.rgrowth < 1e-3) {
+      klu_free_numeric(&lu->numeric, &lu->common);
+    }
+  }
+  if (lu->numeric == NULL) {
+    lu->numeric = klu_factor(lu->Ap, lu->Ai, lu->Ax, lu->symbolic, &lu->common);
+  }
+  if (lu->numeric == NULL || lu->common.status != KLU_OK) {
+    if (lu->numeric) {
+      klu_free_numeric(&lu->numeric, &lu->common);
+    }
+    infoStreamPrint(OMC_LOG_NLS_V, 0, "Sparse LU: Matrix singular.");
+    return -1;
+  }
+
+  /* cheap estimate of the reciprocal condition number */
+  klu_rcond(lu->symbolic, lu->numeric, &lu->common);
+  if (!(lu->common.rcond > DBL_EPSILON)) {
+    klu_free_numeric(&lu->numeric, &lu->common);
+    infoStreamPrint(OMC_LOG_NLS_V, 0, "Sparse LU: Matrix (nearly) singular, rcond = %g.", lu->common.rcond);
+    return -1;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Solve factorized square system.
+ *
+ * @param lu    Sparse LU data.
+ * @param b     Right hand side, length n, or n+1 with extra row.
+ * @param x     Solution, indexed by columns of [a*J + s*I | c]. Element
+ *              x[fixedCol] is not touched. May be the same as b.
+ * @return      0 on success, -1 otherwise.
+ */
+int nlsSparseLUSolve(NLS_SPARSE_LU* lu, const double* b, double* x)
+{
+  int k;
+
+  memcpy(lu->work, b, lu->size*sizeof(double));
+  if (!klu_solve(lu->symbolic, lu->numeric, lu->size, 1, lu->work, &lu->common)) {
+    return -1;
+  }
+  for (k = 0; k < lu->size; k++) {
+    x[lu->colIdx[k]] = lu->work[k];
+  }
+
+  return 0;
+}
+
+#else /* WITH_SUITESPARSE */
+
+modelica_boolean nlsSparseLUApplicable(NONLINEAR_SYSTEM_DATA* nlsData, const SPARSE_PATTERN* sparsePattern, int n)
+{
+  return FALSE;
+}
+
+NLS_SPARSE_LU* nlsSparseLUAllocate(int n, int nCols, const SPARSE_PATTERN* sparsePattern)
+{
+  return NULL;
+}
+
+void nlsSparseLUFree(NLS_SPARSE_LU* lu)
+{
+}
+
+double* nlsSparseLUValues(NLS_SPARSE_LU* lu)
+{
+  throwStreamPrint(NULL, "No SuiteSparse/KLU support activated.");
+  return NULL;
+}
+
+int nlsSparseLUNumberOfNonZeros(NLS_SPARSE_LU* lu)
+{
+  throwStreamPrint(NULL, "No SuiteSparse/KLU support activated.");
+  return 0;
+}
+
+void nlsSparseLUUpdate(NLS_SPARSE_LU* lu, const double* colScaling)
+{
+  throwStreamPrint(NULL, "No SuiteSparse/KLU support activated.");
+}
+
+void nlsSparseLUSetHomotopy(NLS_SPARSE_LU* lu, double jacFactor, double diagShift, const double* lambdaCol)
+{
+  throwStreamPrint(NULL, "No SuiteSparse/KLU support activated.");
+}
+
+void nlsSparseLUGetColumn(NLS_SPARSE_LU* lu, int col, double* values)
+{
+  throwStreamPrint(NULL, "No SuiteSparse/KLU support activated.");
+}
+
+void nlsSparseLUAbsRowSum(NLS_SPARSE_LU* lu, modelica_boolean withLambda, double* rowSum)
+{
+  throwStreamPrint(NULL, "No SuiteSparse/KLU support activated.");
+}
+
+void nlsSparseLUColMaxNorm(NLS_SPARSE_LU* lu, double* colNorm)
+{
+  throwStreamPrint(NULL, "No SuiteSparse/KLU support activated.");
+}
+
+int nlsSparseLUFactorize(NLS_SPARSE_LU* lu, int fixedCol, const double* extraRow)
+{
+  throwStreamPrint(NULL, "No SuiteSparse/KLU support activated.");
+  return -1;
+}
+
+int nlsSparseLUSolve(NLS_SPARSE_LU* lu, const double* b, double* x)
+{
+  throwStreamPrint(NULL, "No SuiteSparse/KLU support activated.");
+  return -1;
+}
+
+#endif /* WITH_SUITESPARSE */
@@ -0,0 +1,74 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF THE BSD NEW LICENSE OR THE
+ * GPL VERSION 3 LICENSE OR THE OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the OSMC (Open Source Modelica Consortium)
+ * Public License (OSMC-PL) are obtained from OSMC, either from the above
+ * address, from the URLs: http://www.openmodelica.org or
+ * http://www.ida.liu.se/projects/OpenModelica, and in the OpenModelica
+ * distribution. GNU version 3 is obtained from:
+ * http://www.gnu.org/copyleft/gpl.html. The New BSD License is obtained from:
+ * http://www.opensource.org/licenses/BSD-3-Clause.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE, EXCEPT AS
+ * EXPRESSLY SET FORTH IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE
+ * CONDITIONS OF OSMC-PL.
+ *
+ */
+
+/*! \file nlsSparseLU.h
+ *
+ * Sparse Jacobian and KLU factorization for the Newton and homotopy solvers.
+ *
+ * The Jacobian J of n residuals is stored in compressed column format in the
+ * order of its sparsity pattern. The solvers factorize square systems built
+ * from the n x (n+1) matrix [a*J + s*I | c], where c is the lambda column of
+ * the homotopy, by either
+ *   - dropping one column (fixedCol), e.g. fixedCol = n for a Newton step, or
+ *   - appending one dense row (fixedCol = -1), e.g. the tangent vector for
+ *     the orthogonal corrector of the path following.
+ */
+
+#ifndef _NLSSPARSELU_H_
+#define _NLSSPARSELU_H_
+
+#include "../../simulation_data.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct NLS_SPARSE_LU NLS_SPARSE_LU;
+
+modelica_boolean nlsSparseLUApplicable(NONLINEAR_SYSTEM_DATA* nlsData, const SPARSE_PATTERN* sparsePattern, int n);
+NLS_SPARSE_LU* nlsSparseLUAllocate(int n, int nCols, const SPARSE_PATTERN* sparsePattern);
+void nlsSparseLUFree(NLS_SPARSE_LU* lu);
+
+double* nlsSparseLUValues(NLS_SPARSE_LU* lu);
+int nlsSparseLUNumberOfNonZeros(NLS_SPARSE_LU* lu);
+void nlsSparseLUUpdate(NLS_SPARSE_LU* lu, const double* colScaling);
+void nlsSparseLUSetHomotopy(NLS_SPARSE_LU* lu, double jacFactor, double diagShift, const double* lambdaCol);
+void nlsSparseLUGetColumn(NLS_SPARSE_LU* lu, int col, double* values);
+void nlsSparseLUAbsRowSum(NLS_SPARSE_LU* lu, modelica_boolean withLambda, double* rowSum);
+void nlsSparseLUColMaxNorm(NLS_SPARSE_LU* lu, double* colNorm);
+
+int nlsSparseLUFactorize(NLS_SPARSE_LU* lu, int fixedCol, const double* extraRow);
+int nlsSparseLUSolve(NLS_SPARSE_LU* lu, const double* b, double* x);
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* _NLSSPARSELU_H_ */
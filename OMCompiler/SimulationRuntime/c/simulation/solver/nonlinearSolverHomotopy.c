@@ -57,6 +57,7 @@
 #include "nonlinearSystem.h"
 #include "nonlinearSolverHomotopy.h"
 #include "nonlinearSolverHybrd.h"
+#include "nlsSparseLU.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -143,6 +144,11 @@ typedef struct DATA_HOMOTOPY
   int* indRow;
   int* indCol;
 
+  /* sparse linear system, NULL if dense matrices fJac and hJac are used */
+  NLS_SPARSE_LU* sparseLU;
+  double* jacx0;          /* sparse Jacobian at x0, see fJacx0 */
+  double* sparseCol;      /* work vector of length n */
+
   int (*f)         (struct DATA_HOMOTOPY*, double*, double*);
   int (*f_con)     (struct DATA_HOMOTOPY*, double*, double*);
   int (*fJac_f)    (struct DATA_HOMOTOPY* solverData, double* x, double* fJac);
@@ -167,9 +173,20 @@ typedef struct DATA_HOMOTOPY
  */
 DATA_HOMOTOPY* allocateHomotopyData(size_t size, NLS_USERDATA* userData)
 {
+  NONLINEAR_SYSTEM_DATA* nlsData = userData->nlsData;
+  JACOBIAN* jacobian = userData->analyticJacobian;
   DATA_HOMOTOPY* homotopyData = (DATA_HOMOTOPY*) malloc(sizeof(DATA_HOMOTOPY));
   assertStreamPrint(NULL, NULL != homotopyData, "allocationHomotopyData() failed!");
 
+  /* Use sparse LU for big systems with analytic Jacobian. The total pivot
+   * search for casual tearing sets is only available for dense matrices. */
+  homotopyData->sparseLU = NULL;
+  if (jacobian != NULL && nlsData->jacobianIndex != -1 && nlsData->strictTearingFunctionCall == NULL &&
+      jacobian->sizeRows == size && nlsSparseLUApplicable(nlsData, jacobian->sparsePattern, size))
+  {
+    homotopyData->sparseLU = nlsSparseLUAllocate(size, jacobian->sizeCols, jacobian->sparsePattern);
+  }
+
   homotopyData->initialized = FALSE;
   homotopyData->n = size;
   homotopyData->m = size + 1;
@@ -200,12 +217,21 @@ DATA_HOMOTOPY* allocateHomotopyData(size_t size, NLS_USERDATA* userData)
   homotopyData->x1 = (double*) calloc((size+1),sizeof(double));
   homotopyData->finit = (double*) calloc(size,sizeof(double));
   homotopyData->fx0 = (double*) calloc(size,sizeof(double));
-  homotopyData->fJac = (double*) calloc((size*(size+1)),sizeof(double));
-  homotopyData->fJacx0 = (double*) calloc((size*(size+1)),sizeof(double));
+  if (homotopyData->sparseLU) {
+    homotopyData->fJac = NULL;
+    homotopyData->fJacx0 = NULL;
+    homotopyData->jacx0 = (double*) calloc(nlsSparseLUNumberOfNonZeros(homotopyData->sparseLU),sizeof(double));
+    homotopyData->sparseCol = (double*) calloc(size,sizeof(double));
+  } else {
+    homotopyData->fJac = (double*) calloc((size*(size+1)),sizeof(double));
+    homotopyData->fJacx0 = (double*) calloc((size*(size+1)),sizeof(double));
+    homotopyData->jacx0 = NULL;
+    homotopyData->sparseCol = NULL;
+  }
 
   /* debug arrays */
   homotopyData->debug_dx = (double*) calloc(size,sizeof(double));
-  homotopyData->debug_fJac = (double*) calloc((size*(size+1)),sizeof(double));
+  homotopyData->debug_fJac = homotopyData->sparseLU ? NULL : (double*) calloc((size*(size+1)),sizeof(double));
 
    /* homotopy */
   homotopyData->y0 = (double*) calloc((size+1),sizeof(double));
@@ -216,9 +242,15 @@ DATA_HOMOTOPY* allocateHomotopyData(size_t size, NLS_USERDATA* userData)
   homotopyData->dy1 = (double*) calloc((size+homBacktraceStrategy),sizeof(double));
   homotopyData->dy2 = (double*) calloc((size+1),sizeof(double));
   homotopyData->hvec = (double*) calloc(size,sizeof(double));
-  homotopyData->hJac = (double*) calloc(size*(size+1),sizeof(double));
-  homotopyData->hJac2 = (double*) calloc((size+1)*(size+2),sizeof(double));
-  homotopyData->hJacInit = (double*) calloc(size*(size+1),sizeof(double));
+  if (homotopyData->sparseLU) {
+    homotopyData->hJac = NULL;
+    homotopyData->hJac2 = NULL;
+    homotopyData->hJacInit = NULL;
+  } else {
+    homotopyData->hJac = (double*) calloc(size*(size+1),sizeof(double));
+    homotopyData->hJac2 = (double*) calloc((size+1)*(size+2),sizeof(double));
+    homotopyData->hJacInit = (double*) calloc(size*(size+1),sizeof(double));
+  }
   homotopyData->ones = (double*) calloc(size+1,sizeof(double));
 
   /* linear system */
@@ -229,6 +261,11 @@ DATA_HOMOTOPY* allocateHomotopyData(size_t size, NLS_USERDATA* userData)
 
   homotopyData->dataHybrid = allocateHybrdData(size, userData);
 
+  if (homotopyData->sparseLU) {
+    infoStreamPrint(OMC_LOG_NLS, 0, "Homotopy solver uses sparse LU (KLU) for non-linear system %d of size %d with %d non-zero elements.",
+                    (int)nlsData->equationIndex, (int)size, nlsSparseLUNumberOfNonZeros(homotopyData->sparseLU));
+  }
+
   return homotopyData;
 }
 
@@ -277,6 +314,9 @@ void freeHomotopyData(DATA_HOMOTOPY* homotopyData)
   /* linear system */
   free(homotopyData->indRow);
   free(homotopyData->indCol);
+  nlsSparseLUFree(homotopyData->sparseLU);
+  free(homotopyData->jacx0);
+  free(homotopyData->sparseCol);
 
   /* Don't free userData here, it's done in freeHybrdData */
   freeHybrdData(homotopyData->dataHybrid);
@@ -842,6 +882,22 @@ int getAnalyticalJacobianHomotopy(DATA_HOMOTOPY* solverData, double* jac)
   return 0;
 }
 
+/*! \fn getSparseJacobianHomotopy
+ *
+ *  function calculates analytical jacobian with colored seed vectors and
+ *  stores it in the sparse LU data, columns are scaled like in the dense case
+ *
+ */
+static void getSparseJacobianHomotopy(DATA_HOMOTOPY* solverData)
+{
+  DATA* data = solverData->userData->data;
+  threadData_t *threadData = solverData->userData->threadData;
+  JACOBIAN* jacobian = solverData->userData->analyticJacobian;
+
+  evalJacobian(data, threadData, jacobian, NULL, nlsSparseLUValues(solverData->sparseLU), FALSE);
+  nlsSparseLUUpdate(solverData->sparseLU, solverData->xScaling);
+}
+
 /*! \fn getNumericalJacobianHomotopy
  *
  *  function calculates a jacobian matrix by
@@ -945,7 +1001,11 @@ static int wrapper_fvec_der(DATA_HOMOTOPY* solverData, double* x, double* fJac)
   rt_ext_tp_tick(&nlsData->jacobianTimeClock);
 
   /* calculate jacobian */
-  if(nlsData->jacobianIndex != -1)
+  if(solverData->sparseLU)
+  {
+    getSparseJacobianHomotopy(solverData);
+  }
+  else if(nlsData->jacobianIndex != -1)
   {
     /* !!!!!!!!!!! Be sure that actual x is used !!!!!!!!!!! */
     getAnalyticalJacobianHomotopy(solverData, fJac);
@@ -955,7 +1015,7 @@ static int wrapper_fvec_der(DATA_HOMOTOPY* solverData, double* x, double* fJac)
     getNumericalJacobianHomotopy(solverData, x, fJac);
   }
 
-  if(OMC_ACTIVE_STREAM(OMC_LOG_NLS_JAC_TEST))
+  if(OMC_ACTIVE_STREAM(OMC_LOG_NLS_JAC_TEST) && !solverData->sparseLU)
   {
     int n = solverData->n;
     /* debugMatrixDouble(OMC_LOG_NLS_JAC_TEST,"analytical jacobian:",fJac, n, n+1); */
@@ -1006,7 +1066,10 @@ static int wrapper_fvec_homotopy_newton_der(DATA_HOMOTOPY* solverData, double* x
   wrapper_fvec_der(solverData, x, hJac);
 
   /* add f(x0) as the last column of the Jacobian*/
-  vecCopy(n, solverData->fx0, hJac + n*n);
+  if (solverData->sparseLU)
+    nlsSparseLUSetHomotopy(solverData->sparseLU, 1.0, 0.0, solverData->fx0);
+  else
+    vecCopy(n, solverData->fx0, hJac + n*n);
 
   return 0;
 }
@@ -1042,6 +1105,13 @@ static int wrapper_fvec_homotopy_fixpoint_der(DATA_HOMOTOPY* solverData, double*
 
   /* Fixpoint homotopy */
   wrapper_fvec_der(solverData, x, hJac);
+  if (solverData->sparseLU) {
+    for (i=0; i<n; i++){
+      solverData->sparseCol[i] = solverData->f1[i]-(x[i] - solverData->x0[i]);
+    }
+    nlsSparseLUSetHomotopy(solverData->sparseLU, x[n], 1-x[n], solverData->sparseCol);
+    return 0;
+  }
   for (i=0; i<n; i++){
     for (j=0; j<n; j++) {
       hJac[i+ j * n] = x[n]*hJac[i+ j * n];
@@ -1286,6 +1356,73 @@ int linearSolverWrapper(DATA *data, int n, double* x, double* A, int* indRow, in
 }
 
 
+/*! \fn sparseNewtonStep
+ *
+ *  solves J*dy0 = -f1 with the sparse LU, same result as the total pivot
+ *  search with fixed column pos = n
+ */
+static int sparseNewtonStep(DATA_HOMOTOPY* solverData)
+{
+  int n = solverData->n;
+
+  if (nlsSparseLUFactorize(solverData->sparseLU, n, NULL) != 0)
+  {
+    debugString(OMC_LOG_NLS_V, "Sparse LU solver failed!!!");
+    return -1;
+  }
+  vecScalarMult(n, solverData->f1, -1, solverData->dy0);
+  if (nlsSparseLUSolve(solverData->sparseLU, solverData->dy0, solverData->dy0) != 0)
+  {
+    return -1;
+  }
+  solverData->dy0[n] = 1.0;
+
+  return 0;
+}
+
+/*! \fn sparseTangent
+ *
+ *  calculates the tangent vector dy0 of the homotopy path with the sparse LU.
+ *  Instead of the total pivot search the coordinate with the largest scaled
+ *  component of the last step dy2 is fixed, i.e. lambda at the start of the
+ *  path. If this leads to a singular system, lambda is fixed.
+ */
+static int sparseTangent(DATA_HOMOTOPY* solverData, int* pos)
+{
+  int i, k, n = solverData->n;
+  int candidate[2];
+  double absMax = 0.0;
+
+  candidate[0] = n;
+  for (i=0; i<=n; i++) {
+    if (fabs(solverData->dy2[i])/solverData->xScaling[i] > absMax) {
+      absMax = fabs(solverData->dy2[i])/solverData->xScaling[i];
+      candidate[0] = i;
+    }
+  }
+  candidate[1] = n;
+
+  for (k=0; k<2; k++) {
+    if (k==1 && candidate[0]==n)
+      break;
+    *pos = candidate[k];
+    if (nlsSparseLUFactorize(solverData->sparseLU, *pos, NULL) == 0)
+    {
+      nlsSparseLUGetColumn(solverData->sparseLU, *pos, solverData->sparseCol);
+      vecScalarMult(n, solverData->sparseCol, -1, solverData->sparseCol);
+      if (nlsSparseLUSolve(solverData->sparseLU, solverData->sparseCol, solverData->dy0) == 0)
+      {
+        solverData->dy0[*pos] = 1.0;
+        debugInt(OMC_LOG_NLS_V,"fixed coordinate of tangent vector = ", *pos);
+        return 0;
+      }
+    }
+  }
+  debugString(OMC_LOG_NLS_V, "Sparse LU solver failed!!!");
+
+  return -1;
+}
+
 /*! \fn solve system with damped Newton-Raphson
  *
  *  \author bbachmann
@@ -1337,7 +1474,9 @@ static int newtonAlgorithm(DATA_HOMOTOPY* solverData, double* x)
     debugInt(OMC_LOG_NLS_V, "Iteration:", numberOfIterations);
 
     /* solve jacobian and function value (both stored in hJac, last column is fvec), side effects: jacobian matrix is changed */
-    if (numberOfIterations>1)
+    if (numberOfIterations>1 && solverData->sparseLU)
+      solverinfo = sparseNewtonStep(solverData);
+    else if (numberOfIterations>1)
       solverinfo = linearSolverWrapper(data, solverData->n, solverData->dy0, solverData->fJac, solverData->indRow, solverData->indCol, &pos, &rank, linearSolverMethod, solverData->casualTearingSet);
 
     if (solverinfo == -1)
@@ -1641,6 +1780,13 @@ static int newtonAlgorithm(DATA_HOMOTOPY* solverData, double* x)
       debugString(OMC_LOG_NLS_V,"UPS! assert when calculating Jacobian!!!");
       break;
     }
+    if (solverData->sparseLU)
+    {
+      /* calculate scaling factor of residuals, Newton step is done with the next iteration */
+      nlsSparseLUAbsRowSum(solverData->sparseLU, FALSE, solverData->resScaling);
+      debugVectorDouble(OMC_LOG_NLS_JAC, "residuum scaling:", solverData->resScaling, solverData->n);
+      continue;
+    }
     vecCopy(n, solverData->f1, solverData->fJac + n*n);
     /* calculate scaling factor of residuals */
     matVecMultAbsBB(solverData->n, solverData->fJac, solverData->ones, solverData->resScaling);
@@ -1782,16 +1928,20 @@ static int homotopyAlgorithm(DATA_HOMOTOPY* solverData, double *x)
     MMC_TRY_INTERNAL(simulationJumpBuffer)
 #endif
       solverData->hJac_dh(solverData, solverData->y0, solverData->hJac);
-      debugMatrixDouble(OMC_LOG_NLS_JAC,"Jacobian hJac:",solverData->hJac, solverData->n, solverData->n+1);
-      scaleMatrixRows(solverData->n, solverData->m, solverData->hJac);
-      debugMatrixDouble(OMC_LOG_NLS_JAC,"Jacobian hJac after scaling:",solverData->hJac, solverData->n, solverData->n+1);
+      if (!solverData->sparseLU)
+      {
+        debugMatrixDouble(OMC_LOG_NLS_JAC,"Jacobian hJac:",solverData->hJac, solverData->n, solverData->n+1);
+        scaleMatrixRows(solverData->n, solverData->m, solverData->hJac);
+        debugMatrixDouble(OMC_LOG_NLS_JAC,"Jacobian hJac after scaling:",solverData->hJac, solverData->n, solverData->n+1);
+      }
       assert = 0;
       pos = -1; /* stable solution algorithm for solving a generalized over-determined linear system */
 #ifndef OMC_EMCC
     MMC_CATCH_INTERNAL(simulationJumpBuffer)
 #endif
 
-      if (assert || (solveSystemWithTotalPivotSearch(data, solverData->n, solverData->dy0, solverData->hJac, solverData->indRow, solverData->indCol, &pos, &rank, solverData->casualTearingSet) == -1))
+      if (assert || (solverData->sparseLU && sparseTangent(solverData, &pos) == -1)
+                 || (!solverData->sparseLU && solveSystemWithTotalPivotSearch(data, solverData->n, solverData->dy0, solverData->hJac, solverData->indRow, solverData->indCol, &pos, &rank, solverData->casualTearingSet) == -1))
       {
         /* report solver abortion */
         solverData->info=-1;
@@ -1924,9 +2074,10 @@ static int homotopyAlgorithm(DATA_HOMOTOPY* solverData, double *x)
 #endif
       /* calculate homotopy jacobian */
       solverData->hJac_dh(solverData, solverData->y1, solverData->hJac);
-      debugMatrixDouble(OMC_LOG_NLS_JAC,"Jacobian hJac:",solverData->hJac, solverData->n, solverData->n+1);
+      if (!solverData->sparseLU)
+        debugMatrixDouble(OMC_LOG_NLS_JAC,"Jacobian hJac:",solverData->hJac, solverData->n, solverData->n+1);
 
-      if (correctorStrategy==2)
+      if (correctorStrategy==2 && !solverData->sparseLU)
       {
         /* calculate the newton matrix hJac2 for the orthogonal backtrace strategy */
         orthogonalBacktraceMatrix(solverData, solverData->hJac, solverData->hvec, solverData->dy0, solverData->hJac2, solverData->n, solverData->m);
@@ -1943,10 +2094,45 @@ static int homotopyAlgorithm(DATA_HOMOTOPY* solverData, double *x)
         stepAccept = 0;
         break;
       }
-      matVecMultAbs(solverData->n, solverData->m, solverData->hJac, solverData->ones, solverData->resScaling);
+      if (solverData->sparseLU)
+        nlsSparseLUAbsRowSum(solverData->sparseLU, TRUE, solverData->resScaling);
+      else
+        matVecMultAbs(solverData->n, solverData->m, solverData->hJac, solverData->ones, solverData->resScaling);
       debugVectorDouble(OMC_LOG_NLS_HOMOTOPY, "residuum scaling of function h:", solverData->resScaling, solverData->n);
 
-      if (correctorStrategy==1) // fix one coordinate
+      if (solverData->sparseLU)
+      {
+        if (correctorStrategy==1) // fix one coordinate
+        {
+          vecScalarMult(solverData->n, solverData->hvec, -1, solverData->dy1);
+          if (nlsSparseLUFactorize(solverData->sparseLU, pos, NULL) != 0)
+          {
+            debugString(OMC_LOG_NLS_HOMOTOPY, "step NOT accepted, because sparse LU factorization failed!");
+            stepAccept = 0;
+            break;
+          }
+        }
+        else // go back in orthogonal direction to tangent vector, dense row dy0 is added
+        {
+          vecScalarMult(solverData->n, solverData->hvec, -1, solverData->dy1);
+          solverData->dy1[solverData->n] = 0.0;
+          if (nlsSparseLUFactorize(solverData->sparseLU, -1, solverData->dy0) != 0)
+          {
+            debugString(OMC_LOG_NLS_HOMOTOPY, "step NOT accepted, because sparse LU factorization failed!");
+            stepAccept = 0;
+            break;
+          }
+        }
+        if (nlsSparseLUSolve(solverData->sparseLU, solverData->dy1, solverData->dy1) != 0)
+        {
+          debugString(OMC_LOG_NLS_HOMOTOPY, "step NOT accepted, because sparse LU solver failed!");
+          stepAccept = 0;
+          break;
+        }
+        if (correctorStrategy==1)
+          solverData->dy1[pos] = 0.0;
+      }
+      else if (correctorStrategy==1) // fix one coordinate
       {
         /* copy vector h to column "pos" of the jacobian */
         debugVectorDouble(OMC_LOG_NLS_HOMOTOPY, "copy vector hvec to column 'pos' of the jacobian:", solverData->hvec, solverData->n);
@@ -2141,6 +2327,10 @@ NLS_SOLVER_STATUS solveHomotopy(DATA *data, threadData_t *threadData, NONLINEAR_
   modelica_boolean* relationsPreBackup;
   relationsPreBackup = (modelica_boolean*) malloc(data->modelData->nRelations*sizeof(modelica_boolean));
 
+  /* data may be a per-thread copy, see taskGraph.c */
+  homotopyData->userData->data = data;
+  homotopyData->userData->threadData = threadData;
+
   homotopyData->f = wrapper_fvec;
   homotopyData->f_con = wrapper_fvec_constraints;
   homotopyData->fJac_f = wrapper_fvec_der;
@@ -2241,17 +2431,28 @@ NLS_SOLVER_STATUS solveHomotopy(DATA *data, threadData_t *threadData, NONLINEAR_
         assert = 0;
       } else {
         homotopyData->fJac_f(homotopyData, homotopyData->x0, homotopyData->fJac);
-        vecCopy(homotopyData->n, homotopyData->f1, homotopyData->fJac + homotopyData->n*homotopyData->n);
-        vecCopy(homotopyData->n*homotopyData->m, homotopyData->fJac, homotopyData->fJacx0);
         if (mixedSystem)
           memcpy(relationsPreBackup, data->simulationInfo->relations, sizeof(modelica_boolean)*data->modelData->nRelations);
-        /* calculate scaling factor of residuals */
-        matVecMultAbsBB(homotopyData->n, homotopyData->fJac, homotopyData->ones, homotopyData->resScaling);
-        debugVectorDouble(OMC_LOG_NLS_JAC, "residuum scaling:", homotopyData->resScaling, homotopyData->n);
-        scaleMatrixRows(homotopyData->n, homotopyData->m, homotopyData->fJac);
+        if (homotopyData->sparseLU)
+        {
+          vecCopy(nlsSparseLUNumberOfNonZeros(homotopyData->sparseLU), nlsSparseLUValues(homotopyData->sparseLU), homotopyData->jacx0);
+          /* calculate scaling factor of residuals */
+          nlsSparseLUAbsRowSum(homotopyData->sparseLU, FALSE, homotopyData->resScaling);
+          debugVectorDouble(OMC_LOG_NLS_JAC, "residuum scaling:", homotopyData->resScaling, homotopyData->n);
+          assert = (sparseNewtonStep(homotopyData) == -1);
+        }
+        else
+        {
+          vecCopy(homotopyData->n, homotopyData->f1, homotopyData->fJac + homotopyData->n*homotopyData->n);
+          vecCopy(homotopyData->n*homotopyData->m, homotopyData->fJac, homotopyData->fJacx0);
+          /* calculate scaling factor of residuals */
+          matVecMultAbsBB(homotopyData->n, homotopyData->fJac, homotopyData->ones, homotopyData->resScaling);
+          debugVectorDouble(OMC_LOG_NLS_JAC, "residuum scaling:", homotopyData->resScaling, homotopyData->n);
+          scaleMatrixRows(homotopyData->n, homotopyData->m, homotopyData->fJac);
 
-        pos = homotopyData->n;
-        assert = (solveSystemWithTotalPivotSearch(data, homotopyData->n, homotopyData->dy0, homotopyData->fJac, homotopyData->indRow, homotopyData->indCol, &pos, &rank, homotopyData->casualTearingSet) == -1);
+          pos = homotopyData->n;
+          assert = (solveSystemWithTotalPivotSearch(data, homotopyData->n, homotopyData->dy0, homotopyData->fJac, homotopyData->indRow, homotopyData->indCol, &pos, &rank, homotopyData->casualTearingSet) == -1);
+        }
       }
       if (!assert)
         debugString(OMC_LOG_NLS_V, "regular initial point!!!");
@@ -2357,14 +2558,26 @@ NLS_SOLVER_STATUS solveHomotopy(DATA *data, threadData_t *threadData, NONLINEAR_
           alreadyTested = 1;
           vecCopy(homotopyData->n, homotopyData->x0, homotopyData->x);
           vecCopy(homotopyData->n, homotopyData->fx0, homotopyData->f1);
-          vecCopy(homotopyData->n*homotopyData->m, homotopyData->fJacx0, homotopyData->fJac);
+          if (homotopyData->sparseLU)
+          {
+            vecCopy(nlsSparseLUNumberOfNonZeros(homotopyData->sparseLU), homotopyData->jacx0, nlsSparseLUValues(homotopyData->sparseLU));
+            nlsSparseLUUpdate(homotopyData->sparseLU, homotopyData->xScaling);
 
-          /* calculate scaling factor of residuals */
-          matVecMultAbsBB(homotopyData->n, homotopyData->fJac, homotopyData->ones, homotopyData->resScaling);
-          scaleMatrixRows(homotopyData->n, homotopyData->m, homotopyData->fJac);
+            /* calculate scaling factor of residuals */
+            nlsSparseLUAbsRowSum(homotopyData->sparseLU, FALSE, homotopyData->resScaling);
+            sparseNewtonStep(homotopyData);
+          }
+          else
+          {
+            vecCopy(homotopyData->n*homotopyData->m, homotopyData->fJacx0, homotopyData->fJac);
 
-          pos = homotopyData->n;
-          solveSystemWithTotalPivotSearch(data, homotopyData->n, homotopyData->dy0, homotopyData->fJac,   homotopyData->indRow, homotopyData->indCol, &pos, &rank, homotopyData->casualTearingSet);
+            /* calculate scaling factor of residuals */
+            matVecMultAbsBB(homotopyData->n, homotopyData->fJac, homotopyData->ones, homotopyData->resScaling);
+            scaleMatrixRows(homotopyData->n, homotopyData->m, homotopyData->fJac);
+
+            pos = homotopyData->n;
+            solveSystemWithTotalPivotSearch(data, homotopyData->n, homotopyData->dy0, homotopyData->fJac,   homotopyData->indRow, homotopyData->indCol, &pos, &rank, homotopyData->casualTearingSet);
+          }
           debugDouble(OMC_LOG_NLS_V,"solve mixed system at time : ", homotopyData->timeValue);
           continue;
         }
@@ -2465,14 +2678,24 @@ NLS_SOLVER_STATUS solveHomotopy(DATA *data, threadData_t *threadData, NONLINEAR_
         homotopyData->f(homotopyData, homotopyData->x, homotopyData->f1);
 
       homotopyData->fJac_f(homotopyData, homotopyData->x, homotopyData->fJac);
-      vecCopy(homotopyData->n, homotopyData->f1, homotopyData->fJac + homotopyData->n*homotopyData->n);
-      /* calculate scaling factor of residuals */
-      matVecMultAbsBB(homotopyData->n, homotopyData->fJac, homotopyData->ones, homotopyData->resScaling);
-      debugVectorDouble(OMC_LOG_NLS_JAC, "residuum scaling:", homotopyData->resScaling, homotopyData->n);
-      scaleMatrixRows(homotopyData->n, homotopyData->m, homotopyData->fJac);
-
-      pos = homotopyData->n;
-      assert = (solveSystemWithTotalPivotSearch(data, homotopyData->n, homotopyData->dy0, homotopyData->fJac,   homotopyData->indRow, homotopyData->indCol, &pos, &rank, homotopyData->casualTearingSet) == -1);
+      if (homotopyData->sparseLU)
+      {
+        /* calculate scaling factor of residuals */
+        nlsSparseLUAbsRowSum(homotopyData->sparseLU, FALSE, homotopyData->resScaling);
+        debugVectorDouble(OMC_LOG_NLS_JAC, "residuum scaling:", homotopyData->resScaling, homotopyData->n);
+        assert = (sparseNewtonStep(homotopyData) == -1);
+      }
+      else
+      {
+        vecCopy(homotopyData->n, homotopyData->f1, homotopyData->fJac + homotopyData->n*homotopyData->n);
+        /* calculate scaling factor of residuals */
+        matVecMultAbsBB(homotopyData->n, homotopyData->fJac, homotopyData->ones, homotopyData->resScaling);
+        debugVectorDouble(OMC_LOG_NLS_JAC, "residuum scaling:", homotopyData->resScaling, homotopyData->n);
+        scaleMatrixRows(homotopyData->n, homotopyData->m, homotopyData->fJac);
+
+        pos = homotopyData->n;
+        assert = (solveSystemWithTotalPivotSearch(data, homotopyData->n, homotopyData->dy0, homotopyData->fJac,   homotopyData->indRow, homotopyData->indCol, &pos, &rank, homotopyData->casualTearingSet) == -1);
+      }
       if (!assert)
         debugString(OMC_LOG_NLS_V, "regular initial point!!!");
 #ifndef OMC_EMCC
@@ -418,6 +418,7 @@ NLS_SOLVER_STATUS solveHybrd(DATA *data, threadData_t *threadData, NONLINEAR_SYS
   int retries = 0;
   int retries2 = 0;
   int retries3 = 0;
+
   int assertCalled = 0;
   int assertRetries = 0;
   int assertMessage = 0;
@@ -426,6 +427,10 @@ NLS_SOLVER_STATUS solveHybrd(DATA *data, threadData_t *threadData, NONLINEAR_SYS
 
   relationsPreBackup = (modelica_boolean*) malloc(data->modelData->nRelations*sizeof(modelica_boolean));
 
+  /* data may be a per-thread copy, see taskGraph.c */
+  hybrdData->userData->data = data;
+  hybrdData->userData->threadData = threadData;
+
   hybrdData->numberOfFunctionEvaluations = 0;
 
   // Initialize lambda variable
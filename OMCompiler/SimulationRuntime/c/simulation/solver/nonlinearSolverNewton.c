@@ -95,7 +95,45 @@ int wrapper_fvec_newton(int n, double* x, double* fvec, NLS_USERDATA* userData,
     /* performance measurement */
     rt_ext_tp_tick(&nlsData->jacobianTimeClock);
 
-    if(nlsData->jacobianIndex != -1 && jacobian != NULL ) {
+    if(solverData->sparseLU && nlsData->jacobianIndex != -1 && jacobian != NULL) {
+      /* call generic sparse Jacobian */
+      evalJacobian(data, threadData, jacobian, NULL, nlsSparseLUValues(solverData->sparseLU), FALSE);
+      nlsSparseLUUpdate(solverData->sparseLU, NULL);
+    } else if(solverData->sparseLU) {
+      /* finite differences, columns of the same color are perturbed together */
+      const SPARSE_PATTERN* sp = nlsData->sparsePattern;
+      double* jac = nlsSparseLUValues(solverData->sparseLU);
+      double* xsave = solverData->fdWork;
+      double* delta_hh = solverData->fdWork + n;
+      double delta_h = sqrt(solverData->epsfcn);
+      unsigned int color, nz;
+      int i;
+
+      for(color = 1; color <= sp->maxColors; color++) {
+        for(i = 0; i < n; i++) {
+          if(sp->colorCols[i] == color) {
+            xsave[i] = x[i];
+            delta_hh[i] = fmax(delta_h * fmax(fabs(x[i]), fabs(fvec[i])), delta_h);
+            delta_hh[i] = ((fvec[i] >= 0) ? delta_hh[i] : -delta_hh[i]);
+            delta_hh[i] = x[i] + delta_hh[i] - x[i];
+            x[i] += delta_hh[i];
+          }
+        }
+
+        wrapper_fvec_newton(n, x, solverData->rwork, userData, 1);
+        solverData->nfev++;
+
+        for(i = 0; i < n; i++) {
+          if(sp->colorCols[i] == color) {
+            for(nz = sp->leadindex[i]; nz < sp->leadindex[i+1]; nz++) {
+              jac[nz] = (solverData->rwork[sp->index[nz]] - fvec[sp->index[nz]]) / delta_hh[i];
+            }
+            x[i] = xsave[i];
+          }
+        }
+      }
+      nlsSparseLUUpdate(solverData->sparseLU, NULL);
+    } else if(nlsData->jacobianIndex != -1 && jacobian != NULL ) {
       /* call generic dense Jacobian */
       evalJacobian(data, threadData, jacobian, NULL, solverData->fjac, TRUE);
     } else {
@@ -165,6 +203,10 @@ NLS_SOLVER_STATUS solveNewton(DATA *data, threadData_t *threadData, NONLINEAR_SY
 
   relationsPreBackup = (modelica_boolean*) malloc(data->modelData->nRelations*sizeof(modelica_boolean));
 
+  /* data may be a per-thread copy, see taskGraph.c */
+  solverData->userData->data = data;
+  solverData->userData->threadData = threadData;
+
   solverData->nfev = 0;
 
   /* try to calculate jacobian only once at the beginning of the iteration */
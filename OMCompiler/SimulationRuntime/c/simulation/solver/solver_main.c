@@ -37,6 +37,7 @@
 #include "solver_main.h"
 #include "openmodelica_func.h"
 #include "initialization/initialization.h"
+#include "checkpoint.h"
 #include "nonlinearSystem.h"
 #include "newtonIteration.h"
 #include "cvode_solver.h"
@@ -44,6 +45,7 @@
 #include "ida_solver.h"
 #include "delay.h"
 #include "events.h"
+#include "spatialDistribution.h"
 #include "util/parallel_helper.h"
 #include "util/varinfo.h"
 #include "model_help.h"
@@ -389,13 +391,23 @@ int initializeModel(DATA* data, threadData_t *threadData, const char* init_initM
 #if !defined(OMC_EMCC)
     MMC_TRY_INTERNAL(simulationJumpBuffer)
 #endif
-    if(initialization(data, threadData, init_initMethod, init_file, init_time))
+    if(omc_flag[FLAG_RESTART])
+    {
+      /* continue from a checkpoint instead of solving the initial system */
+      if(restoreCheckpoint(data, threadData, omc_flagValue[FLAG_RESTART]))
+      {
+        warningStreamPrint(OMC_LOG_STDOUT, 0, "Error restoring checkpoint. Storing results and exiting.");
+        simInfo->stopTime = simInfo->startTime;
+        retValue = -1;
+      }
+    }
+    else if(initialization(data, threadData, init_initMethod, init_file, init_time))
     {
       warningStreamPrint(OMC_LOG_STDOUT, 0, "Error in initialization. Storing results and exiting.\nUse -lv=LOG_INIT -w for more information.");
       simInfo->stopTime = simInfo->startTime;
       retValue = -1;
     }
-    if (!retValue)
+    if (!retValue && !omc_flag[FLAG_RESTART])
     {
       if (data->simulationInfo->homotopySteps == 0) {
         infoStreamPrint(OMC_LOG_SUCCESS, 0, "The initialization finished successfully without homotopy method.");
@@ -505,6 +517,10 @@ int finishSimulation(DATA* data, threadData_t *threadData, SOLVER_INFO* solverIn
     infoStreamPrint(OMC_LOG_STATS, 0, "%5ld time events", solverInfo->sampleEvents);
     messageClose(OMC_LOG_STATS);
 
+    if (data->modelData->nSpatialDistributions > 0) {
+      printSpatialDistributionStatistics(data, OMC_LOG_STATS);
+    }
+
     if(S_OPTIMIZATION == solverInfo->solverMethod || /* skip solver statistics for optimization */
        S_QSS == solverInfo->solverMethod) /* skip also for qss, since not available*/
     {
@@ -659,6 +675,13 @@ int solver_main(DATA* data, threadData_t *threadData, const char* init_initMetho
   retVal = initializeSolverData(data, threadData, &solverInfo);
   initSolverInfo = 1;
 
+  /* checkpoints only contain the state of the standard solver interface */
+  if (0 == retVal && omc_flag[FLAG_RESTART] &&
+      (S_QSS == solverInfo.solverMethod || S_OPTIMIZATION == solverInfo.solverMethod)) {
+    errorStreamPrint(OMC_LOG_STDOUT, 0, "Flag -%s is not supported by solver %s.", FLAG_NAME[FLAG_RESTART], SOLVER_METHOD_NAME[solverInfo.solverMethod]);
+    retVal = -1;
+  }
+
   /* initialize all parts of the model */
   if (0 == retVal){
     retVal = initializeModel(data, threadData, init_initMethod, init_file, init_time);
@@ -34,6 +34,8 @@
  */
 
 #include "spatialDistribution.h"
+#include "checkpoint.h"
+#include "../options.h"
 #include "../../util/omc_error.h"
 #include "../../util/ringbuffer.h"
 #include "../../openmodelica.h"
@@ -75,6 +77,15 @@ double extrapolateTransportedQuantity(const TRANSPORTED_QUANTITY_DATA* leftData,
 void addNewNodeSpatialDistribution(SPATIAL_DISTRIBUTION_DATA* spatialDistribution, int isPositiveVelocity, double position, double value, int isEvent);
 int findOppositeEndSpatialDistribution(SPATIAL_DISTRIBUTION_DATA* spatialDistribution, double in0, double in1, double posX, int isPositiveVelocity, double* eventPreValue, double* outValue);
 int pruneSpatialDistribution(SPATIAL_DISTRIBUTION_DATA* spatialDistribution, int isPositiveVelocity);
+static int findCutOffSpatialDistribution(RINGBUFFER* transportedQuantityList, int isPositiveVelocity);
+static void mergeNodeSpatialDistribution(SPATIAL_DISTRIBUTION_DATA* spatialDistribution, int front);
+
+/**
+ * @brief Access i-th node of transported quantity list.
+ */
+static OMC_INLINE TRANSPORTED_QUANTITY_DATA* quantityNode(RINGBUFFER* transportedQuantityList, int i) {
+  return (TRANSPORTED_QUANTITY_DATA*) getRingData(transportedQuantityList, i);
+}
 
 // ############################################################################
 //
@@ -99,19 +110,26 @@ SPATIAL_DISTRIBUTION_DATA* allocSpatialDistribution(unsigned int nSpatialDistrib
   /* Variables */
   int i;
   SPATIAL_DISTRIBUTION_DATA* spatialDistributionData;
+  double mergeTolerance = 0.0;
 
   if (nSpatialDistributions==0) {
     return NULL;
   }
 
+  if (omc_flag[FLAG_SPATIAL_DISTR_TOL]) {
+    mergeTolerance = atof(omc_flagValue[FLAG_SPATIAL_DISTR_TOL]);
+    infoStreamPrint(OMC_LOG_SPATIALDISTR, 0, "Merging nodes of spatial distributions with tolerance %e.", mergeTolerance);
+  }
+
   spatialDistributionData = (SPATIAL_DISTRIBUTION_DATA*) calloc(nSpatialDistributions, sizeof(SPATIAL_DISTRIBUTION_DATA));
 
   for(i=0; i<nSpatialDistributions; i++) {
     spatialDistributionData[i].index = i;
     spatialDistributionData[i].isInitialized = 0 /* false */;
-    spatialDistributionData[i].transportedQuantity = allocDoubleEndedList(sizeof(TRANSPORTED_QUANTITY_DATA)); /* empty double ended list */
-    spatialDistributionData[i].storedEvents = allocDoubleEndedList(sizeof(TRANSPORTED_EVENT_DATA));           /* empty double ended list */
+    spatialDistributionData[i].transportedQuantity = allocRingBuffer(16, sizeof(TRANSPORTED_QUANTITY_DATA));  /* empty deque */
+    spatialDistributionData[i].storedEvents = allocRingBuffer(4, sizeof(TRANSPORTED_EVENT_DATA));             /* empty deque */
     spatialDistributionData[i].lastStoredEventValue = 0;
+    spatialDistributionData[i].mergeTolerance = mergeTolerance;
   }
 
   return spatialDistributionData;
@@ -132,8 +150,8 @@ void freeSpatialDistribution(SPATIAL_DISTRIBUTION_DATA* spatialDistributionData,
   int i;
 
   for(i=0; i<nSpatialDistributions; i++) {
-    freeDoubleEndedList(spatialDistributionData[i].transportedQuantity);
-    freeDoubleEndedList(spatialDistributionData[i].storedEvents);
+    freeRingBuffer(spatialDistributionData[i].transportedQuantity);
+    freeRingBuffer(spatialDistributionData[i].storedEvents);
   }
 }
 
@@ -159,7 +177,7 @@ void initSpatialDistribution(DATA* data, threadData_t* threadData, unsigned int
   /* Variables */
   int i;
   SPATIAL_DISTRIBUTION_DATA* spatialDistributionData;
-  DOUBLE_ENDED_LIST* transportedQuantityList;
+  RINGBUFFER* transportedQuantityList;
   TRANSPORTED_QUANTITY_DATA tmpData;
   TRANSPORTED_EVENT_DATA eventData;
   int numSamePos = 0;
@@ -197,7 +215,7 @@ void initSpatialDistribution(DATA* data, threadData_t* threadData, unsigned int
   for (i=0; i<length-1; i++) {
     tmpData.position = initPnts[i];
     tmpData.value = initVals[i];
-    pushBackDoubleEndedList(transportedQuantityList, (const void*) &tmpData);
+    appendRingData(transportedQuantityList, (void*) &tmpData);
     if (initPnts[i] == initPnts[i+1]) {
       numSamePos += 1;
       if (numSamePos > 1) {
@@ -210,26 +228,139 @@ void initSpatialDistribution(DATA* data, threadData_t* threadData, unsigned int
       eventData.position = initPnts[i];
       lastZeroCrossValue = lastZeroCrossValue*(-1);
       eventData.zeroCrossValue = lastZeroCrossValue;
-      pushBackDoubleEndedList(spatialDistributionData->storedEvents, (const void*) &eventData);
+      appendRingData(spatialDistributionData->storedEvents, (void*) &eventData);
     } else {
       numSamePos = 0;
     }
   }
   tmpData.position = initPnts[length-1];
   tmpData.value = initVals[length-1];
-  pushBackDoubleEndedList(transportedQuantityList, (const void*) &tmpData);
+  appendRingData(transportedQuantityList, (void*) &tmpData);
+  spatialDistributionData->maxNodes = ringBufferLength(transportedQuantityList);
 
   spatialDistributionData->isInitialized = 1 /* true */;
 
   /* Debug info */
-  doubleEndedListPrint(transportedQuantityList, OMC_LOG_SPATIALDISTR, &printTransportedQuantity);
+  printRingBuffer(transportedQuantityList, OMC_LOG_SPATIALDISTR, &printTransportedQuantity);
   infoStreamPrint(OMC_LOG_SPATIALDISTR, 0, "List of events");
-  doubleEndedListPrint(spatialDistributionData->storedEvents, OMC_LOG_SPATIALDISTR, &printTransportedQuantity);
+  printRingBuffer(spatialDistributionData->storedEvents, OMC_LOG_SPATIALDISTR, &printTransportedQuantity);
   messageClose(OMC_LOG_SPATIALDISTR);
   infoStreamPrint(OMC_LOG_SPATIALDISTR, 0, "Finished initializing spatial distribution (index=%i)", index);
 }
 
 
+// ############################################################################
+//
+// Section for writing/ reading spatial distribution data to/from checkpoints
+//
+// ############################################################################
+
+
+/**
+ * @brief Write list with items of given size to checkpoint file.
+ *
+ * @param file          Checkpoint file opened for binary writing.
+ * @param list          List to write.
+ * @param itemSize      Size of list items.
+ * @return int          0 on success, 1 on failure.
+ */
+static int writeListCheckpoint(FILE* file, RINGBUFFER* list, size_t itemSize) {
+  int i;
+  int len = ringBufferLength(list);
+
+  if (checkpointWrite(file, &len, sizeof(int), 1)) {
+    return 1;
+  }
+  for (i = 0; i < len; i++) {
+    if (checkpointWrite(file, getRingData(list, i), itemSize, 1)) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+
+/**
+ * @brief Replace content of list with items read from checkpoint file.
+ *
+ * @param file          Checkpoint file opened for binary reading.
+ * @param list          List to overwrite.
+ * @param item          Buffer for one item.
+ * @param itemSize      Size of list items.
+ * @return int          0 on success, 1 on failure.
+ */
+static int readListCheckpoint(FILE* file, RINGBUFFER* list, void* item, size_t itemSize) {
+  int i, len;
+
+  removeLastRingData(list, ringBufferLength(list));
+  if (checkpointRead(file, &len, sizeof(int), 1) || len < 0 ||
+      checkpointCheckLength(file, (size_t) len, itemSize)) {
+    return 1;
+  }
+  for (i = 0; i < len; i++) {
+    if (checkpointRead(file, item, itemSize, 1)) {
+      return 1;
+    }
+    appendRingData(list, item);
+  }
+  return 0;
+}
+
+
+/**
+ * @brief Write transported quantities and stored events of all spatial
+ * distributions to checkpoint file.
+ *
+ * @param data        Data
+ * @param file        Checkpoint file opened for binary writing.
+ * @return int        0 on success, 1 on failure.
+ */
+int writeSpatialDistributionCheckpoint(DATA* data, FILE* file) {
+  int i;
+  SPATIAL_DISTRIBUTION_DATA* spatialDistribution;
+
+  for (i = 0; i < data->modelData->nSpatialDistributions; i++) {
+    spatialDistribution = &(data->simulationInfo->spatialDistributionData[i]);
+    if (checkpointWrite(file, &spatialDistribution->isInitialized, sizeof(modelica_boolean), 1) ||
+        checkpointWrite(file, &spatialDistribution->oldPosX, sizeof(modelica_real), 1) ||
+        checkpointWrite(file, &spatialDistribution->lastStoredEventValue, sizeof(int), 1) ||
+        writeListCheckpoint(file, spatialDistribution->transportedQuantity, sizeof(TRANSPORTED_QUANTITY_DATA)) ||
+        writeListCheckpoint(file, spatialDistribution->storedEvents, sizeof(TRANSPORTED_EVENT_DATA))) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+
+/**
+ * @brief Restore transported quantities and stored events of all spatial
+ * distributions from checkpoint file.
+ *
+ * @param data        Data
+ * @param file        Checkpoint file opened for binary reading.
+ * @return int        0 on success, 1 on failure.
+ */
+int readSpatialDistributionCheckpoint(DATA* data, FILE* file) {
+  int i;
+  SPATIAL_DISTRIBUTION_DATA* spatialDistribution;
+  TRANSPORTED_QUANTITY_DATA quantity;
+  TRANSPORTED_EVENT_DATA event;
+
+  for (i = 0; i < data->modelData->nSpatialDistributions; i++) {
+    spatialDistribution = &(data->simulationInfo->spatialDistributionData[i]);
+    if (checkpointRead(file, &spatialDistribution->isInitialized, sizeof(modelica_boolean), 1) ||
+        checkpointRead(file, &spatialDistribution->oldPosX, sizeof(modelica_real), 1) ||
+        checkpointRead(file, &spatialDistribution->lastStoredEventValue, sizeof(int), 1) ||
+        readListCheckpoint(file, spatialDistribution->transportedQuantity, &quantity, sizeof(TRANSPORTED_QUANTITY_DATA)) ||
+        readListCheckpoint(file, spatialDistribution->storedEvents, &event, sizeof(TRANSPORTED_EVENT_DATA))) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+
 // ############################################################################
 //
 // Section for evaluating spatialDistribution operator
@@ -252,8 +383,8 @@ void initSpatialDistribution(DATA* data, threadData_t* threadData, unsigned int
 void storeSpatialDistribution(DATA* data, threadData_t *threadData, unsigned int index, double in0, double in1, double posX, int isPositiveVelocity) {
   /* Variables */
   SPATIAL_DISTRIBUTION_DATA* spatialDistribution;
-  DOUBLE_ENDED_LIST* transportedQuantityList;
-  DOUBLE_ENDED_LIST* storedEventsList;
+  RINGBUFFER* transportedQuantityList;
+  RINGBUFFER* storedEventsList;
   int walkedOverEvents = 0;
   double deltaX, realDirection;
 
@@ -265,9 +396,9 @@ void storeSpatialDistribution(DATA* data, threadData_t *threadData, unsigned int
   /* Debug log */
   infoStreamPrint(OMC_LOG_SPATIALDISTR, 1, "Calling storeSpatialDistribution (index=%i, time=%e)", index, data->localData[0]->timeValue);
   infoStreamPrint(OMC_LOG_SPATIALDISTR, 0, "spatialDistribution(%f, %f, %f, %s)", in0, in1, posX, isPositiveVelocity?"true":"false");
-  doubleEndedListPrint(transportedQuantityList, OMC_LOG_SPATIALDISTR, &printTransportedQuantity);
+  printRingBuffer(transportedQuantityList, OMC_LOG_SPATIALDISTR, &printTransportedQuantity);
   infoStreamPrint(OMC_LOG_SPATIALDISTR, 0, "List of events");
-  doubleEndedListPrint(storedEventsList, OMC_LOG_SPATIALDISTR, &printTransportedQuantity);
+  printRingBuffer(storedEventsList, OMC_LOG_SPATIALDISTR, &printTransportedQuantity);
 
   if (data->simulationInfo->discreteCall) {
     errorStreamPrint(OMC_LOG_STDOUT, 0, "Discrete call of storeSpatialDistribution");
@@ -295,7 +426,7 @@ void storeSpatialDistribution(DATA* data, threadData_t *threadData, unsigned int
    * Check if it an event and only save it if has a discrete change in in0 or in1.
    */
   if (isPositiveVelocity) {
-    TRANSPORTED_QUANTITY_DATA* front = (TRANSPORTED_QUANTITY_DATA*) firstDataDoubleEndedList(transportedQuantityList);
+    TRANSPORTED_QUANTITY_DATA* front = (TRANSPORTED_QUANTITY_DATA*) getRingData(transportedQuantityList, 0);
     if (fabs(-posX - front->position) < SPATIAL_EPS) {
       if (fabs(front->value - in0) > SPATIAL_EPS) {
         addNewNodeSpatialDistribution(spatialDistribution, isPositiveVelocity, -posX, in0, 1 /* true */);
@@ -304,7 +435,7 @@ void storeSpatialDistribution(DATA* data, threadData_t *threadData, unsigned int
       addNewNodeSpatialDistribution(spatialDistribution, isPositiveVelocity, -posX, in0, 0 /* false */);
     }
   } else {
-    TRANSPORTED_QUANTITY_DATA* last = (TRANSPORTED_QUANTITY_DATA*) lastDataDoubleEndedList(transportedQuantityList);
+    TRANSPORTED_QUANTITY_DATA* last = (TRANSPORTED_QUANTITY_DATA*) getRingData(transportedQuantityList, ringBufferLength(transportedQuantityList)-1);
     if (fabs(-posX+1 - last->position) < SPATIAL_EPS) {
       if (fabs(last->value - in1) > SPATIAL_EPS) {
         addNewNodeSpatialDistribution(spatialDistribution, isPositiveVelocity, -posX+1, in1, 1 /* true */);
@@ -350,9 +481,8 @@ void storeSpatialDistribution(DATA* data, threadData_t *threadData, unsigned int
 double spatialDistribution(DATA* data, threadData_t *threadData, unsigned int index, double in0, double in1, double posX, int isPositiveVelocity, double* out1) {
   /* Variables */
   SPATIAL_DISTRIBUTION_DATA* spatialDistribution;
-  DOUBLE_ENDED_LIST* transportedQuantityList;
-  DOUBLE_ENDED_LIST_NODE* firstNode;
-  DOUBLE_ENDED_LIST_NODE* lastNode;
+  RINGBUFFER* transportedQuantityList;
+  int nNodes;
   TRANSPORTED_QUANTITY_DATA* firstNodeData;
   TRANSPORTED_QUANTITY_DATA* secondNodeData;
   TRANSPORTED_QUANTITY_DATA* lastNodeData;
@@ -373,7 +503,7 @@ double spatialDistribution(DATA* data, threadData_t *threadData, unsigned int in
   infoStreamPrint(OMC_LOG_SPATIALDISTR, 1, "Calling spatialDistribution (index=%i, time=%e)", index, data->localData[0]->timeValue);
   infoStreamPrint(OMC_LOG_SPATIALDISTR, 0, "(out0,out1) = spatialDistribution(%f, %f, %f, %s)", in0, in1, posX, isPositiveVelocity?"true":"false");
   infoStreamPrint(OMC_LOG_SPATIALDISTR, 0, "                                     in0        in1        x     isPositiveVelocity");
-  doubleEndedListPrint(transportedQuantityList, OMC_LOG_SPATIALDISTR, &printTransportedQuantity);
+  printRingBuffer(transportedQuantityList, OMC_LOG_SPATIALDISTR, &printTransportedQuantity);
 
   /* Get deltaX */
   deltaX = spatialDistribution->oldPosX - posX;
@@ -401,8 +531,8 @@ double spatialDistribution(DATA* data, threadData_t *threadData, unsigned int in
 
   /* Special case: Zero progress */
   if (deltaX < SPATIAL_EPS) {
-    firstNodeData = (TRANSPORTED_QUANTITY_DATA*) firstDataDoubleEndedList(transportedQuantityList);
-    lastNodeData = (TRANSPORTED_QUANTITY_DATA*) lastDataDoubleEndedList(transportedQuantityList);
+    firstNodeData = (TRANSPORTED_QUANTITY_DATA*) getRingData(transportedQuantityList, 0);
+    lastNodeData = (TRANSPORTED_QUANTITY_DATA*) getRingData(transportedQuantityList, ringBufferLength(transportedQuantityList)-1);
     out0 = firstNodeData->value;
     *out1 = lastNodeData->value;
     infoStreamPrint(OMC_LOG_SPATIALDISTR, 0, "(out0,out1) = (%f, %f)", out0, *out1);
@@ -425,10 +555,11 @@ double spatialDistribution(DATA* data, threadData_t *threadData, unsigned int in
   }
 
   /* Extrapolate return values to break up quasi-loop with inputs */
-  firstNodeData = (TRANSPORTED_QUANTITY_DATA*) firstDataDoubleEndedList(transportedQuantityList);
-  secondNodeData = dataDoubleEndedList(getNextNodeDoubleEndedList(getFirstNodeDoubleEndedList(transportedQuantityList)));
-  lastNodeData = (TRANSPORTED_QUANTITY_DATA*) lastDataDoubleEndedList(transportedQuantityList);
-  forelastNodeData = dataDoubleEndedList(getPreviousNodeDoubleEndedList(getLastNodeDoubleEndedList(transportedQuantityList)));
+  nNodes = ringBufferLength(transportedQuantityList);
+  firstNodeData = quantityNode(transportedQuantityList, 0);
+  secondNodeData = quantityNode(transportedQuantityList, 1);
+  lastNodeData = quantityNode(transportedQuantityList, nNodes-1);
+  forelastNodeData = quantityNode(transportedQuantityList, nNodes-2);
   if (isPositiveVelocity) {
     if (jumped) {
       out0 = in0;
@@ -479,8 +610,8 @@ double spatialDistribution(DATA* data, threadData_t *threadData, unsigned int in
 double spatialDistributionZeroCrossing(DATA* data, threadData_t *threadData, unsigned int index, unsigned int relationIndex, double posX, int isPositiveVelocity) {
   /* Variables */
   SPATIAL_DISTRIBUTION_DATA* spatialDistribution;
-  DOUBLE_ENDED_LIST* storedEventsList;
-  DOUBLE_ENDED_LIST_NODE* currentNode;
+  RINGBUFFER* storedEventsList;
+  int nEvents, i;
   TRANSPORTED_EVENT_DATA* currentNodeData;
   double zeroCrossingValue;
   double prevPosition, prevValue;
@@ -489,20 +620,21 @@ double spatialDistributionZeroCrossing(DATA* data, threadData_t *threadData, uns
   spatialDistribution = &(data->simulationInfo->spatialDistributionData[index]);
   storedEventsList = spatialDistribution->storedEvents;
 
-  if (doubleEndedListLen(storedEventsList) == 0) {
+  if (ringBufferLength(storedEventsList) == 0) {
     zeroCrossingValue = data->simulationInfo->zeroCrossingsPre[relationIndex];
     infoStreamPrint(OMC_LOG_SPATIALDISTR, 0, "List of events for spatialDistributionZeroCrossing(%e) = %e\n", posX, zeroCrossingValue);
     return zeroCrossingValue;
   }
 
   if (isPositiveVelocity) {
-    currentNode = getLastNodeDoubleEndedList(storedEventsList);
-    currentNodeData = dataDoubleEndedList(currentNode);
+    nEvents = ringBufferLength(storedEventsList);
+    i = nEvents-1;
+    currentNodeData = (TRANSPORTED_EVENT_DATA*) getRingData(storedEventsList, i);
     // -posX+1 is behind last event
     if (currentNodeData->position < -posX+1 ) {
       zeroCrossingValue = -currentNodeData->zeroCrossValue;
     } else {
-      while (currentNode != NULL) {
+      for (;;) {
         // Am I on an event?
         if (fabs(currentNodeData->position+posX-1) <= SPATIAL_EPS) {
           zeroCrossingValue = -currentNodeData->zeroCrossValue;
@@ -511,13 +643,13 @@ double spatialDistributionZeroCrossing(DATA* data, threadData_t *threadData, uns
 
         prevPosition = currentNodeData->position;
         prevValue = currentNodeData->zeroCrossValue;
-        currentNode = getPreviousNodeDoubleEndedList(currentNode);
+        i--;
         // Did I walk over the first element in the list?
-        if (currentNode==NULL) {
+        if (i < 0) {
           zeroCrossingValue = prevValue;  /* prevValue value of first list element */
           break;
         }
-        currentNodeData = dataDoubleEndedList(currentNode);
+        currentNodeData = (TRANSPORTED_EVENT_DATA*) getRingData(storedEventsList, i);
 
         // Are we between two events?
         if (currentNodeData->position < -posX+1 && -posX+1 < prevPosition) {
@@ -527,13 +659,14 @@ double spatialDistributionZeroCrossing(DATA* data, threadData_t *threadData, uns
       }
     }
   } else {
-    currentNode = getFirstNodeDoubleEndedList(storedEventsList);
-    currentNodeData = dataDoubleEndedList(currentNode);
+    nEvents = ringBufferLength(storedEventsList);
+    i = 0;
+    currentNodeData = (TRANSPORTED_EVENT_DATA*) getRingData(storedEventsList, i);
     // -posX is before first event
     if (currentNodeData->position > -posX ) {
       zeroCrossingValue = currentNodeData->zeroCrossValue;
     } else {
-      while (currentNode != NULL) {
+      for (;;) {
         // Am I on an event?
         if (fabs(currentNodeData->position+posX) <= SPATIAL_EPS) {
           zeroCrossingValue = -currentNodeData->zeroCrossValue;
@@ -542,13 +675,13 @@ double spatialDistributionZeroCrossing(DATA* data, threadData_t *threadData, uns
 
         prevPosition = currentNodeData->position;
         prevValue = currentNodeData->zeroCrossValue;
-        currentNode = getNextNodeDoubleEndedList(currentNode);
-        // Did I walk over the first element in the list?
-        if (currentNode==NULL) {
+        i++;
+        // Did I walk over the last element in the list?
+        if (i >= nEvents) {
           zeroCrossingValue = -prevValue;  /* prevValue value of first list element */
           break;
         }
-        currentNodeData = dataDoubleEndedList(currentNode);
+        currentNodeData = (TRANSPORTED_EVENT_DATA*) getRingData(storedEventsList, i);
 
         // Are we between two events?
         if (currentNodeData->position > -posX && -posX > prevPosition) {
@@ -561,7 +694,7 @@ double spatialDistributionZeroCrossing(DATA* data, threadData_t *threadData, uns
 
 
   infoStreamPrint(OMC_LOG_SPATIALDISTR, 0, "List of events for spatialDistributionZeroCrossing(%e) = %e\n", posX, zeroCrossingValue);
-  doubleEndedListPrint(storedEventsList, OMC_LOG_SPATIALDISTR, &printTransportedQuantity);
+  printRingBuffer(storedEventsList, OMC_LOG_SPATIALDISTR, &printTransportedQuantity);
 
   return zeroCrossingValue;
 }
@@ -638,7 +771,7 @@ double extrapolateTransportedQuantity(const TRANSPORTED_QUANTITY_DATA* leftData,
  * For positive velocity add at frond, else at back.
  * If this node is an event node add an event to stored events list as well.
  *
- * @param transportedQuantityList     Double ended list representing spatial distribution.
+ * @param transportedQuantityList     Ring buffer representing spatial distribution.
  * @param front                       Boolean value if node should be added at the front (true) or the end (false).
  * @param position                    Position of new node.
  * @param value                       Value of new node.
@@ -646,8 +779,8 @@ double extrapolateTransportedQuantity(const TRANSPORTED_QUANTITY_DATA* leftData,
  */
 void addNewNodeSpatialDistribution(SPATIAL_DISTRIBUTION_DATA* spatialDistribution, int front, double position, double value, int isEvent) {
   /* Variables */
-  DOUBLE_ENDED_LIST* transportedQuantityList = spatialDistribution->transportedQuantity;
-  DOUBLE_ENDED_LIST* storedEventsList = spatialDistribution->storedEvents;
+  RINGBUFFER* transportedQuantityList = spatialDistribution->transportedQuantity;
+  RINGBUFFER* storedEventsList = spatialDistribution->storedEvents;
   TRANSPORTED_QUANTITY_DATA newNodeData;
   TRANSPORTED_EVENT_DATA newEventNodeData;
 
@@ -660,20 +793,29 @@ void addNewNodeSpatialDistribution(SPATIAL_DISTRIBUTION_DATA* spatialDistributio
   infoStreamPrint(OMC_LOG_SPATIALDISTR, 0, "Adding (%e,%e) at %s.", newNodeData.position, newNodeData.value, front?"front":"back");
   if (front) {
     // Make sure new first node is smaller then previous first node
-    TRANSPORTED_QUANTITY_DATA* oldFront = (TRANSPORTED_QUANTITY_DATA*) firstDataDoubleEndedList(transportedQuantityList);
+    TRANSPORTED_QUANTITY_DATA* oldFront = (TRANSPORTED_QUANTITY_DATA*) getRingData(transportedQuantityList, 0);
     assertStreamPrint(NULL, position<=oldFront->position, "New front position is not smaller then previous first node.");
-    pushFrontDoubleEndedList(transportedQuantityList, (const void*) &newNodeData);
+    prependRingData(transportedQuantityList, (void*) &newNodeData);
   } else {
     // Make sure new first node is smaller then previous first node
-    TRANSPORTED_QUANTITY_DATA* oldEnd = (TRANSPORTED_QUANTITY_DATA*) lastDataDoubleEndedList(transportedQuantityList);
+    TRANSPORTED_QUANTITY_DATA* oldEnd = (TRANSPORTED_QUANTITY_DATA*) getRingData(transportedQuantityList, ringBufferLength(transportedQuantityList)-1);
     assertStreamPrint(NULL, position>=oldEnd->position, "New end position is not bigger then previous last node.");
-    pushBackDoubleEndedList(transportedQuantityList, (const void*) &newNodeData);
+    appendRingData(transportedQuantityList, (void*) &newNodeData);
+  }
+  spatialDistribution->nAddedNodes++;
+
+  /* Merge neighbor of new node if it is (almost) on the line between its neighbors */
+  if (spatialDistribution->mergeTolerance > 0 && isEvent != 1 && ringBufferLength(transportedQuantityList) >= 3) {
+    mergeNodeSpatialDistribution(spatialDistribution, front);
+  }
+  if (ringBufferLength(transportedQuantityList) > spatialDistribution->maxNodes) {
+    spatialDistribution->maxNodes = ringBufferLength(transportedQuantityList);
   }
 
   /* Add event to stored event list */
   if (isEvent == 1) {
     if (front) {
-      if (doubleEndedListLen(storedEventsList) == 0) {
+      if (ringBufferLength(storedEventsList) == 0) {
         if (spatialDistribution->lastStoredEventValue==0) {
           newEventNodeData.zeroCrossValue = 1;
         } else {
@@ -681,36 +823,36 @@ void addNewNodeSpatialDistribution(SPATIAL_DISTRIBUTION_DATA* spatialDistributio
         }
       } else {
         // Make sure new first node is smaller then previous first node
-        TRANSPORTED_EVENT_DATA* oldEventFront = (TRANSPORTED_EVENT_DATA*) firstDataDoubleEndedList(storedEventsList);
+        TRANSPORTED_EVENT_DATA* oldEventFront = (TRANSPORTED_EVENT_DATA*) getRingData(storedEventsList, 0);
         assertStreamPrint(NULL, position<=oldEventFront->position, "New front position is not smaller then previous first event node.");
         newEventNodeData.zeroCrossValue = oldEventFront->zeroCrossValue*(-1);
       }
-      pushFrontDoubleEndedList(storedEventsList, (const void*) &newEventNodeData);
+      prependRingData(storedEventsList, (void*) &newEventNodeData);
     } else {
-      if (doubleEndedListLen(storedEventsList) == 0) {
+      if (ringBufferLength(storedEventsList) == 0) {
         newEventNodeData.zeroCrossValue = 1;
       } else {
         // Make sure new first node is smaller then previous first node
-        TRANSPORTED_EVENT_DATA* oldEventEnd = (TRANSPORTED_EVENT_DATA*) lastDataDoubleEndedList(storedEventsList);
+        TRANSPORTED_EVENT_DATA* oldEventEnd = (TRANSPORTED_EVENT_DATA*) getRingData(storedEventsList, ringBufferLength(storedEventsList)-1);
         assertStreamPrint(NULL, position>=oldEventEnd->position, "New end position is not bigger then previous last event node.");
         newEventNodeData.zeroCrossValue = oldEventEnd->zeroCrossValue*(-1);
       }
-      pushBackDoubleEndedList(storedEventsList, (const void*) &newEventNodeData);
+      appendRingData(storedEventsList, (void*) &newEventNodeData);
     }
     infoStreamPrint(OMC_LOG_SPATIALDISTR, 0, "Adding event (%e,%e) at %s.", newEventNodeData.position, newEventNodeData.zeroCrossValue, front?"front":"back");
   }
 
   /* Debug prints */
-  doubleEndedListPrint(transportedQuantityList, OMC_LOG_SPATIALDISTR, &printTransportedQuantity);
+  printRingBuffer(transportedQuantityList, OMC_LOG_SPATIALDISTR, &printTransportedQuantity);
   infoStreamPrint(OMC_LOG_SPATIALDISTR, 0, "List of events");
-  doubleEndedListPrint(storedEventsList, OMC_LOG_SPATIALDISTR, &printTransportedQuantity);
+  printRingBuffer(storedEventsList, OMC_LOG_SPATIALDISTR, &printTransportedQuantity);
 }
 
 
 /**
  * @brief Gets value from opposite end of list.
  *
- * @param transportedQuantityList     Double ended list containing spatial distribution.
+ * @param transportedQuantityList     Ring buffer containing spatial distribution.
  * @param isPositiveVelocity          Boolean describing if velocity v is positive (>=0).
  *                                    Velocity v is `v:=der(x)`.
  * @param eventPreValue               On output containing value of first/last node before event.
@@ -719,12 +861,9 @@ void addNewNodeSpatialDistribution(SPATIAL_DISTRIBUTION_DATA* spatialDistributio
  */
 int findOppositeEndSpatialDistribution(SPATIAL_DISTRIBUTION_DATA* spatialDistribution, double in0, double in1, double posX, int isPositiveVelocity, double* eventPreValue, double* outValue) {
   /* Variables */
-  DOUBLE_ENDED_LIST* transportedQuantityList = spatialDistribution->transportedQuantity;
-  DOUBLE_ENDED_LIST* storedEventsList = spatialDistribution->storedEvents;
-  DOUBLE_ENDED_LIST_NODE* currentNode;
-  DOUBLE_ENDED_LIST_NODE* firstNode;
-  DOUBLE_ENDED_LIST_NODE* lastNode;
-  DOUBLE_ENDED_LIST_NODE* prevVisitedNode;
+  RINGBUFFER* transportedQuantityList = spatialDistribution->transportedQuantity;
+  RINGBUFFER* storedEventsList = spatialDistribution->storedEvents;
+  int nNodes, cutOff, i;
   TRANSPORTED_QUANTITY_DATA* currentNodeData;
   TRANSPORTED_QUANTITY_DATA* prevVisitedNodeData;
   TRANSPORTED_QUANTITY_DATA* firstNodeData;
@@ -737,10 +876,9 @@ int findOppositeEndSpatialDistribution(SPATIAL_DISTRIBUTION_DATA* spatialDistrib
   /* Step 0
    * Check if we are still in spatialDistribution intervall or if deltaX > 1
    */
-  firstNode = getFirstNodeDoubleEndedList(transportedQuantityList);
-  firstNodeData = firstDataDoubleEndedList(transportedQuantityList);
-  lastNode = getLastNodeDoubleEndedList(transportedQuantityList);
-  lastNodeData = lastDataDoubleEndedList(transportedQuantityList);
+  nNodes = ringBufferLength(transportedQuantityList);
+  firstNodeData = quantityNode(transportedQuantityList, 0);
+  lastNodeData = quantityNode(transportedQuantityList, nNodes-1);
   if (isPositiveVelocity) {
     if (-posX+1 < firstNodeData->position) {
       // We need to interpolate (-posX,in0) <-> (-posX+1,out1) <-> (firstNodeData->position, firstNodeData->value)
@@ -749,7 +887,7 @@ int findOppositeEndSpatialDistribution(SPATIAL_DISTRIBUTION_DATA* spatialDistrib
       tempData.position = -posX;
       tempData.value = in0;
       *outValue = interpolateTransportedQuantity(&tempData, firstNodeData, -posX + 1);
-      return doubleEndedListLen(storedEventsList);
+      return ringBufferLength(storedEventsList);
     }
   } else {
     if (-posX > lastNodeData->position) {
@@ -759,22 +897,21 @@ int findOppositeEndSpatialDistribution(SPATIAL_DISTRIBUTION_DATA* spatialDistrib
       tempData.position = -posX+1;
       tempData.value = in1;
       *outValue = interpolateTransportedQuantity(lastNodeData, &tempData, -posX);
-      return doubleEndedListLen(storedEventsList);
+      return ringBufferLength(storedEventsList);
     }
   }
 
   /* Step 1
-   * Walk over list, starting from opposite side of edgeNode,
-   * until distance between currentNode and edgeNode < 1.
+   * Find the node nearest to the opposite side of edgeNode that still has a
+   * distance >= 1 to edgeNode. Nodes are sorted by position, so bisect.
    */
   if (isPositiveVelocity) {
     edgeNodePosition = firstNodeData->position;
-    currentNode = lastNode;
+    currentNodeData = lastNodeData;
   } else {
     edgeNodePosition = lastNodeData->position;
-    currentNode = firstNode;
+    currentNodeData = firstNodeData;
   }
-  currentNodeData = (TRANSPORTED_QUANTITY_DATA*) dataDoubleEndedList(currentNode);
 
   currentDistance = fabs(currentNodeData->position - edgeNodePosition);
   if (currentDistance + SPATIAL_EPS < 1) {
@@ -783,55 +920,36 @@ int findOppositeEndSpatialDistribution(SPATIAL_DISTRIBUTION_DATA* spatialDistrib
     return walkedOverEvents;
   }
 
-  /* Move to neighbor */
-  prevVisitedNode = currentNode;
-  prevVisitedNodeData = (TRANSPORTED_QUANTITY_DATA*) dataDoubleEndedList(prevVisitedNode);
+  cutOff = findCutOffSpatialDistribution(transportedQuantityList, isPositiveVelocity);
+  prevVisitedNodeData = quantityNode(transportedQuantityList, cutOff);
+  currentNodeData = quantityNode(transportedQuantityList, isPositiveVelocity ? cutOff-1 : cutOff+1);
 
-  while (currentNode != NULL) {
-    if (isPositiveVelocity) {
-      currentNode = getPreviousNodeDoubleEndedList(currentNode);
-    } else {
-      currentNode = getNextNodeDoubleEndedList(currentNode);
-    }
-    if(currentNode == NULL) {
-      break;
-    }
-    currentNodeData = (TRANSPORTED_QUANTITY_DATA*) dataDoubleEndedList(currentNode);
-
-    /* Check for event:
-     * Current node position equal to previous visited node position
-     */
-    if (fabs(prevVisitedNodeData->position - currentNodeData->position) < SPATIAL_EPS) {
-      *eventPreValue = prevVisitedNodeData->value;
-      walkedOverEvents += 1;
+  /* Count events between opposite end and first node with distance < 1.
+   * An event is a pair of consecutive nodes at the same position.
+   */
+  if (isPositiveVelocity) {
+    for (i = nNodes-1; i >= cutOff; i--) {
+      if (fabs(quantityNode(transportedQuantityList, i)->position - quantityNode(transportedQuantityList, i-1)->position) < SPATIAL_EPS) {
+        *eventPreValue = quantityNode(transportedQuantityList, i)->value;
+        walkedOverEvents += 1;
+      }
     }
-
-    /* Check if distance between currentNode and edgeNode is < 1 */
-    currentDistance = fabs(currentNodeData->position - edgeNodePosition);
-    if (currentDistance + SPATIAL_EPS < 1) {
-      break;
-    } else {
-      prevVisitedNode = currentNode;
-      prevVisitedNodeData = (TRANSPORTED_QUANTITY_DATA*) dataDoubleEndedList(prevVisitedNode);
+  } else {
+    for (i = 0; i <= cutOff; i++) {
+      if (fabs(quantityNode(transportedQuantityList, i)->position - quantityNode(transportedQuantityList, i+1)->position) < SPATIAL_EPS) {
+        *eventPreValue = quantityNode(transportedQuantityList, i)->value;
+        walkedOverEvents += 1;
+      }
     }
   }
 
   /* Step 2
    * Interpolate at edgeNodePosition +/- 1.
    */
-  if (currentNode == NULL) {
-    /* Walked over all elements of list */
-    if (isPositiveVelocity) {
-      *outValue = lastNodeData->value;
-    } else {
-      *outValue = firstNodeData->value;
-    }
+  if (isPositiveVelocity) {
+    *outValue = interpolateTransportedQuantity(currentNodeData, prevVisitedNodeData, edgeNodePosition + 1);
   } else {
-    if (isPositiveVelocity) {
-      *outValue = interpolateTransportedQuantity(currentNodeData, prevVisitedNodeData, edgeNodePosition + 1);
-    } else {
-      *outValue = interpolateTransportedQuantity(prevVisitedNodeData, currentNodeData, edgeNodePosition - 1);
-    }
+    *outValue = interpolateTransportedQuantity(prevVisitedNodeData, currentNodeData, edgeNodePosition - 1);
   }
 
   return walkedOverEvents;
@@ -842,7 +960,7 @@ int findOppositeEndSpatialDistribution(SPATIAL_DISTRIBUTION_DATA* spatialDistrib
 /**
  * @brief Remove nodes until distance between first and last element is 1.
  *
- * @param transportedQuantityList     Double ended list containing spatial distribution.
+ * @param transportedQuantityList     Ring buffer containing spatial distribution.
  * @param isPositiveVelocity          Boolean describing if velocity v is positive (>=0).
  *                                    Velocity v is `v:=der(x)`.
  * @param eventPreValue               On output containing value of first/last node before event.
@@ -851,32 +969,28 @@ int findOppositeEndSpatialDistribution(SPATIAL_DISTRIBUTION_DATA* spatialDistrib
  */
 int pruneSpatialDistribution(SPATIAL_DISTRIBUTION_DATA* spatialDistribution, int isPositiveVelocity) {
   /* Variables */
-  DOUBLE_ENDED_LIST* transportedQuantityList = spatialDistribution->transportedQuantity;
-  DOUBLE_ENDED_LIST* storedEventsList = spatialDistribution->storedEvents;
-  DOUBLE_ENDED_LIST_NODE* edgeNode;
-  DOUBLE_ENDED_LIST_NODE* currentNode;
-  DOUBLE_ENDED_LIST_NODE* prevVisitedNode;
+  RINGBUFFER* transportedQuantityList = spatialDistribution->transportedQuantity;
+  RINGBUFFER* storedEventsList = spatialDistribution->storedEvents;
   TRANSPORTED_QUANTITY_DATA* edgeNodeData;
   TRANSPORTED_QUANTITY_DATA* currentNodeData;
   TRANSPORTED_QUANTITY_DATA* prevVisitedNodeData;
   TRANSPORTED_EVENT_DATA* eventData;
   int walkedOverEvents = 0;
-  int i;
+  int nNodes, cutOff, i;
   double currentDistance;
 
   /* Step 1
-   * Walk over list, starting from opposite side of edgeNode,
-   * until distance between currentNode and edgeNode < 1.
+   * Find the node nearest to the opposite side of edgeNode that still has a
+   * distance >= 1 to edgeNode.
    */
+  nNodes = ringBufferLength(transportedQuantityList);
   if (isPositiveVelocity) {
-    edgeNode = getFirstNodeDoubleEndedList(transportedQuantityList);
-    currentNode = getLastNodeDoubleEndedList(transportedQuantityList);
+    edgeNodeData = quantityNode(transportedQuantityList, 0);
+    currentNodeData = quantityNode(transportedQuantityList, nNodes-1);
   } else {
-    edgeNode = getLastNodeDoubleEndedList(transportedQuantityList);
-    currentNode = getFirstNodeDoubleEndedList(transportedQuantityList);
+    edgeNodeData = quantityNode(transportedQuantityList, nNodes-1);
+    currentNodeData = quantityNode(transportedQuantityList, 0);
   }
-  edgeNodeData  = (TRANSPORTED_QUANTITY_DATA*) dataDoubleEndedList(edgeNode);
-  currentNodeData = (TRANSPORTED_QUANTITY_DATA*) dataDoubleEndedList(currentNode);
 
   currentDistance = fabs(currentNodeData->position - edgeNodeData->position);
   if (currentDistance + SPATIAL_EPS < 1) {
@@ -884,97 +998,194 @@ int pruneSpatialDistribution(SPATIAL_DISTRIBUTION_DATA* spatialDistribution, int
     omc_throw_function(NULL);
   }
 
-  /* Move to neighbor */
-  prevVisitedNode = currentNode;
-  prevVisitedNodeData = (TRANSPORTED_QUANTITY_DATA*) dataDoubleEndedList(prevVisitedNode);
-
-  while (currentNode != edgeNode) {
-    if (isPositiveVelocity) {
-      currentNode = getPreviousNodeDoubleEndedList(currentNode);
-    } else {
-      currentNode = getNextNodeDoubleEndedList(currentNode);
-    }
-    currentNodeData = (TRANSPORTED_QUANTITY_DATA*) dataDoubleEndedList(currentNode);
+  cutOff = findCutOffSpatialDistribution(transportedQuantityList, isPositiveVelocity);
+  prevVisitedNodeData = quantityNode(transportedQuantityList, cutOff);
+  currentNodeData = quantityNode(transportedQuantityList, isPositiveVelocity ? cutOff-1 : cutOff+1);
 
-    /* Check for event:
-     * Current node position equal to previous visited node position
-     */
-    if (fabs(prevVisitedNodeData->position - currentNodeData->position) < SPATIAL_EPS) {
-      walkedOverEvents += 1;
+  if (isPositiveVelocity) {
+    for (i = nNodes-1; i >= cutOff; i--) {
+      if (fabs(quantityNode(transportedQuantityList, i)->position - quantityNode(transportedQuantityList, i-1)->position) < SPATIAL_EPS) {
+        walkedOverEvents += 1;
+      }
     }
-
-    /* Check if distance between currentNode and edgeNode is < 1 */
-    currentDistance = fabs(currentNodeData->position - edgeNodeData->position);
-    if (currentDistance + SPATIAL_EPS < 1) {
-      break;
-    } else {
-      prevVisitedNode = currentNode;
-      prevVisitedNodeData = (TRANSPORTED_QUANTITY_DATA*) dataDoubleEndedList(prevVisitedNode);
+  } else {
+    for (i = 0; i <= cutOff; i++) {
+      if (fabs(quantityNode(transportedQuantityList, i)->position - quantityNode(transportedQuantityList, i+1)->position) < SPATIAL_EPS) {
+        walkedOverEvents += 1;
+      }
     }
   }
 
   /* Step 2
    * Interpolate at edgeNode->position +/- 1.
    */
-  if (currentDistance + SPATIAL_EPS < 1) {
-    if (isPositiveVelocity) {
-      prevVisitedNodeData->value = interpolateTransportedQuantity(currentNodeData, prevVisitedNodeData, edgeNodeData->position + 1);
-      prevVisitedNodeData->position = edgeNodeData->position + 1;
-    } else {
-      prevVisitedNodeData->value = interpolateTransportedQuantity(prevVisitedNodeData, currentNodeData, edgeNodeData->position - 1);
-      prevVisitedNodeData->position = edgeNodeData->position - 1;
-    }
-    infoStreamPrint(OMC_LOG_SPATIALDISTR, 0, "Interpolate at %s", isPositiveVelocity?"end":"front");
+  if (isPositiveVelocity) {
+    prevVisitedNodeData->value = interpolateTransportedQuantity(currentNodeData, prevVisitedNodeData, edgeNodeData->position + 1);
+    prevVisitedNodeData->position = edgeNodeData->position + 1;
+  } else {
+    prevVisitedNodeData->value = interpolateTransportedQuantity(prevVisitedNodeData, currentNodeData, edgeNodeData->position - 1);
+    prevVisitedNodeData->position = edgeNodeData->position - 1;
   }
+  infoStreamPrint(OMC_LOG_SPATIALDISTR, 0, "Interpolate at %s", isPositiveVelocity?"end":"front");
 
   /* Step 3
    * Remove all nodes that have a distance to edge > 1.
    */
-  infoStreamPrint(OMC_LOG_SPATIALDISTR, 0, "Removing nodes %s node %p", isPositiveVelocity?"after":"before", prevVisitedNode);
+  infoStreamPrint(OMC_LOG_SPATIALDISTR, 0, "Removing nodes %s node %i", isPositiveVelocity?"after":"before", cutOff);
   if (isPositiveVelocity) {
-    clearAfterNodeDoubleEndedList(transportedQuantityList, prevVisitedNode);
-  } else {
-    clearBeforeNodeDoubleEndedList(transportedQuantityList, prevVisitedNode);
+    removeLastRingData(transportedQuantityList, nNodes-1-cutOff);
+  } else if (cutOff > 0) {
+    dequeueNFirstRingDatas(transportedQuantityList, cutOff);
   }
-
   /* Step 4
    * Remove all events that are outside spatial distribution [leftEdge-SPATIAL_ZERO_DELTA_X, rightEdge+SPATIAL_ZERO_DELTA_X]
    */
-  if (doubleEndedListLen(storedEventsList) > 0) {
+  if (ringBufferLength(storedEventsList) > 0) {
     if (isPositiveVelocity) {
-      eventData = lastDataDoubleEndedList(storedEventsList);
+      eventData = getRingData(storedEventsList, ringBufferLength(storedEventsList)-1);
       while (edgeNodeData->position+1 + SPATIAL_ZERO_DELTA_X < eventData->position) {
         spatialDistribution->lastStoredEventValue = eventData->zeroCrossValue;
-        removeLastDoubleEndedList(storedEventsList);
-        if (doubleEndedListLen(storedEventsList) == 0) {
+        removeLastRingData(storedEventsList, 1);
+        if (ringBufferLength(storedEventsList) == 0) {
           break;
         } else {
-          eventData = lastDataDoubleEndedList(storedEventsList);
+          eventData = getRingData(storedEventsList, ringBufferLength(storedEventsList)-1);
         }
       }
     } else {
-      eventData = firstDataDoubleEndedList(storedEventsList);
+      eventData = getRingData(storedEventsList, 0);
       while (edgeNodeData->position-1 - SPATIAL_ZERO_DELTA_X > eventData->position) {
         spatialDistribution->lastStoredEventValue = eventData->zeroCrossValue;
-        removeFirstDoubleEndedList(storedEventsList);
-        if (doubleEndedListLen(storedEventsList) == 0) {
+        if (ringBufferLength(storedEventsList) == 1) {
+          removeLastRingData(storedEventsList, 1);
+          break;
+        }
+        dequeueNFirstRingDatas(storedEventsList, 1);
+        if (ringBufferLength(storedEventsList) == 0) {
           break;
         } else {
-          eventData = firstDataDoubleEndedList(storedEventsList);
+          eventData = getRingData(storedEventsList, 0);
         }
       }
     }
   }
 
   /* Debug prints */
-  doubleEndedListPrint(transportedQuantityList, OMC_LOG_SPATIALDISTR, &printTransportedQuantity);
+  printRingBuffer(transportedQuantityList, OMC_LOG_SPATIALDISTR, &printTransportedQuantity);
   infoStreamPrint(OMC_LOG_SPATIALDISTR, 0, "List of events");
-  doubleEndedListPrint(storedEventsList, OMC_LOG_SPATIALDISTR, &printTransportedQuantity);
+  printRingBuffer(storedEventsList, OMC_LOG_SPATIALDISTR, &printTransportedQuantity);
 
   return walkedOverEvents;
 }
 
 
+/**
+ * @brief Remove neighbor of newly added edge node if it can be interpolated.
+ *
+ * The second (front) or forelast (back) node is removed if linear interpolation
+ * between its neighbors reproduces its value within the merge tolerance.
+ * Nodes belonging to an event are never removed.
+ *
+ * @param spatialDistribution   Spatial distribution with at least three nodes.
+ * @param front                 Boolean describing if new node was added at front.
+ */
+static void mergeNodeSpatialDistribution(SPATIAL_DISTRIBUTION_DATA* spatialDistribution, int front) {
+  RINGBUFFER* transportedQuantityList = spatialDistribution->transportedQuantity;
+  int nNodes = ringBufferLength(transportedQuantityList);
+  int i = front ? 1 : nNodes-2;
+  TRANSPORTED_QUANTITY_DATA* prevNodeData = quantityNode(transportedQuantityList, i-1);
+  TRANSPORTED_QUANTITY_DATA* nodeData = quantityNode(transportedQuantityList, i);
+  TRANSPORTED_QUANTITY_DATA* nextNodeData = quantityNode(transportedQuantityList, i+1);
+
+  if (fabs(nodeData->position - prevNodeData->position) < SPATIAL_EPS ||
+      fabs(nextNodeData->position - nodeData->position) < SPATIAL_EPS) {
+    return;
+  }
+  if (fabs(interpolateTransportedQuantity(prevNodeData, nextNodeData, nodeData->position) - nodeData->value) > spatialDistribution->mergeTolerance) {
+    return;
+  }
+
+  infoStreamPrint(OMC_LOG_SPATIALDISTR, 0, "Merging node (%e,%e).", nodeData->position, nodeData->value);
+  if (front) {
+    *nodeData = *prevNodeData;
+    dequeueNFirstRingDatas(transportedQuantityList, 1);
+  } else {
+    *nodeData = *nextNodeData;
+    removeLastRingData(transportedQuantityList, 1);
+  }
+  spatialDistribution->nMergedNodes++;
+}
+
+
+/**
+ * @brief Find node at distance one to the edge.
+ *
+ * Nodes are sorted by position, so the distance to the edge node is monotonic
+ * and the node can be found by bisection.
+ *
+ * @param transportedQuantityList     Ring buffer containing spatial distribution.
+ * @param isPositiveVelocity          Boolean describing if velocity v is positive (>=0).
+ *                                    Edge is first node for positive velocity, last node otherwise.
+ * @return int                        Index of node with distance >= 1 to edge that is closest to the edge.
+ */
+static int findCutOffSpatialDistribution(RINGBUFFER* transportedQuantityList, int isPositiveVelocity) {
+  int nNodes = ringBufferLength(transportedQuantityList);
+  int lo, hi, mid;
+  double edgePosition;
+
+  if (isPositiveVelocity) {
+    /* Smallest index with distance >= 1 to first node, in [1, nNodes-1] */
+    edgePosition = quantityNode(transportedQuantityList, 0)->position;
+    lo = 1;
+    hi = nNodes-1;
+    while (lo < hi) {
+      mid = lo + (hi-lo)/2;
+      if (fabs(quantityNode(transportedQuantityList, mid)->position - edgePosition) + SPATIAL_EPS < 1) {
+        lo = mid+1;
+      } else {
+        hi = mid;
+      }
+    }
+  } else {
+    /* Largest index with distance >= 1 to last node, in [0, nNodes-2] */
+    edgePosition = quantityNode(transportedQuantityList, nNodes-1)->position;
+    lo = 0;
+    hi = nNodes-2;
+    while (lo < hi) {
+      mid = hi - (hi-lo)/2;
+      if (fabs(quantityNode(transportedQuantityList, mid)->position - edgePosition) + SPATIAL_EPS < 1) {
+        hi = mid-1;
+      } else {
+        lo = mid;
+      }
+    }
+  }
+
+  return lo;
+}
+
+
+/**
+ * @brief Print node statistics of all spatial distributions.
+ *
+ * @param data      Data
+ * @param stream    Stream of OMC_LOG_STREAM type.
+ */
+void printSpatialDistributionStatistics(DATA* data, int stream) {
+  int i;
+  SPATIAL_DISTRIBUTION_DATA* spatialDistribution;
+
+  infoStreamPrint(stream, 1, "spatialDistribution");
+  for (i = 0; i < data->modelData->nSpatialDistributions; i++) {
+    spatialDistribution = &(data->simulationInfo->spatialDistributionData[i]);
+    infoStreamPrint(stream, 0, "[%d] %5lu nodes added, %5lu nodes merged, %5d nodes max, %5d nodes stored",
+                    i, spatialDistribution->nAddedNodes, spatialDistribution->nMergedNodes,
+                    spatialDistribution->maxNodes, ringBufferLength(spatialDistribution->transportedQuantity));
+  }
+  messageClose(stream);
+}
+
+
 /**
  * @brief Print transported quantity data to stream.
  *
@@ -31,8 +31,10 @@
 /*! \file spatialDistribution.h
  */
 
+#include <stdio.h>
+
 #include "../../simulation_data.h"
-#include "../../util/doubleEndedList.h"
+#include "../../util/ringbuffer.h"
 
 #ifdef __cplusplus
   extern "C" {
@@ -45,6 +47,11 @@ void storeSpatialDistribution(DATA* data, threadData_t *threadData, unsigned int
 double spatialDistribution(DATA* data, threadData_t *threadData, unsigned int index, double in0, double in1, double posX, int isPositiveVelocity, double* out1);
 double spatialDistributionZeroCrossing (DATA* data, threadData_t *threadData, unsigned int index, unsigned int relationIndex, double posX, int isPositiveVelocity);
 
+int writeSpatialDistributionCheckpoint(DATA* data, FILE* file);
+int readSpatialDistributionCheckpoint(DATA* data, FILE* file);
+
+void printSpatialDistributionStatistics(DATA* data, int stream);
+
 void printTransportedQuantity(void* data, int stream, void* nodePointer);
 
 #ifdef __cplusplus
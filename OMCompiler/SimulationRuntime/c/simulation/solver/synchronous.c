@@ -29,6 +29,7 @@
  */
 
 #include "synchronous.h"
+#include "checkpoint.h"
 #include "epsilon.h"
 #include "../results/simulation_result.h"
 
@@ -40,6 +41,20 @@ extern "C" {
 void printClocks(BASECLOCK_DATA* baseClocks, int nBaseCllocks);
 void printSyncTimer(void* data, int stream, void* elemPointer);
 
+/**
+ * @brief Insert given timer into queue of timers.
+ *
+ * Timers are ordered by activation time, timers with equal activation time
+ * fire in the order they were inserted.
+ *
+ * @param queue   Queue with timers
+ * @param timer   Timer to insert into queue.
+ */
+static void insertTimer(TIMER_QUEUE* queue, SYNC_TIMER* timer)
+{
+  pushTimer(queue, timer->activationTime, timer);
+}
+
 /**
  * @brief Initialize memory for synchronous functionalities.
  *
@@ -71,18 +86,22 @@ void initSynchronous(DATA* data, threadData_t *threadData, modelica_real startTi
 
   for(i=0; i<data->modelData->nBaseClocks; i++)
   {
-    baseClock = &data->simulationInfo->baseClocks[i];
-
     data->callback->function_updateSynchronous(data, threadData, i);
+  }
+
+  // Add base-clock activation times to data->simulationInfo->intvlTimers.
+  // Timers with equal activation time fire in insertion order, at start time the last base-clock fires first.
+  for(i=data->modelData->nBaseClocks-1; i>=0; i--)
+  {
+    baseClock = &data->simulationInfo->baseClocks[i];
     if (!baseClock->isEventClock) {
-      // Add base-clock activation time to data->simulationInfo->intvlTimers
       SYNC_TIMER timer = (SYNC_TIMER){
         .base_idx = i,
         .sub_idx = -1,
         .type = SYNC_BASE_CLOCK,
         .activationTime = startTime
       };
-      listPushFront(data->simulationInfo->intvlTimers, &timer);
+      insertTimer(data->simulationInfo->intvlTimers, &timer);
     }
   }
 
@@ -90,29 +109,6 @@ void initSynchronous(DATA* data, threadData_t *threadData, modelica_real startTi
   printClocks(data->simulationInfo->baseClocks, data->modelData->nBaseClocks);
 }
 
-/**
- * @brief Insert given timer into ordered list of timers.
- *
- * Timer with lowest activation time is at the start of the list, last at the end.
- *
- * @param list    List with timers
- * @param timer   Timer to insert into list.
- */
-static void insertTimer(LIST* list, SYNC_TIMER* timer)
-{
-  LIST_NODE *it, *prevNode = NULL;
-  for(it = listFirstNode(list); it; it = listNextNode(it))
-  {
-    SYNC_TIMER *tmpTimer = listNodeData(it);
-    if(tmpTimer->activationTime > timer->activationTime)
-      break;
-    prevNode = it;
-  }
-  if (prevNode) listInsert(list, prevNode, timer);
-  else listPushFront(list, timer);
-}
-
-
 /**
  * @brief Check when next clock needs to fire.
  *
@@ -124,14 +120,14 @@ static void insertTimer(LIST* list, SYNC_TIMER* timer)
  */
 void checkForSynchronous(DATA *data, SOLVER_INFO* solverInfo)
 {
-  if (data->simulationInfo->intvlTimers != NULL && listLen(data->simulationInfo->intvlTimers) > 0)
+  if (data->simulationInfo->intvlTimers != NULL && timerQueueLength(data->simulationInfo->intvlTimers) > 0)
   {
-    SYNC_TIMER* nextTimer = (SYNC_TIMER*)listNodeData(listFirstNode(data->simulationInfo->intvlTimers));
+    double activationTime = nextTimerTime(data->simulationInfo->intvlTimers);
     double nextTimeStep = solverInfo->currentTime + solverInfo->currentStepSize;
 
-    if ((nextTimer->activationTime <= nextTimeStep + SYNC_EPS) && (nextTimer->activationTime >= solverInfo->currentTime))
+    if ((activationTime <= nextTimeStep + SYNC_EPS) && (activationTime >= solverInfo->currentTime))
     {
-      solverInfo->currentStepSize = nextTimer->activationTime - solverInfo->currentTime;
+      solverInfo->currentStepSize = activationTime - solverInfo->currentTime;
     }
   }
 }
@@ -252,23 +248,23 @@ fire_timer_t handleTimers(DATA* data, threadData_t *threadData, SOLVER_INFO* sol
   double activationTime;
   modelica_boolean frstSubClockIsBaseClock = 0 /* false */;
   SYNC_TIMER_TYPE type;
-  SYNC_TIMER* nextTimer;
+  SYNC_TIMER nextTimer;
   fire_timer_t ret = NO_TIMER_FIRED;
   SUBCLOCK_DATA* subClock;
 
-  if (data->simulationInfo->intvlTimers == NULL || listLen(data->simulationInfo->intvlTimers) <= 0) {
+  if (data->simulationInfo->intvlTimers == NULL || timerQueueLength(data->simulationInfo->intvlTimers) <= 0) {
     return ret;
   }
 
   /* Fire all timers at current time step */
-  nextTimer = (SYNC_TIMER*)listNodeData(listFirstNode(data->simulationInfo->intvlTimers));
-  while(nextTimer->activationTime <= solverInfo->currentTime + SYNC_EPS)
+  while(timerQueueLength(data->simulationInfo->intvlTimers) > 0 &&
+        nextTimerTime(data->simulationInfo->intvlTimers) <= solverInfo->currentTime + SYNC_EPS)
   {
-    base_idx = nextTimer->base_idx;
-    sub_idx = nextTimer->sub_idx;
-    type = nextTimer->type;
-    activationTime = nextTimer->activationTime;
-    listRemoveFront(data->simulationInfo->intvlTimers);
+    popTimer(data->simulationInfo->intvlTimers, &nextTimer);
+    base_idx = nextTimer.base_idx;
+    sub_idx = nextTimer.sub_idx;
+    type = nextTimer.type;
+    activationTime = nextTimer.activationTime;
     switch(type)
     {
       case SYNC_BASE_CLOCK:
@@ -298,10 +294,6 @@ fire_timer_t handleTimers(DATA* data, threadData_t *threadData, SOLVER_INFO* sol
         }
         break;
     }
-    if (listLen(data->simulationInfo->intvlTimers) == 0){
-      break;
-    }
-    nextTimer = (SYNC_TIMER*)listNodeData(listFirstNode(data->simulationInfo->intvlTimers));
   }
   return ret;
 }
@@ -330,25 +322,25 @@ int handleTimersFMI(DATA* data, threadData_t *threadData, double currentTime, mo
   double activationTime;
   modelica_boolean frstSubClockIsBaseClock = 0 /* false */;
   SYNC_TIMER_TYPE type;
-  SYNC_TIMER* nextTimer;
+  SYNC_TIMER nextTimer;
   fire_timer_t ret = NO_TIMER_FIRED;
   SUBCLOCK_DATA* subClock;
 
   *nextTimerDefined = FALSE;
 
-  if (data->simulationInfo->intvlTimers == NULL || listLen(data->simulationInfo->intvlTimers) <= 0) {
+  if (data->simulationInfo->intvlTimers == NULL || timerQueueLength(data->simulationInfo->intvlTimers) <= 0) {
     return (int) ret;
   }
 
   /* Fire all timers at current time step */
-  nextTimer = (SYNC_TIMER*)listNodeData(listFirstNode(data->simulationInfo->intvlTimers));
-  while(nextTimer->activationTime <= currentTime + SYNC_EPS)
+  while(timerQueueLength(data->simulationInfo->intvlTimers) > 0 &&
+        nextTimerTime(data->simulationInfo->intvlTimers) <= currentTime + SYNC_EPS)
   {
-    base_idx = nextTimer->base_idx;
-    sub_idx = nextTimer->sub_idx;
-    type = nextTimer->type;
-    activationTime = nextTimer->activationTime;
-    listRemoveFront(data->simulationInfo->intvlTimers);
+    popTimer(data->simulationInfo->intvlTimers, &nextTimer);
+    base_idx = nextTimer.base_idx;
+    sub_idx = nextTimer.sub_idx;
+    type = nextTimer.type;
+    activationTime = nextTimer.activationTime;
     switch(type)
     {
       case SYNC_BASE_CLOCK:
@@ -376,13 +368,11 @@ int handleTimersFMI(DATA* data, threadData_t *threadData, double currentTime, mo
         }
         break;
     }
-    if (listLen(data->simulationInfo->intvlTimers) == 0){
-      break;
+    if (timerQueueLength(data->simulationInfo->intvlTimers) > 0) {
+      /* Next time a timer will activate: */
+      *nextTimerActivationTime = nextTimerTime(data->simulationInfo->intvlTimers);
+      *nextTimerDefined = TRUE;
     }
-    nextTimer = (SYNC_TIMER*)listNodeData(listFirstNode(data->simulationInfo->intvlTimers));
-    /* Next time a timer will activate: */
-    *nextTimerActivationTime = nextTimer->activationTime;
-    *nextTimerDefined = TRUE;
   }
   return (int) ret;
 }
@@ -429,6 +419,102 @@ void printClocks(BASECLOCK_DATA* baseClocks, int nBaseClocks)
   }
 }
 
+/**
+ * @brief Write state of all clocks and pending timers to checkpoint file.
+ *
+ * @param data        Pointer to data.
+ * @param file        Checkpoint file opened for binary writing.
+ * @return int        0 on success, 1 on failure.
+ */
+int writeSynchronousCheckpoint(DATA* data, FILE* file)
+{
+  int i, j, len, failed = 0;
+  BASECLOCK_DATA* baseClock;
+  SYNC_TIMER* timers;
+
+  for (i = 0; i < data->modelData->nBaseClocks; i++) {
+    baseClock = &data->simulationInfo->baseClocks[i];
+    if (checkpointWrite(file, &baseClock->intervalCounter, sizeof(int), 1) ||
+        checkpointWrite(file, &baseClock->resolution, sizeof(int), 1) ||
+        checkpointWrite(file, &baseClock->interval, sizeof(double), 1) ||
+        checkpointWrite(file, &baseClock->stats, sizeof(CLOCK_STATS), 1)) {
+      return 1;
+    }
+    for (j = 0; j < baseClock->nSubClocks; j++) {
+      if (checkpointWrite(file, &baseClock->subClocks[j].stats, sizeof(CLOCK_STATS), 1)) {
+        return 1;
+      }
+    }
+  }
+
+  len = data->simulationInfo->intvlTimers ? timerQueueLength(data->simulationInfo->intvlTimers) : 0;
+  if (checkpointWrite(file, &len, sizeof(int), 1)) {
+    return 1;
+  }
+  if (len == 0) {
+    return 0;
+  }
+
+  /* Write timers in firing order, so reading them back in keeps the order of simultaneous timers */
+  timers = (SYNC_TIMER*) malloc(len * sizeof(SYNC_TIMER));
+  assertStreamPrint(NULL, timers != NULL, "writeSynchronousCheckpoint: Out of memory");
+  for (i = 0; i < len; i++) {
+    popTimer(data->simulationInfo->intvlTimers, &timers[i]);
+  }
+  failed = checkpointWrite(file, timers, sizeof(SYNC_TIMER), len);
+  for (i = 0; i < len; i++) {
+    insertTimer(data->simulationInfo->intvlTimers, &timers[i]);
+  }
+  free(timers);
+  return failed;
+}
+
+/**
+ * @brief Restore state of all clocks and pending timers from checkpoint file.
+ *
+ * initSynchronous has to be called before to set up the clocks.
+ *
+ * @param data        Pointer to data.
+ * @param file        Checkpoint file opened for binary reading.
+ * @return int        0 on success, 1 on failure.
+ */
+int readSynchronousCheckpoint(DATA* data, FILE* file)
+{
+  int i, j, len;
+  BASECLOCK_DATA* baseClock;
+  SYNC_TIMER timer;
+
+  for (i = 0; i < data->modelData->nBaseClocks; i++) {
+    baseClock = &data->simulationInfo->baseClocks[i];
+    if (checkpointRead(file, &baseClock->intervalCounter, sizeof(int), 1) ||
+        checkpointRead(file, &baseClock->resolution, sizeof(int), 1) ||
+        checkpointRead(file, &baseClock->interval, sizeof(double), 1) ||
+        checkpointRead(file, &baseClock->stats, sizeof(CLOCK_STATS), 1)) {
+      return 1;
+    }
+    for (j = 0; j < baseClock->nSubClocks; j++) {
+      if (checkpointRead(file, &baseClock->subClocks[j].stats, sizeof(CLOCK_STATS), 1)) {
+        return 1;
+      }
+    }
+  }
+
+  if (checkpointRead(file, &len, sizeof(int), 1)) {
+    return 1;
+  }
+  if (data->simulationInfo->intvlTimers == NULL) {
+    return len != 0;
+  }
+  clearTimerQueue(data->simulationInfo->intvlTimers);
+  for (i = 0; i < len; i++) {
+    if (checkpointRead(file, &timer, sizeof(SYNC_TIMER), 1)) {
+      return 1;
+    }
+    insertTimer(data->simulationInfo->intvlTimers, &timer);
+  }
+  return 0;
+}
+
 /**
  * @brief Print synchronous timer.
  *
@@ -57,6 +57,8 @@ void checkForSynchronous(DATA *data, SOLVER_INFO* solverInfo);
 modelica_boolean handleBaseClock(DATA* data, threadData_t *threadData, long idx, double curTime);
 fire_timer_t handleTimers(DATA* data, threadData_t *threadData, SOLVER_INFO* solverInfo);
 int handleTimersFMI(DATA* data, threadData_t *threadData, double currentTime, modelica_boolean *nextTimerDefined, double *nextTimerActivationTime);
+int writeSynchronousCheckpoint(DATA* data, FILE* file);
+int readSynchronousCheckpoint(DATA* data, FILE* file);
 
 #ifdef __cplusplus
 }
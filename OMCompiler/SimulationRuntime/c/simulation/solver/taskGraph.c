@@ -0,0 +1,207 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF THE BSD NEW LICENSE OR THE
+ * GPL VERSION 3 LICENSE OR THE OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the OSMC (Open Source Modelica Consortium)
+ * Public License (OSMC-PL) are obtained from OSMC, either from the above
+ * address, from the URLs: http://www.openmodelica.org or
+ * http://www.ida.liu.se/projects/OpenModelica, and in the OpenModelica
+ * distribution. GNU version 3 is obtained from:
+ * http://www.gnu.org/copyleft/gpl.html. The New BSD License is obtained from:
+ * http://www.opensource.org/licenses/BSD-3-Clause.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE, EXCEPT AS
+ * EXPRESSLY SET FORTH IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE
+ * CONDITIONS OF OSMC-PL.
+ *
+ */
+
+/*! \file taskGraph.c
+ *
+ * The compiler sorts the equation blocks into levels such that a block only
+ * depends on blocks of lower levels. Levels are evaluated one after another,
+ * the blocks of a level are distributed over the available threads. Every
+ * block writes its own variables, so the result does not depend on the
+ * number of threads or on the order in which the blocks of a level finish.
+ *
+ * Linear and non-linear systems change the homotopy parameter lambda,
+ * noThrowDivZero, solveContinuous and the linear solver of kinsol while they
+ * are solved. Each thread therefore works on a private copy of DATA and
+ * SIMULATION_INFO, the flags raised by the blocks are merged back once the
+ * level finished. The arrays referenced by both copies are shared, every
+ * system is solved by exactly one thread.
+ *
+ * Each thread also works on a private copy of threadData with its own jump
+ * buffers. If a block throws, the remaining blocks of the level are skipped
+ * and the level is continued sequentially on the calling thread, starting
+ * with the first failing block. The error is thus raised exactly as in a
+ * sequential evaluation.
+ */
+
+#ifdef USE_PARJAC
+  #include <omp.h>
+  #define GC_THREADS
+  #include <gc/omc_gc.h>
+#endif
+
+#include <string.h>
+
+#include "taskGraph.h"
+#include "../options.h"
+#include "../../meta/meta_modelica.h"
+#include "../../util/parallel_helper.h"
+
+#ifdef USE_PARJAC
+/**
+ * @brief Number of threads used for concurrent levels.
+ *
+ * Set by -parallelODEThreads, limited by the number of OpenMP threads because
+ * the per-thread data of linear systems is allocated for that many threads.
+ * Logging of selected systems (-lv_system) switches the process-wide log
+ * streams off and on again, so all blocks are evaluated sequentially then.
+ */
+static int taskGraphThreads(void)
+{
+  int maxThreads = omc_get_max_threads();
+  int nThreads = maxThreads;
+
+  if (omc_flag[FLAG_LV_SYSTEM]) {
+    return 1;
+  }
+  if (omc_flag[FLAG_PARALLEL_ODE_THREADS]) {
+    nThreads = atoi(omc_flagValue[FLAG_PARALLEL_ODE_THREADS]);
+    if (nThreads <= 0 || nThreads > maxThreads) {
+      nThreads = maxThreads;
+    }
+  }
+  return nThreads;
+}
+
+/**
+ * @brief Evaluate blocks [start, end) concurrently.
+ *
+ * The blocks are called with a per-thread copy of data and its
+ * simulationInfo. needToIterate and needToReThrow are merged back, as well as
+ * the homotopy steps of the systems solved during initialization.
+ *
+ * @return int    Index of first failing block, or end if all blocks succeeded.
+ */
+static int evaluateLevelParallel(DATA* data, threadData_t* threadData, const TASK_GRAPH* taskGraph, int start, int end, int nThreads)
+{
+  int next = start;
+  int failed = end;
+  int homotopySteps = data->simulationInfo->homotopySteps;
+
+  GC_allow_register_threads();
+
+#pragma omp parallel num_threads(nThreads) shared(data, threadData, taskGraph, end, next, failed, homotopySteps)
+{
+  volatile int current = end;
+  volatile int caught = 0;
+  int i, stop;
+  DATA threadLocalData = *data;
+  SIMULATION_INFO threadLocalSimulationInfo = *data->simulationInfo;
+
+  threadLocalData.simulationInfo = &threadLocalSimulationInfo;
+  /* other threads may already have merged their steps */
+  threadLocalSimulationInfo.homotopySteps = homotopySteps;
+
+  /* Register omp-thread in GC */
+  if (!GC_thread_is_registered()) {
+    struct GC_stack_base sb;
+    memset(&sb, 0, sizeof(sb));
+    GC_get_stack_base(&sb);
+    GC_register_my_thread(&sb);
+  }
+
+  MMC_TRY_TOP_SET(threadData)
+    threadData->globalJumpBuffer = threadData->mmc_jumper;
+    threadData->simulationJumpBuffer = threadData->mmc_jumper;
+    for (;;) {
+#pragma omp atomic capture
+      i = next++;
+#pragma omp atomic read
+      stop = failed;
+      if (i >= end || stop < end) {
+        break;
+      }
+      current = i;
+      taskGraph->tasks[i](&threadLocalData, threadData);
+    }
+  MMC_CATCH_TOP(caught = 1)
+
+#pragma omp critical(taskGraphMerge)
+  {
+    data->simulationInfo->needToIterate |= threadLocalSimulationInfo.needToIterate;
+    data->simulationInfo->needToReThrow |= threadLocalSimulationInfo.needToReThrow;
+    data->simulationInfo->homotopySteps += threadLocalSimulationInfo.homotopySteps - homotopySteps;
+  }
+
+  if (caught) {
+#pragma omp critical(taskGraphFailed)
+    {
+      if (current < failed) {
+        failed = current;
+      }
+    }
+  }
+}
+
+  return failed;
+}
+#endif
+
+/**
+ * @brief Evaluate all equation blocks of a task graph.
+ *
+ * @param data          Pointer to data.
+ * @param threadData    Pointer to thread data of calling thread.
+ * @param taskGraph     Task graph generated by the compiler.
+ */
+void evaluateTaskGraph(DATA* data, threadData_t* threadData, const TASK_GRAPH* taskGraph)
+{
+  int level, i, start = 0, end;
+#ifdef USE_PARJAC
+  int nThreads = taskGraphThreads();
+  int cost;
+#endif
+
+  for (level = 0; level < taskGraph->nLevels; level++) {
+    end = start + taskGraph->levelSize[level];
+
+#ifdef USE_PARJAC
+    /* Blocks are sorted by decreasing cost, the first one is the most
+     * expensive one. Only run in parallel if the other blocks are worth it. */
+    if (nThreads > 1 && end - start > 1) {
+      cost = 0;
+      for (i = start + 1; i < end; i++) {
+        cost += taskGraph->cost[i];
+      }
+      if (cost >= TASK_GRAPH_MIN_PARALLEL_COST) {
+        /* Continue with the first failing block on the calling thread to
+         * raise its error. Blocks only assign their own variables, evaluating
+         * one twice is harmless. */
+        start = evaluateLevelParallel(data, threadData, taskGraph, start, end, nThreads);
+      }
+    }
+#endif
+
+    /* sequential evaluation, or the rest of a failed level */
+    for (i = start; i < end; i++) {
+      taskGraph->tasks[i](data, threadData);
+    }
+    start = end;
+  }
+}
@@ -0,0 +1,65 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF THE BSD NEW LICENSE OR THE
+ * GPL VERSION 3 LICENSE OR THE OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the OSMC (Open Source Modelica Consortium)
+ * Public License (OSMC-PL) are obtained from OSMC, either from the above
+ * address, from the URLs: http://www.openmodelica.org or
+ * http://www.ida.liu.se/projects/OpenModelica, and in the OpenModelica
+ * distribution. GNU version 3 is obtained from:
+ * http://www.gnu.org/copyleft/gpl.html. The New BSD License is obtained from:
+ * http://www.opensource.org/licenses/BSD-3-Clause.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE, EXCEPT AS
+ * EXPRESSLY SET FORTH IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE
+ * CONDITIONS OF OSMC-PL.
+ *
+ */
+
+/*! \file taskGraph.h
+ *
+ * Evaluation of equation blocks along a dependency graph generated by the
+ * compiler with --parallelODE or --parallelInit. The blocks of one level do
+ * not depend on each other and are evaluated concurrently if the runtime is
+ * built with OpenMP, including linear and non-linear systems.
+ */
+
+#ifndef OMC_TASK_GRAPH_H
+#define OMC_TASK_GRAPH_H
+
+#include "../../simulation_data.h"
+
+#ifdef __cplusplus
+  extern "C" {
+#endif
+
+/* Levels with less estimated work than this are evaluated sequentially */
+#define TASK_GRAPH_MIN_PARALLEL_COST 1000
+
+typedef struct TASK_GRAPH {
+  int nTasks;                                     /* number of equation blocks */
+  int nLevels;                                    /* number of levels of the dependency graph */
+  void (*const *tasks)(DATA*, threadData_t*);     /* blocks sorted by level, decreasing cost within a level */
+  const int *levelSize;                           /* number of blocks of each level */
+  const int *cost;                                /* estimated cost of each block */
+} TASK_GRAPH;
+
+void evaluateTaskGraph(DATA* data, threadData_t* threadData, const TASK_GRAPH* taskGraph);
+
+#ifdef __cplusplus
+  }
+#endif
+
+#endif
@@ -44,6 +44,7 @@
 #include "util/ringbuffer.h"
 #include "util/rtclock.h"
 #include "util/simulation_options.h"
+#include "util/timer_queue.h"
 #include "util/context.h"
 
 #define omc_dummyVarInfo {-1,-1,"","",omc_dummyFileInfo_val}
@@ -715,7 +716,7 @@ typedef enum SYNC_TIMER_TYPE {
 } SYNC_TIMER_TYPE;
 
 /**
- * @brief Data elements of list data->simulationInfo->intvlTimers.
+ * @brief Data elements of timer queue data->simulationInfo->intvlTimers.
  * Stores next activation time of synchronous clock idx.
  */
 typedef struct SYNC_TIMER {
@@ -775,9 +776,16 @@ typedef struct SPATIAL_DISTRIBUTION_DATA {
 
   modelica_real oldPosX;
 
-  DOUBLE_ENDED_LIST* transportedQuantity;
-  DOUBLE_ENDED_LIST* storedEvents;
+  RINGBUFFER* transportedQuantity;     /* Nodes (position, value) ordered by position */
+  RINGBUFFER* storedEvents;            /* Events (position, zeroCrossValue) ordered by position */
   int lastStoredEventValue;
+
+  modelica_real mergeTolerance;        /* Nodes reproduced by linear interpolation within this tolerance are merged, 0 disables merging */
+
+  /* statistics */
+  unsigned long nAddedNodes;           /* Number of nodes added at the in-flowing end */
+  unsigned long nMergedNodes;          /* Number of nodes removed by merging */
+  int maxNodes;                        /* Maximum number of nodes stored at the same time */
 } SPATIAL_DISTRIBUTION_DATA;
 
 typedef struct SIMULATION_INFO
@@ -831,11 +839,14 @@ typedef struct SIMULATION_INFO
   void** extObjs;                      /* External objects */
 
   double nextSampleEvent;              /* point in time of next sample-call */
-  double *nextSampleTimes;             /* array of next sample time */ // TODO ringbuffer
+  double *nextSampleTimes;             /* array of next sample time */
   modelica_boolean *samples;           /* array of the current value for all sample-calls */
+  TIMER_QUEUE* sampleTimers;           /* Indices of all sample-calls that are not active, ordered by next sample time. */
+  long *activeSamples;                 /* Indices of the active sample-calls */
+  long nActiveSamples;                 /* Number of active sample-calls */
 
   BASECLOCK_DATA *baseClocks;          /* Containing simulation data for clocks. E.g interval and next evaluation time */
-  LIST* intvlTimers;                   /* Sorted list with next actiavtion time for each base-clock partition. */
+  TIMER_QUEUE* intvlTimers;            /* SYNC_TIMERs ordered by next activation time of base-clocks and sub-clocks. */
 
   SPATIAL_DISTRIBUTION_DATA* spatialDistributionData;     /* Array of spatialDistribution data */
 
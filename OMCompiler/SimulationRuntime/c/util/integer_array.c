@@ -38,6 +38,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#include <string.h>
 #include <math.h>
 
 #include "omc_error.h"
@@ -120,15 +121,9 @@ void alloc_integer_array_data(integer_array* a)
 void copy_integer_array_data_mem(const integer_array source,
                                  modelica_integer *dest)
 {
-    size_t i, nr_of_elements;
-
     omc_assert_macro(base_array_ok(&source));
 
-    nr_of_elements = base_array_nr_of_elements(source);
-
-    for(i = 0; i < nr_of_elements; ++i) {
-        dest[i] = integer_get(source, i);
-    }
+    memcpy(dest, source.data, sizeof(modelica_integer) * base_array_nr_of_elements(source));
 }
 
 void copy_integer_array(const integer_array source, integer_array *dest)
@@ -438,15 +433,12 @@ void simple_index_integer_array1(const integer_array * source,
                                  int i1,
                                  integer_array* dest)
 {
-    size_t i;
     size_t nr_of_elements = base_array_nr_of_elements(*dest);
     size_t off = nr_of_elements * i1;
 
     omc_assert_macro(dest->ndims == (source->ndims - 1));
 
-    for(i = 0 ; i < nr_of_elements ; i++) {
-        integer_set(dest, i, integer_get(*source, off + i));
-    }
+    memcpy(dest->data, integer_ptrget(source, off), sizeof(modelica_integer) * nr_of_elements);
 }
 
 /* Returns dest := source[i1,i2,:,:...]*/
@@ -454,13 +446,10 @@ void simple_index_integer_array2(const integer_array * source,
                                  int i1, int i2,
                                  integer_array* dest)
 {
-    size_t i;
     size_t nr_of_elements = base_array_nr_of_elements(*dest);
     size_t off = nr_of_elements * ((source->dim_size[1] * i1) + i2);
 
-    for(i = 0 ; i < nr_of_elements ; i++) {
-        integer_set(dest, i, integer_get(*source, off + i));
-    }
+    memcpy(dest->data, integer_ptrget(source, off), sizeof(modelica_integer) * nr_of_elements);
 }
 
 void array_integer_array(integer_array* dest,int n,integer_array first,...)
@@ -699,24 +688,28 @@ void range_integer_array(modelica_integer start, modelica_integer stop, modelica
 void usub_integer_array(integer_array* a)
 {
     size_t nr_of_elements, i;
+    modelica_integer *pa = (modelica_integer *) a->data;
 
     nr_of_elements = base_array_nr_of_elements(*a);
     for(i = 0; i < nr_of_elements; ++i)
     {
-        integer_set(a, i, -integer_get(*a, i));
+        pa[i] = -pa[i];
     }
 }
 
 void usub_alloc_integer_array(const integer_array a, integer_array* dest)
 {
     size_t nr_of_elements, i;
+    const modelica_integer *pa = (const modelica_integer *) a.data;
+    modelica_integer *pdest;
     clone_integer_array_spec(&a,dest);
     alloc_integer_array_data(dest);
+    pdest = (modelica_integer *) dest->data;
 
     nr_of_elements = base_array_nr_of_elements(*dest);
     for(i = 0; i < nr_of_elements; ++i)
     {
-        integer_set(dest, i, -integer_get(a, i));
+        pdest[i] = -pa[i];
     }
 }
 
@@ -724,6 +717,9 @@ void add_integer_array(const integer_array * a, const integer_array * b, integer
 {
     size_t nr_of_elements;
     size_t i;
+    const modelica_integer *pa = (const modelica_integer *) a->data;
+    const modelica_integer *pb = (const modelica_integer *) b->data;
+    modelica_integer *pdest = (modelica_integer *) dest->data;
 
     nr_of_elements = base_array_nr_of_elements(*a);
 
@@ -733,7 +729,7 @@ void add_integer_array(const integer_array * a, const integer_array * b, integer
     omc_assert_macro(base_array_nr_of_elements(*dest) == nr_of_elements);
 
     for(i = 0; i < nr_of_elements; ++i) {
-        integer_set(dest, i, integer_get(*a, i)+integer_get(*b, i));
+        pdest[i] = pa[i] + pb[i];
     }
 }
 
@@ -750,6 +746,9 @@ void sub_integer_array(const integer_array * a, const integer_array * b, integer
 {
     size_t nr_of_elements;
     size_t i;
+    const modelica_integer *pa = (const modelica_integer *) a->data;
+    const modelica_integer *pb = (const modelica_integer *) b->data;
+    modelica_integer *pdest = (modelica_integer *) dest->data;
 
     nr_of_elements = base_array_nr_of_elements(*a);
 
@@ -759,7 +758,7 @@ void sub_integer_array(const integer_array * a, const integer_array * b, integer
     omc_assert_macro(base_array_nr_of_elements(*dest) == nr_of_elements);
 
     for(i = 0; i < nr_of_elements; ++i) {
-        integer_set(dest, i, integer_get(*a, i)-integer_get(*b, i));
+        pdest[i] = pa[i] - pb[i];
     }
 }
 
@@ -768,6 +767,8 @@ void sub_integer_array_data_mem(const integer_array * a, const integer_array * b
 {
     size_t nr_of_elements;
     size_t i;
+    const modelica_integer *pa = (const modelica_integer *) a->data;
+    const modelica_integer *pb = (const modelica_integer *) b->data;
 
     nr_of_elements = base_array_nr_of_elements(*a);
 
@@ -776,7 +777,7 @@ void sub_integer_array_data_mem(const integer_array * a, const integer_array * b
     /* Assert that dest are of correct size */
 
     for(i = 0; i < nr_of_elements; ++i) {
-        dest[i] = integer_get(*a, i) - integer_get(*b, i);
+        dest[i] = pa[i] - pb[i];
     }
 }
 
@@ -793,6 +794,8 @@ void mul_scalar_integer_array(modelica_integer a,const integer_array * b,integer
 {
     size_t nr_of_elements;
     size_t i;
+    const modelica_integer *pb = (const modelica_integer *) b->data;
+    modelica_integer *pdest = (modelica_integer *) dest->data;
 
     nr_of_elements = base_array_nr_of_elements(*b);
 
@@ -800,7 +803,7 @@ void mul_scalar_integer_array(modelica_integer a,const integer_array * b,integer
     omc_assert_macro(base_array_nr_of_elements(*dest) == nr_of_elements);
 
     for(i=0; i < nr_of_elements; ++i) {
-        integer_set(dest, i, a * integer_get(*b, i));
+        pdest[i] = a * pb[i];
     }
 }
 
@@ -817,6 +820,8 @@ void mul_integer_array_scalar(const integer_array * a,modelica_integer b,integer
 {
     size_t nr_of_elements;
     size_t i;
+    const modelica_integer *pa = (const modelica_integer *) a->data;
+    modelica_integer *pdest = (modelica_integer *) dest->data;
 
     nr_of_elements = base_array_nr_of_elements(*a);
 
@@ -824,7 +829,7 @@ void mul_integer_array_scalar(const integer_array * a,modelica_integer b,integer
     omc_assert_macro(base_array_nr_of_elements(*dest) == nr_of_elements);
 
     for(i=0; i < nr_of_elements; ++i) {
-        integer_set(dest, i, integer_get(*a, i) * b);
+        pdest[i] = pa[i] * b;
     }
 }
 
@@ -841,10 +846,13 @@ void mul_integer_array(const integer_array *a,const integer_array *b,integer_arr
 {
   size_t nr_of_elements;
   size_t i;
+  const modelica_integer *pa = (const modelica_integer *) a->data;
+  const modelica_integer *pb = (const modelica_integer *) b->data;
+  modelica_integer *pdest = (modelica_integer *) dest->data;
   /* Assert that a,b have same sizes? */
   nr_of_elements = base_array_nr_of_elements(*a);
   for(i=0; i < nr_of_elements; ++i) {
-    integer_set(dest, i, integer_get(*a, i) * integer_get(*b, i));
+    pdest[i] = pa[i] * pb[i];
   }
 }
 
@@ -864,6 +872,8 @@ modelica_integer mul_integer_scalar_product(const integer_array a, const integer
     size_t nr_of_elements;
     size_t i;
     modelica_integer res;
+    const modelica_integer *pa = (const modelica_integer *) a.data;
+    const modelica_integer *pb = (const modelica_integer *) b.data;
 
     /* Assert that a and b are vectors */
     omc_assert_macro(a.ndims == 1);
@@ -874,7 +884,7 @@ modelica_integer mul_integer_scalar_product(const integer_array a, const integer
     nr_of_elements = base_array_nr_of_elements(a);
     res = 0;
     for(i = 0; i < nr_of_elements; ++i) {
-        res += integer_get(a, i)*integer_get(b, i);
+        res += pa[i] * pb[i];
     }
     return res;
 }
@@ -888,19 +898,26 @@ void mul_integer_matrix_product(const integer_array * a,const integer_array * b,
     size_t i;
     size_t j;
     size_t k;
+    const modelica_integer *pb;
+    modelica_integer *pdest;
 
     /* Assert that dest har correct size */
     i_size = dest->dim_size[0];
     j_size = dest->dim_size[1];
     k_size = a->dim_size[1];
 
+    /* i-k-j order: the inner loop runs over contiguous rows of b and dest */
     for(i = 0; i < i_size; ++i) {
+        pdest = integer_ptrget(dest, i * j_size);
         for(j = 0; j < j_size; ++j) {
-            tmp = 0;
-            for(k = 0; k < k_size; ++k) {
-                tmp += integer_get(*a, (i * k_size) + k)*integer_get(*b, (k * j_size) + j);
+            pdest[j] = 0;
+        }
+        for(k = 0; k < k_size; ++k) {
+            tmp = integer_get(*a, (i * k_size) + k);
+            pb = integer_ptrget(b, k * j_size);
+            for(j = 0; j < j_size; ++j) {
+                pdest[j] += tmp * pb[j];
             }
-            integer_set(dest, (i * j_size) + j, tmp);
         }
     }
 }
@@ -940,6 +957,8 @@ void mul_integer_vector_matrix(const integer_array * a, const integer_array * b,
     size_t i_size;
     size_t j_size;
     modelica_integer tmp;
+    const modelica_integer *pb;
+    modelica_integer *pdest = (modelica_integer *) dest->data;
 
     /* Assert a vector */
     omc_assert_macro(a->ndims == 1);
@@ -947,15 +966,19 @@ void mul_integer_vector_matrix(const integer_array * a, const integer_array * b,
     omc_assert_macro(b->ndims == 2);
     /* Assert dest vector of correct size */
 
-    i_size = a->dim_size[0];
+    i_size = b->dim_size[0];
     j_size = b->dim_size[1];
 
+    /* dest[j] = sum_i a[i]*b[i,j], accumulated row by row of b */
+    for(j = 0; j < j_size; ++j) {
+        pdest[j] = 0;
+    }
     for(i = 0; i < i_size; ++i) {
-        tmp = 0;
+        tmp = integer_get(*a, i);
+        pb = integer_ptrget(b, i * j_size);
         for(j = 0; j < j_size; ++j) {
-            tmp += integer_get(*a, j) * integer_get(*b, (j * j_size) + i);
+            pdest[j] += tmp * pb[j];
         }
-        integer_set(dest, i, tmp);
     }
 }
 
@@ -981,6 +1004,8 @@ void div_integer_array_scalar(const integer_array * a,modelica_integer b,integer
 {
     size_t nr_of_elements;
     size_t i;
+    const modelica_integer *pa = (const modelica_integer *) a->data;
+    modelica_integer *pdest = (modelica_integer *) dest->data;
 
     /* Do we need to check for b=0? */
     nr_of_elements = base_array_nr_of_elements(*a);
@@ -989,7 +1014,7 @@ void div_integer_array_scalar(const integer_array * a,modelica_integer b,integer
     omc_assert_macro(nr_of_elements == base_array_nr_of_elements(*dest));
 
     for(i=0; i < nr_of_elements; ++i) {
-        integer_set(dest, i, integer_get(*a, i)/b);
+        pdest[i] = pa[i] / b;
     }
 }
 
@@ -1030,11 +1055,13 @@ void div_scalar_integer_array(modelica_integer a, const integer_array* b, intege
 {
     size_t nr_of_elements;
     size_t i;
+    const modelica_integer *pb = (const modelica_integer *) b->data;
+    modelica_integer *pdest = (modelica_integer *) dest->data;
     /* Assert that dest has correct size*/
     /* Do we need to check for b=0? */
     nr_of_elements = base_array_nr_of_elements(*b);
     for(i=0; i < nr_of_elements; ++i) {
-        integer_set(dest, i, a / integer_get(*b, i));
+        pdest[i] = a / pb[i];
     }
 }
 
@@ -1491,13 +1518,14 @@ modelica_integer sum_integer_array(const integer_array a)
     size_t i;
     size_t nr_of_elements;
     modelica_integer sum = 0;
+    const modelica_integer *pa = (const modelica_integer *) a.data;
 
     omc_assert_macro(base_array_ok(&a));
 
     nr_of_elements = base_array_nr_of_elements(a);
 
     for(i = 0;i < nr_of_elements; ++i) {
-        sum += integer_get(a, i);
+        sum += pa[i];
     }
 
     return sum;
@@ -1508,13 +1536,14 @@ modelica_integer product_integer_array(const integer_array a)
     size_t i;
     size_t nr_of_elements;
     modelica_integer product = 1;
+    const modelica_integer *pa = (const modelica_integer *) a.data;
 
     omc_assert_macro(base_array_ok(&a));
 
     nr_of_elements = base_array_nr_of_elements(a);
 
     for(i = 0;i < nr_of_elements; ++i) {
-        product *= integer_get(a, i);
+        product *= pa[i];
     }
 
     return product;
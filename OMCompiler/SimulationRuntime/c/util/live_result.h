@@ -0,0 +1,103 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF THE BSD NEW LICENSE OR THE
+ * GPL VERSION 3 LICENSE OR THE OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the OSMC (Open Source Modelica Consortium)
+ * Public License (OSMC-PL) are obtained from OSMC, either from the above
+ * address, from the URLs: http://www.openmodelica.org or
+ * http://www.ida.liu.se/projects/OpenModelica, and in the OpenModelica
+ * distribution. GNU version 3 is obtained from:
+ * http://www.gnu.org/copyleft/gpl.html. The New BSD License is obtained from:
+ * http://www.opensource.org/licenses/BSD-3-Clause.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE, EXCEPT AS
+ * EXPRESSLY SET FORTH IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE
+ * CONDITIONS OF OSMC-PL.
+ *
+ */
+
+/*
+ * Layout of the live result file written with -liveResult.
+ *
+ * The simulation publishes its real variables into a memory mapped file that
+ * other processes (e.g. the OMEdit animation) map and read while the
+ * simulation is running, without any file I/O in the simulation loop.
+ *
+ * The file starts with an omc_live_result_header, followed by the name
+ * table, the names, the real parameters and a ring buffer of numFrames
+ * frames. Each frame is a sequence number followed by numSignals doubles,
+ * the first one being time.
+ *
+ * The writer never waits for readers. A frame is written by clearing its
+ * sequence number, writing the values and then setting the sequence number to
+ * its frame number + 1, after which writeCount is increased. A reader copies
+ * the values of frame n from slot n % numFrames and only uses them if the
+ * sequence number was n + 1 both before and after the copy, otherwise the
+ * writer has overwritten the slot in the meantime. Readers that are slower
+ * than the simulation skip frames by always starting from the newest one.
+ */
+
+#ifndef OMC_LIVE_RESULT_H
+#define OMC_LIVE_RESULT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define OMC_LIVE_RESULT_MAGIC "OMLIVE1"
+#define OMC_LIVE_RESULT_VERSION 1
+
+enum omc_live_result_state {
+  OMC_LIVE_RESULT_INITIALIZING = 0, /* names are valid, parameters are not written yet */
+  OMC_LIVE_RESULT_RUNNING = 1,      /* parameters are written, frames are being emitted */
+  OMC_LIVE_RESULT_FINISHED = 2      /* the simulation has finished, no more frames follow */
+};
+
+typedef struct omc_live_result_header {
+  char magic[8];                /* OMC_LIVE_RESULT_MAGIC */
+  uint32_t version;             /* OMC_LIVE_RESULT_VERSION */
+  uint32_t headerSize;          /* sizeof(omc_live_result_header) */
+  uint32_t numSignals;          /* values per frame, including time */
+  uint32_t numFrames;           /* number of frames in the ring buffer */
+  uint32_t numParameters;
+  uint32_t numNames;
+  uint64_t namesOffset;         /* omc_live_result_name[numNames] */
+  uint64_t stringsOffset;       /* null terminated names */
+  uint64_t parametersOffset;    /* double[numParameters] */
+  uint64_t framesOffset;        /* frames of OMC_LIVE_RESULT_FRAME_SIZE(numSignals) bytes */
+  uint64_t fileSize;
+  double startTime;
+  double stopTime;
+  volatile uint64_t writeCount; /* number of frames written so far */
+  volatile uint32_t state;      /* omc_live_result_state */
+  uint32_t reserved;
+} omc_live_result_header;
+
+typedef struct omc_live_result_name {
+  uint32_t nameOffset;          /* offset of the name from stringsOffset */
+  int32_t index;                /* >= 0: index in the frame, < 0: parameter -index-1 */
+  int32_t negate;               /* the value is the negated signal (negated alias) */
+  uint32_t reserved;
+} omc_live_result_name;
+
+#define OMC_LIVE_RESULT_FRAME_SIZE(numSignals) (sizeof(uint64_t) + (uint64_t)(numSignals) * sizeof(double))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OMC_LIVE_RESULT_H */
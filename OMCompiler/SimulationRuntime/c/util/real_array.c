@@ -42,6 +42,7 @@
 #include <stdarg.h>
 #include <math.h>
 #include <float.h>
+#include <string.h>
 
 static inline modelica_real *real_ptrget(const real_array *a, size_t i)
 {
@@ -118,15 +119,9 @@ void alloc_real_array_data(real_array *a)
 
 void copy_real_array_data_mem(const real_array source, modelica_real *dest)
 {
-    size_t i, nr_of_elements;
-
     omc_assert_macro(base_array_ok(&source));
 
-    nr_of_elements = base_array_nr_of_elements(source);
-
-    for(i = 0; i < nr_of_elements; ++i) {
-        dest[i] = real_get(source, i);
-    }
+    memcpy(dest, source.data, sizeof(modelica_real) * base_array_nr_of_elements(source));
 }
 
 void copy_real_array(const real_array source, real_array *dest)
@@ -359,6 +354,7 @@ void index_real_array(const real_array * source,
     _index_t* idx_size;
     int j;
     int i;
+    int k;
 
     omc_assert_macro(base_array_ok(source));
     omc_assert_macro(base_array_ok(dest));
@@ -400,6 +396,29 @@ void index_real_array(const real_array * source,
         }
     }
 
+    /* The trailing dimensions that are taken as a whole (a[i,:,:]) are
+     * contiguous in source and dest; copy them as blocks instead of
+     * calculating the index of every element. */
+    for(k = source->ndims; k > 0 && source_spec->index[k-1] == NULL; --k);
+    if(k < source->ndims && base_array_nr_of_elements(*dest) > 0) {
+        size_t block = 1, off;
+        for(i = k; i < source->ndims; ++i) {
+            block *= source->dim_size[i];
+        }
+        j = 0;
+        do {
+            off = 0;
+            for(i = 0; i < k; ++i) {
+                off = off * source->dim_size[i] + (source_spec->index[i] ? source_spec->index[i][idx_vec1[i]] - 1 : idx_vec1[i]);
+            }
+            memcpy(real_ptrget(dest, j), real_ptrget(source, off * block), sizeof(modelica_real) * block);
+            j += block;
+        } while(k > 0 && 0 == next_index(k, idx_vec1, idx_size));
+
+        omc_assert_macro(j == base_array_nr_of_elements(*dest));
+        return;
+    }
+
     j = 0;
     do {
         /*
@@ -468,13 +487,10 @@ void simple_index_real_array1(const real_array * source,
                                  int i1,
                                  real_array* dest)
 {
-    size_t i;
     size_t nr_of_elements = base_array_nr_of_elements(*dest);
     size_t off = nr_of_elements * i1;
 
-    for(i = 0 ; i < nr_of_elements ; off++,i++) {
-        real_set(dest, i, real_get(*source, off));
-    }
+    memcpy(dest->data, real_ptrget(source, off), sizeof(modelica_real) * nr_of_elements);
 }
 
 /* Returns dest := source[i1,i2,:,:...]*/
@@ -482,13 +498,10 @@ void simple_index_real_array2(const real_array * source,
                                  int i1, int i2,
                                  real_array* dest)
 {
-    size_t i;
     size_t nr_of_elements = base_array_nr_of_elements(*dest);
     size_t off = nr_of_elements * ((source->dim_size[1] * i1) + i2);
 
-    for(i = 0 ; i < nr_of_elements ; i++,off++) {
-        real_set(dest, i, real_get(*source, off));
-    }
+    memcpy(dest->data, real_ptrget(source, off), sizeof(modelica_real) * nr_of_elements);
 }
 
 void array_real_array(real_array* dest,int n,real_array first,...)
@@ -730,11 +743,15 @@ void add_real_array(const real_array * a, const real_array * b, real_array* dest
     size_t nr_of_elements;
     size_t i;
 
+    const modelica_real *pa = (const modelica_real *) a->data;
+    const modelica_real *pb = (const modelica_real *) b->data;
+    modelica_real *pdest = (modelica_real *) dest->data;
+
     /* Assert a and b are of the same size */
     /* Assert that dest are of correct size */
     nr_of_elements = base_array_nr_of_elements(*a);
     for(i = 0; i < nr_of_elements; ++i) {
-        real_set(dest, i, real_get(*a, i)+real_get(*b, i));
+        pdest[i] = pa[i] + pb[i];
     }
 }
 
@@ -777,10 +794,12 @@ void usub_real_array(real_array* a)
 {
     size_t nr_of_elements, i;
 
+    modelica_real *pa = (modelica_real *) a->data;
+
     nr_of_elements = base_array_nr_of_elements(*a);
     for(i = 0; i < nr_of_elements; ++i)
     {
-        real_set(a, i, -real_get(*a, i));
+        pa[i] = -pa[i];
     }
 }
 
@@ -802,11 +821,15 @@ void sub_real_array(const real_array * a, const real_array * b, real_array* dest
     size_t nr_of_elements;
     size_t i;
 
+    const modelica_real *pa = (const modelica_real *) a->data;
+    const modelica_real *pb = (const modelica_real *) b->data;
+    modelica_real *pdest = (modelica_real *) dest->data;
+
     /* Assert a and b are of the same size */
     /* Assert that dest are of correct size */
     nr_of_elements = base_array_nr_of_elements(*a);
     for(i = 0; i < nr_of_elements; ++i) {
-        real_set(dest, i, real_get(*a, i)-real_get(*b, i));
+        pdest[i] = pa[i] - pb[i];
     }
 }
 
@@ -837,10 +860,12 @@ void mul_scalar_real_array(modelica_real a,const real_array * b,real_array* dest
 {
     size_t nr_of_elements;
     size_t i;
+    const modelica_real *pb = (const modelica_real *) b->data;
+    modelica_real *pdest = (modelica_real *) dest->data;
     /* Assert that dest has correct size*/
     nr_of_elements = base_array_nr_of_elements(*b);
     for(i=0; i < nr_of_elements; ++i) {
-        real_set(dest, i, a * real_get(*b, i));
+        pdest[i] = a * pb[i];
     }
 }
 
@@ -858,10 +883,12 @@ void mul_real_array_scalar(const real_array * a,modelica_real b,real_array* dest
 {
     size_t nr_of_elements;
     size_t i;
+    const modelica_real *pa = (const modelica_real *) a->data;
+    modelica_real *pdest = (modelica_real *) dest->data;
     /* Assert that dest has correct size*/
     nr_of_elements = base_array_nr_of_elements(*a);
     for(i=0; i < nr_of_elements; ++i) {
-        real_set(dest, i, real_get(*a, i) * b);
+        pdest[i] = pa[i] * b;
     }
 }
 
@@ -878,10 +905,13 @@ void mul_real_array(const real_array *a,const real_array *b,real_array* dest)
 {
   size_t nr_of_elements;
   size_t i;
+  const modelica_real *pa = (const modelica_real *) a->data;
+  const modelica_real *pb = (const modelica_real *) b->data;
+  modelica_real *pdest = (modelica_real *) dest->data;
   /* Assert that a,b have same sizes? */
   nr_of_elements = base_array_nr_of_elements(*a);
   for(i=0; i < nr_of_elements; ++i) {
-    real_set(dest, i, real_get(*a, i) * real_get(*b, i));
+    pdest[i] = pa[i] * pb[i];
   }
 }
 
@@ -899,13 +929,15 @@ modelica_real mul_real_scalar_product(const real_array a, const real_array b)
     size_t nr_of_elements;
     size_t i;
     modelica_real res;
+    const modelica_real *pa = (const modelica_real *) a.data;
+    const modelica_real *pb = (const modelica_real *) b.data;
     /* Assert that a and b are vectors */
     /* Assert that vectors are of matching size */
 
     nr_of_elements = real_array_nr_of_elements(a);
     res = 0.0;
     for(i = 0; i < nr_of_elements; ++i) {
-        res += real_get(a, i)*real_get(b, i);
+        res += pa[i] * pb[i];
     }
     return res;
 }
@@ -919,19 +951,27 @@ void mul_real_matrix_product(const real_array * a,const real_array * b,real_arra
     size_t i;
     size_t j;
     size_t k;
+    const modelica_real *pa = (const modelica_real *) a->data;
+    const modelica_real *pb;
+    modelica_real *pdest;
 
     /* Assert that dest has correct size */
     i_size = dest->dim_size[0];
     j_size = dest->dim_size[1];
     k_size = a->dim_size[1];
 
+    /* i-k-j order: the inner loop runs over contiguous rows of b and dest */
     for(i = 0; i < i_size; ++i) {
+        pdest = real_ptrget(dest, i * j_size);
         for(j = 0; j < j_size; ++j) {
-            tmp = 0;
-            for(k = 0; k < k_size; ++k) {
-                tmp += real_get(*a, (i * k_size) + k)*real_get(*b, (k * j_size) + j);
+            pdest[j] = 0;
+        }
+        for(k = 0; k < k_size; ++k) {
+            tmp = pa[(i * k_size) + k];
+            pb = real_ptrget(b, k * j_size);
+            for(j = 0; j < j_size; ++j) {
+                pdest[j] += tmp * pb[j];
             }
-            real_set(dest, (i * j_size) + j, tmp);
         }
     }
 }
@@ -948,13 +988,17 @@ void mul_real_matrix_vector(const real_array * a, const real_array * b,real_arra
     /* Assert b vector */
     /* Assert dest correct size (a vector)*/
 
+    const modelica_real *pa;
+    const modelica_real *pb = (const modelica_real *) b->data;
+
     i_size = a->dim_size[0];
     j_size = a->dim_size[1];
 
     for(i = 0; i < i_size; ++i) {
+        pa = real_ptrget(a, i * j_size);
         tmp = 0;
         for(j = 0; j < j_size; ++j) {
-            tmp += real_get(*a, (i * j_size) + j) * real_get(*b, j);
+            tmp += pa[j] * pb[j];
         }
         real_set(dest, i, tmp);
     }
@@ -968,20 +1012,26 @@ void mul_real_vector_matrix(const real_array * a, const real_array * b,real_arra
     size_t i_size;
     size_t j_size;
     modelica_real tmp;
+    const modelica_real *pb;
+    modelica_real *pdest = (modelica_real *) dest->data;
 
     /* Assert a vector */
     /* Assert b matrix */
     /* Assert dest vector of correct size */
 
-    i_size = a->dim_size[0];
+    i_size = b->dim_size[0];
     j_size = b->dim_size[1];
 
+    /* dest[j] = sum_i a[i]*b[i,j], accumulated row by row of b */
+    for(j = 0; j < j_size; ++j) {
+        pdest[j] = 0;
+    }
     for(i = 0; i < i_size; ++i) {
-        tmp = 0;
+        tmp = real_get(*a, i);
+        pb = real_ptrget(b, i * j_size);
         for(j = 0; j < j_size; ++j) {
-            tmp += real_get(*a, j) * real_get(*b, (j * j_size) + i);
+            pdest[j] += tmp * pb[j];
         }
-        real_set(dest, i, tmp);
     }
 }
 
@@ -1317,10 +1367,12 @@ void transpose_alloc_real_array(const real_array * a, real_array* dest)
  *
  * Implementation of transpose(A) for matrix A.
  */
+#define TRANSPOSE_TILE 32
+
 void transpose_real_array(const real_array * a, real_array* dest)
 {
-    size_t i;
-    size_t j;
+    size_t i, ii;
+    size_t j, jj;
     /*  size_t k;*/
     size_t n,m;
 
@@ -1336,9 +1388,14 @@ void transpose_real_array(const real_array * a, real_array* dest)
 
     omc_assert_macro(dest->dim_size[0] == m && dest->dim_size[1] == n);
 
-    for(i = 0; i < n; ++i) {
-        for(j = 0; j < m; ++j) {
-            real_set(dest, (j * n) + i, real_get(*a, (i * m) + j));
+    /* transpose in tiles so that both matrices are accessed cache-friendly */
+    for(ii = 0; ii < n; ii += TRANSPOSE_TILE) {
+        for(jj = 0; jj < m; jj += TRANSPOSE_TILE) {
+            for(i = ii; i < n && i < ii + TRANSPOSE_TILE; ++i) {
+                for(j = jj; j < m && j < jj + TRANSPOSE_TILE; ++j) {
+                    real_set(dest, (j * n) + i, real_get(*a, (i * m) + j));
+                }
+            }
         }
     }
 }
@@ -1516,13 +1573,14 @@ modelica_real sum_real_array(const real_array a)
     size_t i;
     size_t nr_of_elements;
     modelica_real sum = 0;
+    const modelica_real *pa = (const modelica_real *) a.data;
 
     omc_assert_macro(base_array_ok(&a));
 
     nr_of_elements = base_array_nr_of_elements(a);
 
     for(i = 0; i < nr_of_elements; ++i) {
-        sum += real_get(a, i);
+        sum += pa[i];
     }
 
     return sum;
@@ -108,14 +108,23 @@ void *getRingData(RINGBUFFER *rb, int i)
  *
  * Doubles the size of the original ring buffer
  * and copies all values into updated buffer.
+ * Elements that wrapped around the end of the old buffer are moved behind
+ * the old end, so the order of the elements is kept.
  *
  * @param rb    Pointer to ring buffer.
  */
 void expandRingBuffer(RINGBUFFER *rb)
 {
+  int oldSize = rb->bufferSize;
+  int nWrapped = rb->firstElement + rb->nElements - oldSize;
+
   rb->bufferSize *= 2;
   rb->buffer = realloc(rb->buffer, rb->bufferSize*rb->itemSize);
   assertStreamPrint(NULL, 0 != rb->buffer, "out of memory");
+
+  if (nWrapped > 0) {
+    memcpy(((char*)rb->buffer)+(oldSize*rb->itemSize), rb->buffer, nWrapped*rb->itemSize);
+  }
 }
 
 /**
@@ -136,6 +145,24 @@ void appendRingData(RINGBUFFER *rb, void *value)
   ++rb->nElements;
 }
 
+/**
+ * @brief Add element to the front of ring buffer.
+ *
+ * If the buffer isn't big enough it will be expanded.
+ *
+ * @param rb      Pointer to ring buffer.
+ * @param value   Data to add to ring buffer.
+ */
+void prependRingData(RINGBUFFER *rb, void *value)
+{
+  if(rb->bufferSize < rb->nElements+1)
+    expandRingBuffer(rb);
+
+  rb->firstElement = (rb->firstElement+rb->bufferSize-1)%rb->bufferSize;
+  memcpy(((char*)rb->buffer)+(rb->firstElement*rb->itemSize), value, rb->itemSize);
+  ++rb->nElements;
+}
+
 /**
  * @brief Deque first n ring data elements.
  *
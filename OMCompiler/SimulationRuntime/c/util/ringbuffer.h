@@ -35,6 +35,7 @@
  * This is an expanding ring buffer.
  * When it gets full, it doubles in size.
  * It's basically a queue which has get(ix) instead of get_first()/delete_first().
+ * Elements can be added and removed at both ends.
  */
 
 #ifdef __cplusplus
@@ -50,6 +51,7 @@ extern "C" {
   void *getRingData(RINGBUFFER *rb, int nIndex);
 
   void appendRingData(RINGBUFFER *rb, void *value);
+  void prependRingData(RINGBUFFER *rb, void *value);
   void dequeueNFirstRingDatas(RINGBUFFER *rb, int n);
   void removeLastRingData(RINGBUFFER *rb, int n);
 
@@ -35,6 +35,8 @@ const char *FLAG_NAME[FLAG_MAX+1] = {
 
   /* FLAG_ABORT_SLOW */                   "abortSlowSimulation",
   /* FLAG_ALARM */                        "alarm",
+  /* FLAG_CHECKPOINT */                   "checkpoint",
+  /* FLAG_CHECKPOINT_INTERVAL */          "checkpointInterval",
   /* FLAG_CLOCK */                        "clock",
   /* FLAG_CPU */                          "cpu",
   /* FLAG_CSV_OSTEP */                    "csvOstep",
@@ -48,6 +50,8 @@ const char *FLAG_NAME[FLAG_MAX+1] = {
   /* FLAG_EMBEDDED_SERVER_PORT */         "embeddedServerPort",
   /* FLAG_MAT_SYNC */                     "mat_sync",
   /* FLAG_EMIT_PROTECTED */               "emit_protected",
+  /* FLAG_ENSEMBLE */                     "ensemble",
+  /* FLAG_ENSEMBLE_THREADS */             "ensembleThreads",
   /* FLAG_DATA_RECONCILE_Eps */           "eps",
   /* FLAG_F */                            "f",
   /* FLAG_HELP */                         "help",
@@ -72,6 +76,7 @@ const char *FLAG_NAME[FLAG_MAX+1] = {
   /* FLAG_IDA_MAXCONVFAILS */             "idaMaxConvFails",
   /* FLAG_IDA_NONLINCONVCOEF */           "idaNonLinConvCoef",
   /* FLAG_IDA_LS */                       "idaLS",
+  /* FLAG_IDA_PRECOND */                  "idaPrecond",
   /* FLAG_IDA_SCALING */                  "idaScaling",
   /* FLAG_IDAS */                         "idaSensitivity",
   /* FLAG_IGNORE_HIDERESULT */            "ignoreHideResult",
@@ -92,6 +97,7 @@ const char *FLAG_NAME[FLAG_MAX+1] = {
   /* FLAG_JACOBIAN_THREADS */             "jacobianThreads",
   /* FLAG_L */                            "l",
   /* FLAG_L_DATA_RECOVERY */              "l_datarec",
+  /* FLAG_LIVE_RESULT */                  "liveResult",
   /* FLAG_LOG_FORMAT */                   "logFormat",
   /* FLAG_LS */                           "ls",
   /* FLAG_LS_IPOPT */                     "ls_ipopt",
@@ -140,11 +146,13 @@ const char *FLAG_NAME[FLAG_MAX+1] = {
   /* FLAG_OUTPUT_PATH */                  "outputPath",
   /* FLAG_OVERRIDE */                     "override",
   /* FLAG_OVERRIDE_FILE */                "overrideFile",
+  /* FLAG_PARALLEL_ODE_THREADS */         "parallelODEThreads",
   /* FLAG_PORT */                         "port",
   /* FLAG_R */                            "r",
   /* FLAG_DATA_RECONCILE  */              "reconcile",
   /* FLAG_DATA_RECONCILE_BOUNDARY */      "reconcileBoundaryConditions",
   /* FLAG_DATA_RECONCILE_STATE */         "reconcileState",
+  /* FLAG_RESTART */                      "restart",
   /* FLAG_SR */                           "gbm",
   /* FLAG_SR_CTRL */                      "gbctrl",
   /* FLAG_SR_CTRL_FILTER */               "gbctrl_filter",
@@ -163,6 +171,7 @@ const char *FLAG_NAME[FLAG_MAX+1] = {
   /* FLAG_SAVE_INITIAL_GUESS_SYSTEM */    "saveInitialGuess_system",
   /* FLAG_SINGLE_PRECISION */             "single",
   /* FLAG_SOLVER_STEPS */                 "steps",
+  /* FLAG_SPATIAL_DISTR_TOL */            "spatialDistrTol",
   /* FLAG_STEADY_STATE */                 "steadyState",
   /* FLAG_STEADY_STATE_TOL */             "steadyStateTol",
   /* FLAG_STOP_AT_SYSTEM */               "stopAtSystem",
@@ -181,6 +190,8 @@ const char *FLAG_DESC[FLAG_MAX+1] = {
 
   /* FLAG_ABORT_SLOW */                   "aborts if the simulation chatters",
   /* FLAG_ALARM */                        "aborts after the given number of seconds (0 disables)",
+  /* FLAG_CHECKPOINT */                   "value specifies a file to which the simulation state is periodically written for a later restart",
+  /* FLAG_CHECKPOINT_INTERVAL */          "[double (default 600)] value specifies the wall-clock time in seconds between two checkpoints",
   /* FLAG_CLOCK */                        "selects the type of clock to use -clock=RT, -clock=CYC or -clock=CPU",
   /* FLAG_CPU */                          "dumps the cpu-time into the result file",
   /* FLAG_CSV_OSTEP */                    "value specifies csv-files for debug values for optimizer step",
@@ -194,6 +205,8 @@ const char *FLAG_DESC[FLAG_MAX+1] = {
   /* FLAG_EMBEDDED_SERVER_PORT */         "[int (default 4841)] value specifies the port number used by the embedded server",
   /* FLAG_MAT_SYNC */                     "[int (default 0)] syncs the mat file header after emitting every N time-points (default disabled)",
   /* FLAG_EMIT_PROTECTED */               "emits protected variables to the result-file",
+  /* FLAG_ENSEMBLE */                     "value specifies a csv file with one row of parameter values per variant of an ensemble simulation",
+  /* FLAG_ENSEMBLE_THREADS */             "[int (default number of processors)] value specifies the number of variants of an ensemble simulation run concurrently",
   /* FLAG_DATA_RECONCILE_Eps */           "value specifies the number of convergence iteration to be performed for DataReconciliation",
   /* FLAG_F */                            "value specifies a new setup XML file to the generated simulation code",
   /* FLAG_HELP */                         "get detailed information that specifies the command-line flag",
@@ -218,6 +231,7 @@ const char *FLAG_DESC[FLAG_MAX+1] = {
   /* FLAG_IDA_MAXCONVFAILS */             "value specifies the maximum number of nonlinear solver convergence failures at one step. The default value is 10.",
   /* FLAG_IDA_NONLINCONVCOEF */           "value specifies the safety factor in the nonlinear convergence test. The default value is 0.33.",
   /* FLAG_IDA_LS */                       "select the linear solver used by ida",
+  /* FLAG_IDA_PRECOND */                  "select the preconditioner used by the iterative linear solvers of ida",
   /* FLAG_IDA_SCALING */                  "enable scaling of the IDA solver",
   /* FLAG_IDAS */                         "flag to add sensitivity information to the result files",
   /* FLAG_IGNORE_HIDERESULT */            "ignore HideResult=true annotation",
@@ -238,6 +252,7 @@ const char *FLAG_DESC[FLAG_MAX+1] = {
   /* FLAG_JACOBIAN_THREADS */             "[int default: 1] value specifies the number of threads for jacobian evaluation in dassl or ida.",
   /* FLAG_L */                            "value specifies a time where the linearization of the model should be performed",
   /* FLAG_L_DATA_RECOVERY */              "emit data recovery matrices with model linearization",
+  /* FLAG_LIVE_RESULT */                  "value specifies a file to publish the results to while simulating, e.g. for a live animation",
   /* FLAG_LOG_FORMAT */                   "value specifies the log format of the executable. -logFormat=text (default), -logFormat=xml or -logFormat=xmltcp",
   /* FLAG_LS */                           "value specifies the linear solver method (default: lapack, totalpivot (fallback))",
   /* FLAG_LS_IPOPT */                     "value specifies the linear solver method for ipopt",
@@ -286,11 +301,13 @@ const char *FLAG_DESC[FLAG_MAX+1] = {
   /* FLAG_OUTPUT_PATH */                  "value specifies a path for writing the output files i.e., model_res.mat, model_prof.intdata, model_prof.realdata etc.",
   /* FLAG_OVERRIDE */                     "override the variables or the simulation settings in the XML setup file",
   /* FLAG_OVERRIDE_FILE */                "will override the variables or the simulation settings in the XML setup file with the values from the file",
+  /* FLAG_PARALLEL_ODE_THREADS */         "[int default: 0] value specifies the number of threads used to evaluate independent equations of models compiled with --parallelODE or --parallelInit (0 uses the maximum number of threads)",
   /* FLAG_PORT */                         "value specifies the port for simulation status (default disabled)",
   /* FLAG_R */                            "value specifies a new result file than the default Model_res.mat",
   /* FLAG_DATA_RECONCILE */               "Run the Data Reconciliation numerical computation algorithm for constrained equations",
   /* FLAG_DATA_RECONCILE_BOUNDARY */      "Run the Data Reconciliation numerical computation algorithm for boundary condition equations",
   /* FLAG_DATA_RECONCILE_STATE */         "Run the State Estimation numerical computation algorithm for constrained equations",
+  /* FLAG_RESTART */                      "value specifies a checkpoint file (see -checkpoint) from which the simulation is resumed",
   /* FLAG_SR */                           "Value specifies the chosen solver of solver gbode (single-rate, slow states integrator)",
   /* FLAG_SR_CTRL */                      "Step size control of solver gbode (single-rate, slow states integrator)",
   /* FLAG_SR_CTRL_FILTER */               "Applies exponential smoothing to the step size factor; gbctrl_filter = 0 yields constant step size, gbctrl_filter = 1 uses full adaptation without averaging.",
@@ -309,6 +326,7 @@ const char *FLAG_DESC[FLAG_MAX+1] = {
   /* FLAG_SAVE_INITIAL_GUESS_SYSTEM */    "[string (.mat file), uint (NLS index)] debug flag that performs standard initialization until the specified system is reached, computes only the torn part and saves the results obtained so far to a .mat file",
   /* FLAG_SINGLE */                       "output in single precision",
   /* FLAG_SOLVER_STEPS */                 "dumps the number of integration steps into the result file",
+  /* FLAG_SPATIAL_DISTR_TOL */            "[double (default 0)] absolute tolerance for merging nodes of spatialDistribution operators (0 disables)",
   /* FLAG_STEADY_STATE */                 "aborts if steady state is reached",
   /* FLAG_STEADY_STATE_TOL */             "[double (default 1e-3)] This relative tolerance is used to detect steady state.",
   /* FLAG_STOP_AT_SYSTEM */               "[uint (NLS index)] performs standard initialization until the specified system is reached, then aborts the simulation.",
@@ -328,6 +346,13 @@ const char *FLAG_DETAILED_DESC[FLAG_MAX+1] = {
   "  Aborts if the simulation chatters.",
   /* FLAG_ALARM */
   "  Aborts after the given number of seconds (default=0 disables the alarm).",
+  /* FLAG_CHECKPOINT */
+  "  Value specifies a file to which a checkpoint of the simulation state is\n"
+  "  periodically written (see -checkpointInterval). The simulation can be\n"
+  "  resumed from this file with -restart=<file>, without re-initialization.",
+  /* FLAG_CHECKPOINT_INTERVAL */
+  "  Value specifies the wall-clock time in seconds between two checkpoints\n"
+  "  written to the file given by -checkpoint. Default: 600.",
   /* FLAG_CLOCK */
   "  Selects the type of clock to use. Valid options include:\n\n"
   "  * RT (monotonic real-time clock)\n"
@@ -369,6 +394,17 @@ const char *FLAG_DETAILED_DESC[FLAG_MAX+1] = {
   "  Syncs the mat file header after emitting every N time-points.",
   /* FLAG_EMIT_PROTECTED */
   "  Emits protected variables to the result-file.",
+  /* FLAG_ENSEMBLE */
+  "  Value specifies a csv file for an ensemble (parameter sweep) simulation.\n"
+  "  The first row contains names of parameters or variables, every further row\n"
+  "  the start values of one variant. The init file is read once, then all\n"
+  "  variants are simulated in separate worker processes (see -ensembleThreads),\n"
+  "  each writing its own result file <result>_<variant>.<format>.\n"
+  "  An index of all variants and their status is written to\n"
+  "  <modelName>_ensemble.csv.",
+  /* FLAG_ENSEMBLE_THREADS */
+  "  Value specifies the number of variants of an ensemble simulation (see\n"
+  "  -ensemble) that are simulated at the same time.",
   /* FLAG_DATA_RECONCILE_Eps */
   "  Value specifies the number of convergence iteration to be performed for DataReconciliation",
   /* FLAG_F */
@@ -425,6 +461,10 @@ const char *FLAG_DETAILED_DESC[FLAG_MAX+1] = {
   "  Value specifies the safety factor in the nonlinear convergence test. The default value is 0.33.",
   /* FLAG_IDA_LS */
   "  Value specifies the linear solver of the ida integration method. Valid values:\n",
+  /* FLAG_IDA_PRECOND */
+  "  Value specifies the preconditioner used with the iterative linear solvers spgmr, spbcg and sptfqmr of the ida integration method.\n"
+  "  The preconditioner is built from the colored sparse Jacobian and only updated when ida requests a new iteration matrix.\n"
+  "  Valid values:\n",
   /* FLAG_IDA_SCALING */
   "  Enable scaling of the IDA solver.",
   /* FLAG_IDAS */
@@ -467,6 +507,11 @@ const char *FLAG_DETAILED_DESC[FLAG_MAX+1] = {
   "  Value specifies a time where the linearization of the model should be performed.",
   /* FLAG_L_DATA_RECOVERY */
   "  Emit data recovery matrices with model linearization.",
+  /* FLAG_LIVE_RESULT */
+  "  Value specifies a file that the real variables and parameters are published to\n"
+  "  while simulating, in addition to the result file. The file is memory mapped and\n"
+  "  holds a ring buffer of the most recent output points, which other processes can\n"
+  "  read without slowing down the simulation, e.g. OMEdit to animate a running simulation.",
   /* FLAG_LOG_FORMAT */
   "  Value specifies the log format of the executable:\n\n"
   "  * text (default)\n"
@@ -600,6 +645,14 @@ const char *FLAG_DETAILED_DESC[FLAG_MAX+1] = {
   "  Note that: -overrideFile CANNOT be used with -override.\n"
   "  Use when variables for -override are too many.\n"
   "  overrideFileName contains lines of the form: var1=start1",
+  /* FLAG_PARALLEL_ODE_THREADS */
+  "  Value specifies the number of threads used to evaluate independent equation\n"
+  "  blocks of the ODE and algebraic systems concurrently. Only used for models\n"
+  "  compiled with --parallelODE or --parallelInit (initial system) and a\n"
+  "  runtime built with OpenMP support. All blocks are evaluated sequentially\n"
+  "  if -lv_system is used.\n"
+  "  A value of 1 evaluates all blocks sequentially. The default value 0 uses the\n"
+  "  maximum number of OpenMP threads.",
   /* FLAG_PORT */
   "  Value specifies the port for simulation status (default disabled).",
   /* FLAG_R */
@@ -612,6 +665,11 @@ const char *FLAG_DETAILED_DESC[FLAG_MAX+1] = {
   "  Run the Data Reconciliation numerical computation algorithm for boundary condition equations",
   /* FLAG_DATA_RECONCILE_STATE */
   "  Run the State Estimation numerical computation algorithm for constrained equations",
+  /* FLAG_RESTART */
+  "  Value specifies a checkpoint file written with -checkpoint from which the\n"
+  "  simulation is resumed. The initial system is not solved, it is only evaluated\n"
+  "  if it constructs external objects. The integration continues from the time\n"
+  "  stored in the checkpoint. Not supported by the solvers qss and optimization.",
   /* FLAG_SR */
   "  Value specifies the chosen solver of solver gbode (single-rate, slow states integrator).",
   /* FLAG_SR_CTRL */
@@ -658,6 +716,11 @@ const char *FLAG_DETAILED_DESC[FLAG_MAX+1] = {
   "  Output results in single precision (mat-format only).",
   /* FLAG_SOLVER_STEPS */
   "  Dumps the number of integration steps into the result file.",
+  /* FLAG_SPATIAL_DISTR_TOL */
+  "  Value specifies the absolute tolerance for merging nodes of spatialDistribution operators.\n"
+  "  A node is dropped when linear interpolation between its neighbours reproduces its value within this tolerance.\n"
+  "  This bounds the memory of long pipes with slowly varying inputs. Nodes of events are never merged.\n"
+  "  The default value 0 disables merging.",
   /* FLAG_STEADY_STATE */
   "  Aborts the simulation if steady state is reached.",
   /* FLAG_STEADY_STATE_TOL */
@@ -686,6 +749,8 @@ const flag_repeat_policy FLAG_REPEAT_POLICIES[FLAG_MAX] = {
 
   /* FLAG_ABORT_SLOW */                   FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_ALARM */                        FLAG_REPEAT_POLICY_FORBID,
+  /* FLAG_CHECKPOINT */                   FLAG_REPEAT_POLICY_FORBID,
+  /* FLAG_CHECKPOINT_INTERVAL */          FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_CLOCK */                        FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_CPU */                          FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_CSV_OSTEP */                    FLAG_REPEAT_POLICY_FORBID,
@@ -699,6 +764,8 @@ const flag_repeat_policy FLAG_REPEAT_POLICIES[FLAG_MAX] = {
   /* FLAG_EMBEDDED_SERVER_PORT */         FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_MAT_SYNC */                     FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_EMIT_PROTECTED */               FLAG_REPEAT_POLICY_FORBID,
+  /* FLAG_ENSEMBLE */                     FLAG_REPEAT_POLICY_FORBID,
+  /* FLAG_ENSEMBLE_THREADS */             FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_DATA_RECONCILE_Eps */           FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_F */                            FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_HELP */                         FLAG_REPEAT_POLICY_REPLACE,
@@ -723,6 +790,7 @@ const flag_repeat_policy FLAG_REPEAT_POLICIES[FLAG_MAX] = {
   /* FLAG_IDA_MAXCONVFAILS */             FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_IDA_NONLINCONVCOEF */           FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_IDA_LS */                       FLAG_REPEAT_POLICY_FORBID,
+  /* FLAG_IDA_PRECOND */                  FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_IDA_SCALING */                  FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_IDAS */                         FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_IGNORE_HIDERESULT */            FLAG_REPEAT_POLICY_FORBID,
@@ -743,6 +811,7 @@ const flag_repeat_policy FLAG_REPEAT_POLICIES[FLAG_MAX] = {
   /* FLAG_JACOBIAN_THREADS */             FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_L */                            FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_L_DATA_RECOVERY */              FLAG_REPEAT_POLICY_FORBID,
+  /* FLAG_LIVE_RESULT */                  FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_LOG_FORMAT */                   FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_LS */                           FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_LS_IPOPT */                     FLAG_REPEAT_POLICY_FORBID,
@@ -791,11 +860,13 @@ const flag_repeat_policy FLAG_REPEAT_POLICIES[FLAG_MAX] = {
   /* FLAG_OUTPUT_PATH */                  FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_OVERRIDE */                     FLAG_REPEAT_POLICY_COMBINE,
   /* FLAG_OVERRIDE_FILE */                FLAG_REPEAT_POLICY_COMBINE,
+  /* FLAG_PARALLEL_ODE_THREADS */         FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_PORT */                         FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_R */                            FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_DATA_RECONCILE  */              FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_DATA_RECONCILE_BOUNDARY */      FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_DATA_RECONCILE_STATE  */        FLAG_REPEAT_POLICY_FORBID,
+  /* FLAG_RESTART */                      FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_SR */                           FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_SR_CTRL */                      FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_SR_CTRL_FILTER */               FLAG_REPEAT_POLICY_FORBID,
@@ -814,6 +885,7 @@ const flag_repeat_policy FLAG_REPEAT_POLICIES[FLAG_MAX] = {
   /* FLAG_SAVE_INITIAL_GUESS_SYSTEM */    FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_SINGLE_PRECISION */             FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_SOLVER_STEPS */                 FLAG_REPEAT_POLICY_FORBID,
+  /* FLAG_SPATIAL_DISTR_TOL */            FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_STEADY_STATE */                 FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_STEADY_STATE_TOL */             FLAG_REPEAT_POLICY_FORBID,
   /* FLAG_STOP_AT_SYSTEM */               FLAG_REPEAT_POLICY_FORBID,
@@ -831,6 +903,8 @@ const int FLAG_TYPE[FLAG_MAX] = {
 
   /* FLAG_ABORT_SLOW */                   FLAG_TYPE_FLAG,
   /* FLAG_ALARM */                        FLAG_TYPE_OPTION,
+  /* FLAG_CHECKPOINT */                   FLAG_TYPE_OPTION,
+  /* FLAG_CHECKPOINT_INTERVAL */          FLAG_TYPE_OPTION,
   /* FLAG_CLOCK */                        FLAG_TYPE_OPTION,
   /* FLAG_CPU */                          FLAG_TYPE_FLAG,
   /* FLAG_CSV_OSTEP */                    FLAG_TYPE_OPTION,
@@ -844,6 +918,8 @@ const int FLAG_TYPE[FLAG_MAX] = {
   /* FLAG_EMBEDDED_SERVER_PORT */         FLAG_TYPE_OPTION,
   /* FLAG_MAT_SYNC */                     FLAG_TYPE_OPTION,
   /* FLAG_EMIT_PROTECTED */               FLAG_TYPE_FLAG,
+  /* FLAG_ENSEMBLE */                     FLAG_TYPE_OPTION,
+  /* FLAG_ENSEMBLE_THREADS */             FLAG_TYPE_OPTION,
   /* FLAG_DATA_RECONCILE_Eps */           FLAG_TYPE_OPTION,
   /* FLAG_F */                            FLAG_TYPE_OPTION,
   /* FLAG_HELP */                         FLAG_TYPE_OPTION,
@@ -868,6 +944,7 @@ const int FLAG_TYPE[FLAG_MAX] = {
   /* FLAG_IDA_MAXCONVFAILS */             FLAG_TYPE_OPTION,
   /* FLAG_IDA_NONLINCONVCOEF */           FLAG_TYPE_OPTION,
   /* FLAG_IDA_LS */                       FLAG_TYPE_OPTION,
+  /* FLAG_IDA_PRECOND */                  FLAG_TYPE_OPTION,
   /* FLAG_IDA_SCALING */                  FLAG_TYPE_FLAG,
   /* FLAG_IDAS */                         FLAG_TYPE_FLAG,
   /* FLAG_IGNORE_HIDERESULT */            FLAG_TYPE_FLAG,
@@ -888,6 +965,7 @@ const int FLAG_TYPE[FLAG_MAX] = {
   /* FLAG_JACOBIAN_THREADS */             FLAG_TYPE_OPTION,
   /* FLAG_L */                            FLAG_TYPE_OPTION,
   /* FLAG_L_DATA_RECOVERY */              FLAG_TYPE_FLAG,
+  /* FLAG_LIVE_RESULT */                  FLAG_TYPE_OPTION,
   /* FLAG_LOG_FORMAT */                   FLAG_TYPE_OPTION,
   /* FLAG_LS */                           FLAG_TYPE_OPTION,
   /* FLAG_LS_IPOPT */                     FLAG_TYPE_OPTION,
@@ -936,11 +1014,13 @@ const int FLAG_TYPE[FLAG_MAX] = {
   /* FLAG_OUTPUT_PATH */                  FLAG_TYPE_OPTION,
   /* FLAG_OVERRIDE */                     FLAG_TYPE_OPTION,
   /* FLAG_OVERRIDE_FILE */                FLAG_TYPE_OPTION,
+  /* FLAG_PARALLEL_ODE_THREADS */         FLAG_TYPE_OPTION,
   /* FLAG_PORT */                         FLAG_TYPE_OPTION,
   /* FLAG_R */                            FLAG_TYPE_OPTION,
   /* FLAG_DATA_RECONCILE */               FLAG_TYPE_FLAG,
   /* FLAG_DATA_RECONCILE_BOUNDARY */      FLAG_TYPE_FLAG,
   /* FLAG_DATA_RECONCILE_STATE */         FLAG_TYPE_FLAG,
+  /* FLAG_RESTART */                      FLAG_TYPE_OPTION,
   /* FLAG_SR */                           FLAG_TYPE_OPTION,
   /* FLAG_SR_CTRL */                      FLAG_TYPE_OPTION,
   /* FLAG_SR_CTRL_FILTER */               FLAG_TYPE_OPTION,
@@ -959,6 +1039,7 @@ const int FLAG_TYPE[FLAG_MAX] = {
   /* FLAG_SAVE_INITIAL_GUESS_SYSTEM */    FLAG_TYPE_OPTION,
   /* FLAG_SINGLE */                       FLAG_TYPE_FLAG,
   /* FLAG_SOLVER_STEPS */                 FLAG_TYPE_FLAG,
+  /* FLAG_SPATIAL_DISTR_TOL */            FLAG_TYPE_OPTION,
   /* FLAG_STEADY_STATE */                 FLAG_TYPE_FLAG,
   /* FLAG_STEADY_STATE_TOL */             FLAG_TYPE_OPTION,
   /* FLAG_STOP_AT_SYSTEM */               FLAG_TYPE_OPTION,
@@ -1143,7 +1224,7 @@ const char *SOLVER_METHOD_NAME[S_MAX] = {
 const char *SOLVER_METHOD_DESC[S_MAX] = {
   /* S_UNKNOWN = 0 */   "unknown",
   /* S_DASSL */         "dassl (default) - BDF method - implicit (dense solver), variable step size control, adaptive order 1-5, event location",
-  /* S_IDA */           "ida - SUNDIALS IDA solver - BDF method - implicit (sparse/dense solver, default sparse) variable step size control, adaptive order 1-5, event location - additional simulation flags: -idaMaxErrorTestFails -idaMaxNonLinIters -idaMaxConvFails -idaNonLinConvCoef -idaLS -idaScaling -idaSensitivity",
+  /* S_IDA */           "ida - SUNDIALS IDA solver - BDF method - implicit (sparse/dense solver, default sparse) variable step size control, adaptive order 1-5, event location - additional simulation flags: -idaMaxErrorTestFails -idaMaxNonLinIters -idaMaxConvFails -idaNonLinConvCoef -idaLS -idaPrecond -idaScaling -idaSensitivity",
   /* S_CVODE */         "cvode - SUNDIALS CVODE solver - BDF or Adams-Moulton solver - implicit (dense solver), variable step-size control, adaptive order 1-12, event location - additional simulation flags -cvodeLinearMultistepMethod -cvodeNonlinearSolverIteration",
   /* S_GBODE */         "gbode - generic Runge-Kutta ODE solver - implicit (sparse solver)/explicit, fixed/variable step size control, order 1-14, event location, optional bi-rate integration - additional simulation flags -gbm -gbctrl -gbratio - additional advanced flags -gbctrl_filter -gbctrl_fhr -gberr -gbint -gbnls -gbfm -gbfctrl -gbferr -gbfint -gbfnls",
   /* S_EULER */         "euler - explicit Euler, fixed step size, order 1",
@@ -1319,6 +1400,22 @@ const char *IDA_LS_METHOD_DESC[IDA_LS_MAX] = {
   "ida TFQMR. Iterative method"
 };
 
+const char *IDA_PRECOND_METHOD_NAME[IDA_PRECOND_MAX] = {
+  "unknown",
+
+  "none",
+  "jacobi",
+  "ilu"
+};
+
+const char *IDA_PRECOND_METHOD_DESC[IDA_PRECOND_MAX] = {
+  "unknown",
+
+  "no preconditioner. (default)",
+  "diagonal (Jacobi) preconditioner.",
+  "incomplete LU factorization without fill-in, ILU(0)."
+};
+
 const char *NLS_LS_METHOD_NAME[NLS_LS_MAX] = {
   "unknown",
 
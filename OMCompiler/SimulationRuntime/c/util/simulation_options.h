@@ -53,6 +53,8 @@ enum _FLAG
 
   FLAG_ABORT_SLOW,
   FLAG_ALARM,
+  FLAG_CHECKPOINT,
+  FLAG_CHECKPOINT_INTERVAL,
   FLAG_CLOCK,
   FLAG_CPU,
   FLAG_CSV_OSTEP,
@@ -66,6 +68,8 @@ enum _FLAG
   FLAG_EMBEDDED_SERVER_PORT,
   FLAG_MAT_SYNC,
   FLAG_EMIT_PROTECTED,
+  FLAG_ENSEMBLE,
+  FLAG_ENSEMBLE_THREADS,
   FLAG_DATA_RECONCILE_Eps,
   FLAG_F,
   FLAG_HELP,
@@ -90,6 +94,7 @@ enum _FLAG
   FLAG_IDA_MAXCONVFAILS,
   FLAG_IDA_NONLINCONVCOEF,
   FLAG_IDA_LS,
+  FLAG_IDA_PRECOND,
   FLAG_IDA_SCALING,
   FLAG_IDAS,
   FLAG_IGNORE_HIDERESULT,
@@ -110,6 +115,7 @@ enum _FLAG
   FLAG_JACOBIAN_THREADS,
   FLAG_L,
   FLAG_L_DATA_RECOVERY,
+  FLAG_LIVE_RESULT,
   FLAG_LOG_FORMAT,
   FLAG_LS,
   FLAG_LS_IPOPT,
@@ -158,11 +164,13 @@ enum _FLAG
   FLAG_OUTPUT_PATH,
   FLAG_OVERRIDE,
   FLAG_OVERRIDE_FILE,
+  FLAG_PARALLEL_ODE_THREADS,
   FLAG_PORT,
   FLAG_R,
   FLAG_DATA_RECONCILE,
   FLAG_DATA_RECONCILE_BOUNDARY,
   FLAG_DATA_RECONCILE_STATE,
+  FLAG_RESTART,
   FLAG_SR,
   FLAG_SR_CTRL,
   FLAG_SR_CTRL_FILTER,
@@ -181,6 +189,7 @@ enum _FLAG
   FLAG_SAVE_INITIAL_GUESS_SYSTEM,
   FLAG_SINGLE_PRECISION,
   FLAG_SOLVER_STEPS,
+  FLAG_SPATIAL_DISTR_TOL,
   FLAG_STEADY_STATE,
   FLAG_STEADY_STATE_TOL,
   FLAG_STOP_AT_SYSTEM,
@@ -469,6 +478,25 @@ enum IDA_LS
 extern const char *IDA_LS_METHOD_NAME[IDA_LS_MAX];
 extern const char *IDA_LS_METHOD_DESC[IDA_LS_MAX];
 
+/**
+ * @brief Preconditioner method
+ *
+ * Specify the preconditioner used by the iterative linear solvers of IDA.
+ */
+enum IDA_PRECOND
+{
+  IDA_PRECOND_UNKNOWN = 0, /* Unknown method */
+
+  IDA_PRECOND_NONE,     /* No preconditioner */
+  IDA_PRECOND_JACOBI,   /* Diagonal (Jacobi) preconditioner built from the colored Jacobian */
+  IDA_PRECOND_ILU,      /* Incomplete LU factorization with zero fill-in of the colored Jacobian */
+
+  IDA_PRECOND_MAX       /* Maximum number of methods available. Not a method itself! */
+};
+
+extern const char *IDA_PRECOND_METHOD_NAME[IDA_PRECOND_MAX];
+extern const char *IDA_PRECOND_METHOD_DESC[IDA_PRECOND_MAX];
+
 /**
  * @brief Type of non-linear solver method
  *
@@ -0,0 +1,224 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF THE BSD NEW LICENSE OR THE
+ * GPL VERSION 3 LICENSE OR THE OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the OSMC (Open Source Modelica Consortium)
+ * Public License (OSMC-PL) are obtained from OSMC, either from the above
+ * address, from the URLs: http://www.openmodelica.org or
+ * http://www.ida.liu.se/projects/OpenModelica, and in the OpenModelica
+ * distribution. GNU version 3 is obtained from:
+ * http://www.gnu.org/copyleft/gpl.html. The New BSD License is obtained from:
+ * http://www.opensource.org/licenses/BSD-3-Clause.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE, EXCEPT AS
+ * EXPRESSLY SET FORTH IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE
+ * CONDITIONS OF OSMC-PL.
+ *
+ */
+
+/*! \file timer_queue.c
+ */
+
+#include "timer_queue.h"
+#include "omc_error.h"
+
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct TIMER_NODE
+{
+  double activationTime;    /* key of the heap */
+  unsigned long order;      /* insertion number, breaks ties between equal activation times */
+} TIMER_NODE;
+
+struct TIMER_QUEUE
+{
+  char *nodes;              /* heap of nodes, each TIMER_NODE followed by the item */
+  size_t nodeSize;          /* size of one node in bytes */
+  int itemSize;             /* size of one item in bytes */
+  int nTimers;              /* number of timers in queue */
+  int queueSize;            /* number of timers which could be stored in queue */
+  unsigned long nInserted;  /* number of timers inserted so far */
+  char *tmpNode;            /* scratch node for sifting */
+};
+
+#define TIMER_NODE_AT(tq, i) ((TIMER_NODE*)((tq)->nodes + (size_t)(i) * (tq)->nodeSize))
+#define TIMER_ITEM(node) ((void*)((char*)(node) + sizeof(TIMER_NODE)))
+
+static int timerBefore(const TIMER_NODE *a, const TIMER_NODE *b)
+{
+  return a->activationTime < b->activationTime || (a->activationTime == b->activationTime && a->order < b->order);
+}
+
+/**
+ * @brief Allocate memory for timer queue.
+ *
+ * Free memory with `freeTimerQueue`.
+ *
+ * @param queueSize       Initial number of timers the queue can hold, grows if needed.
+ * @param itemSize        Size of data stored with each timer in bytes.
+ * @return TIMER_QUEUE*   Pointer to allocated timer queue.
+ */
+TIMER_QUEUE *allocTimerQueue(int queueSize, int itemSize)
+{
+  TIMER_QUEUE *tq = (TIMER_QUEUE*)malloc(sizeof(TIMER_QUEUE));
+  assertStreamPrint(NULL, 0 != tq, "out of memory");
+
+  /* keep the activation time of the next node aligned */
+  tq->nodeSize = (sizeof(TIMER_NODE) + itemSize + sizeof(double) - 1) / sizeof(double) * sizeof(double);
+  tq->itemSize = itemSize;
+  tq->nTimers = 0;
+  tq->queueSize = queueSize > 0 ? queueSize : 1;
+  tq->nInserted = 0;
+  tq->nodes = (char*)malloc(tq->queueSize * tq->nodeSize);
+  tq->tmpNode = (char*)malloc(tq->nodeSize);
+  assertStreamPrint(NULL, 0 != tq->nodes && 0 != tq->tmpNode, "out of memory");
+
+  return tq;
+}
+
+/**
+ * @brief Free timer queue.
+ *
+ * @param tq  Pointer to timer queue, can be NULL.
+ */
+void freeTimerQueue(TIMER_QUEUE *tq)
+{
+  if (tq) {
+    free(tq->nodes);
+    free(tq->tmpNode);
+    free(tq);
+  }
+}
+
+/**
+ * @brief Insert timer into queue.
+ *
+ * @param tq              Pointer to timer queue.
+ * @param activationTime  Time the timer fires.
+ * @param item            Data of timer, itemSize bytes are copied.
+ */
+void pushTimer(TIMER_QUEUE *tq, double activationTime, const void *item)
+{
+  TIMER_NODE *node = (TIMER_NODE*)tq->tmpNode;
+  int i, parent;
+
+  if (tq->nTimers == tq->queueSize) {
+    tq->queueSize *= 2;
+    tq->nodes = (char*)realloc(tq->nodes, tq->queueSize * tq->nodeSize);
+    assertStreamPrint(NULL, 0 != tq->nodes, "out of memory");
+  }
+
+  node->activationTime = activationTime;
+  node->order = tq->nInserted++;
+  memcpy(TIMER_ITEM(node), item, tq->itemSize);
+
+  /* sift up */
+  for (i = tq->nTimers++; i > 0; i = parent) {
+    parent = (i - 1) / 2;
+    if (!timerBefore(node, TIMER_NODE_AT(tq, parent))) {
+      break;
+    }
+    memcpy(TIMER_NODE_AT(tq, i), TIMER_NODE_AT(tq, parent), tq->nodeSize);
+  }
+  memcpy(TIMER_NODE_AT(tq, i), node, tq->nodeSize);
+}
+
+/**
+ * @brief Remove timer with lowest activation time from queue.
+ *
+ * @param tq        Pointer to non-empty timer queue.
+ * @param item      Data of removed timer is copied here, can be NULL.
+ * @return double   Activation time of removed timer.
+ */
+double popTimer(TIMER_QUEUE *tq, void *item)
+{
+  TIMER_NODE *last;
+  double activationTime;
+  int i, child, n;
+
+  assertStreamPrint(NULL, tq->nTimers > 0, "empty TimerQueue");
+
+  activationTime = TIMER_NODE_AT(tq, 0)->activationTime;
+  if (item) {
+    memcpy(item, TIMER_ITEM(TIMER_NODE_AT(tq, 0)), tq->itemSize);
+  }
+
+  n = --tq->nTimers;
+  if (n == 0) {
+    return activationTime;
+  }
+
+  /* sift last node down from the root */
+  last = TIMER_NODE_AT(tq, n);
+  for (i = 0; (child = 2 * i + 1) < n; i = child) {
+    if (child + 1 < n && timerBefore(TIMER_NODE_AT(tq, child + 1), TIMER_NODE_AT(tq, child))) {
+      child++;
+    }
+    if (!timerBefore(TIMER_NODE_AT(tq, child), last)) {
+      break;
+    }
+    memcpy(TIMER_NODE_AT(tq, i), TIMER_NODE_AT(tq, child), tq->nodeSize);
+  }
+  memcpy(TIMER_NODE_AT(tq, i), last, tq->nodeSize);
+
+  return activationTime;
+}
+
+/**
+ * @brief Get data of timer with lowest activation time.
+ *
+ * @param tq        Pointer to timer queue.
+ * @return void*    Pointer to data of next timer, NULL if queue is empty.
+ *                  Only valid until the queue is modified.
+ */
+void *nextTimer(TIMER_QUEUE *tq)
+{
+  return tq->nTimers > 0 ? TIMER_ITEM(TIMER_NODE_AT(tq, 0)) : NULL;
+}
+
+/**
+ * @brief Get lowest activation time of all timers.
+ *
+ * @param tq        Pointer to timer queue.
+ * @return double   Activation time of next timer, DBL_MAX if queue is empty.
+ */
+double nextTimerTime(TIMER_QUEUE *tq)
+{
+  return tq->nTimers > 0 ? TIMER_NODE_AT(tq, 0)->activationTime : DBL_MAX;
+}
+
+/**
+ * @brief Returns number of timers in queue.
+ *
+ * @param tq      Pointer to timer queue.
+ * @return int    Number of timers.
+ */
+int timerQueueLength(TIMER_QUEUE *tq)
+{
+  return tq->nTimers;
+}
+
+/**
+ * @brief Remove all timers from queue.
+ *
+ * @param tq  Pointer to timer queue.
+ */
+void clearTimerQueue(TIMER_QUEUE *tq)
+{
+  tq->nTimers = 0;
+  tq->nInserted = 0;
+}
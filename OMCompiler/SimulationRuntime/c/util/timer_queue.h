@@ -0,0 +1,64 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF THE BSD NEW LICENSE OR THE
+ * GPL VERSION 3 LICENSE OR THE OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the OSMC (Open Source Modelica Consortium)
+ * Public License (OSMC-PL) are obtained from OSMC, either from the above
+ * address, from the URLs: http://www.openmodelica.org or
+ * http://www.ida.liu.se/projects/OpenModelica, and in the OpenModelica
+ * distribution. GNU version 3 is obtained from:
+ * http://www.gnu.org/copyleft/gpl.html. The New BSD License is obtained from:
+ * http://www.opensource.org/licenses/BSD-3-Clause.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE, EXCEPT AS
+ * EXPRESSLY SET FORTH IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE
+ * CONDITIONS OF OSMC-PL.
+ *
+ */
+
+/*! \file timer_queue.h
+ *
+ * Priority queue of timers, e.g. clock ticks or sample events, ordered by
+ * their activation time. Implemented as binary min-heap, so insertion and
+ * removal of the next timer are O(log n). Timers with equal activation time
+ * are returned in the order they were inserted.
+ */
+
+#ifndef _TIMER_QUEUE_H_
+#define _TIMER_QUEUE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  struct TIMER_QUEUE;
+  typedef struct TIMER_QUEUE TIMER_QUEUE;
+
+  TIMER_QUEUE *allocTimerQueue(int queueSize, int itemSize);
+  void freeTimerQueue(TIMER_QUEUE *tq);
+
+  void pushTimer(TIMER_QUEUE *tq, double activationTime, const void *item);
+  double popTimer(TIMER_QUEUE *tq, void *item);
+  void *nextTimer(TIMER_QUEUE *tq);
+  double nextTimerTime(TIMER_QUEUE *tq);
+
+  int timerQueueLength(TIMER_QUEUE *tq);
+  void clearTimerQueue(TIMER_QUEUE *tq);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
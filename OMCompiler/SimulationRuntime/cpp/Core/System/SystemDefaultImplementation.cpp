@@ -55,6 +55,8 @@ SystemDefaultImplementation::SystemDefaultImplementation(IGlobalSettings *global
   , _dimAE          (0)
   , _timeEventData  (NULL)
   , _currTimeEvents (NULL)
+  , _timeEventQueueTime(0.0)
+  , _timeEventQueueValid(false)
   , _clockInterval  (NULL)
   , _clockShift     (NULL)
   , _clockTime      (NULL)
@@ -98,6 +100,8 @@ SystemDefaultImplementation::SystemDefaultImplementation(SystemDefaultImplementa
   , _dimAE          (0)
   , _timeEventData  (NULL)
   , _currTimeEvents (NULL)
+  , _timeEventQueueTime(0.0)
+  , _timeEventQueueValid(false)
   , _clockInterval  (NULL)
   , _clockShift     (NULL)
   , _clockTime      (NULL)
@@ -207,6 +211,7 @@ int SystemDefaultImplementation::getDimClock() const
 void SystemDefaultImplementation::setIntervalInTimEventData(int clockIdx, double interval)
 {
     _timeEventData[_dimTimeEvent-_dimClock+clockIdx].second = interval;
+    resetTimeEventQueue();
 }
 
 /// Provide number (dimension) of right hand sides (equations and/or residuals) according to the index
@@ -798,40 +803,93 @@ void SystemDefaultImplementation::resetTimeConditions()
 }
 
 /**
-    Computes the next time events for each time event sampler
+    Discards the queue of the next time events, it is rebuilt by the next call
+    of computeNextTimeEvents. Must be called when the time event data changes.
+*/
+void SystemDefaultImplementation::resetTimeEventQueue()
+{
+  _timeEventQueue.clear();
+  _timeEventQueueValid = false;
+}
+
+/**
+    Computes the last and the next time event of one time event sampler
+    @param The current Time
+    @param The index of the time event sampler
+    @param The definition of the time event samplers (starttime, intervall)
+    @return the next time event of the sampler
+*/
+double SystemDefaultImplementation::computeNextTimeEvent(double currTime, int timerIdx, std::pair<double, double>* timeEventPairs)
+{
+  double nextTimeEvent;
+  double pastIntervalls;
+
+  // the time event samples started already
+  if (timeEventPairs[timerIdx].first <= currTime)
+  {
+    pastIntervalls = std::floor((currTime - timeEventPairs[timerIdx].first + 1e4*UROUND) / timeEventPairs[timerIdx].second);
+    _currTimeEvents[timerIdx] = timeEventPairs[timerIdx].first + (pastIntervalls) * timeEventPairs[timerIdx].second;
+    nextTimeEvent = _currTimeEvents[timerIdx] + timeEventPairs[timerIdx].second;
+  }
+  else
+  {
+    nextTimeEvent = timeEventPairs[timerIdx].first;
+    _currTimeEvents[timerIdx] = 1.0;
+  }
+  // a sampler without a valid interval never fires, a NaN would break the order of the queue
+  if (!(nextTimeEvent < std::numeric_limits<double>::max()))
+    nextTimeEvent = std::numeric_limits<double>::max();
+  return nextTimeEvent;
+}
+
+/**
+    Computes the next time events for each time event sampler.
+    The samplers are kept in a binary heap ordered by their next time event,
+    so only the samplers that fire at the current time are updated.
     @param The current Time
     @param The definition of the time event samplers (starttime, intervall)
-    @param An array of the next time events for each sampler
     @return the closest time event
 */
 double SystemDefaultImplementation::computeNextTimeEvents(double currTime, std::pair<double, double>* timeEventPairs)
 {
-  double closestTimeEvent = std::numeric_limits<double>::max();
-  double nextTimeEvent = 0;
-  double pastIntervalls;
+  std::greater<std::pair<double, int> > later;
   int clockOffset = _dimTimeEvent - _dimClock;
 
-  for (int timerIdx = 0; timerIdx < _dimTimeEvent; timerIdx++)
+  if (!_timeEventQueueValid || currTime < _timeEventQueueTime)
   {
-    // skip event clocks
-    if (timerIdx >= clockOffset && _clockEventBased[timerIdx - clockOffset])
-      continue;
-
-    // the time event samples started already
-    if (timeEventPairs[timerIdx].first <= currTime)
+    // (re)build the queue at the start or if the time went back
+    _timeEventQueue.clear();
+    for (int timerIdx = 0; timerIdx < _dimTimeEvent; timerIdx++)
     {
-      pastIntervalls = std::floor((currTime - timeEventPairs[timerIdx].first + 1e4*UROUND) / timeEventPairs[timerIdx].second);
-      _currTimeEvents[timerIdx] = timeEventPairs[timerIdx].first + (pastIntervalls) * timeEventPairs[timerIdx].second;
-      nextTimeEvent = _currTimeEvents[timerIdx] + timeEventPairs[timerIdx].second;
+      // skip event clocks
+      if (timerIdx >= clockOffset && _clockEventBased[timerIdx - clockOffset])
+        continue;
+      _timeEventQueue.push_back(std::make_pair(computeNextTimeEvent(currTime, timerIdx, timeEventPairs), timerIdx));
     }
-    else
+    std::make_heap(_timeEventQueue.begin(), _timeEventQueue.end(), later);
+    _timeEventQueueValid = true;
+  }
+  else
+  {
+    // move all samplers that fire at the current time to the end of the queue
+    size_t numDue = 0;
+    while (numDue < _timeEventQueue.size() && _timeEventQueue.front().first <= currTime + 1e4*UROUND)
     {
-      nextTimeEvent = timeEventPairs[timerIdx].first;
-      _currTimeEvents[timerIdx] = 1.0;
+      std::pop_heap(_timeEventQueue.begin(), _timeEventQueue.end() - numDue, later);
+      numDue++;
+    }
+    // and insert them again with their next time event
+    for (size_t i = _timeEventQueue.size() - numDue; i < _timeEventQueue.size(); i++)
+    {
+      _timeEventQueue[i].first = computeNextTimeEvent(currTime, _timeEventQueue[i].second, timeEventPairs);
+      std::push_heap(_timeEventQueue.begin(), _timeEventQueue.begin() + i + 1, later);
     }
-    closestTimeEvent = std::min(closestTimeEvent, nextTimeEvent);
   }
-  return closestTimeEvent;
+  _timeEventQueueTime = currTime;
+
+  if (_timeEventQueue.empty())
+    return std::numeric_limits<double>::max();
+  return _timeEventQueue.front().first;
 }
 
 /** @} */ // end of coreSystem
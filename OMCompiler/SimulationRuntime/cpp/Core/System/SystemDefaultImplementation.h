@@ -149,6 +149,7 @@ public:
   shared_ptr<ISimVars> getSimVars();
 
   double computeNextTimeEvents(double currTime, std::pair<double, double>* timeEventPairs);
+  void resetTimeEventQueue();
   void computeTimeEventConditions(double currTime);
   void setIntervalInTimEventData(int clockIdx, double interval);
   void resetTimeConditions();
@@ -177,6 +178,7 @@ protected:
     void storeTime(double time);
     double delay(unsigned int expr_id,double expr_value, double delayTime, double delayMax);
     bool isConsistent();
+    double computeNextTimeEvent(double currTime, int timerIdx, std::pair<double, double>* timeEventPairs);
 
     shared_ptr<ISimObjects> _simObjects;
 
@@ -204,6 +206,10 @@ protected:
     std::pair<double, double>*
         _timeEventData;
     double* _currTimeEvents;
+    std::vector<std::pair<double, int> >
+        _timeEventQueue;      ///< next time event and index of the time event samplers, binary min-heap
+    double _timeEventQueueTime;  ///< time of the last update of _timeEventQueue
+    bool _timeEventQueueValid;
 
     double *_clockInterval;   ///< time interval between clock ticks
     double *_clockShift;      ///< time before first activation
@@ -258,7 +258,7 @@ static inline void setThreadData(ModelInstance* comp)
 
 fmi2Status internalEventUpdate(fmi2Component c, fmi2EventInfo* eventInfo)
 {
-  int i, done=0;
+  int done=0;
   ModelInstance* comp = (ModelInstance *)c;
   threadData_t *threadData = comp->threadData;
   fmi2Real nextSampleEvent;
@@ -292,12 +292,7 @@ fmi2Status internalEventUpdate(fmi2Component c, fmi2EventInfo* eventInfo)
     //storePreValues(comp->fmuData);
 
     /* activate sample event */
-    for(i=0; i<comp->fmuData->modelData->nSamples; ++i) {
-      if (comp->fmuData->simulationInfo->nextSampleTimes[i] <= comp->fmuData->localData[0]->timeValue) {
-        comp->fmuData->simulationInfo->samples[i] = 1;
-        infoStreamPrint(LOG_EVENTS, 0, "[%ld] sample(%g, %g)", comp->fmuData->modelData->samplesInfo[i].index, comp->fmuData->modelData->samplesInfo[i].start, comp->fmuData->modelData->samplesInfo[i].interval);
-      }
-    }
+    activateSampleEvents(comp->fmuData, comp->fmuData->localData[0]->timeValue);
 
     /* fix issue https://github.com/OpenModelica/OpenModelica/issues/12350
      * we need to update discreteSystem during event update, before evaluating functionDAE
@@ -307,18 +302,7 @@ fmi2Status internalEventUpdate(fmi2Component c, fmi2EventInfo* eventInfo)
     comp->fmuData->callback->functionDAE(comp->fmuData, comp->threadData);
 
     /* deactivate sample events */
-    for(i=0; i<comp->fmuData->modelData->nSamples; ++i) {
-      if (comp->fmuData->simulationInfo->samples[i]) {
-        comp->fmuData->simulationInfo->samples[i] = 0;
-        comp->fmuData->simulationInfo->nextSampleTimes[i] += comp->fmuData->modelData->samplesInfo[i].interval;
-      }
-    }
-
-    for(i=0; i<comp->fmuData->modelData->nSamples; ++i) {
-      if ((i == 0) || (comp->fmuData->simulationInfo->nextSampleTimes[i] < comp->fmuData->simulationInfo->nextSampleEvent)) {
-        comp->fmuData->simulationInfo->nextSampleEvent = comp->fmuData->simulationInfo->nextSampleTimes[i];
-      }
-    }
+    deactivateSampleEvents(comp->fmuData);
 
     /* Handle clock timers */
     syncRet = handleTimersFMI(comp->fmuData, comp->threadData, comp->fmuData->localData[0]->timeValue, &nextTimerDefined, &nextTimerActivationTime);
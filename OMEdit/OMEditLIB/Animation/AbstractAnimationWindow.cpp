@@ -46,6 +46,7 @@
 #include "Visualization.h"
 #include "VisualizationMAT.h"
 #include "VisualizationCSV.h"
+#include "VisualizationLive.h"
 
 #include <QDockWidget>
 
@@ -144,6 +145,11 @@ void AbstractAnimationWindow::openAnimationFile(QString fileName, bool stashCame
         initInteractiveControlPanel();
       }
 
+      // follow a running simulation right away
+      if (mpVisualization->getTimeManager()->isLive()) {
+        mpVisualization->getTimeManager()->setPause(false);
+      }
+
       if(stashCamera && !mCameraInitialized) {         // mCameraInitialized is used to make sure the view is never stashed
         mCameraInitialized = true;      // before the camera is initialized the first time
         stashView();
@@ -387,6 +393,8 @@ bool AbstractAnimationWindow::loadVisualization()
     visType = VisType::MAT;
   } else if (isCSV(mFileName)) {
     visType = VisType::CSV;
+  } else if (isLIVE(mFileName)) {
+    visType = VisType::LIVE;
   } else {
     MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, tr("Unknown visualization type."),
                                                           Helper::scriptingKind, Helper::errorLevel));
@@ -400,11 +408,20 @@ bool AbstractAnimationWindow::loadVisualization()
                                                           Helper::errorLevel));
     return false;
   } else {
+    // release the live result file of a running simulation when it is replaced, e.g. by the result file once the simulation has finished
+    if (mpVisualization && mpVisualization->getVisType() == VisType::LIVE) {
+      mpVisualization->getTimeManager()->setPause(true);
+      mpViewerWidget->getSceneView()->setSceneData(nullptr);
+      delete mpVisualization;
+      mpVisualization = nullptr;
+    }
     //init visualization
     if (visType == VisType::MAT) {
       mpVisualization = new VisualizationMAT(mFileName, mPathName);
     } else if (visType == VisType::CSV) {
       mpVisualization = new VisualizationCSV(mFileName, mPathName);
+    } else if (visType == VisType::LIVE) {
+      mpVisualization = new VisualizationLive(mFileName, mPathName);
     } else if (visType == VisType::FMU) {
       mpVisualization = new VisualizationFMU(mFileName, mPathName);
     } else {
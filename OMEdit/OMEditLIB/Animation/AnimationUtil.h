@@ -53,7 +53,8 @@ enum class VisType
   MAT = 3,
   MAT_REMOTE = 4,
   CSV = 5,
-  CSV_REMOTE = 6
+  CSV_REMOTE = 6,
+  LIVE = 7
 };
 
 /*!
@@ -83,6 +84,15 @@ inline bool isCSV(const std::string& fileIn){
   return (csv != std::string::npos);
 }
 
+/*!
+ * \brief isLIVE
+ * checks of the file is a live result file of a running simulation
+ */
+inline bool isLIVE(const std::string& fileIn){
+  std::size_t live = fileIn.find(".live");
+  return (live != std::string::npos);
+}
+
 /*!
  * \brief assembleXMLFileName
  * constructs the name of the corresponding xml file
@@ -90,7 +100,7 @@ inline bool isCSV(const std::string& fileIn){
 inline std::string assembleXMLFileName(const std::string& modelFile, const std::string& path){
   QFileInfo fi(modelFile.c_str());
   QString suf = fi.suffix();
-  if (!(suf.compare("mat") || suf.compare("csv") || suf.compare("fmu"))) {
+  if (!(suf.compare("mat") || suf.compare("csv") || suf.compare("fmu") || suf.compare("live"))) {
     MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, QObject::tr("This file extension is not supported."),
                                                           Helper::scriptingKind, Helper::errorLevel));
   }
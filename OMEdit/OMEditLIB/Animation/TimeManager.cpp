@@ -45,6 +45,7 @@ TimeManager::TimeManager(const double simTime, const double realTime, const doub
     _endTime(endTime),
     _pause(true),
     _repeat(false),
+    _live(false),
     mSpeedUp(1.0),
     mTimeDiscretization(1000)
 {
@@ -153,6 +154,16 @@ void TimeManager::setRepeat(const bool repeat)
   _repeat = repeat;
 }
 
+bool TimeManager::isLive() const
+{
+  return _live;
+}
+
+void TimeManager::setLive(const bool live)
+{
+  _live = live;
+}
+
 void TimeManager::setSpeedUp(double value)
 {
   mSpeedUp = value;
@@ -88,6 +88,10 @@ class TimeManager
   void setPause(const bool status);
   bool canRepeat() const;
   void setRepeat(const bool repeat);
+  /*! \brief Returns true, if the visualization follows a running simulation. */
+  bool isLive() const;
+  /*! \brief Sets if the visualization follows a running simulation, playing then shows the newest simulation time. */
+  void setLive(const bool live);
   int getTimeFraction();
   void setSpeedUp(double value);
   double getSpeedUp();
@@ -112,6 +116,8 @@ class TimeManager
   bool _pause;
   //! This variable indicates if the simulation/visualization can repeat.
   bool _repeat;
+  //! This variable indicates if the visualization follows a running simulation up to _simTime.
+  bool _live;
   double mSpeedUp;
   int mTimeDiscretization;
   rtclock_t _visualTimer;
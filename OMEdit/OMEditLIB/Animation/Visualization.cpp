@@ -1257,8 +1257,14 @@ void VisualizationAbstract::sceneUpdate()
   mpTimeManager->updateTick();
   // set next time step
   if (!mpTimeManager->isPaused()) {
-    // finish animation with pause when end time is reached
-    if (mpTimeManager->getVisTime() >= mpTimeManager->getEndTime()) {
+    if (mpTimeManager->isLive()) {
+      // follow the running simulation by showing its newest time, the frames in between are skipped
+      if (mpTimeManager->getSimTime() != mpTimeManager->getVisTime()) {
+        mpTimeManager->setVisTime(mpTimeManager->getSimTime());
+        updateScene(mpTimeManager->getVisTime());
+      }
+    } else if (mpTimeManager->getVisTime() >= mpTimeManager->getEndTime()) {
+      // finish animation with pause when end time is reached
       if (mpTimeManager->canRepeat()) {
         initVisualization();
         mpTimeManager->setPause(false);
@@ -252,7 +252,7 @@ public:
   virtual void simulate(TimeManager& omvm) = 0;
 
   void setUpScene();
-  void sceneUpdate();
+  virtual void sceneUpdate();
 
   void initVisualization();
   void startVisualization();
@@ -0,0 +1,305 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#include "VisualizationLive.h"
+
+#include <atomic>
+#include <cstring>
+
+VisualizationLive::VisualizationLive(const std::string& modelFile, const std::string& path)
+  : VisualizationAbstract(modelFile, path, VisType::LIVE),
+    mpData(nullptr),
+    mpHeader(nullptr)
+{
+}
+
+/*!
+ * \brief VisualizationLive::~VisualizationLive
+ * Unmaps the live result file.
+ */
+VisualizationLive::~VisualizationLive()
+{
+  if (mpData) {
+    mFile.unmap(const_cast<uchar*>(mpData));
+  }
+}
+
+void VisualizationLive::initData()
+{
+  VisualizationAbstract::initData();
+  if (openLiveResult(mpOMVisualBase->getModelFile(), mpOMVisualBase->getPath())) {
+    mpTimeManager->setStartTime(mpHeader->startTime);
+    mpTimeManager->setEndTime(mpHeader->stopTime);
+    double time;
+    if (writeCount() > 0 && readFrameTime(writeCount() - 1, time)) {
+      mpTimeManager->setSimTime(time);
+    } else {
+      mpTimeManager->setSimTime(mpHeader->startTime);
+    }
+    mpTimeManager->setLive(!isFinished());
+  }
+}
+
+void VisualizationLive::initializeVisAttributes(const double time)
+{
+  if (mpHeader) {
+    readFrameAt(time);
+  }
+  updateVisAttributes(time);
+}
+
+/*!
+ * \brief VisualizationLive::sceneUpdate
+ * Updates the newest simulation time before updating the scene, so that a playing animation follows the simulation.
+ * Once the simulation has finished the animation stops at its last frame.
+ */
+void VisualizationLive::sceneUpdate()
+{
+  if (mpHeader && mpTimeManager->isLive()) {
+    const bool finished = isFinished();
+    const uint64_t count = writeCount();
+    double time;
+    if (count > 0 && readFrameTime(count - 1, time)) {
+      mpTimeManager->setSimTime(time);
+    }
+    if (finished) {
+      mpTimeManager->setLive(false);
+      mpTimeManager->setEndTime(mpTimeManager->getSimTime());
+      mpTimeManager->setVisTime(mpTimeManager->getSimTime());
+      updateScene(mpTimeManager->getVisTime());
+      mpTimeManager->setPause(true);
+      return;
+    }
+  }
+  VisualizationAbstract::sceneUpdate();
+}
+
+void VisualizationLive::updateScene(const double time)
+{
+  mpTimeManager->updateTick();  //for real-time measurement
+  double visTime = mpTimeManager->getRealTime();
+  if (mpHeader) {
+    readFrameAt(time);
+  }
+  updateVisAttributes(time);
+  mpTimeManager->updateTick();  //for real-time measurement
+  visTime = mpTimeManager->getRealTime() - visTime;
+  mpTimeManager->setRealTimeFactor(mpTimeManager->getHVisual() / visTime);
+}
+
+void VisualizationLive::updateVisualizerAttribute(VisualizerAttribute& attr, const double time)
+{
+  Q_UNUSED(time);
+  if (!attr.isConst) {
+    attr.exp = getVarValue(attr.cref);
+  }
+}
+
+/*!
+ * \brief VisualizationLive::isFinished
+ * Returns true if the simulation writing the live result file has finished.
+ */
+bool VisualizationLive::isFinished() const
+{
+  return !mpHeader || mpHeader->state == OMC_LIVE_RESULT_FINISHED;
+}
+
+/*!
+ * \brief VisualizationLive::openLiveResult
+ * Maps the live result file and reads its variable names.
+ * \param modelFile
+ * \param path
+ * \return true if the file is a valid live result file.
+ */
+bool VisualizationLive::openLiveResult(const std::string& modelFile, const std::string& path)
+{
+  QString fileName = QString::fromStdString(path + modelFile);
+  mFile.setFileName(fileName);
+  if (!mFile.open(QIODevice::ReadOnly)) {
+    MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, QObject::tr("Could not open the live result file %1: %2.")
+                                                          .arg(fileName, mFile.errorString()), Helper::scriptingKind, Helper::errorLevel));
+    return false;
+  }
+  // the writer creates the file with its final size and writes the magic after the rest of the header
+  const omc_live_result_header* pHeader = nullptr;
+  if (mFile.size() >= (qint64)sizeof(omc_live_result_header)) {
+    mpData = mFile.map(0, mFile.size());
+    pHeader = reinterpret_cast<const omc_live_result_header*>(mpData);
+  }
+  if (!pHeader || std::memcmp(pHeader->magic, OMC_LIVE_RESULT_MAGIC, sizeof(pHeader->magic)) != 0
+      || pHeader->version != OMC_LIVE_RESULT_VERSION || pHeader->headerSize != sizeof(omc_live_result_header)
+      || pHeader->fileSize > (uint64_t)mFile.size() || pHeader->numSignals == 0 || pHeader->numFrames == 0) {
+    MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, QObject::tr("%1 is not a valid live result file.").arg(fileName),
+                                                          Helper::scriptingKind, Helper::errorLevel));
+    if (mpData) {
+      mFile.unmap(const_cast<uchar*>(mpData));
+      mpData = nullptr;
+    }
+    return false;
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  mpHeader = pHeader;
+  // read the names
+  const omc_live_result_name* pNames = reinterpret_cast<const omc_live_result_name*>(mpData + mpHeader->namesOffset);
+  const char* pStrings = reinterpret_cast<const char*>(mpData + mpHeader->stringsOffset);
+  mNames.reserve(mpHeader->numNames);
+  for (uint32_t i = 0; i < mpHeader->numNames; ++i) {
+    mNames.emplace(std::string(pStrings + pNames[i].nameOffset), pNames[i]);
+  }
+  mValues.assign(mpHeader->numSignals, 0.0);
+  return true;
+}
+
+/*!
+ * \brief VisualizationLive::isReady
+ * Checks if a simulation has created the live result file, i.e., the file has its magic which is written last.
+ * \param fileName
+ * \return true if the file can be opened.
+ */
+bool VisualizationLive::isReady(const QString& fileName)
+{
+  QFile file(fileName);
+  if (!file.open(QIODevice::ReadOnly) || file.size() < (qint64)sizeof(omc_live_result_header)) {
+    return false;
+  }
+  const QByteArray magic = file.read(sizeof(omc_live_result_header::magic));
+  return magic.size() == (int)sizeof(omc_live_result_header::magic)
+      && std::memcmp(magic.constData(), OMC_LIVE_RESULT_MAGIC, magic.size()) == 0;
+}
+
+/*!
+ * \brief VisualizationLive::writeCount
+ * Returns the number of frames written so far.
+ */
+uint64_t VisualizationLive::writeCount() const
+{
+  const uint64_t count = mpHeader->writeCount;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return count;
+}
+
+/*!
+ * \brief VisualizationLive::readFrameTime
+ * Reads the time of the given frame.
+ * \param frame
+ * \param time
+ * \return false if the frame is not in the ring buffer anymore.
+ */
+bool VisualizationLive::readFrameTime(const uint64_t frame, double& time) const
+{
+  const uchar* pSlot = mpData + mpHeader->framesOffset + (frame % mpHeader->numFrames) * OMC_LIVE_RESULT_FRAME_SIZE(mpHeader->numSignals);
+  const volatile uint64_t* pSequence = reinterpret_cast<const volatile uint64_t*>(pSlot);
+  if (*pSequence != frame + 1) {
+    return false;
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  std::memcpy(&time, pSlot + sizeof(uint64_t), sizeof(double));
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return *pSequence == frame + 1;
+}
+
+/*!
+ * \brief VisualizationLive::readFrame
+ * Copies the values of the given frame.
+ * \param frame
+ * \return false if the frame is not in the ring buffer anymore, mValues is then unspecified.
+ */
+bool VisualizationLive::readFrame(const uint64_t frame)
+{
+  const uchar* pSlot = mpData + mpHeader->framesOffset + (frame % mpHeader->numFrames) * OMC_LIVE_RESULT_FRAME_SIZE(mpHeader->numSignals);
+  const volatile uint64_t* pSequence = reinterpret_cast<const volatile uint64_t*>(pSlot);
+  if (*pSequence != frame + 1) {
+    return false;
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  std::memcpy(mValues.data(), pSlot + sizeof(uint64_t), mValues.size() * sizeof(double));
+  std::atomic_thread_fence(std::memory_order_acquire);
+  // the writer has overwritten the slot if the sequence number changed while copying
+  return *pSequence == frame + 1;
+}
+
+/*!
+ * \brief VisualizationLive::readFrameAt
+ * Reads the newest frame at or before the given time.
+ * If the time is older than all the frames in the ring buffer then the oldest frame is read.
+ * \param time
+ * \return false if there is no frame yet.
+ */
+bool VisualizationLive::readFrameAt(const double time)
+{
+  // retry if the writer overwrites the frame while it is read
+  for (int attempt = 0; attempt < 8; ++attempt) {
+    const uint64_t count = writeCount();
+    if (count == 0) {
+      return false;
+    }
+    const uint64_t first = count > mpHeader->numFrames ? count - mpHeader->numFrames : 0;
+    uint64_t frame = count - 1;
+    double frameTime;
+    while (frame > first && readFrameTime(frame, frameTime) && frameTime > time) {
+      --frame;
+    }
+    if (readFrame(frame)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/*!
+ * \brief VisualizationLive::getVarValue
+ * Returns the value of the variable in the current frame.
+ * \param varName
+ * \return
+ */
+double VisualizationLive::getVarValue(const std::string& varName)
+{
+  auto it = mNames.find(varName);
+  if (it == mNames.end()) {
+    // report each missing variable once instead of on every frame
+    if (mMissingNames.insert(varName).second) {
+      MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica,
+                                                            QString(QObject::tr("Did not get variable from live result file. Variable name is %1."))
+                                                            .arg(varName.c_str()), Helper::scriptingKind, Helper::errorLevel));
+    }
+    return 0.0;
+  }
+  const omc_live_result_name& name = it->second;
+  double value = 0.0;
+  if (name.index >= 0) {
+    value = mValues[name.index];
+  } else if (mpHeader->state != OMC_LIVE_RESULT_INITIALIZING) {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const double* pParameters = reinterpret_cast<const double*>(mpData + mpHeader->parametersOffset);
+    value = pParameters[-name.index - 1];
+  }
+  return name.negate ? -value : value;
+}
@@ -0,0 +1,83 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#ifndef VISUALIZATIONLIVE_H
+#define VISUALIZATIONLIVE_H
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <QFile>
+
+#include "Visualization.h"
+#include "util/live_result.h"
+
+/*!
+ * \brief The VisualizationLive class
+ * Animates a running simulation from the live result file it publishes its results to with -liveResult.
+ * The file is mapped into memory and holds a ring buffer of the newest frames, see util/live_result.h.
+ */
+class VisualizationLive : public VisualizationAbstract
+{
+public:
+  VisualizationLive() = delete;
+  VisualizationLive(const std::string& fileName, const std::string& path);
+  ~VisualizationLive();
+  VisualizationLive(const VisualizationLive& omvl) = delete;
+  VisualizationLive& operator=(const VisualizationLive& omvl) = delete;
+  void initData() override;
+  void initializeVisAttributes(const double time) override;
+  void simulate(TimeManager& omvm) override {Q_UNUSED(omvm);}
+  void sceneUpdate() override;
+  void updateScene(const double time) override;
+  void updateVisualizerAttribute(VisualizerAttribute& attr, const double time) override;
+  bool isFinished() const;
+  static bool isReady(const QString& fileName);
+private:
+  bool openLiveResult(const std::string& modelFile, const std::string& path);
+  uint64_t writeCount() const;
+  bool readFrameTime(const uint64_t frame, double& time) const;
+  bool readFrame(const uint64_t frame);
+  bool readFrameAt(const double time);
+  double getVarValue(const std::string& varName);
+
+  QFile mFile;
+  const uchar* mpData;
+  const omc_live_result_header* mpHeader;
+  std::unordered_map<std::string, omc_live_result_name> mNames;
+  std::unordered_set<std::string> mMissingNames;
+  //! The values of the frame shown in the scene.
+  std::vector<double> mValues;
+};
+
+#endif // VISUALIZATIONLIVE_H
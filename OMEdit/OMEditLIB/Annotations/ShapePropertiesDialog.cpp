@@ -885,7 +885,7 @@ bool ShapePropertiesDialog::applyShapeProperties()
       MainWindow *pMainWindow = MainWindow::instance();
       LibraryTreeItem *pLibraryTreeItem = mpShapeAnnotation->getGraphicsView()->getModelWidget()->getLibraryTreeItem();
       QString nameStructure = StringHandler::getFirstWordBeforeDot(pLibraryTreeItem->getNameStructure());
-      pLibraryTreeItem = pMainWindow->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem(nameStructure);
+      pLibraryTreeItem = pMainWindow->getLibraryWidget()->getLibraryTreeModel()->fetchLibraryTreeItem(nameStructure);
       /* get the class directory path and use it to get the relative path of the chosen bitmap file */
       QFileInfo classFileInfo(pLibraryTreeItem->getFileName());
       QDir classDirectory = classFileInfo.absoluteDir();
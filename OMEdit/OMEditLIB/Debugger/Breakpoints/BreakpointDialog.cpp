@@ -190,7 +190,7 @@ void BreakpointDialog::addOrEditBreakpoint()
     }
   } else {  /* if user has selected a class using Browse Classes button */
     LibraryWidget *pLibraryWidget = MainWindow::instance()->getLibraryWidget();
-    LibraryTreeItem *pLibraryTreeItem = pLibraryWidget->getLibraryTreeModel()->findLibraryTreeItem(mpFileNameTextBox->text());
+    LibraryTreeItem *pLibraryTreeItem = pLibraryWidget->getLibraryTreeModel()->fetchLibraryTreeItem(mpFileNameTextBox->text());
     if (pLibraryTreeItem) {
       if (!pLibraryTreeItem->isSaved()) {
         QMessageBox::critical(this, QString(Helper::applicationName).append(" - ").append(Helper::error),
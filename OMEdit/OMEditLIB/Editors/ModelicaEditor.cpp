@@ -423,7 +423,7 @@ QStringList ModelicaEditor::getClassNames(QString *errorString)
   // check if the class already exists
   foreach(QString className, classNames) {
     if (pLibraryTreeItem->getNameStructure().compare(className) != 0) {
-      if (MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem(className)) {
+      if (MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->fetchLibraryTreeItem(className)) {
         existingmodelsList.append(className);
         existModel = true;
       }
@@ -1879,7 +1879,7 @@ void ElementParameters::commentLinkClicked(QString link)
   QUrl linkUrl(link);
   if (linkUrl.scheme().compare("modelica") == 0) {
     link = link.remove("modelica://");
-    LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem(link);
+    LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->fetchLibraryTreeItem(link);
     if (pLibraryTreeItem) {
       MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->showModelWidget(pLibraryTreeItem);
     }
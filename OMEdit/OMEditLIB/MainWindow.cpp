@@ -3223,10 +3223,10 @@ void MainWindow::openRecentModelWidget()
   QToolButton *pToolButton = qobject_cast<QToolButton*>(sender());
   LibraryTreeItem *pLibraryTreeItem;
   if (pAction) {
-    pLibraryTreeItem = mpLibraryWidget->getLibraryTreeModel()->findLibraryTreeItem(pAction->data().toString());
+    pLibraryTreeItem = mpLibraryWidget->getLibraryTreeModel()->fetchLibraryTreeItem(pAction->data().toString());
     mpModelWidgetContainer->addModelWidget(pLibraryTreeItem->getModelWidget(), false);
   } else if (pToolButton && mpModelSwitcherActions[0]->isVisible()) {
-    pLibraryTreeItem = mpLibraryWidget->getLibraryTreeModel()->findLibraryTreeItem(mpModelSwitcherActions[0]->data().toString());
+    pLibraryTreeItem = mpLibraryWidget->getLibraryTreeModel()->fetchLibraryTreeItem(mpModelSwitcherActions[0]->data().toString());
     mpModelWidgetContainer->addModelWidget(pLibraryTreeItem->getModelWidget(), false);
   }
 }
@@ -761,7 +761,7 @@ void OMSimulatorUndoCommand::switchToEditedModelWidget()
 {
   if (mSwitchToEdited) {
     LibraryTreeModel *pLibraryTreeModel = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel();
-    LibraryTreeItem *pEditedLibraryTreeItem = pLibraryTreeModel->findLibraryTreeItem(mEditedCref);
+    LibraryTreeItem *pEditedLibraryTreeItem = pLibraryTreeModel->fetchLibraryTreeItem(mEditedCref);
     if (pEditedLibraryTreeItem) {
       pLibraryTreeModel->showModelWidget(pEditedLibraryTreeItem);
     }
@@ -805,7 +805,10 @@ void OMCUndoCommand::redoInternal()
 {
   MainWindow::instance()->getOMCProxy()->loadString(mNewModelText, mpParentContainingLibraryTreeItem->getFileName(), Helper::utf8,
                                                     mpParentContainingLibraryTreeItem->isSaveFolderStructure());
-  if (!mSkipGetModelInstance || mUndoCalledOnce) {
+  if (mUndoCalledOnce) {
+    // redo from the undo stack, several commands might be redone at once so let the last one draw the model.
+    mpLibraryTreeItem->getModelWidget()->requestModelInstance(mNewModelInfo);
+  } else if (!mSkipGetModelInstance) {
     mpLibraryTreeItem->getModelWidget()->reDrawModelWidget(mNewModelInfo);
   }
 }
@@ -819,5 +822,5 @@ void OMCUndoCommand::undo()
   mUndoCalledOnce = true;
   MainWindow::instance()->getOMCProxy()->loadString(mOldModelText, mpParentContainingLibraryTreeItem->getFileName(), Helper::utf8,
                                                     mpParentContainingLibraryTreeItem->isSaveFolderStructure());
-  mpLibraryTreeItem->getModelWidget()->reDrawModelWidget(mOldModelInfo);
+  mpLibraryTreeItem->getModelWidget()->requestModelInstance(mOldModelInfo);
 }
@@ -464,7 +464,7 @@ void ElementTreeModel::addElementsHelper(ModelInstance::Model *pModel, ElementTr
     QModelIndex index = elementTreeItemIndex(pParentElementTreeItem);
     int row = 0;
     const QString name = pModel->getReplaceable() ? pModel->getNameIfReplaceable() : pModel->getName();
-    LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem(name);
+    LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->fetchLibraryTreeItem(name);
     if (pLibraryTreeItem && pLibraryTreeItem->getAccess() >= LibraryTreeItem::icon) {
       QList<ModelInstance::Element*> elements = pModel->getElements();
       QList<ModelInstance::Element*> visibleElements;
@@ -56,6 +56,12 @@
 #include <QMessageBox>
 #include <QMenu>
 #include <QScreen>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QCryptographicHash>
+#include <QFutureWatcher>
+#include <QPointer>
+#include <QtConcurrent/QtConcurrent>
 
 /*!
  * \class LibraryTreeItem
@@ -625,7 +631,7 @@ const QList<LibraryTreeItem*> &LibraryTreeItem::getInheritedClasses()
     mInheritedClasses.clear();
     foreach (auto pElement, elements) {
       if (pElement->isExtend()) {
-        LibraryTreeItem *pInheritedLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem(pElement->getType());
+        LibraryTreeItem *pInheritedLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->fetchLibraryTreeItem(pElement->getType());
         if (pInheritedLibraryTreeItem) {
           mInheritedClasses.append(pInheritedLibraryTreeItem);
         }
@@ -644,7 +650,7 @@ const QList<LibraryTreeItem*> &LibraryTreeItem::getInheritedClasses()
            * Also check for cyclic loops.
            */
           if (!(MainWindow::instance()->getOMCProxy()->isBuiltinType(inheritedClass) || inheritedClass.compare(getNameStructure()) == 0)) {
-            LibraryTreeItem *pInheritedLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem(inheritedClass);
+            LibraryTreeItem *pInheritedLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->fetchLibraryTreeItem(inheritedClass);
             if (pInheritedLibraryTreeItem) {
               mInheritedClasses.append(pInheritedLibraryTreeItem);
             }
@@ -722,7 +728,7 @@ LibraryTreeItem *LibraryTreeItem::getDirectComponentsClass(const QString &name)
   for (int i = 0; i < components.size(); ++i) {
     if (components[i].getName() == name) {
       LibraryTreeModel *pLibraryTreeModel = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel();
-      return pLibraryTreeModel->findLibraryTreeItem(components[i].getClassName());
+      return pLibraryTreeModel->fetchLibraryTreeItem(components[i].getClassName());
     }
   }
 
@@ -746,6 +752,9 @@ void LibraryTreeItem::tryToComplete(QList<CompleterItem> &completionClasses, QLi
   QList<LibraryTreeItem*> baseClasses = getInheritedClassesDeepList();
 
   for (int bc = 0; bc < baseClasses.size(); ++bc) {
+    if (baseClasses[bc]->hasPendingChildren()) {
+      MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->fetchLibraryTreeItemChildren(baseClasses[bc]);
+    }
     QList<LibraryTreeItem*> classes = baseClasses[bc]->childrenItems();
     for (int i = 0; i < classes.size(); ++i) {
       if (classes[i]->getName().startsWith(lastPart, Qt::CaseInsensitive) && classes[i]->getNameStructure().compare(Helper::OMEditInternal) != 0)
@@ -789,6 +798,88 @@ void LibraryTreeItem::removeChild(LibraryTreeItem *pLibraryTreeItem)
   pLibraryTreeItem->deleteLater();
 }
 
+/*!
+ * \brief LibraryTreeItem::hasPendingChildren
+ * Returns true if the LibraryTreeItem has children that are not created yet.
+ * \return
+ */
+bool LibraryTreeItem::hasPendingChildren() const
+{
+  if (mIsRootItem) {
+    return false;
+  }
+  const LibraryTreeItem *pTopLevelLibraryTreeItem = this;
+  while (pTopLevelLibraryTreeItem && !pTopLevelLibraryTreeItem->isTopLevel()) {
+    pTopLevelLibraryTreeItem = pTopLevelLibraryTreeItem->parent();
+  }
+  return pTopLevelLibraryTreeItem && pTopLevelLibraryTreeItem->mPendingChildren.contains(mNameStructure);
+}
+
+/*!
+ * \brief LibraryTreeItem::takePendingChildren
+ * Removes and returns the names of the children that are not created yet.
+ * \return
+ */
+QStringList LibraryTreeItem::takePendingChildren()
+{
+  if (mIsRootItem) {
+    return QStringList();
+  }
+  LibraryTreeItem *pTopLevelLibraryTreeItem = this;
+  while (pTopLevelLibraryTreeItem && !pTopLevelLibraryTreeItem->isTopLevel()) {
+    pTopLevelLibraryTreeItem = pTopLevelLibraryTreeItem->parent();
+  }
+  return pTopLevelLibraryTreeItem ? pTopLevelLibraryTreeItem->mPendingChildren.take(mNameStructure) : QStringList();
+}
+
+/*!
+ * \brief pendingChildMatching
+ * Returns true if the name of any child of nameStructure or of its children in pendingChildren matches regExp.
+ * \param pendingChildren
+ * \param nameStructure
+ * \param regExp
+ * \return
+ */
+template <typename RegExp>
+static bool pendingChildMatching(const QHash<QString, QStringList> &pendingChildren, const QString &nameStructure, const RegExp &regExp)
+{
+  const QString prefix = nameStructure + ".";
+  for (auto it = pendingChildren.constBegin(); it != pendingChildren.constEnd(); ++it) {
+    if (it.key().compare(nameStructure) != 0 && !it.key().startsWith(prefix)) {
+      continue;
+    }
+    foreach (const QString &name, it.value()) {
+      if (QString(it.key() + "." + name).contains(regExp)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/*!
+ * \brief LibraryTreeItem::hasPendingChildMatching
+ * Returns true if any of the children that are not created yet, or their children, matches regExp.
+ * Used to search the system libraries without creating their LibraryTreeItems.
+ * \param regExp
+ * \return
+ */
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+bool LibraryTreeItem::hasPendingChildMatching(const QRegularExpression &regExp) const
+#else
+bool LibraryTreeItem::hasPendingChildMatching(const QRegExp &regExp) const
+#endif
+{
+  if (mIsRootItem) {
+    return false;
+  }
+  const LibraryTreeItem *pTopLevelLibraryTreeItem = this;
+  while (pTopLevelLibraryTreeItem && !pTopLevelLibraryTreeItem->isTopLevel()) {
+    pTopLevelLibraryTreeItem = pTopLevelLibraryTreeItem->parent();
+  }
+  return pTopLevelLibraryTreeItem && pendingChildMatching(pTopLevelLibraryTreeItem->mPendingChildren, mNameStructure, regExp);
+}
+
 /*!
  * \brief LibraryTreeItem::data
  * Returns the data stored under the given role for the item referred to by the column.
@@ -974,6 +1065,14 @@ bool LibraryTreeProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &s
         return !hide;
       }
     }
+    // the children of system libraries that are not created yet are searched by name
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    if (pLibraryTreeItem->hasPendingChildMatching(filterRegularExpression())) {
+#else
+    if (pLibraryTreeItem->hasPendingChildMatching(filterRegExp())) {
+#endif
+      return !hide;
+    }
     // check current index itself
     if (hide) {
       return false;
@@ -1038,6 +1137,53 @@ int LibraryTreeModel::rowCount(const QModelIndex &parent) const
   return pParentLibraryTreeItem ? pParentLibraryTreeItem->childrenSize() : 0;
 }
 
+/*!
+ * \brief LibraryTreeModel::hasChildren
+ * Returns true if parent has any children.
+ * The children of system libraries are only created when they are needed so also check for the pending children.
+ * \param parent
+ * \return
+ */
+bool LibraryTreeModel::hasChildren(const QModelIndex &parent) const
+{
+  if (parent.column() > 0) {
+    return false;
+  }
+
+  if (!parent.isValid()) {
+    return mpRootLibraryTreeItem->childrenSize() > 0;
+  }
+  LibraryTreeItem *pLibraryTreeItem = static_cast<LibraryTreeItem*>(parent.internalPointer());
+  return pLibraryTreeItem && (pLibraryTreeItem->childrenSize() > 0 || pLibraryTreeItem->hasPendingChildren());
+}
+
+/*!
+ * \brief LibraryTreeModel::canFetchMore
+ * Returns true if parent has children that are not created yet.
+ * \param parent
+ * \return
+ */
+bool LibraryTreeModel::canFetchMore(const QModelIndex &parent) const
+{
+  if (!parent.isValid()) {
+    return false;
+  }
+  LibraryTreeItem *pLibraryTreeItem = static_cast<LibraryTreeItem*>(parent.internalPointer());
+  return pLibraryTreeItem && pLibraryTreeItem->hasPendingChildren();
+}
+
+/*!
+ * \brief LibraryTreeModel::fetchMore
+ * Creates the children of parent that are not created yet.
+ * \param parent
+ */
+void LibraryTreeModel::fetchMore(const QModelIndex &parent)
+{
+  if (parent.isValid()) {
+    fetchLibraryTreeItemChildren(static_cast<LibraryTreeItem*>(parent.internalPointer()));
+  }
+}
+
 /*!
  * \brief LibraryTreeModel::headerData
  * Returns the data for the given role and section in the header with the specified orientation.
@@ -1222,6 +1368,22 @@ LibraryTreeItem* LibraryTreeModel::findLibraryTreeItemOneLevel(const QString &na
   return 0;
 }
 
+/*!
+ * \brief LibraryTreeModel::fetchLibraryTreeItem
+ * Finds the LibraryTreeItem based on the name and case sensitivity like LibraryTreeModel::findLibraryTreeItem.\n
+ * If the class is in a system library and its LibraryTreeItem is not created yet then it is created along with its parents.
+ * \param name
+ * \param caseSensitivity
+ * \return
+ */
+LibraryTreeItem* LibraryTreeModel::fetchLibraryTreeItem(const QString &name, Qt::CaseSensitivity caseSensitivity)
+{
+  if (LibraryTreeItem *pLibraryTreeItem = findLibraryTreeItem(name, 0, caseSensitivity)) {
+    return pLibraryTreeItem;
+  }
+  return fetchLibraryTreeItemPath(name, caseSensitivity);
+}
+
 /*!
  * \brief LibraryTreeModel::libraryTreeItemIndex
  * Finds the QModelIndex attached to LibraryTreeItem.
@@ -1262,7 +1424,7 @@ void LibraryTreeModel::addModelicaLibraries(const QVector<QPair<QString, QString
   pOMCProxy->loadSystemLibraries(libraries);
   QStringList systemLibs = pOMCProxy->getClassNames();
   foreach (QString systemLib, systemLibs) {
-    LibraryTreeItem *pLibraryTreeItem = findLibraryTreeItem(systemLib);
+    LibraryTreeItem *pLibraryTreeItem = fetchLibraryTreeItem(systemLib);
     if (!pLibraryTreeItem) {
       SplashScreen::instance()->showMessage(QString("%1 %2").arg(Helper::loading, systemLib), Qt::AlignRight, Qt::white);
       createLibraryTreeItem(systemLib, mpRootLibraryTreeItem, true, true, true);
@@ -1524,6 +1686,21 @@ void LibraryTreeModel::loadLibraryTreeItemPixmap(LibraryTreeItem *pLibraryTreeIt
   if (pLibraryTreeItem->isSSP() /*&& pLibraryTreeItem->getOMSConnector()*/) {
     return;
   }
+  // use the pixmap cached on disk if there is one. An empty file means that the class has no icon.
+  const QString cacheFile = libraryTreeItemPixmapCacheFile(pLibraryTreeItem);
+  QFileInfo cacheFileInfo(cacheFile);
+  if (!cacheFile.isEmpty() && cacheFileInfo.exists()) {
+    QPixmap libraryPixmap;
+    if (cacheFileInfo.size() > 0 && libraryPixmap.load(cacheFile, "PNG")) {
+      pLibraryTreeItem->setPixmap(libraryPixmap);
+      pLibraryTreeItem->setDragPixmap(libraryPixmap.scaled(QSize(50, 50), Qt::KeepAspectRatio, Qt::SmoothTransformation));
+      return;
+    } else if (cacheFileInfo.size() == 0) {
+      pLibraryTreeItem->setPixmap(QPixmap());
+      pLibraryTreeItem->setDragPixmap(pLibraryTreeItem->getLibraryTreeItemIcon().pixmap(QSize(50, 50)));
+      return;
+    }
+  }
   if (!pLibraryTreeItem->getModelWidget()) {
     showModelWidget(pLibraryTreeItem, false);
   }
@@ -1568,6 +1745,197 @@ void LibraryTreeModel::loadLibraryTreeItemPixmap(LibraryTreeItem *pLibraryTreeIt
     pLibraryTreeItem->setPixmap(QPixmap());
     pLibraryTreeItem->setDragPixmap(pLibraryTreeItem->getLibraryTreeItemIcon().pixmap(QSize(50, 50)));
   }
+  // cache the pixmap so the class doesn't need to be loaded next time.
+  if (!cacheFile.isEmpty() && QDir().mkpath(cacheFileInfo.absolutePath())) {
+    QSaveFile file(cacheFile);
+    if (file.open(QIODevice::WriteOnly)) {
+      if (!pLibraryTreeItem->getPixmap().isNull()) {
+        pLibraryTreeItem->getPixmap().save(&file, "PNG");
+      }
+      file.commit();
+    }
+  }
+}
+
+/*!
+ * \brief LibraryTreeModel::loadCachedLibraryTreeItemPixmaps
+ * Reads the pixmaps of the LibraryTreeItems that are cached on disk in a separate thread and sets them once they are read.
+ * \param libraryTreeItems
+ * \return the LibraryTreeItems that don't have a cached pixmap.
+ */
+QList<LibraryTreeItem*> LibraryTreeModel::loadCachedLibraryTreeItemPixmaps(const QList<LibraryTreeItem*> &libraryTreeItems)
+{
+  struct CachedPixmap {
+    QPointer<LibraryTreeItem> mpLibraryTreeItem;
+    QString mFileName;
+    QImage mImage;
+  };
+
+  QList<LibraryTreeItem*> uncachedLibraryTreeItems;
+  QList<CachedPixmap> cachedPixmaps;
+  foreach (LibraryTreeItem *pLibraryTreeItem, libraryTreeItems) {
+    const QString cacheFile = libraryTreeItemPixmapCacheFile(pLibraryTreeItem);
+    if (!pLibraryTreeItem->isSSP() && !cacheFile.isEmpty() && QFile::exists(cacheFile)) {
+      cachedPixmaps.append({pLibraryTreeItem, cacheFile, QImage()});
+    } else {
+      uncachedLibraryTreeItems.append(pLibraryTreeItem);
+    }
+  }
+
+  if (!cachedPixmaps.isEmpty()) {
+    // QPixmap can only be used in the GUI thread so the files are read into QImages and converted once they are all read.
+    QFutureWatcher<QList<CachedPixmap>> *pFutureWatcher = new QFutureWatcher<QList<CachedPixmap>>(this);
+    connect(pFutureWatcher, &QFutureWatcher<QList<CachedPixmap>>::finished, this, [this, pFutureWatcher]() {
+      foreach (const CachedPixmap &cachedPixmap, pFutureWatcher->result()) {
+        // the item might have been unloaded while the pixmaps were read.
+        LibraryTreeItem *pLibraryTreeItem = cachedPixmap.mpLibraryTreeItem.data();
+        if (!pLibraryTreeItem) {
+          continue;
+        }
+        if (cachedPixmap.mImage.isNull()) {
+          pLibraryTreeItem->setPixmap(QPixmap());
+          pLibraryTreeItem->setDragPixmap(pLibraryTreeItem->getLibraryTreeItemIcon().pixmap(QSize(50, 50)));
+        } else {
+          QPixmap libraryPixmap = QPixmap::fromImage(cachedPixmap.mImage);
+          pLibraryTreeItem->setPixmap(libraryPixmap);
+          pLibraryTreeItem->setDragPixmap(libraryPixmap.scaled(QSize(50, 50), Qt::KeepAspectRatio, Qt::SmoothTransformation));
+        }
+        updateLibraryTreeItem(pLibraryTreeItem);
+      }
+      pFutureWatcher->deleteLater();
+    });
+    pFutureWatcher->setFuture(QtConcurrent::run([cachedPixmaps]() mutable {
+      for (CachedPixmap &cachedPixmap : cachedPixmaps) {
+        if (QFileInfo(cachedPixmap.mFileName).size() > 0) {
+          cachedPixmap.mImage.load(cachedPixmap.mFileName, "PNG");
+        }
+      }
+      return cachedPixmaps;
+    }));
+  }
+  return uncachedLibraryTreeItems;
+}
+
+/*!
+ * \brief LibraryTreeModel::loadLibraryTreeItemPixmaps
+ * Loads the pixmaps of the LibraryTreeItems like LibraryTreeModel::loadLibraryTreeItemPixmap.\n
+ * The icons of all the LibraryTreeItems are fetched from omc with one call and parsed in a separate thread.
+ * The pixmaps are rendered from the fetched icons once they are parsed.
+ * \param libraryTreeItems
+ */
+void LibraryTreeModel::loadLibraryTreeItemPixmaps(const QList<LibraryTreeItem*> &libraryTreeItems)
+{
+  QList<QPointer<LibraryTreeItem> > modelicaLibraryTreeItems;
+  QStringList classNames;
+  foreach (LibraryTreeItem *pLibraryTreeItem, libraryTreeItems) {
+    if (pLibraryTreeItem->isModelica()) {
+      modelicaLibraryTreeItems.append(pLibraryTreeItem);
+      classNames.append(pLibraryTreeItem->getNameStructure());
+    }
+  }
+  if (classNames.isEmpty()) {
+    return;
+  }
+
+  OMCProxy *pOMCProxy = MainWindow::instance()->getOMCProxy();
+  QFutureWatcher<QJsonObject> *pFutureWatcher = new QFutureWatcher<QJsonObject>(this);
+  connect(pFutureWatcher, &QFutureWatcher<QJsonObject>::finished, this, [this, pFutureWatcher, pOMCProxy, modelicaLibraryTreeItems]() {
+    pOMCProxy->setModelInstanceIcons(pFutureWatcher->result());
+    // set the range for progress bar.
+    int progressValue = 0;
+    MainWindow::instance()->getProgressBar()->setRange(0, modelicaLibraryTreeItems.size());
+    MainWindow::instance()->showProgressBar();
+    foreach (const QPointer<LibraryTreeItem> &pLibraryTreeItem, modelicaLibraryTreeItems) {
+      // the item might have been unloaded while the icons were parsed.
+      if (pLibraryTreeItem) {
+        MainWindow::instance()->getStatusBar()->showMessage(QString(Helper::loading).append(": ").append(pLibraryTreeItem->getNameStructure()));
+        loadLibraryTreeItemPixmap(pLibraryTreeItem);
+        updateLibraryTreeItem(pLibraryTreeItem);
+        MainWindow::instance()->getStatusBar()->clearMessage();
+      }
+      MainWindow::instance()->getProgressBar()->setValue(++progressValue);
+    }
+    MainWindow::instance()->hideProgressBar();
+    pOMCProxy->setModelInstanceIcons(QJsonObject());
+    pFutureWatcher->deleteLater();
+  });
+  pFutureWatcher->setFuture(pOMCProxy->getModelInstanceIconsAsync(classNames));
+}
+
+/*!
+ * \brief LibraryTreeModel::fetchLibraryTreeItemChildren
+ * Creates the children of the LibraryTreeItem that are not created yet.
+ * \param pLibraryTreeItem
+ */
+void LibraryTreeModel::fetchLibraryTreeItemChildren(LibraryTreeItem *pLibraryTreeItem)
+{
+  const QStringList names = pLibraryTreeItem->takePendingChildren();
+  if (names.isEmpty()) {
+    return;
+  }
+  const int row = pLibraryTreeItem->childrenSize();
+  beginInsertRows(libraryTreeItemIndex(pLibraryTreeItem), row, row + names.size() - 1);
+  foreach (QString name, names) {
+    createLibraryTreeItemImpl(name, pLibraryTreeItem, pLibraryTreeItem->isSaved(), false, false, -1, pLibraryTreeItem->isAccessAnnotationsEnabled());
+  }
+  endInsertRows();
+}
+
+/*!
+ * \brief LibraryTreeModel::fetchLibraryTreeItemPath
+ * Finds the LibraryTreeItem by walking down its path and creating the LibraryTreeItems on the way that are not created yet.
+ * \param name
+ * \param caseSensitivity
+ * \return
+ */
+LibraryTreeItem* LibraryTreeModel::fetchLibraryTreeItemPath(const QString &name, Qt::CaseSensitivity caseSensitivity)
+{
+  LibraryTreeItem *pLibraryTreeItem = mpRootLibraryTreeItem;
+  QString nameStructure;
+  foreach (QString part, StringHandler::makeVariableParts(name)) {
+    nameStructure = nameStructure.isEmpty() ? part : nameStructure + "." + part;
+    fetchLibraryTreeItemChildren(pLibraryTreeItem);
+    pLibraryTreeItem = findLibraryTreeItemOneLevel(nameStructure, pLibraryTreeItem, caseSensitivity);
+    if (!pLibraryTreeItem) {
+      return 0;
+    }
+  }
+  return pLibraryTreeItem == mpRootLibraryTreeItem ? 0 : pLibraryTreeItem;
+}
+
+/*!
+ * \brief LibraryTreeModel::libraryTreeItemPixmapCacheFile
+ * Returns the file used to cache the pixmap of the LibraryTreeItem.
+ * Only the pixmaps of system libraries are cached since they are read-only. The versions of OMEdit and of the library are part of the path
+ * so the cache is not used for another version of the library or by another version of OMEdit that might render the icons differently.
+ * \param pLibraryTreeItem
+ * \return the file name or an empty string if the pixmap should not be cached.
+ */
+QString LibraryTreeModel::libraryTreeItemPixmapCacheFile(LibraryTreeItem *pLibraryTreeItem)
+{
+  if (!pLibraryTreeItem->isModelica() || pLibraryTreeItem->isRootItem() || !pLibraryTreeItem->parent()) {
+    return "";
+  }
+  LibraryTreeItem *pTopLevelLibraryTreeItem = getTopLevelLibraryTreeItem(pLibraryTreeItem);
+  QString version = pTopLevelLibraryTreeItem->getVersion();
+  if (!pTopLevelLibraryTreeItem->isSystemLibrary() || version.isEmpty()) {
+    return "";
+  }
+  if (!pTopLevelLibraryTreeItem->getVersionBuild().isEmpty()) {
+    version = version + "+" + pTopLevelLibraryTreeItem->getVersionBuild();
+  }
+  // names with quotes or other special characters are hashed to get a valid file name.
+  static const QRegularExpression validName("^[A-Za-z0-9_.+-]+$");
+  QString directoryName = pTopLevelLibraryTreeItem->getName() + "-" + version;
+  if (!validName.match(directoryName).hasMatch()) {
+    directoryName = QCryptographicHash::hash(directoryName.toUtf8(), QCryptographicHash::Md5).toHex();
+  }
+  QString fileName = pLibraryTreeItem->getNameStructure();
+  if (!validName.match(fileName).hasMatch()) {
+    fileName = QCryptographicHash::hash(fileName.toUtf8(), QCryptographicHash::Md5).toHex();
+  }
+  const QString omeditVersion = QCryptographicHash::hash(Helper::OpenModelicaVersion.toUtf8(), QCryptographicHash::Md5).toHex().left(12);
+  return QString("%1/LibraryIcons/%2/%3/%4.png").arg(QStandardPaths::writableLocation(QStandardPaths::CacheLocation), omeditVersion, directoryName, fileName);
 }
 
 /*!
@@ -1578,7 +1946,7 @@ void LibraryTreeModel::loadLibraryTreeItemPixmap(LibraryTreeItem *pLibraryTreeIt
 void LibraryTreeModel::loadDependentLibraries(QStringList libraries)
 {
   foreach (QString library, libraries) {
-    LibraryTreeItem* pLoadedLibraryTreeItem = findLibraryTreeItem(library);
+    LibraryTreeItem* pLoadedLibraryTreeItem = fetchLibraryTreeItem(library);
     if (!pLoadedLibraryTreeItem) {
       MainWindow::instance()->getStatusBar()->showMessage(QString("%1: %2").arg(Helper::loading).arg(library));
       createLibraryTreeItem(library, mpRootLibraryTreeItem, true, true, true);
@@ -1786,7 +2154,7 @@ bool LibraryTreeModel::reloadClass(LibraryTreeItem *pLibraryTreeItem, bool askQu
       MainWindow::instance()->getModelWidgetContainer()->openModelWidgetsAndSelectElement(openedModelWidgetsAndSelectedElements);
     }
     // find the active model and show it
-    LibraryTreeItem *pActiveLibraryTreeItem = findLibraryTreeItem(activeModel);
+    LibraryTreeItem *pActiveLibraryTreeItem = fetchLibraryTreeItem(activeModel);
     if (pActiveLibraryTreeItem) {
       showModelWidget(pActiveLibraryTreeItem);
       // clear the Library Browser selection and select the active model
@@ -1931,7 +2299,7 @@ void LibraryTreeModel::reLoadOMSimulatorModel(const QString &modelName, const QS
   pModelLibraryTreeItem->setModelWidget(0);
   const QString filePath = pModelLibraryTreeItem->getFileName();
   // Get the edited LibraryTreeItem and its ModelWidget
-  LibraryTreeItem *pEditedLibraryTreeItem = findLibraryTreeItem(oldEditedCref.isEmpty() ? editedCref : oldEditedCref);
+  LibraryTreeItem *pEditedLibraryTreeItem = fetchLibraryTreeItem(oldEditedCref.isEmpty() ? editedCref : oldEditedCref);
   ModelWidget *pEditedModelWidget = 0;
   if (pEditedLibraryTreeItem) {
     if (!pEditedLibraryTreeItem->getModelWidget()) {
@@ -1957,7 +2325,7 @@ void LibraryTreeModel::reLoadOMSimulatorModel(const QString &modelName, const QS
   // if the top level model and edited model are not the same
   LibraryTreeItem *pNewEditedLibraryTreeItem = 0;
   if (!sameModelAndEditedCref) {
-    pNewEditedLibraryTreeItem = findLibraryTreeItem(newEditedCref.isEmpty() ? editedCref : newEditedCref);
+    pNewEditedLibraryTreeItem = fetchLibraryTreeItem(newEditedCref.isEmpty() ? editedCref : newEditedCref);
     if (pNewEditedLibraryTreeItem && pEditedModelWidget) {
       pNewEditedLibraryTreeItem->setModelWidget(pEditedModelWidget);
       pEditedModelWidget->setLibraryTreeItem(pNewEditedLibraryTreeItem);
@@ -2243,6 +2611,21 @@ void LibraryTreeModel::createLibraryTreeItems(LibraryTreeItem *pLibraryTreeItem)
     if (!libs.isEmpty()) {
       libs.removeFirst();
     }
+    /* System libraries are read-only and usually big so only keep the class names and create the items when their parent is expanded or looked up.
+     * See LibraryTreeModel::fetchLibraryTreeItemChildren.
+     */
+    if (pLibraryTreeItem->isSystemLibrary() && pLibraryTreeItem->isTopLevel()) {
+      QHash<QString, QStringList> pendingChildren;
+      foreach (QString lib, libs) {
+        /* $Code is a special OpenModelica keyword. No API command will work if we use it. */
+        if (lib.contains("$Code")) {
+          continue;
+        }
+        pendingChildren[StringHandler::removeLastWordAfterDot(lib)].append(StringHandler::getLastWordAfterDot(lib));
+      }
+      pLibraryTreeItem->setPendingChildren(pendingChildren);
+      return;
+    }
     LibraryTreeItem *pParentLibraryTreeItem = 0;
     foreach (QString lib, libs) {
       /* $Code is a special OpenModelica keyword. No API command will work if we use it. */
@@ -2898,19 +3281,13 @@ LibraryTreeItem* LibraryTreeView::getSelectedLibraryTreeItem()
 void LibraryTreeView::libraryTreeItemExpanded(LibraryTreeItem *pLibraryTreeItem)
 {
   if (!pLibraryTreeItem->isExpanded()) {
-    // set the range for progress bar.
-    int progressValue = 0;
-    MainWindow::instance()->getProgressBar()->setRange(0, pLibraryTreeItem->childrenSize());
-    MainWindow::instance()->showProgressBar();
+    LibraryTreeModel *pLibraryTreeModel = mpLibraryWidget->getLibraryTreeModel();
+    // create the children of system libraries when they are first needed.
+    pLibraryTreeModel->fetchLibraryTreeItemChildren(pLibraryTreeItem);
+    // the cached pixmaps are read in the background, the icons of the classes without a cached pixmap are fetched with one call.
+    QList<LibraryTreeItem*> libraryTreeItems = pLibraryTreeModel->loadCachedLibraryTreeItemPixmaps(pLibraryTreeItem->childrenItems());
     pLibraryTreeItem->setExpanded(true);
-    for (int i = 0; i < pLibraryTreeItem->childrenSize(); i++) {
-      LibraryTreeItem *pChildLibraryTreeItem = pLibraryTreeItem->child(i);
-      MainWindow::instance()->getStatusBar()->showMessage(QString(Helper::loading).append(": ").append(pChildLibraryTreeItem->getNameStructure()));
-      mpLibraryWidget->getLibraryTreeModel()->loadLibraryTreeItemPixmap(pChildLibraryTreeItem);
-      MainWindow::instance()->getStatusBar()->clearMessage();
-      MainWindow::instance()->getProgressBar()->setValue(++progressValue);
-    }
-    MainWindow::instance()->hideProgressBar();
+    pLibraryTreeModel->loadLibraryTreeItemPixmaps(libraryTreeItems);
   }
 }
 
@@ -4294,7 +4671,7 @@ void LibraryWidget::parseAndLoadModelicaText(QString modelText)
       if (parentName.isEmpty() || (modelName.compare(parentName) == 0)) {
         pParentLibraryTreeItem = mpLibraryTreeModel->getRootLibraryTreeItem();
       } else {
-        pParentLibraryTreeItem = mpLibraryTreeModel->findLibraryTreeItem(parentName);
+        pParentLibraryTreeItem = mpLibraryTreeModel->fetchLibraryTreeItem(parentName);
       }
       mpLibraryTreeModel->createLibraryTreeItem(modelName, pParentLibraryTreeItem, false, false, true);
     }
@@ -4418,7 +4795,7 @@ bool LibraryWidget::saveLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem, bool
   /* Ticket #4788. Add the file to the recent files list. */
   if (result) {
     QString topLevelLibraryTreeItemName = StringHandler::getFirstWordBeforeDot(pLibraryTreeItem->getNameStructure());
-    LibraryTreeItem *pTopLevelLibraryTreeItem = mpLibraryTreeModel->findLibraryTreeItem(topLevelLibraryTreeItemName);
+    LibraryTreeItem *pTopLevelLibraryTreeItem = mpLibraryTreeModel->fetchLibraryTreeItem(topLevelLibraryTreeItemName);
     // Ticket #4987. Only add the top level model/package to recent files list.
     if (pLibraryTreeItem->isTopLevel() ||
         (pTopLevelLibraryTreeItem && pLibraryTreeItem->getFileName().compare(pTopLevelLibraryTreeItem->getFileName()) == 0)) {
@@ -4487,7 +4864,7 @@ void LibraryWidget::saveTotalLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem)
  */
 void LibraryWidget::openLibraryTreeItem(QString nameStructure)
 {
-  LibraryTreeItem *pLibraryTreeItem = mpLibraryTreeModel->findLibraryTreeItem(nameStructure);
+  LibraryTreeItem *pLibraryTreeItem = mpLibraryTreeModel->fetchLibraryTreeItem(nameStructure);
   if (pLibraryTreeItem) {
     mpLibraryTreeModel->showModelWidget(pLibraryTreeItem);
   } else {
@@ -4609,7 +4986,7 @@ bool LibraryWidget::saveModelicaLibraryTreeItem(LibraryTreeItem *pLibraryTreeIte
     result = saveModelicaLibraryTreeItemHelper(pLibraryTreeItem, saveAs);
   } else {
     QString topLevelClassName = StringHandler::getFirstWordBeforeDot(pLibraryTreeItem->getNameStructure());
-    LibraryTreeItem *pTopLevelLibraryTreeItem = mpLibraryTreeModel->findLibraryTreeItem(topLevelClassName);
+    LibraryTreeItem *pTopLevelLibraryTreeItem = mpLibraryTreeModel->fetchLibraryTreeItem(topLevelClassName);
     result = saveModelicaLibraryTreeItemHelper(pTopLevelLibraryTreeItem, saveAs);
   }
   return result;
@@ -4879,7 +5256,7 @@ bool LibraryWidget::saveTextLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem, b
     if (saveFile(fileName, pLibraryTreeItem->getModelWidget()->getEditor()->getPlainTextEdit()->toPlainText())) {
       // if saveAs and the new file location already exists then unload it
       if (saveAs) {
-        LibraryTreeItem *pExistingLibraryTreeItem = mpLibraryTreeModel->findLibraryTreeItem(fileName);
+        LibraryTreeItem *pExistingLibraryTreeItem = mpLibraryTreeModel->fetchLibraryTreeItem(fileName);
         if (pExistingLibraryTreeItem) {
           mpLibraryTreeModel->unloadTextFile(pExistingLibraryTreeItem, false);
         }
@@ -5060,7 +5437,7 @@ void LibraryWidget::reDrawModelsToUpdate()
   QStringList models = mModelsToUpdate;
   mModelsToUpdate.clear();
   foreach (QString model, models) {
-    LibraryTreeItem *pLibraryTreeItem = mpLibraryTreeModel->findLibraryTreeItem(model);
+    LibraryTreeItem *pLibraryTreeItem = mpLibraryTreeModel->fetchLibraryTreeItem(model);
     if (pLibraryTreeItem && pLibraryTreeItem->getModelWidget()) {
       pLibraryTreeItem->getModelWidget()->reDrawModelWidget(pLibraryTreeItem->getModelWidget()->createModelInfo());
     }
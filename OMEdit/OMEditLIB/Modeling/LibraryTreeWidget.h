@@ -176,6 +176,14 @@ public:
   void tryToComplete(QList<CompleterItem> &completionClasses, QList<CompleterItem> &completionComponents, const QString &lastPart);
   void removeChildren();
   void removeChild(LibraryTreeItem *pLibraryTreeItem);
+  void setPendingChildren(const QHash<QString, QStringList> &pendingChildren) {mPendingChildren = pendingChildren;}
+  bool hasPendingChildren() const;
+  QStringList takePendingChildren();
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+  bool hasPendingChildMatching(const QRegularExpression &regExp) const;
+#else
+  bool hasPendingChildMatching(const QRegExp &regExp) const;
+#endif
   QVariant data(int column, int role = Qt::DisplayRole) const;
   int row() const;
   void setParent(LibraryTreeItem *pParentLibraryTreeItem) {mpParentLibraryTreeItem = pParentLibraryTreeItem;}
@@ -192,6 +200,10 @@ private:
   bool mIsRootItem;
   LibraryTreeItem *mpParentLibraryTreeItem = 0;
   QList<LibraryTreeItem*> mChildren;
+  /* Names of the classes of a system library that are not created yet, by the name of their parent.
+   * Only set on the top level item since the whole library is read with one getClassNames call.
+   */
+  QHash<QString, QStringList> mPendingChildren;
   bool mInheritedClassesLoaded = false;
   QList<LibraryTreeItem*> mInheritedClasses;
   QList<ElementInfo> mComponents;
@@ -252,6 +264,9 @@ public:
   LibraryTreeItem* getRootLibraryTreeItem() {return mpRootLibraryTreeItem;}
   int columnCount(const QModelIndex &parent = QModelIndex()) const override;
   int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+  bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+  bool canFetchMore(const QModelIndex &parent) const override;
+  void fetchMore(const QModelIndex &parent) override;
   QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
   QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
   QModelIndex parent(const QModelIndex & index) const override;
@@ -264,6 +279,7 @@ public:
   LibraryTreeItem* findLibraryTreeItem(const QRegularExpression &regExp, LibraryTreeItem *pLibraryTreeItem = 0) const;
 #endif
   LibraryTreeItem* findLibraryTreeItemOneLevel(const QString &name, LibraryTreeItem *pLibraryTreeItem = 0, Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive) const;
+  LibraryTreeItem* fetchLibraryTreeItem(const QString &name, Qt::CaseSensitivity caseSensitivity = Qt::CaseSensitive);
   QModelIndex libraryTreeItemIndex(const LibraryTreeItem *pLibraryTreeItem) const;
   void addModelicaLibraries(const QVector<QPair<QString, QString> > libraries = QVector<QPair<QString, QString> >());
   LibraryTreeItem* createLibraryTreeItem(QString name, LibraryTreeItem *pParentLibraryTreeItem, bool isSaved = true,
@@ -280,6 +296,9 @@ public:
   LibraryTreeItem* getContainingFileParentLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem);
   static LibraryTreeItem* getTopLevelLibraryTreeItem(LibraryTreeItem *pLibraryTreeItem);
   void loadLibraryTreeItemPixmap(LibraryTreeItem *pLibraryTreeItem);
+  QList<LibraryTreeItem*> loadCachedLibraryTreeItemPixmaps(const QList<LibraryTreeItem*> &libraryTreeItems);
+  void loadLibraryTreeItemPixmaps(const QList<LibraryTreeItem*> &libraryTreeItems);
+  void fetchLibraryTreeItemChildren(LibraryTreeItem *pLibraryTreeItem);
   void loadDependentLibraries(QStringList libraries);
   LibraryTreeItem* getLibraryTreeItemFromFile(QString fileName, int lineNumber);
   void showModelWidget(LibraryTreeItem *pLibraryTreeItem, bool show = true);
@@ -321,6 +340,8 @@ private:
   void createOMSBusConnectorLibraryTreeItems(LibraryTreeItem *pLibraryTreeItem);
   void unloadClassChildren(LibraryTreeItem *pLibraryTreeItem, bool deleteFile);
   void unloadClassHelper(LibraryTreeItem *pLibraryTreeItem, bool deleteFile);
+  LibraryTreeItem* fetchLibraryTreeItemPath(const QString &name, Qt::CaseSensitivity caseSensitivity);
+  static QString libraryTreeItemPixmapCacheFile(LibraryTreeItem *pLibraryTreeItem);
 protected:
   Qt::DropActions supportedDropActions() const override;
 signals:
@@ -244,7 +244,7 @@ void MessageWidget::addGUIMessage(MessageItem messageItem)
   }
   if (messageItem.getFileName().isEmpty()) { // if custom error message
     errorMessage = message;
-  } else if (MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem(messageItem.getFileName())) {
+  } else if (MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->fetchLibraryTreeItem(messageItem.getFileName())) {
     // If the class is only loaded in AST via loadString then create link for the error message.
     errorMessage = linkFormat.arg(messageItem.getFileName())
         .arg(messageItem.getLocation())
@@ -306,7 +306,7 @@ void MessageWidget::openErrorMessageClass(QUrl url)
     className.remove(0, 1);
   }
   // find the class that has the error
-  LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem(className);
+  LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->fetchLibraryTreeItem(className);
   if (pLibraryTreeItem) {
     /* the error could be in P.M but we get P as error class in this case we see if current class has the same file as P
      * and also contains the line number. If we have correct current class then no need to show root parent class i.e., P.
@@ -67,6 +67,9 @@
 #include <QDesktopServices>
 #include <QClipboard>
 #include <QStringBuilder>
+#include <QFutureWatcher>
+
+#include <memory>
 
 const QString cutCopyPasteComponentsConnectionsFormat("application/OMEdit.cut-copy-paste-components-connections");
 const QString cutCopyPasteComponentsFormat("application/OMEdit.cut-copy-paste-components");
@@ -867,7 +870,7 @@ ModelInstance::Component *GraphicsView::createModelInstanceComponent(ModelInstan
 bool GraphicsView::addComponent(QString className, QPointF position)
 {
   MainWindow *pMainWindow = MainWindow::instance();
-  LibraryTreeItem *pLibraryTreeItem = pMainWindow->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem(className);
+  LibraryTreeItem *pLibraryTreeItem = pMainWindow->getLibraryWidget()->getLibraryTreeModel()->fetchLibraryTreeItem(className);
   if (!pLibraryTreeItem) {
     return false;
   }
@@ -1006,10 +1009,10 @@ void GraphicsView::addUsesAnnotation(const QString &insertedClassName, const QSt
   LibraryTreeModel *pLibraryTreeModel = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel();
   // get the toplevel class of dragged component or duplicated model
   QString packageName = StringHandler::getFirstWordBeforeDot(insertedClassName);
-  LibraryTreeItem *pPackageLibraryTreeItem = pLibraryTreeModel->findLibraryTreeItem(packageName);
+  LibraryTreeItem *pPackageLibraryTreeItem = pLibraryTreeModel->fetchLibraryTreeItem(packageName);
   // get the top level class of containing class
   QString topLevelClassName = StringHandler::getFirstWordBeforeDot(containingClassName);
-  LibraryTreeItem *pTopLevelLibraryTreeItem = pLibraryTreeModel->findLibraryTreeItem(topLevelClassName);
+  LibraryTreeItem *pTopLevelLibraryTreeItem = pLibraryTreeModel->fetchLibraryTreeItem(topLevelClassName);
   if (pPackageLibraryTreeItem && pTopLevelLibraryTreeItem) {
     // get uses annotation of the toplevel class
     QList<QList<QString > > usesAnnotation = MainWindow::instance()->getOMCProxy()->getUses(pTopLevelLibraryTreeItem->getNameStructure());
@@ -5825,15 +5828,19 @@ void ModelWidget::drawModelIconDiagram(ModelInstance::Model *pModelInstance, boo
  * Calls getModelInstance and draws the model.
  * \param icon
  * \param modelInfo
+ * \param pModelJson - the model instance JSON if it is already fetched, see ModelWidget::requestModelInstance.
  */
-void ModelWidget::loadModelInstance(bool icon, const ModelInfo &modelInfo)
+void ModelWidget::loadModelInstance(bool icon, const ModelInfo &modelInfo, const QJsonObject *pModelJson)
 {
+  // the model is loaded now so any pending request is outdated.
+  mModelInstanceRequestId++;
+  setModelInstanceRequestPending(false);
   // save the current ModelInstance pointer so we can delete it later.
   ModelInstance::Model *pOldModelInstance = mpModelInstance;
   QElapsedTimer timer;
   timer.start();
   // call getModelInstance
-  const QJsonObject jsonObject = MainWindow::instance()->getOMCProxy()->getModelInstance(mpLibraryTreeItem->getNameStructure(), "", false, icon);
+  const QJsonObject jsonObject = pModelJson ? *pModelJson : MainWindow::instance()->getOMCProxy()->getModelInstance(mpLibraryTreeItem->getNameStructure(), "", false, icon);
   // set the new ModelInstance
   mpModelInstance = new ModelInstance::Model(jsonObject);
   if (MainWindow::instance()->isNewApiProfiling()) {
@@ -6353,8 +6360,9 @@ void ModelWidget::reDrawModelWidget()
  * \brief ModelWidget::reDrawModelWidget
  * Redraws the ModelWidget with a new ModelInfo.
  * \param modelInfo
+ * \param pModelJson - the model instance JSON if it is already fetched.
  */
-void ModelWidget::reDrawModelWidget(const ModelInfo &modelInfo)
+void ModelWidget::reDrawModelWidget(const ModelInfo &modelInfo, const QJsonObject *pModelJson)
 {
   QApplication::setOverrideCursor(Qt::WaitCursor);
   // Remove all elements from the scene
@@ -6397,7 +6405,7 @@ void ModelWidget::reDrawModelWidget(const ModelInfo &modelInfo)
     setComponentModified(false);
     updateElementModeButtons();
   }
-  loadModelInstance(false, modelInfo);
+  loadModelInstance(false, modelInfo, pModelJson);
   // update the coordinate system according to new values
   mpIconGraphicsView->resetZoom();
   mpDiagramGraphicsView->resetZoom();
@@ -6405,6 +6413,69 @@ void ModelWidget::reDrawModelWidget(const ModelInfo &modelInfo)
   QApplication::restoreOverrideCursor();
 }
 
+/*!
+ * \brief ModelWidget::requestModelInstance
+ * Redraws the ModelWidget with a new ModelInfo like ModelWidget::reDrawModelWidget but without blocking.\n
+ * The request is only sent to omc once control returns to the event loop and the JSON is parsed in a separate thread.
+ * A newer request or a synchronous load supersedes the request, so e.g., undoing several steps at once only fetches and draws the last one.
+ * The views are disabled while the request is pending since the drawn items don't match the model in omc anymore.
+ * If the model changed in omc while the JSON was parsed then the new instance, which omc already sent with the check, is parsed and drawn instead.
+ * omc is not thread safe so it is still called in the GUI thread, only the parsing is done in a separate thread.
+ * \param modelInfo
+ */
+void ModelWidget::requestModelInstance(const ModelInfo &modelInfo)
+{
+  mRequestedModelInfo = modelInfo;
+  const quint64 requestId = ++mModelInstanceRequestId;
+  setModelInstanceRequestPending(true);
+  QTimer::singleShot(0, this, [this, requestId]() {
+    if (requestId != mModelInstanceRequestId) {
+      return;
+    }
+    const QString className = mpLibraryTreeItem->getNameStructure();
+    std::shared_ptr<int> pRevision = std::make_shared<int>(0);
+    QFutureWatcher<QJsonObject> *pFutureWatcher = new QFutureWatcher<QJsonObject>(this);
+    connect(pFutureWatcher, &QFutureWatcher<QJsonObject>::finished, this, [this, pFutureWatcher, requestId, className, pRevision]() {
+      if (requestId != mModelInstanceRequestId) {
+        pFutureWatcher->deleteLater();
+        return;
+      }
+      const int revision = *pRevision;
+      const QJsonObject modelJson = pFutureWatcher->result();
+      if (revision > 0) {
+        QFuture<QJsonObject> future = MainWindow::instance()->getOMCProxy()->getModelInstanceAsyncIfChanged(className, modelJson, pRevision.get());
+        // the model changed in omc while the JSON was parsed. Wait for the new instance which is already fetched.
+        if (*pRevision != revision) {
+          pFutureWatcher->setFuture(future);
+          return;
+        }
+      }
+      pFutureWatcher->deleteLater();
+      reDrawModelWidget(mRequestedModelInfo, &modelJson);
+    });
+    pFutureWatcher->setFuture(MainWindow::instance()->getOMCProxy()->getModelInstanceAsync(className, QString(""), false, pRevision.get()));
+  });
+}
+
+/*!
+ * \brief ModelWidget::setModelInstanceRequestPending
+ * Enables/disables the icon and diagram views while a model instance request is pending, see ModelWidget::requestModelInstance.
+ * \param pending
+ */
+void ModelWidget::setModelInstanceRequestPending(bool pending)
+{
+  if (mModelInstanceRequestPending == pending) {
+    return;
+  }
+  mModelInstanceRequestPending = pending;
+  if (mpIconGraphicsView) {
+    mpIconGraphicsView->setEnabled(!pending);
+  }
+  if (mpDiagramGraphicsView) {
+    mpDiagramGraphicsView->setEnabled(!pending);
+  }
+}
+
 /*!
  * \brief ModelWidget::validateText
  * Validates the text of the editor.
@@ -6551,7 +6622,7 @@ void ModelWidget::updateChildClasses(LibraryTreeItem *pLibraryTreeItem)
   int index = 0;
   foreach (QString className, classNames) {
     QString classNameStructure = QString("%1.%2").arg(pLibraryTreeItem->getNameStructure()).arg(className);
-    LibraryTreeItem *pChildLibraryTreeItem = pLibraryTreeModel->findLibraryTreeItem(classNameStructure);
+    LibraryTreeItem *pChildLibraryTreeItem = pLibraryTreeModel->fetchLibraryTreeItem(classNameStructure);
     // if the class already exists then we update it if needed.
     if (pChildLibraryTreeItem) {
       if (pChildLibraryTreeItem->isInPackageOneFile()) {
@@ -7001,7 +7072,7 @@ void ModelWidget::showElement(ModelInstance::Model *pModelInstance, bool addToLi
     mModelInstanceList.append(pModelInstance);
     // find correct LibraryTreeItem for ModelInstance.
     QString name = pModelInstance->getReplaceable() ? pModelInstance->getNameIfReplaceable() : pModelInstance->getName();
-    LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem(name);
+    LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->fetchLibraryTreeItem(name);
     if (!pLibraryTreeItem) {
       MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica, "Could not find the LibraryTreeItem for model " + name +
                                                             ". This is a fatal error. Please report a bug.", Helper::scriptingKind, Helper::errorLevel));
@@ -7060,7 +7131,7 @@ void ModelWidget::navigateToClass(const QString &className)
   LibraryTreeItem *pLibraryTreeItem = nullptr;
   // first see if we find any relative class
   const QString parentClassName = StringHandler::removeLastWordAfterDot(mpLibraryTreeItem->getNameStructure());
-  pLibraryTreeItem = pLibraryWidget->getLibraryTreeModel()->findLibraryTreeItem(parentClassName % "." % className);
+  pLibraryTreeItem = pLibraryWidget->getLibraryTreeModel()->fetchLibraryTreeItem(parentClassName % "." % className);
   if (pLibraryTreeItem) {
     pLibraryWidget->getLibraryTreeModel()->showModelWidget(pLibraryTreeItem);
   } else {
@@ -7070,10 +7141,10 @@ void ModelWidget::navigateToClass(const QString &className)
       auto imports = mpModelInstance->getImports();
       foreach (auto import, imports) {
         if (className.compare(import.getShortName()) == 0) {
-          pLibraryTreeItem = pLibraryWidget->getLibraryTreeModel()->findLibraryTreeItem(import.getPath());
+          pLibraryTreeItem = pLibraryWidget->getLibraryTreeModel()->fetchLibraryTreeItem(import.getPath());
         } else {
           const QString importPath = StringHandler::removeLastWordAfterDot(import.getPath());
-          pLibraryTreeItem = pLibraryWidget->getLibraryTreeModel()->findLibraryTreeItem(importPath % "." % className);
+          pLibraryTreeItem = pLibraryWidget->getLibraryTreeModel()->fetchLibraryTreeItem(importPath % "." % className);
         }
         // check if we found the class in imports
         if (pLibraryTreeItem) {
@@ -7084,7 +7155,7 @@ void ModelWidget::navigateToClass(const QString &className)
     }
     // if class is not found in imports then see if the class is fully qualified path.
     if (!classFound) {
-      pLibraryTreeItem = pLibraryWidget->getLibraryTreeModel()->findLibraryTreeItem(className);
+      pLibraryTreeItem = pLibraryWidget->getLibraryTreeModel()->fetchLibraryTreeItem(className);
     }
     // if class is found then open it.
     if (pLibraryTreeItem) {
@@ -8168,7 +8239,7 @@ void ModelWidgetContainer::openModelWidgetsAndSelectElement(QHash<QString, QPair
   LibraryTreeModel *pLibraryTreeModel = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel();
   QHash<QString, QPair<QStringList, QStringList> >::const_iterator iterator = closedModelWidgetsAndSelectedElements.constBegin();
   while (iterator != closedModelWidgetsAndSelectedElements.constEnd()) {
-    LibraryTreeItem *pLibraryTreeItem = pLibraryTreeModel->findLibraryTreeItem(iterator.key());
+    LibraryTreeItem *pLibraryTreeItem = pLibraryTreeModel->fetchLibraryTreeItem(iterator.key());
     if (pLibraryTreeItem) {
       pLibraryTreeModel->showModelWidget(pLibraryTreeItem);
       if (pLibraryTreeItem->getModelWidget() && !skipSelection) {
@@ -8225,7 +8296,7 @@ bool ModelWidgetContainer::openRecentModelWidget(QListWidgetItem *pListWidgetIte
   if (!validateText()) {
     return false;
   }
-  LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem(pListWidgetItem->data(Qt::UserRole).toString());
+  LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->fetchLibraryTreeItem(pListWidgetItem->data(Qt::UserRole).toString());
   if (!pLibraryTreeItem) {
     return false;
   }
@@ -574,7 +574,7 @@ public:
 
   void drawModel(const ModelInfo &modelInfo);
   void drawModelIconDiagram(ModelInstance::Model *pModelInstance, bool inherited, const ModelInfo &modelInfo);
-  void loadModelInstance(bool icon, const ModelInfo &modelInfo);
+  void loadModelInstance(bool icon, const ModelInfo &modelInfo, const QJsonObject *pModelJson = 0);
   void loadDiagramViewNAPI();
   void detectMultipleDeclarations();
   void createModelWidgetComponents();
@@ -584,7 +584,8 @@ public:
   void clearGraphicsViews();
   void clearGraphicsViewsExceptOutOfSceneItems();
   void reDrawModelWidget();
-  void reDrawModelWidget(const ModelInfo &modelInfo);
+  void reDrawModelWidget(const ModelInfo &modelInfo, const QJsonObject *pModelJson = 0);
+  void requestModelInstance(const ModelInfo &modelInfo);
   bool validateText(LibraryTreeItem **pLibraryTreeItem);
   bool modelicaEditorTextChanged(LibraryTreeItem **pLibraryTreeItem);
   void updateChildClasses(LibraryTreeItem *pLibraryTreeItem);
@@ -652,8 +653,13 @@ private:
   ModelInfo mModelInfo;
   bool mComponentModified = false;
   bool mRestoringModel = false;
+  // incremented for each model instance request, see ModelWidget::requestModelInstance
+  quint64 mModelInstanceRequestId = 0;
+  bool mModelInstanceRequestPending = false;
+  ModelInfo mRequestedModelInfo;
 
   void createUndoStack();
+  void setModelInstanceRequestPending(bool pending);
   void handleCanUndoRedoChanged();
   void drawOMSModelIconElements();
   void drawOMSModelDiagramElements();
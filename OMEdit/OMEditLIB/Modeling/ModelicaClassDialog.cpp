@@ -287,7 +287,7 @@ void ModelicaClassDialog::showHideSaveContentsInOneFileCheckBox(int index)
   LibraryTreeModel *pLibraryTreeModel = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel();
   LibraryTreeItem *pParentLibraryTreeItem = pLibraryTreeModel->getRootLibraryTreeItem();
   if (!mpParentClassTextBox->text().isEmpty()) {
-    LibraryTreeItem *pLibraryTreeItem = pLibraryTreeModel->findLibraryTreeItem(mpParentClassTextBox->text());
+    LibraryTreeItem *pLibraryTreeItem = pLibraryTreeModel->fetchLibraryTreeItem(mpParentClassTextBox->text());
     if (pLibraryTreeItem) {
       pParentLibraryTreeItem = pLibraryTreeItem;
     }
@@ -331,7 +331,7 @@ void ModelicaClassDialog::createModelicaClass()
   LibraryTreeModel *pLibraryTreeModel = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel();
   LibraryTreeItem *pExtendsLibraryTreeItem = 0;
   if (!mpExtendsClassTextBox->text().isEmpty()) {
-    pExtendsLibraryTreeItem = pLibraryTreeModel->findLibraryTreeItem(mpExtendsClassTextBox->text());
+    pExtendsLibraryTreeItem = pLibraryTreeModel->fetchLibraryTreeItem(mpExtendsClassTextBox->text());
     if (!pExtendsLibraryTreeItem) {
       QMessageBox::critical(this, QString(Helper::applicationName).append(" - ").append(Helper::error),
                             GUIMessages::getMessage(GUIMessages::EXTENDS_CLASS_NOT_FOUND).arg(mpExtendsClassTextBox->text()), QMessageBox::Ok);
@@ -341,7 +341,7 @@ void ModelicaClassDialog::createModelicaClass()
   /* if insert in class doesn't exist. */
   LibraryTreeItem *pParentLibraryTreeItem = pLibraryTreeModel->getRootLibraryTreeItem();
   if (!mpParentClassTextBox->text().isEmpty()) {
-    pParentLibraryTreeItem = pLibraryTreeModel->findLibraryTreeItem(mpParentClassTextBox->text());
+    pParentLibraryTreeItem = pLibraryTreeModel->fetchLibraryTreeItem(mpParentClassTextBox->text());
     if (!pParentLibraryTreeItem) {
       QMessageBox::critical(this, QString(Helper::applicationName).append(" - ").append(Helper::error),
                             GUIMessages::getMessage(GUIMessages::INSERT_IN_CLASS_NOT_FOUND).arg(mpParentClassTextBox->text()), QMessageBox::Ok);
@@ -706,7 +706,7 @@ void SaveAsClassDialog::saveAsModelicaClass()
   }
   /* if insert in class is system library. */
   LibraryTreeModel *pLibraryTreeModel = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel();
-  LibraryTreeItem *pParentLibraryTreeItem = pLibraryTreeModel->findLibraryTreeItem(mpParentClassComboBox->currentText());
+  LibraryTreeItem *pParentLibraryTreeItem = pLibraryTreeModel->fetchLibraryTreeItem(mpParentClassComboBox->currentText());
   if (pParentLibraryTreeItem) {
     if (pParentLibraryTreeItem->isSystemLibrary()) {
       QMessageBox::critical(this, QString(Helper::applicationName).append(" - ").append(Helper::error), GUIMessages::getMessage(
@@ -1136,7 +1136,7 @@ void DuplicateClassDialog::duplicateClass()
   LibraryTreeModel *pLibraryTreeModel = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel();
   LibraryTreeItem *pParentLibraryTreeItem = pLibraryTreeModel->getRootLibraryTreeItem();
   if (!mpPathTextBox->text().isEmpty()) {
-    pParentLibraryTreeItem = pLibraryTreeModel->findLibraryTreeItem(mpPathTextBox->text());
+    pParentLibraryTreeItem = pLibraryTreeModel->fetchLibraryTreeItem(mpPathTextBox->text());
     if (!pParentLibraryTreeItem) {
       QMessageBox::critical(MainWindow::instance(), QString("%1 - %2").arg(Helper::applicationName, Helper::error),
                             GUIMessages::getMessage(GUIMessages::INSERT_IN_CLASS_NOT_FOUND).arg(mpPathTextBox->text()), QMessageBox::Ok);
@@ -1163,7 +1163,7 @@ void DuplicateClassDialog::duplicateClass()
   }
   // check if path is not a system library
   if (!mpPathTextBox->text().isEmpty()) {
-    LibraryTreeItem *pLibraryTreeItem = pLibraryTreeModel->findLibraryTreeItem(mpPathTextBox->text());
+    LibraryTreeItem *pLibraryTreeItem = pLibraryTreeModel->fetchLibraryTreeItem(mpPathTextBox->text());
     if (pLibraryTreeItem && pLibraryTreeItem->isSystemLibrary()) {
       QMessageBox::critical(MainWindow::instance(), QString("%1 - %2").arg(Helper::applicationName, Helper::error),
                             tr("Cannot duplicate inside system library."), QMessageBox::Ok);
@@ -2046,7 +2046,7 @@ void SaveChangesDialog::saveChanges()
   bool saveResult = true;
   foreach (QListWidgetItem *pListItem, mpUnsavedClassesListWidget->selectedItems()) {
     LibraryTreeItem *pLibraryTreeItem;
-    pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem(pListItem->text());
+    pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->fetchLibraryTreeItem(pListItem->text());
     if (pLibraryTreeItem && !MainWindow::instance()->getLibraryWidget()->saveLibraryTreeItem(pLibraryTreeItem)) {
       saveResult = false;
     }
@@ -2273,7 +2273,7 @@ void CreateNewItemDialog::createNewFileOrFolder()
   }
   // find the LibraryTreeItem based on path
   LibraryTreeModel *pLibraryTreeModel = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel();
-  LibraryTreeItem *pParentLibraryTreeItem = pLibraryTreeModel->findLibraryTreeItem(mpPathTextBox->text());
+  LibraryTreeItem *pParentLibraryTreeItem = pLibraryTreeModel->fetchLibraryTreeItem(mpPathTextBox->text());
   if (!pParentLibraryTreeItem) {
     pParentLibraryTreeItem = pLibraryTreeModel->getRootLibraryTreeItem();
   }
@@ -56,6 +56,11 @@ void omc_Main_setWindowsPaths(threadData_t *threadData, void* _inOMHome);
 
 #include <QMessageBox>
 #include <QStringBuilder>
+#include <QJsonDocument>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrent>
+
+#include <memory>
 
 /*!
  * \class OMCProxy
@@ -352,7 +357,7 @@ void OMCProxy::sendCommand(const QString expression, bool saveToHistory)
       } else if (mLibrariesBrowserDeletionCommandsList.contains(exp.functionName())) {
         if (exp.functionName().compare(QStringLiteral("deleteClass")) == 0) {
           if (exp.args().size() > 0) {
-            LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem(exp.arg(0).toQString());
+            LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->fetchLibraryTreeItem(exp.arg(0).toQString());
             if (pLibraryTreeItem) {
               MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->unloadClass(pLibraryTreeItem, false, false);
             }
@@ -578,7 +583,7 @@ QString OMCProxy::getErrorString(bool warningsAsErrors)
 
 /*!
  * \brief OMCProxy::printMessagesStringInternal
- * Gets the errors by using the getMessagesStringInternal API.
+ * Gets the errors by using the getMessagesJSON API.
  * Reads all the errors and add them to the Messages Browser.
  * \see MessagesWidget::addGUIMessage
  * \return true if there are any errors otherwise false.
@@ -587,153 +592,51 @@ bool OMCProxy::printMessagesStringInternal()
 {
   MainWindow::instance()->printStandardOutAndErrorFilesMessages();
   // read errors
-  int errorsSize = getMessagesStringInternal();
-  bool returnValue = errorsSize > 0 ? true : false;
+  QJsonArray messages = getMessagesJSON();
 
-  /* Loop in reverse order since getMessagesStringInternal returns error messages in reverse order. */
-  for (int i = errorsSize; i > 0 ; i--) {
-    setCurrentError(i);
-    const int errorId = getErrorId();
+  foreach (const QJsonValue &value, messages) {
+    const QJsonObject message = value.toObject();
+    const int errorId = message.value("id").toInt();
     if (errorId == 371 || errorId == 372 || errorId == 373) {
       mLoadModelError = true;
     }
-    MessageItem messageItem(MessageItem::Modelica, getErrorFileName(), getErrorReadOnly(), getErrorLineStart(), getErrorColumnStart(), getErrorLineEnd(),
-                            getErrorColumnEnd(), getErrorMessage(), getErrorKind(), getErrorLevel());
+    const QJsonObject info = message.value("info").toObject();
+    QString fileName = info.value("filename").toString();
+    if (fileName.compare("<interactive>") == 0) {
+      fileName = "";
+    }
+    MessageItem messageItem(MessageItem::Modelica, fileName, info.value("readonly").toBool(), info.value("lineStart").toInt(),
+                            info.value("columnStart").toInt(), info.value("lineEnd").toInt(), info.value("columnEnd").toInt(),
+                            message.value("message").toString(), ".OpenModelica.Scripting.ErrorKind." % message.value("kind").toString(),
+                            ".OpenModelica.Scripting.ErrorLevel." % message.value("level").toString());
     MessagesWidget::instance()->addGUIMessage(messageItem);
   }
-  return returnValue;
+  return !messages.isEmpty();
 }
 
 /*!
-  Retrieves the list of errors from OMC
-  \return size of errors
-  */
-int OMCProxy::getMessagesStringInternal()
+ * \brief OMCProxy::getMessagesJSON
+ * Retrieves all the pending errors from OMC with a single getMessagesJSON call.
+ * \return the errors ordered from the oldest to the newest.
+ */
+QJsonArray OMCProxy::getMessagesJSON()
 {
-  // getMessagesStringInternal() is quite slow, check if there are any messages first.
+  // check if there are any messages first to avoid a call that just returns an empty list.
   auto res = mpOMCInterface->countMessages();
 
   if (res.numMessages || res.numErrors || res.numWarnings) {
-    sendCommand("errors:=getMessagesStringInternal()");
-    sendCommand("size(errors,1)");
-    return getResult().toInt();
+    const QString messagesJson = mpOMCInterface->getMessagesJSON(true);
+    QJsonParseError jsonParserError;
+    QJsonDocument doc = QJsonDocument::fromJson(messagesJson.toUtf8(), &jsonParserError);
+    if (doc.isNull()) {
+      MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica,
+                                                            QString("Failed to parse messages json with error %1.").arg(jsonParserError.errorString()),
+                                                            Helper::scriptingKind, Helper::errorLevel));
+    }
+    return doc.array();
   }
 
-  return 0;
-}
-
-/*!
-  Sets the current error.
-  \param int the error index
-  */
-void OMCProxy::setCurrentError(int errorIndex)
-{
-  sendCommand("currentError:=errors[" + QString::number(errorIndex) + "]");
-}
-
-/*!
-  Gets the error file name from current error.
-  \return the error file name
-  */
-QString OMCProxy::getErrorFileName()
-{
-  sendCommand("currentError.info.filename");
-  QString file = StringHandler::unparse(getResult());
-  if (file.compare("<interactive>") == 0)
-    return "";
-  else
-    return file;
-}
-
-/*!
-  Gets the error read only state from current error.
-  \return the error read only state
-  */
-bool OMCProxy::getErrorReadOnly()
-{
-  sendCommand("currentError.info.readonly");
-  return StringHandler::unparseBool(StringHandler::unparse(getResult()));
-}
-
-/*!
-  Gets the error line start index from current error.
-  \return the error line start index
-  */
-int OMCProxy::getErrorLineStart()
-{
-  sendCommand("currentError.info.lineStart");
-  return getResult().toInt();
-}
-
-/*!
-  Gets the error column start index from current error.
-  \return the error column start index
-  */
-int OMCProxy::getErrorColumnStart()
-{
-  sendCommand("currentError.info.columnStart");
-  return getResult().toInt();
-}
-
-/*!
-  Gets the error line end index from current error.
-  \return the error line end index
-  */
-int OMCProxy::getErrorLineEnd()
-{
-  sendCommand("currentError.info.lineEnd");
-  return getResult().toInt();
-}
-
-/*!
-  Gets the error column end index from current error.
-  \return the error column end index
-  */
-int OMCProxy::getErrorColumnEnd()
-{
-  sendCommand("currentError.info.columnEnd");
-  return getResult().toInt();
-}
-
-/*!
-  Gets the error message from current error.
-  \return the error message
-  */
-QString OMCProxy::getErrorMessage()
-{
-  sendCommand("currentError.message");
-  return StringHandler::unparse(getResult());
-}
-
-/*!
-  Gets the error kind from current error.
-  \return the error kind
-  */
-QString OMCProxy::getErrorKind()
-{
-  sendCommand("currentError.kind");
-  return getResult();
-}
-
-/*!
-  Gets the error level from current error.
-  \return the error level
-  */
-QString OMCProxy::getErrorLevel()
-{
-  sendCommand("currentError.level");
-  return getResult();
-}
-
-/*!
- * \brief OMCProxy::getErrorId
- * Gets the current error id.
- * \return
- */
-int OMCProxy::getErrorId()
-{
-  sendCommand("currentError.id");
-  return getResult().toInt();
+  return QJsonArray();
 }
 
 /*!
@@ -776,7 +679,7 @@ void OMCProxy::loadSystemLibraries(const QVector<QPair<QString, QString> > libra
       } else {
         if (lib.compare(QStringLiteral("OpenModelica")) == 0) {
           LibraryTreeModel *pLibraryTreeModel = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel();
-          LibraryTreeItem *pLibraryTreeItem = pLibraryTreeModel->findLibraryTreeItem(lib);
+          LibraryTreeItem *pLibraryTreeItem = pLibraryTreeModel->fetchLibraryTreeItem(lib);
           if (!pLibraryTreeItem) {
             SplashScreen::instance()->showMessage(QString("%1 %2").arg(Helper::loading, lib), Qt::AlignRight, Qt::white);
             pLibraryTreeModel->createLibraryTreeItem(lib, pLibraryTreeModel->getRootLibraryTreeItem(), true, true, true);
@@ -1656,6 +1559,8 @@ bool OMCProxy::loadFile(QString fileName, QString encoding, bool uses, bool noti
   bool result = false;
   fileName = fileName.replace('\\', '/');
   result = mpOMCInterface->loadFile(fileName, encoding, uses, notify, requireExactVersion, allowWithin);
+  // omc drops its cached instances on loadFile so drop ours as well.
+  mModelInstanceCache.clear();
   /* If result is true then print messages anyway, because there might be warnings/notifications
    * If result is false then print messages only if printErrors is true.
    */
@@ -3387,21 +3292,50 @@ QList<QString> OMCProxy::getAvailablePackageConversionsFrom(const QString &pkg,
 }
 
 /*!
- * \brief OMCProxy::getModelInstance
+ * \brief modelInstanceCacheKey
+ * Returns the key of the model instance in OMCProxy::mModelInstanceCache.
  * \param className
+ * \param modifier
  * \param prettyPrint
- * \param icon
  * \return
  */
-QJsonObject OMCProxy::getModelInstance(const QString &className, const QString &modifier, bool prettyPrint, bool icon)
+static QString modelInstanceCacheKey(const QString &className, const QString &modifier, bool prettyPrint)
+{
+  return className % QStringLiteral("\n") % modifier % QStringLiteral("\n") % (prettyPrint ? QStringLiteral("true") : QStringLiteral("false"));
+}
+
+/*!
+ * \brief modelInstanceIconFilter
+ * Returns the annotations needed to draw the icon of a class.
+ * \return
+ */
+static QList<QString> modelInstanceIconFilter()
+{
+  QList<QString> filter;
+  filter << "Icon" << "IconMap" << "Diagram" << "DiagramMap" << "experiment";
+  return filter;
+}
+
+/*!
+ * \brief OMCProxy::getModelInstanceJson
+ * Calls getModelInstance or getModelInstanceAnnotation and returns the JSON string.
+ * \param className
+ * \param modifier
+ * \param prettyPrint
+ * \param icon
+ * \param modelInstanceJson
+ * \param newRevision - the revision of the instance, 0 for icon instances which are not cached.
+ * \return false if the cached instance is still current.
+ */
+bool OMCProxy::getModelInstanceJson(const QString &className, const QString &modifier, bool prettyPrint, bool icon, QString &modelInstanceJson, int &newRevision)
 {
   QElapsedTimer timer;
   timer.start();
 
-  QString modelInstanceJson = "";
+  modelInstanceJson = "";
+  newRevision = 0;
   if (icon) {
-    QList<QString> filter;
-    filter << "Icon" << "IconMap" << "Diagram" << "DiagramMap" << "experiment";
+    const QList<QString> filter = modelInstanceIconFilter();
     modelInstanceJson = mpOMCInterface->getModelInstanceAnnotation(className, filter, prettyPrint);
     if (modelInstanceJson.isEmpty()) {
       if (MainWindow::instance()->isDebug()) {
@@ -3416,7 +3350,25 @@ QJsonObject OMCProxy::getModelInstance(const QString &className, const QString &
       modelInstanceJson = mpOMCInterface->getModelInstance(className, modifier, prettyPrint);
     }
   } else {
-    modelInstanceJson = mpOMCInterface->getModelInstance(className, modifier, prettyPrint);
+    /* Send the revision of the instance we already have. omc returns an empty string if it is still current,
+     * so we don't need to transfer and parse it again.
+     */
+    const QString cacheKey = modelInstanceCacheKey(className, modifier, prettyPrint);
+    const QPair<int, QJsonObject> *pCachedInstance = mModelInstanceCache.object(cacheKey);
+    const int revision = pCachedInstance ? pCachedInstance->first : 0;
+    OMCInterface::getModelInstanceIfChanged_res instance = mpOMCInterface->getModelInstanceIfChanged(className, revision, modifier, prettyPrint);
+    if (revision > 0 && instance.newRevision == revision && instance.result.isEmpty()) {
+      if (MainWindow::instance()->isNewApiProfiling()) {
+        double elapsed = (double)timer.elapsed() / 1000.0;
+        MainWindow::instance()->writeNewApiProfiling(QString("Time for getModelInstanceIfChanged(%1) %2 secs (unchanged)").arg(className, QString::number(elapsed, 'f', 6)));
+      }
+      printMessagesStringInternal();
+      newRevision = revision;
+      return false;
+    }
+    mModelInstanceCache.remove(cacheKey);
+    modelInstanceJson = instance.result;
+    newRevision = instance.newRevision;
   }
 
   if (MainWindow::instance()->isNewApiProfiling()) {
@@ -3426,8 +3378,33 @@ QJsonObject OMCProxy::getModelInstance(const QString &className, const QString &
   }
 
   printMessagesStringInternal();
+  return true;
+}
+
+/*!
+ * \brief OMCProxy::getModelInstance
+ * \param className
+ * \param prettyPrint
+ * \param icon
+ * \return
+ */
+QJsonObject OMCProxy::getModelInstance(const QString &className, const QString &modifier, bool prettyPrint, bool icon)
+{
+  // use the icon instance if it is already fetched, see OMCProxy::getModelInstanceIconsAsync
+  if (icon && mModelInstanceIcons.value(className).isObject()) {
+    return mModelInstanceIcons.value(className).toObject();
+  }
+
+  QString modelInstanceJson;
+  int newRevision;
+  if (!getModelInstanceJson(className, modifier, prettyPrint, icon, modelInstanceJson, newRevision)) {
+    const QPair<int, QJsonObject> *pCachedInstance = mModelInstanceCache.object(modelInstanceCacheKey(className, modifier, prettyPrint));
+    return pCachedInstance ? pCachedInstance->second : QJsonObject();
+  }
+
   if (!modelInstanceJson.isEmpty()) {
-    timer.restart();
+    QElapsedTimer timer;
+    timer.start();
     QJsonParseError jsonParserError;
     QJsonDocument doc = QJsonDocument::fromJson(modelInstanceJson.toUtf8(), &jsonParserError);
     if (doc.isNull()) {
@@ -3440,11 +3417,114 @@ QJsonObject OMCProxy::getModelInstance(const QString &className, const QString &
       double elapsed = (double)timer.elapsed() / 1000.0;
       MainWindow::instance()->writeNewApiProfiling(QString("Time for converting to JSON %1 secs").arg(QString::number(elapsed, 'f', 6)));
     }
+    if (!doc.isNull() && newRevision > 0) {
+      mModelInstanceCache.insert(modelInstanceCacheKey(className, modifier, prettyPrint), new QPair<int, QJsonObject>(newRevision, doc.object()));
+    }
     return doc.object();
   }
   return QJsonObject();
 }
 
+/*!
+ * \brief OMCProxy::getModelInstanceAsync
+ * Same as OMCProxy::getModelInstance but parses the JSON in a separate thread.\n
+ * omc itself is not thread safe so it is still called in the calling thread, which must be the GUI thread.
+ * \param className
+ * \param modifier
+ * \param prettyPrint
+ * \param pRevision - set to the revision of the returned instance, see OMCProxy::getModelInstanceAsyncIfChanged.
+ * \return
+ */
+QFuture<QJsonObject> OMCProxy::getModelInstanceAsync(const QString &className, const QString &modifier, bool prettyPrint, int *pRevision)
+{
+  QString modelInstanceJson;
+  int newRevision;
+  const QString cacheKey = modelInstanceCacheKey(className, modifier, prettyPrint);
+  const bool changed = getModelInstanceJson(className, modifier, prettyPrint, false, modelInstanceJson, newRevision);
+  if (pRevision) {
+    *pRevision = newRevision;
+  }
+  if (!changed) {
+    const QPair<int, QJsonObject> *pCachedInstance = mModelInstanceCache.object(cacheKey);
+    const QJsonObject modelInstance = pCachedInstance ? pCachedInstance->second : QJsonObject();
+    return QtConcurrent::run([modelInstance]() {return modelInstance;});
+  }
+
+  std::shared_ptr<QJsonParseError> pJsonParserError = std::make_shared<QJsonParseError>();
+  QFuture<QJsonObject> future = QtConcurrent::run([modelInstanceJson, pJsonParserError]() {
+    if (modelInstanceJson.isEmpty()) {
+      return QJsonObject();
+    }
+    return QJsonDocument::fromJson(modelInstanceJson.toUtf8(), pJsonParserError.get()).object();
+  });
+  // report the errors and cache the instance once it is parsed.
+  QFutureWatcher<QJsonObject> *pFutureWatcher = new QFutureWatcher<QJsonObject>(this);
+  connect(pFutureWatcher, &QFutureWatcher<QJsonObject>::finished, this, [this, pFutureWatcher, pJsonParserError, className, cacheKey, newRevision]() {
+    if (pJsonParserError->error != QJsonParseError::NoError) {
+      MessagesWidget::instance()->addGUIMessage(MessageItem(MessageItem::Modelica,
+                                                            QString("Failed to parse model instance json for class %1 with error %2.")
+                                                            .arg(className, pJsonParserError->errorString()),
+                                                            Helper::scriptingKind, Helper::errorLevel));
+    } else if (newRevision > 0) {
+      // a newer instance might have been fetched by getModelInstance in the meantime.
+      const QPair<int, QJsonObject> *pCachedInstance = mModelInstanceCache.object(cacheKey);
+      if (!pCachedInstance || pCachedInstance->first < newRevision) {
+        mModelInstanceCache.insert(cacheKey, new QPair<int, QJsonObject>(newRevision, pFutureWatcher->result()));
+      }
+    }
+    pFutureWatcher->deleteLater();
+  });
+  pFutureWatcher->setFuture(future);
+  return future;
+}
+
+/*!
+ * \brief OMCProxy::getModelInstanceAsyncIfChanged
+ * Same as OMCProxy::getModelInstanceAsync but for an instance that was already parsed with revision *pRevision.\n
+ * The parsed instance is cached first so omc only sends the instance again if it changed in the meantime.
+ * \param className
+ * \param modelInstance - the instance parsed with revision *pRevision.
+ * \param pRevision - the revision of modelInstance, set to the revision of the returned instance.
+ * \return modelInstance if it is still current otherwise the new instance.
+ */
+QFuture<QJsonObject> OMCProxy::getModelInstanceAsyncIfChanged(const QString &className, const QJsonObject &modelInstance, int *pRevision)
+{
+  const QString cacheKey = modelInstanceCacheKey(className, QString(""), false);
+  const QPair<int, QJsonObject> *pCachedInstance = mModelInstanceCache.object(cacheKey);
+  if (!modelInstance.isEmpty() && (!pCachedInstance || pCachedInstance->first < *pRevision)) {
+    mModelInstanceCache.insert(cacheKey, new QPair<int, QJsonObject>(*pRevision, modelInstance));
+  }
+  return getModelInstanceAsync(className, QString(""), false, pRevision);
+}
+
+/*!
+ * \brief OMCProxy::getModelInstanceIconsAsync
+ * Fetches the icon instances of the classes with one getModelInstanceAnnotations call and parses the JSON in a separate thread.\n
+ * omc itself is not thread safe so it is still called in the calling thread, which must be the GUI thread.
+ * Pass the result to OMCProxy::setModelInstanceIcons so OMCProxy::getModelInstance uses it instead of calling omc for each class.
+ * \param classNames
+ * \return the icon instances with the class names as keys, the value is null for classes that omc could not dump.
+ */
+QFuture<QJsonObject> OMCProxy::getModelInstanceIconsAsync(const QStringList &classNames)
+{
+  QElapsedTimer timer;
+  timer.start();
+
+  const QString modelInstanceIconsJson = mpOMCInterface->getModelInstanceAnnotations(classNames, modelInstanceIconFilter(), false);
+  if (MainWindow::instance()->isNewApiProfiling()) {
+    double elapsed = (double)timer.elapsed() / 1000.0;
+    MainWindow::instance()->writeNewApiProfiling(QString("Time for getModelInstanceAnnotations(%1 classes) %2 secs").arg(classNames.size()).arg(QString::number(elapsed, 'f', 6)));
+  }
+  printMessagesStringInternal();
+
+  return QtConcurrent::run([modelInstanceIconsJson]() {
+    if (modelInstanceIconsJson.isEmpty()) {
+      return QJsonObject();
+    }
+    return QJsonDocument::fromJson(modelInstanceIconsJson.toUtf8()).object();
+  });
+}
+
 /*!
  * \brief OMCProxy::modifierToJSON
  * Converts the modifier to JSON format.
@@ -3501,6 +3581,7 @@ bool OMCProxy::restoreAST(int id)
 bool OMCProxy::clear()
 {
   bool result = mpOMCInterface->clear();
+  mModelInstanceCache.clear();
   printMessagesStringInternal();
   return result;
 }
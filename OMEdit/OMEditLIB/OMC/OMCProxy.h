@@ -40,6 +40,10 @@
 #include "Util/Helper.h"
 #include "Util/Utilities.h"
 
+#include <QJsonArray>
+#include <QFuture>
+#include <QCache>
+
 class CustomExpressionBox;
 class OutputPlainTextEdit;
 class ElementInfo;
@@ -84,6 +88,12 @@ private:
   QStringList mLibrariesBrowserAdditionCommandsList;
   QStringList mLibrariesBrowserDeletionCommandsList;
   bool mLoadModelError;
+  // the most recently used parsed model instances with their revision, see OMCProxy::getModelInstance
+  QCache<QString, QPair<int, QJsonObject> > mModelInstanceCache{32};
+  // the icon instances fetched with one call, see OMCProxy::getModelInstanceIconsAsync
+  QJsonObject mModelInstanceIcons;
+
+  bool getModelInstanceJson(const QString &className, const QString &modifier, bool prettyPrint, bool icon, QString &modelInstanceJson, int &newRevision);
 public:
   OMCProxy(threadData_t *threadData, QWidget *pParent = 0);
   ~OMCProxy();
@@ -102,18 +112,7 @@ public:
   bool isLoadModelError() const {return mLoadModelError;}
   QString getErrorString(bool warningsAsErrors = false);
   bool printMessagesStringInternal();
-  int getMessagesStringInternal();
-  void setCurrentError(int errorIndex);
-  QString getErrorFileName();
-  bool getErrorReadOnly();
-  int getErrorLineStart();
-  int getErrorColumnStart();
-  int getErrorLineEnd();
-  int getErrorColumnEnd();
-  QString getErrorMessage();
-  QString getErrorKind();
-  QString getErrorLevel();
-  int getErrorId();
+  QJsonArray getMessagesJSON();
   QString getVersion(QString className = QString("OpenModelica"));
   void loadSystemLibraries(const QVector<QPair<QString, QString> > libraries);
   void loadUserLibraries();
@@ -276,6 +275,10 @@ public:
   bool convertPackageToLibrary(const QString &packageToConvert, const QString &library, const QString &libraryVersion);
   QList<QString> getAvailablePackageConversionsFrom(const QString &pkg, const QString &version);
   QJsonObject getModelInstance(const QString &className, const QString &modifier = QString(""), bool prettyPrint = false, bool icon = false);
+  QFuture<QJsonObject> getModelInstanceAsync(const QString &className, const QString &modifier = QString(""), bool prettyPrint = false, int *pRevision = 0);
+  QFuture<QJsonObject> getModelInstanceAsyncIfChanged(const QString &className, const QJsonObject &modelInstance, int *pRevision);
+  QFuture<QJsonObject> getModelInstanceIconsAsync(const QStringList &classNames);
+  void setModelInstanceIcons(const QJsonObject &modelInstanceIcons) {mModelInstanceIcons = modelInstanceIcons;}
   QJsonObject modifierToJSON(const QString &modifier, bool prettyPrint = false);
   int storeAST();
   bool restoreAST(int id);
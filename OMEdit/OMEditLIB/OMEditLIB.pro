@@ -331,6 +331,7 @@ CONFIG(osg) {
     Animation/Visualization.cpp \
     Animation/VisualizationMAT.cpp \
     Animation/VisualizationCSV.cpp \
+    Animation/VisualizationLive.cpp \
     Animation/VisualizationFMU.cpp \
     Animation/FMUSettingsDialog.cpp \
     Animation/FMUWrapper.cpp \
@@ -351,6 +352,7 @@ CONFIG(osg) {
     Animation/Visualization.h \
     Animation/VisualizationMAT.h \
     Animation/VisualizationCSV.h \
+    Animation/VisualizationLive.h \
     Animation/VisualizationFMU.h \
     Animation/FMUSettingsDialog.h \
     Animation/FMUWrapper.h \
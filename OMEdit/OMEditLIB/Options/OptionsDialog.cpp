@@ -6790,7 +6790,7 @@ void DiscardLocalTranslationFlagsDialog::discardLocalTranslationFlags()
   for (int i = 0; i < mpClassesWithLocalTranslationFlagsListWidget->count(); i++) {
     QListWidgetItem *pClassWithLocalTranslationFlags = mpClassesWithLocalTranslationFlagsListWidget->item(i);
     if (pClassWithLocalTranslationFlags->checkState() == Qt::Checked) {
-      LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem(pClassWithLocalTranslationFlags->text());
+      LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->fetchLibraryTreeItem(pClassWithLocalTranslationFlags->text());
       if (pLibraryTreeItem) {
         pLibraryTreeItem->mSimulationOptions.setIsValid(false);
         pLibraryTreeItem->mSimulationOptions.setDataReconciliationInitialized(false);
@@ -6802,7 +6802,7 @@ void DiscardLocalTranslationFlagsDialog::discardLocalTranslationFlags()
 
 void DiscardLocalTranslationFlagsDialog::showLocalTranslationFlags(QListWidgetItem *pListWidgetItem)
 {
-  LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem(pListWidgetItem->text());
+  LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->fetchLibraryTreeItem(pListWidgetItem->text());
   if (pLibraryTreeItem) {
     QDialog *pLocalTranslationFlagsDialog = new QDialog;
     pLocalTranslationFlagsDialog->setWindowTitle(QString("%1 - Local Translation Flags - %2").arg(Helper::applicationName, pLibraryTreeItem->getNameStructure()));
@@ -271,6 +271,11 @@ void SimulationDialog::setUpForm()
 #if !defined(WITHOUT_OSG)
   // Launch Animation
   mpLaunchAnimationCheckBox = new QCheckBox(tr("Launch Animation"));
+  // Animate the simulation while it is running
+  mpLiveAnimationCheckBox = new QCheckBox(tr("Animate While Simulating"));
+  mpLiveAnimationCheckBox->setToolTip(tr("Opens the animation as soon as the simulation starts and follows it until it has finished"));
+  mpLiveAnimationCheckBox->setEnabled(false);
+  connect(mpLaunchAnimationCheckBox, SIGNAL(toggled(bool)), mpLiveAnimationCheckBox, SLOT(setEnabled(bool)));
 #endif
   QGridLayout *pLaunchOptionsLayout = new QGridLayout;
   pLaunchOptionsLayout->setAlignment(Qt::AlignTop);
@@ -279,6 +284,7 @@ void SimulationDialog::setUpForm()
 #if !defined(WITHOUT_OSG)
   pLaunchOptionsLayout->addWidget(mpLaunchAlgorithmicDebuggerCheckBox, 1, 0);
   pLaunchOptionsLayout->addWidget(mpLaunchAnimationCheckBox, 1, 1);
+  pLaunchOptionsLayout->addWidget(mpLiveAnimationCheckBox, 2, 1);
 #else
   pLaunchOptionsLayout->addWidget(mpLaunchAlgorithmicDebuggerCheckBox, 1, 0, 1, 2);
 #endif
@@ -962,6 +968,7 @@ void SimulationDialog::applySimulationOptions(SimulationOptions simulationOption
 #if !defined(WITHOUT_OSG)
   // Simulate with Animation checkbox
   mpLaunchAnimationCheckBox->setChecked(simulationOptions.getSimulateWithAnimation());
+  mpLiveAnimationCheckBox->setChecked(simulationOptions.getLiveAnimation());
 #endif
   // build only
   mpBuildOnlyCheckBox->setChecked(simulationOptions.getBuildOnly());
@@ -1143,7 +1150,7 @@ SimulationOptions SimulationDialog::createSimulationOptions()
   /* issue #11727
    * Save Interval in resimulate case only if we can find the class and it is defined in the experiment annotation.
    */
-  LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem(mClassName);
+  LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->fetchLibraryTreeItem(mClassName);
   if (pLibraryTreeItem && pLibraryTreeItem->getModelWidget() && pLibraryTreeItem->getModelWidget()->getModelInstance()) {
     simulationOptions.setHasInterval(pLibraryTreeItem->getModelWidget()->getModelInstance()->getAnnotation()->getExperimentAnnotation().hasInterval());
   }
@@ -1165,6 +1172,7 @@ SimulationOptions SimulationDialog::createSimulationOptions()
   simulationOptions.setLaunchAlgorithmicDebugger(mpLaunchAlgorithmicDebuggerCheckBox->isChecked());
 #if !defined(WITHOUT_OSG)
   simulationOptions.setSimulateWithAnimation(mpLaunchAnimationCheckBox->isChecked());
+  simulationOptions.setLiveAnimation(mpLaunchAnimationCheckBox->isChecked() && mpLiveAnimationCheckBox->isEnabled() && mpLiveAnimationCheckBox->isChecked());
 #endif
 
   mpTranslationFlagsWidget->createSimulationOptions(&simulationOptions);
@@ -1248,6 +1256,10 @@ SimulationOptions SimulationDialog::createSimulationOptions()
                          .arg("outputFormat").arg(simulationOptions.getOutputFormat())
                          .arg("variableFilter").arg(simulationOptions.getVariableFilter()));
   simulationFlags.append(QString("-r=%1/%2").arg(simulationOptions.getWorkingDirectory(), simulationOptions.getFullResultFileName()));
+  // publish the results while simulating so the animation can follow the simulation
+  if (simulationOptions.getLiveAnimation()) {
+    simulationFlags.append(QString("-liveResult=%1/%2").arg(simulationOptions.getWorkingDirectory(), simulationOptions.getLiveResultFileName()));
+  }
   // jacobian
   if (!mpJacobianComboBox->currentText().isEmpty()) {
     simulationFlags.append(QString("-jacobian=").append(mpJacobianComboBox->currentText()));
@@ -1932,10 +1944,11 @@ OpcUaClient* SimulationDialog::getOpcUaClient(int port)
  * \brief SimulationDialog::simulationProcessFinished
  * \param simulationOptions
  * \param resultFileLastModifiedDateTime
+ * \param pLiveAnimationWindow - the animation window that followed the running simulation, if any.
  * Handles what should be done after the simulation process has finished.\n
  * Reads the result variables and inserts them into the variable browser.\n
  */
-void SimulationDialog::simulationProcessFinished(SimulationOptions simulationOptions, QDateTime resultFileLastModifiedDateTime)
+void SimulationDialog::simulationProcessFinished(SimulationOptions simulationOptions, QDateTime resultFileLastModifiedDateTime, AnimationWindow *pLiveAnimationWindow)
 {
   QString workingDirectory = simulationOptions.getWorkingDirectory();
   QRegExp regExp(Helper::omResultFileTypesRegExp);
@@ -1964,8 +1977,12 @@ void SimulationDialog::simulationProcessFinished(SimulationOptions simulationOpt
     // if simulated with animation then open the animation directly.
     if (simulationOptions.getSimulateWithAnimation()) {
       if (simulationOptions.getFullResultFileName().endsWith(".mat")) {
-        MainWindow::instance()->getPlotWindowContainer()->addAnimationWindow();
-        AnimationWindow *pAnimationWindow = MainWindow::instance()->getPlotWindowContainer()->getCurrentAnimationWindow();
+        // reuse the window that animated the running simulation, it now switches to the complete result file
+        AnimationWindow *pAnimationWindow = pLiveAnimationWindow;
+        if (!pAnimationWindow) {
+          MainWindow::instance()->getPlotWindowContainer()->addAnimationWindow();
+          pAnimationWindow = MainWindow::instance()->getPlotWindowContainer()->getCurrentAnimationWindow();
+        }
         if (pAnimationWindow) {
           pAnimationWindow->openAnimationFile(resultFileInfo.absoluteFilePath());
         }
@@ -2091,6 +2108,7 @@ void SimulationDialog::buildOnly(bool checked)
   }
 #if !defined(WITHOUT_OSG)
   mpLaunchAnimationCheckBox->setEnabled(!checked);
+  mpLiveAnimationCheckBox->setEnabled(!checked && !mpInteractiveSimulationGroupBox->isChecked() && mpLaunchAnimationCheckBox->isChecked());
 #endif
   mpSimulationFlagsTab->setEnabled(!checked);
 }
@@ -2107,6 +2125,7 @@ void SimulationDialog::interactiveSimulation(bool checked)
   mpLaunchTransformationalDebuggerCheckBox->setEnabled(!checked);
 #if !defined(WITHOUT_OSG)
   mpLaunchAnimationCheckBox->setEnabled(!checked);
+  mpLiveAnimationCheckBox->setEnabled(!checked && !mpBuildOnlyCheckBox->isChecked() && mpLaunchAnimationCheckBox->isChecked());
 #endif
 }
 
@@ -57,6 +57,7 @@ class Label;
 class SimulationOutputWidget;
 class LibraryTreeItem;
 class TranslationFlagsWidget;
+class AnimationWindow;
 
 class SimulationDialog : public QDialog
 {
@@ -110,6 +111,7 @@ private:
   QCheckBox *mpLaunchAlgorithmicDebuggerCheckBox;
 #if !defined(WITHOUT_OSG)
   QCheckBox *mpLaunchAnimationCheckBox;
+  QCheckBox *mpLiveAnimationCheckBox;
 #endif
   // Interactive Simulation Tab
   QWidget *mpInteractiveSimulationTab;
@@ -204,7 +206,7 @@ public:
   void removeInteractiveSimulation(bool isInteractiveSimulation, QString className, bool closeInteractivePlotWindow);
   void reSimulate(SimulationOptions simulationOptions);
   void showAlgorithmicDebugger(SimulationOptions simulationOptions);
-  void simulationProcessFinished(SimulationOptions simulationOptions, QDateTime resultFileLastModifiedDateTime);
+  void simulationProcessFinished(SimulationOptions simulationOptions, QDateTime resultFileLastModifiedDateTime, AnimationWindow *pLiveAnimationWindow = nullptr);
   bool createOpcUaClient(SimulationOptions simulationOptions, QString *pErrorString);
 public slots:
   void numberOfIntervalsRadioToggled(bool toggle);
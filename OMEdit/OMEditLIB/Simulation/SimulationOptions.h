@@ -70,6 +70,7 @@ public:
     setLaunchTransformationalDebugger(false);
     setLaunchAlgorithmicDebugger(false);
     setSimulateWithAnimation(false);
+    setLiveAnimation(false);
     // Translation
     setMatchingAlgorithm("PFPlusExt");
     setIndexReductionMethod("dynamicStateSelection");
@@ -170,6 +171,8 @@ public:
   bool getLaunchAlgorithmicDebugger() const {return mLaunchAlgorithmicDebugger;}
   void setSimulateWithAnimation(bool simulateWithAnimation) {mSimulateWithAnimation = simulateWithAnimation;}
   bool getSimulateWithAnimation() const {return mSimulateWithAnimation;}
+  void setLiveAnimation(bool liveAnimation) {mLiveAnimation = liveAnimation;}
+  bool getLiveAnimation() const {return mLiveAnimation;}
 
   void setMatchingAlgorithm(const QString &matchingAlgorithm) {mMatchingAlgorithm = matchingAlgorithm;}
   QString getMatchingAlgorithm() const {return mMatchingAlgorithm;}
@@ -245,6 +248,7 @@ public:
   void setResultFileName(const QString &resultFileName) {mResultFileName = resultFileName;}
   QString getResultFileName() const {return mResultFileName;}
   QString getFullResultFileName() const {return mResultFileName.isEmpty() ? getOutputFileName() + "_res." + mOutputFormat : mResultFileName;}
+  QString getLiveResultFileName() const {return getOutputFileName() + "_res.live";}
   void setVariableFilter(const QString &variableFilter) {mVariableFilter = variableFilter;}
   QString getVariableFilter() const {return mVariableFilter.isEmpty() ? ".*" : mVariableFilter;}
   void setProtectedVariables(bool protectedVariables) {mProtectedVariables = protectedVariables;}
@@ -296,6 +300,7 @@ private:
   bool mLaunchTransformationalDebugger;
   bool mLaunchAlgorithmicDebugger;
   bool mSimulateWithAnimation;
+  bool mLiveAnimation;
   // Translation
   QString mMatchingAlgorithm;
   QString mIndexReductionMethod;
@@ -43,6 +43,10 @@
 #include "Editors/TextEditor.h"
 #include "SimulationDialog.h"
 #include "TransformationalDebugger/TransformationsWidget.h"
+#include "Plotting/PlotWindowContainer.h"
+#if !defined(WITHOUT_OSG)
+#include "Animation/VisualizationLive.h"
+#endif
 
 #include <QApplication>
 #include <QObject>
@@ -418,6 +422,9 @@ SimulationOutputWidget::SimulationOutputWidget(SimulationOptions simulationOptio
   mpSimulationProcess = 0;
   setSimulationProcessKilled(false);
   mIsSimulationProcessRunning = false;
+  // poll for the live result file of the simulation
+  mLiveAnimationTimer.setInterval(100);
+  connect(&mLiveAnimationTimer, SIGNAL(timeout()), SLOT(openLiveAnimation()));
 }
 
 /*!
@@ -771,6 +778,13 @@ void SimulationOutputWidget::runSimulationExecutable()
   mpGeneratedFilesTabWidget->setTabEnabled(1, true);
   mpGeneratedFilesTabWidget->setCurrentIndex(1);
   writeSimulationOutput(QString("%1 %2").arg(fileName).arg(args.join(" ")), StringHandler::OMEditInfo, true);
+#if !defined(WITHOUT_OSG)
+  // remove the live result file left by an aborted run so that the animation is only opened once the new simulation has created it
+  if (mSimulationOptions.getLiveAnimation()) {
+    QFile::remove(QString("%1/%2").arg(mSimulationOptions.getWorkingDirectory(), mSimulationOptions.getLiveResultFileName()));
+    mLiveAnimationTimer.start();
+  }
+#endif
   mpSimulationProcess->start(fileName, args);
 }
 
@@ -921,7 +935,12 @@ void SimulationOutputWidget::simulationProcessFinishedHelper()
   mpProgressLabel->setText(progressStr);
   updateMessageTab(progressStr);
   mpCancelButton->setEnabled(false);
+  mLiveAnimationTimer.stop();
+#if !defined(WITHOUT_OSG)
+  MainWindow::instance()->getSimulationDialog()->simulationProcessFinished(mSimulationOptions, mResultFileLastModifiedDateTime, mpLiveAnimationWindow);
+#else
   MainWindow::instance()->getSimulationDialog()->simulationProcessFinished(mSimulationOptions, mResultFileLastModifiedDateTime);
+#endif
   mpArchivedSimulationItem->setStatus(Helper::finished);
   if (mpSimulationOutputHandler) {
     mpSimulationOutputHandler->simulationProcessFinished();
@@ -1224,6 +1243,33 @@ void SimulationOutputWidget::simulationProcessFinished(int exitCode, QProcess::E
   MainWindow::instance()->getSimulationDialog()->stopInteractiveSimulationSampling(mSimulationOptions);
 }
 
+/*!
+ * \brief SimulationOutputWidget::openLiveAnimation
+ * Slot activated when mLiveAnimationTimer timeout signal is raised.\n
+ * Opens the animation of the running simulation once it has created its live result file.
+ */
+void SimulationOutputWidget::openLiveAnimation()
+{
+#if !defined(WITHOUT_OSG)
+  if (!isSimulationProcessRunning()) {
+    return;
+  }
+  QString liveResultFileName = QString("%1/%2").arg(mSimulationOptions.getWorkingDirectory(), mSimulationOptions.getLiveResultFileName());
+  if (!VisualizationLive::isReady(liveResultFileName)) {
+    return;
+  }
+  mLiveAnimationTimer.stop();
+  if (OptionsDialog::instance()->getSimulationPage()->getSwitchToPlottingPerspectiveCheckBox()->isChecked()) {
+    MainWindow::instance()->switchToPlottingPerspectiveSlot();
+  }
+  MainWindow::instance()->getPlotWindowContainer()->addAnimationWindow();
+  mpLiveAnimationWindow = MainWindow::instance()->getPlotWindowContainer()->getCurrentAnimationWindow();
+  if (mpLiveAnimationWindow) {
+    mpLiveAnimationWindow->openAnimationFile(liveResultFileName);
+  }
+#endif
+}
+
 /*!
  * \brief SimulationOutputWidget::openTransformationBrowser
  * Slot activated when a link is clicked from simulation output.\n
@@ -45,6 +45,8 @@
 #include <QProcess>
 #include <QDateTime>
 #include <QTcpServer>
+#include <QTimer>
+#include <QPointer>
 
 class Label;
 class OutputPlainTextEdit;
@@ -52,6 +54,7 @@ class SimulationOutputHandler;
 class SimulationOutputWidget;
 class SimulationMessage;
 class ArchivedSimulationItem;
+class AnimationWindow;
 
 class SimulationOutputTree : public QTreeView
 {
@@ -141,6 +144,10 @@ private:
   bool mIsSimulationProcessKilled;
   bool mIsSimulationProcessRunning;
   QDateTime mResultFileLastModifiedDateTime;
+  QTimer mLiveAnimationTimer;
+#if !defined(WITHOUT_OSG)
+  QPointer<AnimationWindow> mpLiveAnimationWindow;
+#endif
 
   void compileModel();
   void runPostCompilation();
@@ -172,6 +179,7 @@ private slots:
   void readSimulationStandardError();
   void simulationProcessError(QProcess::ProcessError error);
   void simulationProcessFinished(int exitCode, QProcess::ExitStatus exitStatus);
+  void openLiveAnimation();
 public slots:
   void cancelCompilationOrSimulation();
   void openTransformationBrowser(QUrl url);
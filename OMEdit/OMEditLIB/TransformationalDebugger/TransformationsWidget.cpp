@@ -1232,7 +1232,7 @@ void TransformationsWidget::fetchEquationData(int equationIndex)
   QFileInfo fileInfo(fileName);
   if (fileInfo.isRelative()) {
     // find the class
-    LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem(fileName);
+    LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->fetchLibraryTreeItem(fileName);
     if (pLibraryTreeItem) {
       fileName = pLibraryTreeItem->getFileName();
     }
@@ -1378,7 +1378,7 @@ void TransformationsWidget::fetchVariableData(const QModelIndex &index)
   QFileInfo fileInfo(fileName);
   if (fileInfo.isRelative()) {
     // find the class
-    LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem(fileName);
+    LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->fetchLibraryTreeItem(fileName);
     if (pLibraryTreeItem) {
       fileName = pLibraryTreeItem->getFileName();
     }
@@ -65,7 +65,7 @@ QString Helper::omResultFileTypesRegExp = "\\b(mat|plt|csv)\\b";
 QString Helper::txtFileTypes = "TXT Files (*.txt)";
 QString Helper::figaroFileTypes = "Figaro Files (*.fi)";
 QString Helper::jarFileTypes = "Jar Files (*.jar)";
-QString Helper::visualizationFileTypes = "Visualization Files (*.mat *.csv *.fmu);;Visualization MAT(*.mat);;Visualization CSV(*.csv);;Visualization FMU(*.fmu)";
+QString Helper::visualizationFileTypes = "Visualization Files (*.mat *.csv *.fmu *.live);;Visualization MAT(*.mat);;Visualization CSV(*.csv);;Visualization FMU(*.fmu);;Visualization Live Result(*.live)";
 QString Helper::subModelFileTypes = "SubModel Files (*.fmu *.mat *.csv);;SubModel FMU (*.fmu);;SubModel MAT (*.mat);;SubModel CSV (*.csv)";
 int Helper::treeIndentation = 13;
 QSize Helper::iconSize = QSize(20, 20);
@@ -120,7 +120,7 @@ void AutoCompletionTest::getCompletionAnnotationsTest_data()
 
 void AutoCompletionTest::getCompletionSymbolsTest()
 {
-  LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem(mModelName);
+  LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->fetchLibraryTreeItem(mModelName);
   if (!pLibraryTreeItem) {
     QFAIL(QString("Failed to find library tree item for %1").arg(mModelName).toStdString().c_str());
   }
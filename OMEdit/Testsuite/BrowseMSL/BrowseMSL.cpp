@@ -56,14 +56,14 @@ void BrowseMSL::initTestCase()
 
 void BrowseMSL::electricalAnalogBasic()
 {
-  if (!Util::expandLibraryTreeItemParentHierarchy(MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem("Modelica.Electrical.Analog.Basic"))) {
+  if (!Util::expandLibraryTreeItemParentHierarchy(MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->fetchLibraryTreeItem("Modelica.Electrical.Analog.Basic"))) {
     QFAIL("Expanding to Modelica.Electrical.Analog.Basic failed.");
   }
 }
 
 void BrowseMSL::mediaAir()
 {
-  if (!Util::expandLibraryTreeItemParentHierarchy(MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem("Modelica.Media.Air"))) {
+  if (!Util::expandLibraryTreeItemParentHierarchy(MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->fetchLibraryTreeItem("Modelica.Media.Air"))) {
     QFAIL("Expanding to Modelica.Media.Air failed.");
   }
 }
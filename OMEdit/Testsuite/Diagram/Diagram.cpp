@@ -56,7 +56,7 @@ void Diagram::initTestCase()
 
 void Diagram::chuaCircuit()
 {
-  LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem("Modelica.Electrical.Analog.Examples.ChuaCircuit");
+  LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->fetchLibraryTreeItem("Modelica.Electrical.Analog.Examples.ChuaCircuit");
   if (!pLibraryTreeItem) {
     QFAIL("Failed to find Modelica.Electrical.Analog.Examples.ChuaCircuit. Makesure MSL is loaded.");
   }
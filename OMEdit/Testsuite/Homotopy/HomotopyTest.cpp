@@ -70,7 +70,7 @@ void HomotopyTest::cleanupTestCase()
 
 void HomotopyTest::simulate(const QString &className)
 {
-  LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->findLibraryTreeItem(className);
+  LibraryTreeItem *pLibraryTreeItem = MainWindow::instance()->getLibraryWidget()->getLibraryTreeModel()->fetchLibraryTreeItem(className);
   if (!Util::expandLibraryTreeItemParentHierarchy(pLibraryTreeItem)) {
     QFAIL(QString("Expanding to %1 failed.").arg(className).toStdString().c_str());
   }
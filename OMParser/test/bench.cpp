@@ -0,0 +1,340 @@
+//
+//  bench.cpp
+//
+//  Parses all Modelica files in the given files and directory trees in
+//  parallel and reports the throughput, optionally compared with loading the
+//  same files with the ANTLR3 parser of omc.
+//
+//  Usage: bench [-j threads] [--repeat n] [--ll] [--omc path] <file or directory>...
+//
+//  Each thread has its own lexer, token stream and parser which are reused for
+//  all files it parses. The DFA caches of the generated lexer and parser are
+//  static and shared between all threads, so the first pass (cold) also
+//  measures building them and the following passes (warm) show the steady
+//  state throughput.
+//
+//  Files are parsed with SLL prediction first, which is much faster but may
+//  fail on some inputs, and only reparsed with full LL prediction if that
+//  fails. With --ll only LL prediction is used, to measure the difference.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "antlr4-runtime.h"
+#include "modelicaLexer.h"
+#include "modelicaParser.h"
+
+using namespace openmodelica;
+using namespace antlr4;
+
+namespace fs = std::filesystem;
+
+namespace
+{
+  using clock = std::chrono::steady_clock;
+
+  struct Options
+  {
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    int repeat = 3;
+    bool llOnly = false;
+    std::string omc;
+    std::vector<std::string> paths;
+  };
+
+  struct PassResult
+  {
+    double seconds = 0;
+    size_t fallbacks = 0;
+    size_t failedFiles = 0;
+  };
+
+  class CountingErrorListener : public BaseErrorListener
+  {
+    public:
+      void syntaxError(Recognizer*, Token*, size_t, size_t, const std::string&, std::exception_ptr) override
+      {
+        ++errors;
+      }
+
+      size_t errors = 0;
+  };
+
+  // The lexer, token stream and parser of one thread, reused for each file.
+  class Worker
+  {
+    public:
+      Worker()
+        : _input(std::string()), _lexer(&_input), _tokens(&_lexer), _parser(&_tokens)
+      {
+        _lexer.removeErrorListeners();
+        _lexer.addErrorListener(&_errors);
+      }
+
+      // Parses a file, returns false if it has syntax errors.
+      bool parse(const std::string &content, bool llOnly, size_t &fallbacks)
+      {
+        _input.load(content);
+        _lexer.setInputStream(&_input);
+        _tokens.setTokenSource(&_lexer);
+        _errors.errors = 0;
+
+        if (!llOnly) {
+          // Try the fast SLL prediction first, bailing out on the first error
+          // since it can be a false positive of SLL.
+          _parser.setTokenStream(&_tokens);
+          _parser.removeErrorListeners();
+          _parser.setErrorHandler(std::make_shared<BailErrorStrategy>());
+          _parser.getInterpreter<atn::ParserATNSimulator>()->setPredictionMode(atn::PredictionMode::SLL);
+
+          try {
+            _parser.stored_definition();
+            return _errors.errors == 0;
+          } catch (ParseCancellationException&) {
+            ++fallbacks;
+            _tokens.seek(0);
+          }
+        }
+
+        // Full LL prediction with the normal error reporting and recovery.
+        _parser.setTokenStream(&_tokens);
+        _parser.removeErrorListeners();
+        _parser.addErrorListener(&_errors);
+        _parser.setErrorHandler(std::make_shared<DefaultErrorStrategy>());
+        _parser.getInterpreter<atn::ParserATNSimulator>()->setPredictionMode(atn::PredictionMode::LL);
+        _parser.stored_definition();
+
+        return _errors.errors == 0;
+      }
+
+    private:
+      ANTLRInputStream _input;
+      modelicaLexer _lexer;
+      CommonTokenStream _tokens;
+      modelicaParser _parser;
+      CountingErrorListener _errors;
+  };
+
+  void usage(const char *name)
+  {
+    std::cerr << "Usage: " << name << " [-j threads] [--repeat n] [--ll] [--omc path] <file or directory>...\n"
+              << "  -j threads   Number of parser threads (default: number of cores).\n"
+              << "  --repeat n   Number of passes over the files, the first one is cold (default: 3).\n"
+              << "  --ll         Only use full LL prediction instead of SLL with LL fallback.\n"
+              << "  --omc path   Also time loading the files with loadFiles in the given omc.\n";
+  }
+
+  bool parseOptions(int argc, char **argv, Options &opts)
+  {
+    for (int i = 1; i < argc; ++i) {
+      std::string arg = argv[i];
+
+      if (arg == "-j" && i + 1 < argc) {
+        opts.threads = std::max(1, std::atoi(argv[++i]));
+      } else if (arg == "--repeat" && i + 1 < argc) {
+        opts.repeat = std::max(1, std::atoi(argv[++i]));
+      } else if (arg == "--ll") {
+        opts.llOnly = true;
+      } else if (arg == "--omc" && i + 1 < argc) {
+        opts.omc = argv[++i];
+      } else if (!arg.empty() && arg[0] == '-') {
+        return false;
+      } else {
+        opts.paths.push_back(arg);
+      }
+    }
+
+    return !opts.paths.empty();
+  }
+
+  // Collects the .mo files in the given files and directory trees, largest
+  // first so that the big files don't end up last on a single thread.
+  std::vector<fs::path> collectFiles(const std::vector<std::string> &paths)
+  {
+    std::vector<std::pair<uintmax_t, fs::path>> files;
+
+    for (auto &p: paths) {
+      if (fs::is_directory(p)) {
+        for (auto &entry: fs::recursive_directory_iterator(p)) {
+          if (entry.is_regular_file() && entry.path().extension() == ".mo") {
+            files.emplace_back(entry.file_size(), entry.path());
+          }
+        }
+      } else if (fs::is_regular_file(p)) {
+        files.emplace_back(fs::file_size(p), p);
+      } else {
+        std::cerr << "Warning: " << p << " is not a file or directory, ignoring it.\n";
+      }
+    }
+
+    std::stable_sort(files.begin(), files.end(), [] (auto &f1, auto &f2) { return f1.first > f2.first; });
+
+    std::vector<fs::path> res;
+    for (auto &f: files) res.push_back(std::move(f.second));
+    return res;
+  }
+
+  std::string readFile(const fs::path &path)
+  {
+    std::ifstream is(path, std::ios::binary);
+    std::ostringstream ss;
+    ss << is.rdbuf();
+    return ss.str();
+  }
+
+  // Parses all the files on the given number of threads. The files are
+  // already in memory so only the lexing and parsing is timed.
+  PassResult parseAll(const std::vector<std::string> &contents, unsigned threadCount, bool llOnly,
+                      std::vector<char> &failed)
+  {
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> fallbacks{0};
+    std::vector<std::thread> threads;
+
+    auto start = clock::now();
+
+    for (unsigned t = 0; t < threadCount; ++t) {
+      threads.emplace_back([&] {
+        Worker worker;
+        size_t local_fallbacks = 0;
+
+        for (size_t i = next++; i < contents.size(); i = next++) {
+          failed[i] = !worker.parse(contents[i], llOnly, local_fallbacks);
+        }
+
+        fallbacks += local_fallbacks;
+      });
+    }
+
+    for (auto &t: threads) t.join();
+
+    PassResult res;
+    res.seconds = std::chrono::duration<double>(clock::now() - start).count();
+    res.fallbacks = fallbacks;
+    res.failedFiles = std::count(failed.begin(), failed.end(), 1);
+    return res;
+  }
+
+  // Times loading the files with loadFiles in omc, which uses the ANTLR3
+  // parser and parses the files in parallel with the given number of threads.
+  // Returns a negative number if omc couldn't be run.
+  double timeOmc(const std::string &omc, const std::vector<fs::path> &files, unsigned threadCount)
+  {
+    auto script = fs::temp_directory_path() / "omparser-bench.mos";
+
+    {
+      std::ofstream os(script);
+      os << "timerTick(1);\nloadFiles({";
+
+      for (size_t i = 0; i < files.size(); ++i) {
+        if (i > 0) os << ",\n";
+        os << '"';
+        for (auto c: fs::absolute(files[i]).string()) {
+          if (c == '"' || c == '\\') os << '\\';
+          os << c;
+        }
+        os << '"';
+      }
+
+      os << "}, numThreads=" << threadCount << ", uses=false, notify=false);\n"
+         << "print(\"omparser-bench: \" + String(timerTock(1)) + \"\\n\");\n";
+    }
+
+    std::string cmd = "\"" + omc + "\" \"" + script.string() + "\"";
+    double seconds = -1;
+
+    if (auto pipe = popen(cmd.c_str(), "r")) {
+      char line[4096];
+      while (fgets(line, sizeof(line), pipe)) {
+        std::sscanf(line, "omparser-bench: %lf", &seconds);
+      }
+      pclose(pipe);
+    }
+
+    fs::remove(script);
+    return seconds;
+  }
+
+  void report(const std::string &name, double seconds, size_t fileCount, double megabytes)
+  {
+    std::printf("%-22s %9.3f s %10.1f files/s %8.2f MB/s\n", name.c_str(), seconds,
+                fileCount / seconds, megabytes / seconds);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  Options opts;
+
+  if (!parseOptions(argc, argv, opts)) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  auto files = collectFiles(opts.paths);
+
+  if (files.empty()) {
+    std::cerr << "No .mo files found.\n";
+    return 1;
+  }
+
+  std::vector<std::string> contents;
+  size_t bytes = 0;
+  for (auto &f: files) {
+    contents.push_back(readFile(f));
+    bytes += contents.back().size();
+  }
+  double megabytes = bytes / (1024.0 * 1024.0);
+
+  std::printf("%zu files, %.2f MB, %u threads, %s prediction\n", files.size(), megabytes,
+              opts.threads, opts.llOnly ? "LL" : "SLL with LL fallback");
+
+  std::vector<char> failed(files.size());
+  PassResult best;
+
+  for (int pass = 1; pass <= opts.repeat; ++pass) {
+    auto res = parseAll(contents, opts.threads, opts.llOnly, failed);
+    report(pass == 1 ? "ANTLR4 pass 1 (cold)" : "ANTLR4 pass " + std::to_string(pass), res.seconds, files.size(), megabytes);
+
+    if (pass == 1 || res.seconds < best.seconds) best = res;
+  }
+
+  if (opts.repeat > 1) {
+    report("ANTLR4 best", best.seconds, files.size(), megabytes);
+  }
+
+  if (!opts.llOnly) {
+    std::printf("%zu files needed the LL fallback\n", best.fallbacks);
+  }
+
+  if (best.failedFiles > 0) {
+    std::printf("%zu files have syntax errors:\n", best.failedFiles);
+    for (size_t i = 0; i < files.size(); ++i) {
+      if (failed[i]) std::printf("  %s\n", files[i].string().c_str());
+    }
+  }
+
+  if (!opts.omc.empty()) {
+    auto seconds = timeOmc(opts.omc, files, opts.threads);
+
+    if (seconds < 0) {
+      std::cerr << "Failed to run " << opts.omc << '\n';
+      return 1;
+    }
+
+    report("omc loadFiles (ANTLR3)", seconds, files.size(), megabytes);
+  }
+
+  return best.failedFiles > 0 ? 2 : 0;
+}
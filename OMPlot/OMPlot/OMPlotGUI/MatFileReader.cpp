@@ -0,0 +1,199 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#include "MatFileReader.h"
+#include "util/omc_file.h"
+
+#include <QElapsedTimer>
+
+#include <cstdlib>
+#include <cstring>
+
+using namespace OMPlot;
+
+/* Number of rows of the preview, about one per pixel of a wide plot. */
+static const uint32_t PREVIEW_ROWS = 2048;
+/* Number of bytes read at once when all rows are read. */
+static const size_t CHUNK_BYTES = 4 * 1024 * 1024;
+/* Minimum time in ms between two rowsRead signals, each of them copies all rows read so far into the curves. */
+static const qint64 PUBLISH_INTERVAL = 250;
+
+/*!
+ * \brief MatFileReader::MatFileReader
+ * \param pReader - the opened mat file. It must not be used by others until the thread has finished.
+ * \param indexes - the indexes of the variables to read as in ModelicaMatVariable_t, negative for negated aliases.
+ * \param pParent
+ */
+MatFileReader::MatFileReader(ModelicaMatReader *pReader, const QVector<int> &indexes, QObject *pParent)
+  : QThread(pParent), mpReader(pReader), mIndexes(indexes), mRowsRead(0), mError(false)
+{
+}
+
+/*!
+ * \brief elementValue
+ * Returns the value of an element of the data_2 block.
+ * \param pElement
+ * \param doublePrecision
+ * \param negate
+ * \return
+ */
+static double elementValue(const char *pElement, bool doublePrecision, bool negate)
+{
+  double value;
+  if (doublePrecision) {
+    memcpy(&value, pElement, sizeof(double));
+  } else {
+    float floatValue;
+    memcpy(&floatValue, pElement, sizeof(float));
+    value = floatValue;
+  }
+  return negate ? -value : value;
+}
+
+/*!
+ * \brief MatFileReader::readPreview
+ * Reads every n-th row and the last one, only the elements of the requested variables.
+ * \return false if the file is corrupt.
+ */
+bool MatFileReader::readPreview()
+{
+  const uint32_t nrows = mpReader->nrows;
+  const uint32_t stride = nrows / PREVIEW_ROWS;
+  if (stride < 2) {
+    return true;
+  }
+  for (uint32_t row = 0 ; row < nrows ; row += stride) {
+    mPreviewRows.append(row);
+  }
+  if (mPreviewRows.last() != nrows - 1) {
+    mPreviewRows.append(nrows - 1);
+  }
+
+  const size_t elementSize = mpReader->doublePrecision == 1 ? sizeof(double) : sizeof(float);
+  char element[sizeof(double)];
+  mPreviewValues.resize((size_t)mIndexes.size() * mPreviewRows.size());
+  for (int i = 0 ; i < mPreviewRows.size() ; i++) {
+    for (int column = 0 ; column < mIndexes.size() ; column++) {
+      const int index = mIndexes.at(column);
+      omc_fseek(mpReader->file, mpReader->var_offset + elementSize * ((size_t)mPreviewRows.at(i) * mpReader->nvar + abs(index) - 1), SEEK_SET);
+      if (1 != omc_fread(element, elementSize, 1, mpReader->file, 0)) {
+        return false;
+      }
+      mPreviewValues[(size_t)column * mPreviewRows.size() + i] = elementValue(element, mpReader->doublePrecision == 1, index < 0);
+    }
+  }
+  return true;
+}
+
+/*!
+ * \brief MatFileReader::readRows
+ * Reads the rows [from, to) of the requested variables.
+ * Whole rows are read at once unless the rows are so wide that most of each one would be skipped.
+ * \param from
+ * \param to
+ * \param buffer - reused between the calls.
+ * \return false if the file is corrupt.
+ */
+bool MatFileReader::readRows(uint32_t from, uint32_t to, std::vector<char> &buffer)
+{
+  const uint32_t nrows = mpReader->nrows;
+  const size_t elementSize = mpReader->doublePrecision == 1 ? sizeof(double) : sizeof(float);
+  const size_t rowSize = elementSize * mpReader->nvar;
+
+  if (rowSize > 4096 * (size_t)mIndexes.size()) {
+    char element[sizeof(double)];
+    for (uint32_t row = from ; row < to ; row++) {
+      for (int column = 0 ; column < mIndexes.size() ; column++) {
+        const int index = mIndexes.at(column);
+        omc_fseek(mpReader->file, mpReader->var_offset + rowSize * row + elementSize * (abs(index) - 1), SEEK_SET);
+        if (1 != omc_fread(element, elementSize, 1, mpReader->file, 0)) {
+          return false;
+        }
+        mValues[(size_t)column * nrows + row] = elementValue(element, mpReader->doublePrecision == 1, index < 0);
+      }
+    }
+    return true;
+  }
+
+  buffer.resize(rowSize * (to - from));
+  omc_fseek(mpReader->file, mpReader->var_offset + rowSize * from, SEEK_SET);
+  if ((size_t)(to - from) * mpReader->nvar != omc_fread(buffer.data(), elementSize, (size_t)(to - from) * mpReader->nvar, mpReader->file, 0)) {
+    return false;
+  }
+  for (int column = 0 ; column < mIndexes.size() ; column++) {
+    const int index = mIndexes.at(column);
+    const char *pElement = buffer.data() + elementSize * (abs(index) - 1);
+    double *pValue = mValues.data() + (size_t)column * nrows + from;
+    for (uint32_t row = from ; row < to ; row++, pElement += rowSize) {
+      *pValue++ = elementValue(pElement, mpReader->doublePrecision == 1, index < 0);
+    }
+  }
+  return true;
+}
+
+/*!
+ * \brief MatFileReader::run
+ * Reimplentation of QThread::run().
+ * Reads the preview and then all rows of the requested variables.
+ * Emits previewRead once the preview is read and rowsRead at most every PUBLISH_INTERVAL while reading the rows.
+ * The thread has read all rows when it has finished without an error.
+ */
+void MatFileReader::run()
+{
+  const uint32_t nrows = mpReader->nrows;
+  if (!readPreview()) {
+    mError = true;
+    return;
+  }
+  if (!mPreviewRows.isEmpty()) {
+    emit previewRead();
+  }
+
+  const size_t rowSize = (mpReader->doublePrecision == 1 ? sizeof(double) : sizeof(float)) * mpReader->nvar;
+  const uint32_t chunkRows = (uint32_t)qMax((size_t)1, CHUNK_BYTES / qMax((size_t)1, rowSize));
+  std::vector<char> buffer;
+  QElapsedTimer timer;
+  timer.start();
+  mValues.resize((size_t)mIndexes.size() * nrows);
+  for (uint32_t from = 0 ; from < nrows ; from += chunkRows) {
+    const uint32_t to = qMin(nrows, from + chunkRows);
+    if (!readRows(from, to, buffer)) {
+      mError = true;
+      return;
+    }
+    // the rows below mRowsRead are not written again, so the GUI thread can read them
+    mRowsRead.storeRelease((int)to);
+    if (to < nrows && timer.elapsed() >= PUBLISH_INTERVAL) {
+      emit rowsRead();
+      timer.restart();
+    }
+  }
+}
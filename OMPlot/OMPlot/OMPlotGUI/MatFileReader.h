@@ -0,0 +1,80 @@
+/*
+ * This file is part of OpenModelica.
+ *
+ * Copyright (c) 1998-CurrentYear, Open Source Modelica Consortium (OSMC),
+ * c/o Linköpings universitet, Department of Computer and Information Science,
+ * SE-58183 Linköping, Sweden.
+ *
+ * All rights reserved.
+ *
+ * THIS PROGRAM IS PROVIDED UNDER THE TERMS OF GPL VERSION 3 LICENSE OR
+ * THIS OSMC PUBLIC LICENSE (OSMC-PL) VERSION 1.2.
+ * ANY USE, REPRODUCTION OR DISTRIBUTION OF THIS PROGRAM CONSTITUTES
+ * RECIPIENT'S ACCEPTANCE OF THE OSMC PUBLIC LICENSE OR THE GPL VERSION 3,
+ * ACCORDING TO RECIPIENTS CHOICE.
+ *
+ * The OpenModelica software and the Open Source Modelica
+ * Consortium (OSMC) Public License (OSMC-PL) are obtained
+ * from OSMC, either from the above address,
+ * from the URLs: http://www.ida.liu.se/projects/OpenModelica or
+ * http://www.openmodelica.org, and in the OpenModelica distribution.
+ * GNU version 3 is obtained from: http://www.gnu.org/copyleft/gpl.html.
+ *
+ * This program is distributed WITHOUT ANY WARRANTY; without
+ * even the implied warranty of  MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE, EXCEPT AS EXPRESSLY SET FORTH
+ * IN THE BY RECIPIENT SELECTED SUBSIDIARY LICENSE CONDITIONS OF OSMC-PL.
+ *
+ * See the full OSMC Public License conditions for more details.
+ *
+ */
+
+#ifndef MATFILEREADER_H
+#define MATFILEREADER_H
+
+#include "util/read_matlab4.h"
+
+#include <QThread>
+#include <QAtomicInt>
+#include <QVector>
+
+#include <vector>
+
+namespace OMPlot
+{
+/* Reads the values of some variables of a mat result file in a thread.
+ * A preview with every n-th row is read first so the curves can be drawn over the whole time range right away,
+ * then all rows are read from the start and published in chunks.
+ */
+class MatFileReader : public QThread
+{
+  Q_OBJECT
+public:
+  MatFileReader(ModelicaMatReader *pReader, const QVector<int> &indexes, QObject *pParent = 0);
+  int getColumnCount() const {return mIndexes.size();}
+  int getPreviewRowCount() const {return mPreviewRows.size();}
+  uint32_t getPreviewRow(int i) const {return mPreviewRows.at(i);}
+  double getPreviewValue(int column, int i) const {return mPreviewValues.at((size_t)column * mPreviewRows.size() + i);}
+  uint32_t getRowsRead() const {return (uint32_t)mRowsRead.loadAcquire();}
+  double getValue(int column, uint32_t row) const {return mValues.at((size_t)column * mpReader->nrows + row);}
+  bool hasError() const {return mError;}
+protected:
+  virtual void run() override;
+private:
+  ModelicaMatReader *mpReader;
+  QVector<int> mIndexes;
+  QVector<uint32_t> mPreviewRows;
+  std::vector<double> mPreviewValues;
+  std::vector<double> mValues;
+  QAtomicInt mRowsRead;
+  bool mError;
+
+  bool readPreview();
+  bool readRows(uint32_t from, uint32_t to, std::vector<char> &buffer);
+signals:
+  void previewRead();
+  void rowsRead();
+};
+}
+
+#endif // MATFILEREADER_H
@@ -26,6 +26,7 @@ SOURCES += Plot.cpp \
   PlotPicker.cpp \
   PlotGrid.cpp \
   PlotCurve.cpp \
+  MatFileReader.cpp \
   PlotWindow.cpp \
   PlotApplication.cpp \
   PlotWindowContainer.cpp \
@@ -41,6 +42,7 @@ HEADERS  += OMPlot.h \
   PlotPicker.h \
   PlotGrid.h \
   PlotCurve.h \
+  MatFileReader.h \
   PlotWindow.h \
   PlotApplication.h \
   PlotWindowContainer.h \
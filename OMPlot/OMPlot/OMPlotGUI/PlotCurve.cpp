@@ -36,15 +36,25 @@
 #include "qwt_text.h"
 #include "qwt_scale_map.h"
 #include "qwt_math.h"
+#include "qwt_painter.h"
+#include "qwt_clipper.h"
 
 #include <QtMath>
 #include <QStringBuilder>
+#include <QPaintDevice>
+
+#include <algorithm>
 
 using namespace OMPlot;
 
+/* Curves with fewer samples are drawn as they are. */
+static const size_t LEVEL_OF_DETAIL_MIN_SAMPLES = 65536;
+/* Number of samples in a bucket of the finest level of the decimation pyramid. */
+static const int LEVEL_OF_DETAIL_MIN_BUCKET_SIZE = 8;
+
 PlotCurve::PlotCurve(const QString &fileName, const QString &absoluteFilePath, const QString &xVariableName, const QString &xUnit, const QString &xDisplayUnit,
                      const QString &yVariableName, const QString &yUnit, const QString &yDisplayUnit, Plot *pParent)
-  : mCustomColor(false)
+  : mCustomColor(false), mpLevelsOfDetailData(0), mLevelsOfDetailSize(0), mLevelsOfDetailValid(false)
 {
   mpParentPlot = pParent;
   mXVariable = xVariableName;
@@ -350,6 +360,7 @@ void PlotCurve::plotData(bool toggleSign)
       resetPrefixUnit(true);
     }
   }
+  invalidateLevelsOfDetail();
   setSamples(mXAxisVector, mYAxisVector);
 }
 
@@ -389,6 +400,50 @@ int PlotCurve::closestPoint(const QPointF &pos, double *dist) const
   int index = -1;
   double dmin = 1.0e10;
 
+  const QwtPointArrayData<double> *pData = levelOfDetailData();
+  if (pData) {
+    /* The samples of huge curves are sorted by x.
+     * Search outwards from the mouse position and stop in each direction once the x distance alone exceeds the closest distance found so far.
+     */
+    const QVector<double> &xData = pData->xData();
+    const QVector<double> &yData = pData->yData();
+    const int n = xData.size();
+    int right = std::lower_bound(xData.constBegin(), xData.constEnd(), xMap.invTransform(pos.x())) - xData.constBegin();
+    int left = right - 1;
+    while (left >= 0 || right < n) {
+      if (right < n) {
+        const double cx = xMap.transform(xData.at(right)) - pos.x();
+        if (index == -1 || qwtSqr(cx) < dmin) {
+          const double f = qwtSqr(cx) + qwtSqr(yMap.transform(yData.at(right)) - pos.y());
+          if (index == -1 || f < dmin) {
+            index = right;
+            dmin = f;
+          }
+          right++;
+        } else {
+          right = n;
+        }
+      }
+      if (left >= 0) {
+        const double cx = xMap.transform(xData.at(left)) - pos.x();
+        if (qwtSqr(cx) < dmin) {
+          const double f = qwtSqr(cx) + qwtSqr(yMap.transform(yData.at(left)) - pos.y());
+          if (f < dmin) {
+            index = left;
+            dmin = f;
+          }
+          left--;
+        } else {
+          left = -1;
+        }
+      }
+    }
+    if (dist) {
+      *dist = qSqrt(dmin);
+    }
+    return index;
+  }
+
   for (uint i = 0; i < numSamples; i++) {
     const QPointF sample = series->sample( i );
 
@@ -435,3 +490,221 @@ QRectF PlotCurve::boundingRect() const
   }
   return existingBoundingRect;
 }
+
+/*!
+ * \brief PlotCurve::invalidateLevelsOfDetail
+ * Drops the decimation pyramid. It is rebuilt on the next redraw.
+ */
+void PlotCurve::invalidateLevelsOfDetail()
+{
+  mpLevelsOfDetailData = 0;
+  mLevelsOfDetailSize = 0;
+  mLevelsOfDetailValid = false;
+  mLevelsOfDetail.clear();
+}
+
+/*!
+ * \brief PlotCurve::levelOfDetailData
+ * Returns the samples of the curve if it is huge enough to be decimated, otherwise 0.
+ * Builds the min/max decimation pyramid on first use.
+ * Each level halves the number of buckets of the previous one so the pyramid needs about 2 bytes per sample.
+ * Only curves with samples sorted by x, i.e., no parametric plots, are decimated.
+ * \return
+ */
+const QwtPointArrayData<double>* PlotCurve::levelOfDetailData() const
+{
+  const QwtPointArrayData<double> *pData = dynamic_cast<const QwtPointArrayData<double>*>(data());
+  if (!pData || pData->size() < LEVEL_OF_DETAIL_MIN_SAMPLES) {
+    return 0;
+  }
+  if (pData == mpLevelsOfDetailData && pData->size() == mLevelsOfDetailSize) {
+    return mLevelsOfDetailValid ? pData : 0;
+  }
+
+  mpLevelsOfDetailData = pData;
+  mLevelsOfDetailSize = pData->size();
+  mLevelsOfDetailValid = false;
+  mLevelsOfDetail.clear();
+
+  const QVector<double> &xData = pData->xData();
+  const QVector<double> &yData = pData->yData();
+  const int n = xData.size();
+  for (int i = 1 ; i < n ; i++) {
+    if (!(xData.at(i) >= xData.at(i - 1))) {
+      return 0;
+    }
+  }
+
+  LevelOfDetail level;
+  level.mBucketSize = LEVEL_OF_DETAIL_MIN_BUCKET_SIZE;
+  int buckets = n / level.mBucketSize;
+  level.mMinIndex.resize(buckets);
+  level.mMaxIndex.resize(buckets);
+  for (int b = 0 ; b < buckets ; b++) {
+    const int first = b * level.mBucketSize;
+    int minIndex = first;
+    int maxIndex = first;
+    for (int i = first + 1 ; i < first + level.mBucketSize ; i++) {
+      if (yData.at(i) < yData.at(minIndex)) {
+        minIndex = i;
+      }
+      if (yData.at(i) > yData.at(maxIndex)) {
+        maxIndex = i;
+      }
+    }
+    level.mMinIndex[b] = minIndex;
+    level.mMaxIndex[b] = maxIndex;
+  }
+  mLevelsOfDetail.append(level);
+
+  // each coarser level merges two buckets of the finer one
+  while (mLevelsOfDetail.last().mMinIndex.size() >= 2) {
+    const LevelOfDetail &finer = mLevelsOfDetail.last();
+    LevelOfDetail coarser;
+    coarser.mBucketSize = 2 * finer.mBucketSize;
+    buckets = finer.mMinIndex.size() / 2;
+    coarser.mMinIndex.resize(buckets);
+    coarser.mMaxIndex.resize(buckets);
+    for (int b = 0 ; b < buckets ; b++) {
+      const int minA = finer.mMinIndex.at(2 * b), minB = finer.mMinIndex.at(2 * b + 1);
+      const int maxA = finer.mMaxIndex.at(2 * b), maxB = finer.mMaxIndex.at(2 * b + 1);
+      coarser.mMinIndex[b] = yData.at(minB) < yData.at(minA) ? minB : minA;
+      coarser.mMaxIndex[b] = yData.at(maxB) > yData.at(maxA) ? maxB : maxA;
+    }
+    mLevelsOfDetail.append(coarser);
+  }
+
+  mLevelsOfDetailValid = true;
+  return pData;
+}
+
+/*!
+ * \brief appendMinMaxIndexes
+ * Appends the indexes of the minimum and maximum y value in [from, to] in the order they appear.
+ * \param yData
+ * \param from
+ * \param to
+ * \param indexes
+ */
+static void appendMinMaxIndexes(const QVector<double> &yData, int from, int to, QVector<int> &indexes)
+{
+  if (from > to) {
+    return;
+  }
+  int minIndex = from;
+  int maxIndex = from;
+  for (int i = from + 1 ; i <= to ; i++) {
+    if (yData.at(i) < yData.at(minIndex)) {
+      minIndex = i;
+    }
+    if (yData.at(i) > yData.at(maxIndex)) {
+      maxIndex = i;
+    }
+  }
+  indexes.append(qMin(minIndex, maxIndex));
+  if (minIndex != maxIndex) {
+    indexes.append(qMax(minIndex, maxIndex));
+  }
+}
+
+/*!
+ * \brief PlotCurve::decimateSamples
+ * Collects the indexes of the samples in [from, to] that are needed to draw them on the given number of pixels.
+ * Uses the coarsest pyramid level that still has at least one bucket per pixel and keeps the minimum and maximum of each bucket,
+ * so the drawn envelope is the same as with all samples while at most 4 points per pixel are drawn.
+ * \param pData
+ * \param from
+ * \param to
+ * \param pixels
+ * \param indexes
+ */
+void PlotCurve::decimateSamples(const QwtPointArrayData<double> *pData, int from, int to, int pixels, QVector<int> &indexes) const
+{
+  const int count = to - from + 1;
+  int level = -1;
+  for (int l = 0 ; l < mLevelsOfDetail.size() && (qint64)mLevelsOfDetail.at(l).mBucketSize * pixels <= count ; l++) {
+    level = l;
+  }
+
+  if (level < 0) {
+    indexes.reserve(count);
+    for (int i = from ; i <= to ; i++) {
+      indexes.append(i);
+    }
+    return;
+  }
+
+  const QVector<double> &yData = pData->yData();
+  const LevelOfDetail &lod = mLevelsOfDetail.at(level);
+  // full buckets strictly between from and to, so the end points are not added twice
+  const int firstBucket = from / lod.mBucketSize + 1;
+  const int lastBucket = qMax(firstBucket, qMin(to / lod.mBucketSize, int(lod.mMinIndex.size())));
+  indexes.reserve(2 * (lastBucket - firstBucket) + 6);
+  indexes.append(from);
+  // the partially covered buckets at both ends are scanned directly
+  appendMinMaxIndexes(yData, from + 1, qMin(firstBucket * lod.mBucketSize, to) - 1, indexes);
+  for (int b = firstBucket ; b < lastBucket ; b++) {
+    const int minIndex = lod.mMinIndex.at(b);
+    const int maxIndex = lod.mMaxIndex.at(b);
+    indexes.append(qMin(minIndex, maxIndex));
+    if (minIndex != maxIndex) {
+      indexes.append(qMax(minIndex, maxIndex));
+    }
+  }
+  appendMinMaxIndexes(yData, qMax(lastBucket * lod.mBucketSize, from + 1), to - 1, indexes);
+  if (to > from) {
+    indexes.append(to);
+  }
+}
+
+/*!
+ * \brief PlotCurve::drawLines
+ * Reimplentation of QwtPlotCurve::drawLines()
+ * Huge curves are drawn from the min/max decimation pyramid so a redraw only touches the visible samples and at most a few points per pixel.
+ * \param painter
+ * \param xMap
+ * \param yMap
+ * \param canvasRect
+ * \param from
+ * \param to
+ */
+void PlotCurve::drawLines(QPainter *painter, const QwtScaleMap &xMap, const QwtScaleMap &yMap, const QRectF &canvasRect, int from, int to) const
+{
+  const QwtPointArrayData<double> *pData = 0;
+  // fitted and filled curves are drawn as usual
+  if (!testCurveAttribute(QwtPlotCurve::Fitted) && brush().style() == Qt::NoBrush) {
+    pData = levelOfDetailData();
+  }
+  if (!pData) {
+    QwtPlotCurve::drawLines(painter, xMap, yMap, canvasRect, from, to);
+    return;
+  }
+
+  const QVector<double> &xData = pData->xData();
+  const QVector<double> &yData = pData->yData();
+  // only the visible samples and one more on each side are drawn
+  const double xMin = qMin(xMap.s1(), xMap.s2());
+  const double xMax = qMax(xMap.s1(), xMap.s2());
+  from = qMax(from, int(std::lower_bound(xData.constBegin() + from, xData.constBegin() + to + 1, xMin) - xData.constBegin()) - 1);
+  to = qMin(to, int(std::upper_bound(xData.constBegin() + from, xData.constBegin() + to + 1, xMax) - xData.constBegin()));
+  if (from > to) {
+    return;
+  }
+
+  qreal pixelRatio = 1.0;
+  if (painter->device()) {
+    pixelRatio = painter->device()->devicePixelRatioF();
+  }
+  QVector<int> indexes;
+  decimateSamples(pData, from, to, qMax(1, qCeil(canvasRect.width() * pixelRatio)), indexes);
+
+  QPolygonF polyline(indexes.size());
+  for (int i = 0 ; i < indexes.size() ; i++) {
+    polyline[i] = QPointF(xMap.transform(xData.at(indexes.at(i))), yMap.transform(yData.at(indexes.at(i))));
+  }
+  if (testPaintAttribute(QwtPlotCurve::ClipPolygons)) {
+    const qreal penWidth = QwtPainter::effectivePenWidth(painter->pen());
+    QwtClipper::clipPolygonF(canvasRect.adjusted(-penWidth, -penWidth, penWidth, penWidth), polyline, false);
+  }
+  QwtPainter::drawPolyline(painter, polyline);
+}
@@ -36,6 +36,7 @@
 
 #include "qwt_plot_directpainter.h"
 #include "qwt_plot_marker.h"
+#include "qwt_point_data.h"
 
 namespace OMPlot
 {
@@ -64,6 +65,23 @@ private:
   Plot *mpParentPlot;
   QwtPlotDirectPainter *mpPlotDirectPainter;
   QwtPlotMarker *mpPointMarker;
+
+  /* One level of the min/max decimation pyramid.
+   * Holds for each bucket of mBucketSize consecutive samples the index of its minimum and maximum y value.
+   */
+  struct LevelOfDetail {
+    int mBucketSize;
+    QVector<int> mMinIndex;
+    QVector<int> mMaxIndex;
+  };
+  // the pyramid is built lazily on the first redraw of a huge curve and dropped when the samples change.
+  mutable QVector<LevelOfDetail> mLevelsOfDetail;
+  mutable const QwtSeriesData<QPointF> *mpLevelsOfDetailData;
+  mutable size_t mLevelsOfDetailSize;
+  mutable bool mLevelsOfDetailValid;
+
+  const QwtPointArrayData<double>* levelOfDetailData() const;
+  void decimateSamples(const QwtPointArrayData<double> *pData, int from, int to, int pixels, QVector<int> &indexes) const;
 public:
   PlotCurve(const QString &fileName, const QString &absoluteFilePath, const QString &xVariableName, const QString &xUnit, const QString &xDisplayUnit,
             const QString &yVariableName, const QString &yUnit, const QString &yDisplayUnit, Plot *pParent);
@@ -123,6 +141,9 @@ public:
   virtual void updateLegend(QwtLegend *legend) const;
 #endif
   virtual int closestPoint(const QPointF &pos, double *dist = NULL) const override;
+  void invalidateLevelsOfDetail();
+protected:
+  virtual void drawLines(QPainter *painter, const QwtScaleMap &xMap, const QwtScaleMap &yMap, const QRectF &canvasRect, int from, int to) const override;
 
   // QwtPlotItem interface
 public:
@@ -36,6 +36,7 @@
 #include "util/read_csv.h"
 #include "util/read_matlab4.h"
 #include "PlotCurve.h"
+#include "MatFileReader.h"
 #include "PlotPicker.h"
 #include "Legend.h"
 #include "PlotPanner.h"
@@ -66,9 +67,13 @@
 #include <QStack>
 #include <QLineEdit>
 #include <QColorDialog>
+#include <QEventLoop>
 
 using namespace OMPlot;
 
+/* Mat files with fewer rows are read on the GUI thread. */
+static const uint32_t BACKGROUND_LOAD_MIN_ROWS = 65536;
+
 PlotWindow::PlotWindow(QStringList arguments, QWidget *parent, bool isInteractiveSimulation, int toolbarIconSize)
   : QMainWindow(parent), mIsInteractiveSimulation(isInteractiveSimulation)
 {
@@ -611,12 +616,21 @@ void PlotWindow::plot(PlotCurve *pPlotCurve)
 
     double startTime = omc_matlab4_startTime(&reader);
     double stopTime =  omc_matlab4_stopTime(&reader);
-    //Read in timevector
-    double *timeVals = omc_matlab4_read_vals(&reader,1);
-    if (!timeVals) {
-      omc_free_matlab4_reader(&reader);
-      throw NoVariableException(QString("Corrupt file. nvar %1").arg(reader.nvar).toStdString().c_str());
+    // huge files are read in a thread, see below
+    const bool readInThread = reader.nrows >= BACKGROUND_LOAD_MIN_ROWS;
+    double *timeVals = 0;
+    if (!readInThread) {
+      //Read in timevector
+      timeVals = omc_matlab4_read_vals(&reader,1);
+      if (!timeVals) {
+        omc_free_matlab4_reader(&reader);
+        throw NoVariableException(QString("Corrupt file. nvar %1").arg(reader.nvar).toStdString().c_str());
+      }
     }
+    // the curves and variable indexes to read in the thread, time first
+    QList<PlotCurve*> curves;
+    QVector<int> indexes;
+    indexes.append(1);
     // read in all values
     for (uint32_t i = 0; i < reader.nall; i++) {
       if (mVariablesList.contains(reader.allInfo[i].name) || isPlotAll()) {
@@ -637,7 +651,10 @@ void PlotWindow::plot(PlotCurve *pPlotCurve)
         pPlotCurve->clearXAxisVector();
         pPlotCurve->clearYAxisVector();
         // if variable is not a parameter then
-        if (!var->isParam) {
+        if (!var->isParam && readInThread) {
+          curves.append(pPlotCurve);
+          indexes.append(var->index);
+        } else if (!var->isParam) {
           double *vals = omc_matlab4_read_vals(&reader,var->index);
           if (!vals) {
             omc_free_matlab4_reader(&reader);
@@ -668,6 +685,25 @@ void PlotWindow::plot(PlotCurve *pPlotCurve)
         }
       }
     }
+    /* Read the variables of huge files in a thread so the GUI is not frozen.
+     * The curves are drawn from a preview of the whole time range first and refined as the rows are read.
+     * User input is held back until the file is read, so the plot window stays as it is and plot() returns complete curves.
+     */
+    if (!curves.isEmpty()) {
+      MatFileReader matFileReader(&reader, indexes);
+      QEventLoop eventLoop;
+      connect(&matFileReader, &MatFileReader::previewRead, this, [&]() {setMatFileSamples(&matFileReader, curves);});
+      connect(&matFileReader, &MatFileReader::rowsRead, this, [&]() {setMatFileSamples(&matFileReader, curves);});
+      connect(&matFileReader, &QThread::finished, &eventLoop, &QEventLoop::quit);
+      matFileReader.start();
+      eventLoop.exec(QEventLoop::ExcludeUserInputEvents);
+      matFileReader.wait();
+      if (matFileReader.hasError()) {
+        omc_free_matlab4_reader(&reader);
+        throw NoVariableException(QString("Corrupt file. nvar %1").arg(reader.nvar).toStdString().c_str());
+      }
+      setMatFileSamples(&matFileReader, curves);
+    }
     // if plottype is PLOT then check which requested variables are not found in the file
     if (isPlot())
       checkForErrors(mVariablesList, variablesPlotted);
@@ -676,6 +712,40 @@ void PlotWindow::plot(PlotCurve *pPlotCurve)
   }
 }
 
+/*!
+ * \brief PlotWindow::setMatFileSamples
+ * Sets the samples of the curves to the rows read so far, followed by the preview rows after them.
+ * \param pMatFileReader
+ * \param curves - the curves of the variables read by pMatFileReader, in the same order.
+ */
+void PlotWindow::setMatFileSamples(MatFileReader *pMatFileReader, const QList<PlotCurve*> &curves)
+{
+  const uint32_t rowsRead = pMatFileReader->getRowsRead();
+  int firstPreviewRow = 0;
+  while (firstPreviewRow < pMatFileReader->getPreviewRowCount() && pMatFileReader->getPreviewRow(firstPreviewRow) < rowsRead) {
+    firstPreviewRow++;
+  }
+  for (int i = 0 ; i < curves.size() ; i++) {
+    PlotCurve *pPlotCurve = curves.at(i);
+    pPlotCurve->clearXAxisVector();
+    pPlotCurve->clearYAxisVector();
+    pPlotCurve->mXAxisVector.reserve(rowsRead + pMatFileReader->getPreviewRowCount() - firstPreviewRow);
+    pPlotCurve->mYAxisVector.reserve(rowsRead + pMatFileReader->getPreviewRowCount() - firstPreviewRow);
+    // column 0 is time
+    for (uint32_t row = 0 ; row < rowsRead ; row++) {
+      pPlotCurve->addXAxisValue(pMatFileReader->getValue(0, row));
+      pPlotCurve->addYAxisValue(pMatFileReader->getValue(i + 1, row));
+    }
+    for (int j = firstPreviewRow ; j < pMatFileReader->getPreviewRowCount() ; j++) {
+      pPlotCurve->addXAxisValue(pMatFileReader->getPreviewValue(0, j));
+      pPlotCurve->addYAxisValue(pMatFileReader->getPreviewValue(i + 1, j));
+    }
+    pPlotCurve->plotData();
+    pPlotCurve->attach(mpPlot);
+  }
+  mpPlot->replot();
+}
+
 void PlotWindow::plotParametric(PlotCurve *pPlotCurve)
 {
   QString xVariable, yVariable, xTitle, yTitle;
@@ -69,6 +69,7 @@ namespace OMPlot
 {
 class Plot;
 class PlotCurve;
+class MatFileReader;
 
 class PlotWindow : public QMainWindow
 {
@@ -223,6 +224,7 @@ public:
   void emitPrefixUnitsChanged();
 private:
   void setInteractiveControls(bool enabled);
+  void setMatFileSamples(MatFileReader *pMatFileReader, const QList<PlotCurve*> &curves);
 signals:
   void closingDown();
   void prefixUnitsChanged();
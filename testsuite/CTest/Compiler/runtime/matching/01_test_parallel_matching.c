@@ -0,0 +1,139 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "matchmaker.h"
+
+#define NUM_THREADS 4
+
+typedef struct {
+  int n;        /* columns (equations) */
+  int m;        /* rows (variables) */
+  int* col_ptrs;
+  int* col_ids;
+} GRAPH;
+
+static unsigned int seed = 4711;
+
+static int nextRandom(int range)
+{
+  seed = seed * 1103515245u + 12345u;
+  return (int)((seed >> 8) % (unsigned int)range);
+}
+
+/**
+ * @brief Random graph with degree entries per column, the first column
+ * entries are shifted by offset so that greedy matchings leave many columns
+ * unmatched.
+ */
+static GRAPH createGraph(int n, int m, int degree, int offset)
+{
+  GRAPH graph;
+  int i, k, nz = 0;
+
+  graph.n = n;
+  graph.m = m;
+  graph.col_ptrs = (int*)malloc(sizeof(int) * (n + 1));
+  graph.col_ids = (int*)malloc(sizeof(int) * n * (degree + 1));
+  for (i = 0; i < n; i++) {
+    graph.col_ptrs[i] = nz;
+    graph.col_ids[nz++] = (i + offset) % m;
+    for (k = 0; k < degree; k++) {
+      graph.col_ids[nz++] = nextRandom(m);
+    }
+  }
+  graph.col_ptrs[n] = nz;
+  return graph;
+}
+
+static void freeGraph(GRAPH* graph)
+{
+  free(graph->col_ptrs);
+  free(graph->col_ids);
+}
+
+/**
+ * @brief Matches the graph and checks that the result is a valid matching.
+ *
+ * @return int  Cardinality of the matching or -1 if it is invalid.
+ */
+static int matchGraph(GRAPH* graph, int matchingId, int cheapId, int numThreads)
+{
+  int* match = (int*)malloc(sizeof(int) * graph->n);
+  int* row_match = (int*)malloc(sizeof(int) * graph->m);
+  int i, k, cardinality = 0;
+
+  matching(graph->col_ptrs, graph->col_ids, match, row_match, graph->n, graph->m, matchingId, cheapId, 1.0, 1, numThreads);
+
+  for (i = 0; i < graph->n && cardinality >= 0; i++) {
+    if (match[i] == -1) {
+      continue;
+    }
+    for (k = graph->col_ptrs[i]; k < graph->col_ptrs[i + 1] && graph->col_ids[k] != match[i]; k++);
+    if (k == graph->col_ptrs[i + 1] || row_match[match[i]] != i) {
+      cardinality = -1;
+    } else {
+      cardinality++;
+    }
+  }
+  for (i = 0; i < graph->m && cardinality >= 0; i++) {
+    if (row_match[i] != -1 && match[row_match[i]] != i) {
+      cardinality = -1;
+    }
+  }
+
+  free(match);
+  free(row_match);
+  return cardinality;
+}
+
+static int testGraph(const char* name, GRAPH graph)
+{
+  int expected = matchGraph(&graph, do_pf_fair, do_old_cheap, 1);
+  int parallel = matchGraph(&graph, do_par_pf, do_par_cheap, NUM_THREADS);
+  int parallelSerialCheap = matchGraph(&graph, do_par_pf, do_sk_cheap_rand, NUM_THREADS);
+  int cheap = matchGraph(&graph, 0, do_par_cheap, NUM_THREADS);
+  int success = 1;
+
+  if (expected < 0 || parallel != expected || parallelSerialCheap != expected) {
+    fprintf(stderr, "Test failed for %s: Expected cardinality '%d', but got '%d' and '%d'.\n", name, expected, parallel, parallelSerialCheap);
+    success = 0;
+  }
+  if (cheap < 0 || cheap > expected) {
+    fprintf(stderr, "Test failed for %s: Invalid parallel cheap matching of cardinality '%d'.\n", name, cheap);
+    success = 0;
+  }
+
+  freeGraph(&graph);
+  return success;
+}
+
+/**
+ * @brief Test the parallel matching algorithms against match_pf_fair.
+ *
+ * All matching algorithms compute a maximum matching, so the parallel ones
+ * need to find the same cardinality as the serial ones.
+ *
+ * @return int  Return 0 on test success, 1 otherwise.
+ */
+int main(void)
+{
+  int test_success = 1;
+
+  test_success &= testGraph("small square graph", createGraph(1000, 1000, 2, 1));
+  test_success &= testGraph("square graph", createGraph(50000, 50000, 2, 1));
+  test_success &= testGraph("sparse square graph", createGraph(50000, 50000, 1, 7));
+  test_success &= testGraph("graph with more equations", createGraph(60000, 40000, 2, 3));
+  test_success &= testGraph("graph with more variables", createGraph(40000, 60000, 3, 5));
+
+  if (test_success)
+  {
+    printf("All tests passed!\n");
+    return 0;
+  }
+  else
+  {
+    printf("Some tests failed!\n");
+    return 1;
+  }
+}
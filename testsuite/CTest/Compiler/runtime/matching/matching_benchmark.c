@@ -0,0 +1,145 @@
+/*
+ * Benchmark of the matching algorithms of Compiler/runtime/matchmaker.h.
+ *
+ * Reads bipartite graphs in MatrixMarket coordinate format, e.g. written by
+ * omc with -d=dumpMatchingGraph, with one row per equation and one column per
+ * variable, and prints the time and cardinality of every matching algorithm.
+ *
+ * Usage: matching_benchmark [-t threads] [-c cheapId] [-r repetitions] file.mtx ...
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "matchmaker.h"
+
+typedef struct {
+  int n;        /* equations */
+  int m;        /* variables */
+  int* col_ptrs;
+  int* col_ids;
+} GRAPH;
+
+static const char* matchingNames[] = {"", "DFS", "BFS", "MC21", "PF", "PF+", "HK", "HK-DW", "ABMP", "ABMP-BFS", "PR-FIFO-FAIR", "PF-PAR"};
+
+static double wallTime(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+static int readGraph(const char* fileName, GRAPH* graph)
+{
+  FILE* file = fopen(fileName, "r");
+  char line[1024];
+  int* eqns;
+  int* vars;
+  int i, nz, count = 0;
+
+  if (!file) {
+    fprintf(stderr, "Could not open %s\n", fileName);
+    return 0;
+  }
+  do {
+    if (!fgets(line, sizeof(line), file)) {
+      fclose(file);
+      return 0;
+    }
+  } while (line[0] == '%');
+  if (3 != sscanf(line, "%d %d %d", &graph->n, &graph->m, &nz)) {
+    fprintf(stderr, "Invalid size line in %s\n", fileName);
+    fclose(file);
+    return 0;
+  }
+
+  eqns = (int*)malloc(sizeof(int) * nz);
+  vars = (int*)malloc(sizeof(int) * nz);
+  while (count < nz && fgets(line, sizeof(line), file)) {
+    if (line[0] != '%' && 2 == sscanf(line, "%d %d", &eqns[count], &vars[count])) {
+      if (eqns[count] < 1 || eqns[count] > graph->n || vars[count] < 1 || vars[count] > graph->m) {
+        fprintf(stderr, "Entry %d %d out of range in %s\n", eqns[count], vars[count], fileName);
+        continue;
+      }
+      count++;
+    }
+  }
+  fclose(file);
+
+  graph->col_ptrs = (int*)calloc(graph->n + 1, sizeof(int));
+  graph->col_ids = (int*)malloc(sizeof(int) * (count > 0 ? count : 1));
+  for (i = 0; i < count; i++) {
+    graph->col_ptrs[eqns[i]]++;
+  }
+  for (i = 0; i < graph->n; i++) {
+    graph->col_ptrs[i + 1] += graph->col_ptrs[i];
+  }
+  for (i = 0; i < count; i++) {
+    graph->col_ids[graph->col_ptrs[eqns[i] - 1]++] = vars[i] - 1;
+  }
+  for (i = graph->n; i > 0; i--) {
+    graph->col_ptrs[i] = graph->col_ptrs[i - 1];
+  }
+  graph->col_ptrs[0] = 0;
+
+  free(eqns);
+  free(vars);
+  return 1;
+}
+
+int main(int argc, char** argv)
+{
+  int numThreads = 4, cheapId = do_sk_cheap_rand, repetitions = 3;
+  int arg, matchingId, rep, i, cardinality;
+  double start, best;
+  GRAPH graph;
+  int* match;
+  int* row_match;
+
+  for (arg = 1; arg + 1 < argc && argv[arg][0] == '-'; arg += 2) {
+    if (0 == strcmp(argv[arg], "-t")) {
+      numThreads = atoi(argv[arg + 1]);
+    } else if (0 == strcmp(argv[arg], "-c")) {
+      cheapId = atoi(argv[arg + 1]);
+    } else if (0 == strcmp(argv[arg], "-r")) {
+      repetitions = atoi(argv[arg + 1]);
+    } else {
+      break;
+    }
+  }
+  if (arg >= argc) {
+    fprintf(stderr, "Usage: %s [-t threads] [-c cheapId] [-r repetitions] file.mtx ...\n", argv[0]);
+    return 1;
+  }
+
+  for (; arg < argc; arg++) {
+    if (!readGraph(argv[arg], &graph)) {
+      return 1;
+    }
+    printf("%s: %d equations, %d variables, %d entries\n", argv[arg], graph.n, graph.m, graph.col_ptrs[graph.n]);
+    match = (int*)malloc(sizeof(int) * graph.n);
+    row_match = (int*)malloc(sizeof(int) * graph.m);
+
+    for (matchingId = do_dfs; matchingId <= do_par_pf; matchingId++) {
+      best = -1;
+      for (rep = 0; rep < repetitions; rep++) {
+        start = wallTime();
+        matching(graph.col_ptrs, graph.col_ids, match, row_match, graph.n, graph.m, matchingId, cheapId, 1.0, 1, numThreads);
+        start = wallTime() - start;
+        best = (best < 0 || start < best) ? start : best;
+      }
+      for (i = 0, cardinality = 0; i < graph.n; i++) {
+        cardinality += match[i] != -1;
+      }
+      printf("  %-13s %10.4f s  cardinality %d\n", matchingNames[matchingId], best, cardinality);
+    }
+
+    free(match);
+    free(row_match);
+    free(graph.col_ptrs);
+    free(graph.col_ids);
+  }
+  return 0;
+}
@@ -0,0 +1,122 @@
+/*
+ * Driver for ZeroMQMessagePack.mos.
+ *
+ * Encodes arrays of strings like the ZeroMQ server encodes the replies to a
+ * binary request, decodes them like it decodes binary requests and checks
+ * that the strings are unchanged. Strings that are not valid UTF-8 must be
+ * encoded as bins, not strings.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../../OMCompiler/Compiler/runtime/zeromqmsgpack.c"
+
+#define MAX_STRINGS 8
+
+typedef struct {
+  size_t count;
+  const char *strs[MAX_STRINGS];
+  size_t lens[MAX_STRINGS];
+} Decoded;
+
+static void add(void *userData, const char *str, size_t len)
+{
+  Decoded *decoded = (Decoded*)userData;
+  if (decoded->count < MAX_STRINGS) {
+    decoded->strs[decoded->count] = str;
+    decoded->lens[decoded->count] = len;
+  }
+  decoded->count++;
+}
+
+static const char* typeName(unsigned char type)
+{
+  if (type >= 0xa0 && type <= 0xbf) return "fixstr";
+  switch (type) {
+    case 0xd9: return "str 8";
+    case 0xda: return "str 16";
+    case 0xdb: return "str 32";
+    case 0xc4: return "bin 8";
+    case 0xc5: return "bin 16";
+    case 0xc6: return "bin 32";
+    default: return "unknown";
+  }
+}
+
+/* Encodes the strings, prints the type of each element and decodes them again */
+static void roundTrip(const char *name, const char **strs, const size_t *lens, size_t count)
+{
+  size_t i, size = ZEROMQ_MAX_HEADER_SIZE;
+  unsigned char *buf, *pos;
+  Decoded decoded;
+
+  for (i = 0; i < count; i++) {
+    size += ZEROMQ_MAX_HEADER_SIZE + lens[i];
+  }
+  buf = (unsigned char*)malloc(size);
+  pos = zeroMQWriteArrayHeader(buf, count);
+  printf("%s:", name);
+  for (i = 0; i < count; i++) {
+    unsigned char *header = pos;
+    pos = zeroMQWriteString(pos, strs[i], lens[i]);
+    printf(" %s", typeName(*header));
+  }
+  printf("\n");
+
+  memset(&decoded, 0, sizeof(decoded));
+  if (!zeroMQDecodeStrings(buf, pos - buf, add, &decoded)) {
+    printf("%s: decoding failed\n", name);
+  } else if (decoded.count != count) {
+    printf("%s: decoded %d strings, expected %d\n", name, (int)decoded.count, (int)count);
+  } else {
+    for (i = 0; i < count; i++) {
+      if (decoded.lens[i] != lens[i] || memcmp(decoded.strs[i], strs[i], lens[i])) {
+        printf("%s: string %d changed\n", name, (int)i);
+      }
+    }
+  }
+
+  /* a truncated array must be rejected */
+  if (pos - buf > 1 && zeroMQDecodeStrings(buf, pos - buf - 1, add, &decoded)) {
+    printf("%s: truncated data was decoded\n", name);
+  }
+  free(buf);
+}
+
+int main(void)
+{
+  char *str300 = (char*)malloc(300), *str70000 = (char*)malloc(70000), *bin300 = (char*)malloc(300);
+  const char *strs[MAX_STRINGS];
+  size_t lens[MAX_STRINGS];
+
+  memset(str300, 'a', 300);
+  memset(str70000, 'b', 70000);
+  memset(bin300, 'c', 300);
+  bin300[150] = (char)0xff;
+
+  strs[0] = "1"; lens[0] = 1;
+  strs[1] = "\"OpenModelica\""; lens[1] = 14;
+  strs[2] = "\"Linköping\""; lens[2] = strlen(strs[2]);
+  strs[3] = ""; lens[3] = 0;
+  strs[4] = "a\0b"; lens[4] = 3;
+  roundTrip("utf-8", strs, lens, 5);
+
+  strs[0] = "\"Link\xf6ping\""; lens[0] = 11;
+  strs[1] = "\xc3"; lens[1] = 1;
+  roundTrip("not utf-8", strs, lens, 2);
+
+  strs[0] = str300; lens[0] = 300;
+  strs[1] = str70000; lens[1] = 70000;
+  strs[2] = bin300; lens[2] = 300;
+  roundTrip("long", strs, lens, 3);
+
+  roundTrip("empty", strs, lens, 0);
+
+  free(str300);
+  free(str70000);
+  free(bin300);
+  printf("done\n");
+  return 0;
+}
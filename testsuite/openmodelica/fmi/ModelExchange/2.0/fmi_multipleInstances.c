@@ -0,0 +1,315 @@
+/*
+ * Driver for fmi_multipleInstances.mos.
+ *
+ * Loads the binary of an unzipped FMI 2.0 model exchange FMU once and
+ * instantiates it twice in the same process, resets one instance while the
+ * other one is alive, frees both and instantiates the FMU again. The
+ * instances share the parsed _info.json, so this covers the reference
+ * counting in modelInfoInit/modelInfoDeinit.
+ *
+ * The driver also takes references to the shared equation info itself, via
+ * the runtime functions exported by the FMU binary, with different values of
+ * measure_time_flag. The profile blocks depend on it, so each value gets its
+ * own entry, and the equation info stays valid after all FMU instances that
+ * parsed it were freed.
+ *
+ * Usage: fmi_multipleInstances <unzipped fmu directory> <model identifier>
+ */
+
+#include <dlfcn.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* The parts of fmi2FunctionTypes.h needed here */
+typedef void* fmi2Component;
+typedef void* fmi2ComponentEnvironment;
+typedef const char* fmi2String;
+typedef double fmi2Real;
+typedef int fmi2Boolean;
+typedef enum { fmi2OK, fmi2Warning, fmi2Discard, fmi2Error, fmi2Fatal, fmi2Pending } fmi2Status;
+typedef enum { fmi2ModelExchange, fmi2CoSimulation } fmi2Type;
+
+typedef struct {
+  void (*logger)(fmi2ComponentEnvironment, fmi2String, fmi2Status, fmi2String, fmi2String, ...);
+  void* (*allocateMemory)(size_t, size_t);
+  void (*freeMemory)(void*);
+  void (*stepFinished)(fmi2ComponentEnvironment, fmi2Status);
+  fmi2ComponentEnvironment componentEnvironment;
+} fmi2CallbackFunctions;
+
+typedef struct {
+  fmi2Boolean newDiscreteStatesNeeded;
+  fmi2Boolean terminateSimulation;
+  fmi2Boolean nominalsOfContinuousStatesChanged;
+  fmi2Boolean valuesOfContinuousStatesChanged;
+  fmi2Boolean nextEventTimeDefined;
+  fmi2Real nextEventTime;
+} fmi2EventInfo;
+
+static fmi2Component (*fmi2Instantiate)(fmi2String, fmi2Type, fmi2String, fmi2String, const fmi2CallbackFunctions*, fmi2Boolean, fmi2Boolean);
+/* The parts of simulation_data.h needed for modelInfoInit */
+typedef struct {
+  const char* filename;
+  int lineStart;
+  int colStart;
+  int lineEnd;
+  int colEnd;
+  int readonly;
+} FILE_INFO;
+
+typedef struct {
+  int id;
+  int section;
+  int profileBlockIndex;
+  int parent;
+  int numVar;
+  const char **vars;
+} EQUATION_INFO;
+
+typedef struct {
+  int id;
+  const char* name;
+  FILE_INFO info;
+} FUNCTION_INFO;
+
+typedef struct {
+  const char *fileName;
+  const char *infoXMLData;
+  size_t modelInfoXmlLength;
+  long nFunctions;
+  long nEquations;
+  long nProfileBlocks;
+  FUNCTION_INFO *functionNames;
+  EQUATION_INFO *equationInfo;
+} MODEL_DATA_XML;
+
+static void (*fmi2FreeInstance)(fmi2Component);
+static fmi2Status (*fmi2Reset)(fmi2Component);
+static fmi2Status (*fmi2SetupExperiment)(fmi2Component, fmi2Boolean, fmi2Real, fmi2Real, fmi2Boolean, fmi2Real);
+static fmi2Status (*fmi2EnterInitializationMode)(fmi2Component);
+static fmi2Status (*fmi2ExitInitializationMode)(fmi2Component);
+static fmi2Status (*fmi2NewDiscreteStates)(fmi2Component, fmi2EventInfo*);
+static fmi2Status (*fmi2EnterContinuousTimeMode)(fmi2Component);
+static fmi2Status (*fmi2SetContinuousStates)(fmi2Component, const fmi2Real*, size_t);
+static fmi2Status (*fmi2GetDerivatives)(fmi2Component, fmi2Real*, size_t);
+static void (*modelInfoInit)(MODEL_DATA_XML*);
+static void (*modelInfoDeinit)(MODEL_DATA_XML*);
+static int *measure_time_flag;
+
+static char guid[256];
+static char resources[PATH_MAX + 32];
+static char infoJson[PATH_MAX + 256];
+static long nEquations;
+
+static void logger(fmi2ComponentEnvironment env, fmi2String instanceName, fmi2Status status, fmi2String category, fmi2String message, ...)
+{
+  va_list args;
+  if (status == fmi2OK) {
+    return;
+  }
+  printf("%s (%s): ", instanceName, category);
+  va_start(args, message);
+  vprintf(message, args);
+  va_end(args);
+  printf("\n");
+}
+
+static const fmi2CallbackFunctions callbacks = {logger, calloc, free, NULL, NULL};
+
+static void* loadSymbol(void *handle, const char *name)
+{
+  void *sym = dlsym(handle, name);
+  if (!sym) {
+    printf("Could not load %s: %s\n", name, dlerror());
+    exit(1);
+  }
+  return sym;
+}
+
+static void readGuid(const char *fmuDir)
+{
+  char fileName[PATH_MAX];
+  char buffer[65536];
+  size_t n;
+  const char *start, *end;
+  FILE *file;
+
+  snprintf(fileName, sizeof(fileName), "%s/modelDescription.xml", fmuDir);
+  file = fopen(fileName, "r");
+  if (!file) {
+    printf("Could not open %s\n", fileName);
+    exit(1);
+  }
+  n = fread(buffer, 1, sizeof(buffer) - 1, file);
+  buffer[n] = '\0';
+  fclose(file);
+
+  start = strstr(buffer, "guid=\"");
+  end = start ? strchr(start + 6, '"') : NULL;
+  if (!end || end - start - 6 >= (long) sizeof(guid)) {
+    printf("No guid in %s\n", fileName);
+    exit(1);
+  }
+  memcpy(guid, start + 6, end - start - 6);
+  guid[end - start - 6] = '\0';
+}
+
+/* The equations of the _info.json, the model has no functions */
+static void countEquations(void)
+{
+  char buffer[65536];
+  const char *str;
+  size_t n;
+  FILE *file = fopen(infoJson, "r");
+
+  if (!file) {
+    printf("Could not open %s\n", infoJson);
+    exit(1);
+  }
+  n = fread(buffer, 1, sizeof(buffer) - 1, file);
+  buffer[n] = '\0';
+  fclose(file);
+
+  for (str = strstr(buffer, "\"eqIndex\""); str; str = strstr(str + 1, "\"eqIndex\"")) {
+    nEquations++;
+  }
+}
+
+/* Takes a reference to the shared equation info and checks it */
+static void readModelInfo(MODEL_DATA_XML *xml, const char *name, int flag)
+{
+  long i;
+  int j, found = 0;
+
+  memset(xml, 0, sizeof(*xml));
+  xml->fileName = infoJson;
+  xml->nEquations = nEquations;
+  *measure_time_flag = flag;
+  modelInfoInit(xml);
+  *measure_time_flag = 0;
+
+  for (i = 1; i < xml->nEquations; i++) {
+    for (j = 0; j < xml->equationInfo[i].numVar; j++) {
+      found = found || !strcmp(xml->equationInfo[i].vars[j], "der(x)");
+    }
+  }
+  printf("%s: measure_time_flag = %d, %s, %s\n", name, flag,
+         xml->nProfileBlocks == 0 ? "no profile blocks" : xml->nProfileBlocks == xml->nEquations ? "one profile block per equation" : "wrong number of profile blocks",
+         found ? "der(x) defined" : "der(x) not defined");
+}
+
+static fmi2Component instantiate(const char *name)
+{
+  fmi2Component c = fmi2Instantiate(name, fmi2ModelExchange, guid, resources, &callbacks, 0, 0);
+  if (!c) {
+    printf("%s: fmi2Instantiate failed\n", name);
+    exit(1);
+  }
+  return c;
+}
+
+/* Initializes the instance, sets the state to x and prints der(x) */
+static void evaluate(fmi2Component c, const char *name, fmi2Real x)
+{
+  fmi2EventInfo eventInfo;
+  fmi2Real dx = 0;
+
+  if (fmi2SetupExperiment(c, 0, 0, 0, 0, 1) != fmi2OK ||
+      fmi2EnterInitializationMode(c) != fmi2OK ||
+      fmi2ExitInitializationMode(c) != fmi2OK) {
+    printf("%s: initialization failed\n", name);
+    exit(1);
+  }
+  memset(&eventInfo, 0, sizeof(eventInfo));
+  eventInfo.newDiscreteStatesNeeded = 1;
+  while (eventInfo.newDiscreteStatesNeeded) {
+    fmi2NewDiscreteStates(c, &eventInfo);
+  }
+  if (fmi2EnterContinuousTimeMode(c) != fmi2OK ||
+      fmi2SetContinuousStates(c, &x, 1) != fmi2OK ||
+      fmi2GetDerivatives(c, &dx, 1) != fmi2OK) {
+    printf("%s: evaluation failed\n", name);
+    exit(1);
+  }
+  printf("%s: x = %g, der(x) = %g\n", name, x, dx);
+}
+
+int main(int argc, char **argv)
+{
+  char fmuDir[PATH_MAX];
+  char library[PATH_MAX + 256];
+  void *handle;
+  fmi2Component c1, c2, c3;
+  MODEL_DATA_XML xml1, xml2, xml3;
+
+  if (argc != 3 || !realpath(argv[1], fmuDir)) {
+    printf("Usage: %s <unzipped fmu directory> <model identifier>\n", argv[0]);
+    return 1;
+  }
+  readGuid(fmuDir);
+  snprintf(resources, sizeof(resources), "file://%s/resources", fmuDir);
+  /* the same file name the instances use, which is the key of the shared info */
+  snprintf(infoJson, sizeof(infoJson), "%s/resources/%s_info.json", fmuDir, argv[2]);
+  countEquations();
+  snprintf(library, sizeof(library), "%s/binaries/linux64/%s.so", fmuDir, argv[2]);
+
+  handle = dlopen(library, RTLD_NOW | RTLD_LOCAL);
+  if (!handle) {
+    printf("Could not load %s: %s\n", library, dlerror());
+    return 1;
+  }
+  fmi2Instantiate = loadSymbol(handle, "fmi2Instantiate");
+  fmi2FreeInstance = loadSymbol(handle, "fmi2FreeInstance");
+  fmi2Reset = loadSymbol(handle, "fmi2Reset");
+  fmi2SetupExperiment = loadSymbol(handle, "fmi2SetupExperiment");
+  fmi2EnterInitializationMode = loadSymbol(handle, "fmi2EnterInitializationMode");
+  fmi2ExitInitializationMode = loadSymbol(handle, "fmi2ExitInitializationMode");
+  fmi2NewDiscreteStates = loadSymbol(handle, "fmi2NewDiscreteStates");
+  fmi2EnterContinuousTimeMode = loadSymbol(handle, "fmi2EnterContinuousTimeMode");
+  fmi2SetContinuousStates = loadSymbol(handle, "fmi2SetContinuousStates");
+  fmi2GetDerivatives = loadSymbol(handle, "fmi2GetDerivatives");
+  modelInfoInit = loadSymbol(handle, "modelInfoInit");
+  modelInfoDeinit = loadSymbol(handle, "modelInfoDeinit");
+  measure_time_flag = loadSymbol(handle, "measure_time_flag");
+
+  /* two instances alive at the same time */
+  c1 = instantiate("inst1");
+  c2 = instantiate("inst2");
+  evaluate(c1, "inst1", 1.0);
+  evaluate(c2, "inst2", 3.0);
+
+  /* the info parsed by the instances, and two entries with profile blocks */
+  readModelInfo(&xml1, "info1", 0);
+  readModelInfo(&xml2, "info2", 2);
+  readModelInfo(&xml3, "info3", 2);
+
+  /* reset one instance while the other one still holds the model info */
+  if (fmi2Reset(c1) != fmi2OK) {
+    printf("inst1: fmi2Reset failed\n");
+    return 1;
+  }
+  evaluate(c1, "inst1", 5.0);
+
+  /* free both, the model info is released with the last instance */
+  fmi2FreeInstance(c1);
+  fmi2FreeInstance(c2);
+  modelInfoDeinit(&xml2);
+
+  /* the info parsed by the instances is still referenced by xml1 */
+  readModelInfo(&xml2, "info2", 0);
+  modelInfoDeinit(&xml1);
+  modelInfoDeinit(&xml2);
+  modelInfoDeinit(&xml3);
+
+  /* instantiate again after the model info was released */
+  c3 = instantiate("inst3");
+  evaluate(c3, "inst3", 7.0);
+  fmi2FreeInstance(c3);
+
+  dlclose(handle);
+  printf("done\n");
+  return 0;
+}